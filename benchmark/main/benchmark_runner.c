@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include "driver/spi_master.h"
+#include "driver/gpio.h"
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+#include "mcp320x_benchmark.h"
+
+#define GPIO_CS GPIO_NUM_5
+#define GPIO_SCLK GPIO_NUM_18
+#define GPIO_MISO GPIO_NUM_19
+#define GPIO_MOSI GPIO_NUM_23
+
+#define RESULT_CAPACITY (2 * MCP320X_BENCHMARK_CLOCK_COUNT_MAX * MCP320X_BENCHMARK_OPERATION_COUNT)
+
+static void print_banner(const char *text);
+
+void app_main(void)
+{
+    /* This is just the benchmark runner.
+     * The benchmark is on "components/#/benchmark".
+     *
+     * Same hardware setup as the test project:
+     * VSS = VDD = 5V
+     * Channel 3 = 2.5V
+     */
+
+    spi_bus_config_t bus_cfg = {
+        .mosi_io_num = GPIO_MOSI,
+        .miso_io_num = GPIO_MISO,
+        .sclk_io_num = GPIO_SCLK,
+        .quadwp_io_num = GPIO_NUM_NC,
+        .quadhd_io_num = GPIO_NUM_NC,
+        .data4_io_num = GPIO_NUM_NC,
+        .data5_io_num = GPIO_NUM_NC,
+        .data6_io_num = GPIO_NUM_NC,
+        .data7_io_num = GPIO_NUM_NC,
+        .max_transfer_sz = 3, // 24 bits.
+        .flags = SPICOMMON_BUSFLAG_MASTER,
+        .isr_cpu_id = ESP_INTR_CPU_AFFINITY_AUTO,
+        .intr_flags = ESP_INTR_FLAG_LEVEL3};
+
+    spi_bus_initialize(SPI3_HOST, &bus_cfg, 0);
+
+    const mcp320x_benchmark_config_t spi_config = {
+        .label = "spi",
+        .device = {
+            .host = SPI3_HOST,
+            .device_model = MCP3204_MODEL,
+            .reference_voltage = 5000,
+            .cs_io_num = GPIO_CS},
+        .channel = MCP320X_CHANNEL_3};
+
+    // The mock transport answers instantly, so what is left is the cost of
+    // the driver itself: validation, encoding, decoding and conversions.
+    static mcp320x_transport_mock_t mock = {.codes = {[MCP320X_CHANNEL_3] = 2048}};
+    static const uint32_t mock_clocks_hz[] = {MCP320X_CLOCK_MAX_HZ};
+    const mcp320x_benchmark_config_t mock_config = {
+        .label = "mock",
+        .device = {
+            .device_model = MCP3204_MODEL,
+            .reference_voltage = 5000,
+            .transport = &mcp320x_transport_mock,
+            .transport_config = &mock},
+        .channel = MCP320X_CHANNEL_3,
+        .clocks_hz = mock_clocks_hz,
+        .clock_count = 1,
+        .iterations = 1000};
+
+    static mcp320x_benchmark_result_t results[RESULT_CAPACITY];
+    size_t count = 0;
+    size_t mock_count = 0;
+
+    print_banner("Running benchmark");
+
+    if (mcp320x_benchmark_run(&spi_config, results, RESULT_CAPACITY, &count) != MCP320X_OK ||
+        mcp320x_benchmark_run(&mock_config, &results[count], RESULT_CAPACITY - count, &mock_count) != MCP320X_OK)
+    {
+        print_banner("Benchmark failed");
+    }
+
+    count += mock_count;
+
+    print_banner("CSV");
+    mcp320x_benchmark_print(stdout, MCP320X_BENCHMARK_FORMAT_CSV, results, count);
+
+    print_banner("JSON");
+    mcp320x_benchmark_print(stdout, MCP320X_BENCHMARK_FORMAT_JSON, results, count);
+
+    spi_bus_free(SPI3_HOST);
+}
+
+static void print_banner(const char *text)
+{
+    printf("\n#### %s #####\n\n", text);
+}
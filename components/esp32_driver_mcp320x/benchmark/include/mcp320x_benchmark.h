@@ -0,0 +1,128 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_BENCHMARK_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_BENCHMARK_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_BENCHMARK_OPERATION_COUNT 9   /** @brief Number of operations measured on each clock speed. */
+#define MCP320X_BENCHMARK_CLOCK_COUNT_MAX 16  /** @brief Maximum number of clock speeds on a sweep. */
+#define MCP320X_BENCHMARK_SAMPLE_COUNT 16     /** @brief Conversions per call of the sample and batch operations. */
+#define MCP320X_BENCHMARK_ITERATIONS 100      /** @brief Default calls measured per operation and clock speed. */
+#define MCP320X_BENCHMARK_STREAM_DURATION 100 /** @brief Default duration of the stream operation, in milliseconds. */
+#define MCP320X_BENCHMARK_CLIENTS 8           /** @brief Default tasks reading at the same time on the contended and broker operations. */
+
+    /**
+     * @typedef mcp320x_benchmark_operation_t
+     * @brief Operation measured.
+     */
+    typedef enum
+    {
+        MCP320X_BENCHMARK_READ = 0,           /** @brief @ref mcp320x_read, one conversion per call. */
+        MCP320X_BENCHMARK_READ_UNCHECKED = 1, /** @brief @ref mcp320x_read_unchecked, one conversion per call. */
+        MCP320X_BENCHMARK_READ_PREPARED = 2,  /** @brief @ref mcp320x_read_prepared, one conversion per call. */
+        MCP320X_BENCHMARK_SAMPLE = 3,         /** @brief @ref mcp320x_sample, @ref MCP320X_BENCHMARK_SAMPLE_COUNT conversions per call. */
+        MCP320X_BENCHMARK_READ_BATCH = 4,     /** @brief @ref mcp320x_read_batch, @ref MCP320X_BENCHMARK_SAMPLE_COUNT conversions per call. */
+        MCP320X_BENCHMARK_SCAN = 5,           /** @brief @ref mcp320x_scan of all channels, one conversion per channel per call. */
+        MCP320X_BENCHMARK_STREAM = 6,         /** @brief @ref mcp320x_stream_read of a background acquisition at its maximum rate. */
+        MCP320X_BENCHMARK_CONTENDED = 7,      /** @brief @ref mcp320x_read of a locked handle, from many tasks at the same time. */
+        MCP320X_BENCHMARK_BROKER = 8          /** @brief @ref mcp320x_broker_read, from many tasks at the same time. */
+    } mcp320x_benchmark_operation_t;
+
+    /**
+     * @typedef mcp320x_benchmark_format_t
+     * @brief Output format of the results.
+     */
+    typedef enum
+    {
+        MCP320X_BENCHMARK_FORMAT_CSV = 0, /** @brief One header line plus one line per result. */
+        MCP320X_BENCHMARK_FORMAT_JSON = 1 /** @brief An array with one object per result. */
+    } mcp320x_benchmark_format_t;
+
+    /**
+     * @typedef mcp320x_benchmark_config_t
+     * @brief Configuration for a benchmark run.
+     */
+    typedef struct
+    {
+        const char *label;           /** @brief Name of the setup, copied to every result; NULL is "default". */
+        mcp320x_config_t device;     /** @brief Device to measure. Its clock speed is replaced by each one on \p clocks_hz. */
+        mcp320x_channel_t channel;   /** @brief Channel converted by the single channel operations. */
+        uint32_t const *clocks_hz;   /** @brief Clock speeds to measure; NULL sweeps from MCP320X_CLOCK_MIN_HZ to MCP320X_CLOCK_MAX_HZ. */
+        size_t clock_count;          /** @brief Number of clock speeds on \p clocks_hz, up to @ref MCP320X_BENCHMARK_CLOCK_COUNT_MAX. */
+        uint32_t iterations;         /** @brief Calls measured per operation and clock speed; 0 uses @ref MCP320X_BENCHMARK_ITERATIONS. */
+        uint32_t stream_duration_ms; /** @brief Duration of the stream operation; 0 uses @ref MCP320X_BENCHMARK_STREAM_DURATION. */
+        uint32_t client_count;       /** @brief Tasks of the contended and broker operations, up to MCP320X_BROKER_CLIENTS_MAX; 0 uses @ref MCP320X_BENCHMARK_CLIENTS. Task N reads channel N modulo the device channels. */
+    } mcp320x_benchmark_config_t;
+
+    /**
+     * @typedef mcp320x_benchmark_result_t
+     * @brief Measurements of one operation on one clock speed.
+     */
+    typedef struct
+    {
+        const char *label;                       /** @brief Name of the setup. */
+        mcp320x_benchmark_operation_t operation; /** @brief Operation measured. */
+        uint32_t clock_hz;                       /** @brief Clock speed requested. */
+        uint32_t actual_clock_hz;                /** @brief Clock speed used by the transport. */
+        uint32_t calls;                          /** @brief Calls measured. */
+        uint32_t samples;                        /** @brief Conversions returned by the calls. */
+        uint32_t errors;                         /** @brief Calls that failed. */
+        uint32_t samples_per_sec;                /** @brief Conversions per second, over the whole run. */
+        uint32_t latency_p50_us;                 /** @brief Median call latency, in microseconds. */
+        uint32_t latency_p99_us;                 /** @brief 99th percentile call latency, in microseconds. */
+        uint32_t latency_max_us;                 /** @brief Worst call latency, in microseconds. */
+        uint32_t cycles_per_sample;              /** @brief CPU cycles spent inside the calls per conversion. */
+    } mcp320x_benchmark_result_t;
+
+    /**
+     * @brief Measure every operation on every clock speed.
+     * @details Each clock speed installs the device, measures the operations in @ref mcp320x_benchmark_operation_t
+     * order and deletes it. The bus is acquired while the blocking operations are measured. The contended and
+     * broker operations split the calls among the client tasks, on a locked handle; their latency includes the
+     * time waiting for the other clients.
+     * @note Cycles are counted on the calling core, including the time it waits for the bus, so they are
+     * an upper bound of the CPU cost when the transport uses DMA. They are not counted for the contended and
+     * broker operations, whose tasks share the cores.
+     * @param[in] config Pointer to a @ref mcp320x_benchmark_config_t struct specifying what to measure.
+     * @param[out] results Array where the results will be stored.
+     * @param[in] capacity Number of elements of \p results; at least clock count * @ref MCP320X_BENCHMARK_OPERATION_COUNT.
+     * @param[out] result_count Pointer to where the number of results stored will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_benchmark_run(mcp320x_benchmark_config_t const *config,
+                                        mcp320x_benchmark_result_t *results,
+                                        size_t capacity,
+                                        size_t *result_count);
+
+    /**
+     * @brief Write results in a machine-readable format.
+     * @param[in] stream Where to write, for example stdout.
+     * @param[in] format Output format.
+     * @param[in] results Array of \p count results.
+     * @param[in] count Number of results.
+     */
+    void mcp320x_benchmark_print(FILE *stream,
+                                 mcp320x_benchmark_format_t format,
+                                 mcp320x_benchmark_result_t const *results,
+                                 size_t count);
+
+    /**
+     * @brief Get the name of an operation, as written by @ref mcp320x_benchmark_print.
+     * @param[in] operation Operation.
+     * @return Operation name, or "unknown".
+     */
+    const char *mcp320x_benchmark_operation_name(mcp320x_benchmark_operation_t operation);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
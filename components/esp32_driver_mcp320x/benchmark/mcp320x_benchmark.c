@@ -0,0 +1,510 @@
+#include <stdlib.h>
+#include <string.h>
+#include "esp_cpu.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp32_driver_mcp320x/mcp320x_stream.h"
+#include "esp32_driver_mcp320x/mcp320x_broker.h"
+#include "mcp320x_benchmark.h"
+#include "assertion.h"
+
+static const uint32_t DEFAULT_CLOCKS_HZ[] = {
+    MCP320X_CLOCK_MIN_HZ,
+    100 * 1000,
+    500 * 1000,
+    1 * 1000 * 1000,
+    MCP320X_CLOCK_MAX_HZ};
+
+static const char *OPERATION_NAMES[MCP320X_BENCHMARK_OPERATION_COUNT] = {
+    "read",
+    "read_unchecked",
+    "read_prepared",
+    "sample",
+    "read_batch",
+    "scan",
+    "stream",
+    "contended",
+    "broker"};
+
+/**
+ * @typedef benchmark_run_t
+ * @brief State shared by the measurements of one clock speed.
+ */
+typedef struct
+{
+    mcp320x_t *handle;                                          /** @brief Device being measured. */
+    mcp320x_prepared_t prepared;                                /** @brief Request of the prepared operation. */
+    mcp320x_benchmark_config_t const *config;                   /** @brief Benchmark configuration. */
+    uint32_t iterations;                                        /** @brief Calls measured per operation. */
+    uint32_t *latencies_us;                                     /** @brief Latency of each call, \p iterations elements. */
+    mcp320x_request_t requests[MCP320X_BENCHMARK_SAMPLE_COUNT]; /** @brief Requests of the batch operation. */
+    uint16_t values[MCP320X_BENCHMARK_SAMPLE_COUNT];            /** @brief Values of the batch and stream operations. */
+    uint8_t channel_mask;                                       /** @brief All channels of the device. */
+    uint32_t client_count;                                      /** @brief Tasks of the contended and broker operations. */
+} benchmark_run_t;
+
+/**
+ * @typedef benchmark_client_t
+ * @brief A task of the contended and broker operations.
+ */
+typedef struct
+{
+    benchmark_run_t *run;                    /** @brief Benchmark run. */
+    mcp320x_benchmark_operation_t operation; /** @brief Operation measured. */
+    mcp320x_channel_t channel;               /** @brief Channel read. */
+    uint32_t *latencies_us;                  /** @brief Latency of each call, \p calls elements. */
+    uint32_t calls;                          /** @brief Calls to make. */
+    uint32_t errors;                         /** @brief Calls that failed. */
+    SemaphoreHandle_t done;                  /** @brief Given by every client when it finishes. */
+} benchmark_client_t;
+
+static mcp320x_err_t benchmark_clock(benchmark_run_t *run, uint32_t clock_hz, mcp320x_benchmark_result_t *results);
+static mcp320x_err_t benchmark_call(benchmark_run_t *run, mcp320x_benchmark_operation_t operation, uint32_t *samples);
+static void benchmark_blocking(benchmark_run_t *run, mcp320x_benchmark_result_t *result);
+static void benchmark_stream(benchmark_run_t *run, mcp320x_benchmark_result_t *result);
+static void benchmark_clients(benchmark_run_t *run, mcp320x_benchmark_result_t *result);
+static void benchmark_client_task(void *arg);
+static void benchmark_summarize(benchmark_run_t *run, mcp320x_benchmark_result_t *result, int64_t elapsed_us, uint64_t cycles);
+static int compare_latency(const void *a, const void *b);
+
+mcp320x_err_t mcp320x_benchmark_run(mcp320x_benchmark_config_t const *config,
+                                    mcp320x_benchmark_result_t *results,
+                                    size_t capacity,
+                                    size_t *result_count)
+{
+    CMP_CHECK(config != NULL, "config error(NULL)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK(config->clocks_hz != NULL || config->clock_count == 0, "clock count error(no clocks)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK(config->clock_count <= MCP320X_BENCHMARK_CLOCK_COUNT_MAX, "clock count error(>MAX)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK(config->client_count <= MCP320X_BROKER_CLIENTS_MAX, "client count error(>MCP320X_BROKER_CLIENTS_MAX)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((uint32_t)config->channel < (uint32_t)config->device.device_model, "channel error", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK(results != NULL, "results error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK(result_count != NULL, "result count error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    uint32_t const *clocks_hz = config->clocks_hz != NULL ? config->clocks_hz : DEFAULT_CLOCKS_HZ;
+    const size_t clock_count = config->clocks_hz != NULL ? config->clock_count : sizeof(DEFAULT_CLOCKS_HZ) / sizeof(DEFAULT_CLOCKS_HZ[0]);
+
+    CMP_CHECK(capacity >= clock_count * MCP320X_BENCHMARK_OPERATION_COUNT, "capacity error(too small)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+
+    benchmark_run_t run = {
+        .config = config,
+        .iterations = config->iterations != 0 ? config->iterations : MCP320X_BENCHMARK_ITERATIONS,
+        .channel_mask = (uint8_t)((1U << config->device.device_model) - 1),
+        .client_count = config->client_count != 0 ? config->client_count : MCP320X_BENCHMARK_CLIENTS};
+
+    run.latencies_us = (uint32_t *)malloc(run.iterations * sizeof(uint32_t));
+
+    CMP_CHECK(run.latencies_us != NULL, "latencies error(malloc)", MCP320X_ERR_NO_MEMORY)
+
+    for (size_t i = 0; i < MCP320X_BENCHMARK_SAMPLE_COUNT; i++)
+    {
+        run.requests[i].channel = config->channel;
+        run.requests[i].read_mode = MCP320X_READ_MODE_SINGLE;
+    }
+
+    mcp320x_err_t result = MCP320X_OK;
+
+    *result_count = 0;
+
+    for (size_t i = 0; i < clock_count && result == MCP320X_OK; i++)
+    {
+        result = benchmark_clock(&run, clocks_hz[i], &results[*result_count]);
+
+        if (result == MCP320X_OK)
+        {
+            *result_count += MCP320X_BENCHMARK_OPERATION_COUNT;
+        }
+    }
+
+    free(run.latencies_us);
+
+    return result;
+}
+
+void mcp320x_benchmark_print(FILE *stream,
+                             mcp320x_benchmark_format_t format,
+                             mcp320x_benchmark_result_t const *results,
+                             size_t count)
+{
+    if (format == MCP320X_BENCHMARK_FORMAT_JSON)
+    {
+        fprintf(stream, "[\n");
+    }
+    else
+    {
+        fprintf(stream, "label,operation,clock_hz,actual_clock_hz,calls,samples,errors,samples_per_sec,latency_p50_us,latency_p99_us,latency_max_us,cycles_per_sample\n");
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        mcp320x_benchmark_result_t const *result = &results[i];
+
+        if (format == MCP320X_BENCHMARK_FORMAT_JSON)
+        {
+            fprintf(stream,
+                    "  {\"label\": \"%s\", \"operation\": \"%s\", \"clock_hz\": %lu, \"actual_clock_hz\": %lu, \"calls\": %lu, \"samples\": %lu, "
+                    "\"errors\": %lu, \"samples_per_sec\": %lu, \"latency_p50_us\": %lu, \"latency_p99_us\": %lu, "
+                    "\"latency_max_us\": %lu, \"cycles_per_sample\": %lu}%s\n",
+                    result->label,
+                    mcp320x_benchmark_operation_name(result->operation),
+                    (unsigned long)result->clock_hz,
+                    (unsigned long)result->actual_clock_hz,
+                    (unsigned long)result->calls,
+                    (unsigned long)result->samples,
+                    (unsigned long)result->errors,
+                    (unsigned long)result->samples_per_sec,
+                    (unsigned long)result->latency_p50_us,
+                    (unsigned long)result->latency_p99_us,
+                    (unsigned long)result->latency_max_us,
+                    (unsigned long)result->cycles_per_sample,
+                    i + 1 < count ? "," : "");
+        }
+        else
+        {
+            fprintf(stream,
+                    "%s,%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n",
+                    result->label,
+                    mcp320x_benchmark_operation_name(result->operation),
+                    (unsigned long)result->clock_hz,
+                    (unsigned long)result->actual_clock_hz,
+                    (unsigned long)result->calls,
+                    (unsigned long)result->samples,
+                    (unsigned long)result->errors,
+                    (unsigned long)result->samples_per_sec,
+                    (unsigned long)result->latency_p50_us,
+                    (unsigned long)result->latency_p99_us,
+                    (unsigned long)result->latency_max_us,
+                    (unsigned long)result->cycles_per_sample);
+        }
+    }
+
+    if (format == MCP320X_BENCHMARK_FORMAT_JSON)
+    {
+        fprintf(stream, "]\n");
+    }
+}
+
+const char *mcp320x_benchmark_operation_name(mcp320x_benchmark_operation_t operation)
+{
+    if ((uint32_t)operation >= MCP320X_BENCHMARK_OPERATION_COUNT)
+    {
+        return "unknown";
+    }
+
+    return OPERATION_NAMES[operation];
+}
+
+static mcp320x_err_t benchmark_clock(benchmark_run_t *run, uint32_t clock_hz, mcp320x_benchmark_result_t *results)
+{
+    mcp320x_config_t device = run->config->device;
+    uint32_t actual_clock_hz = 0;
+
+    device.clock_speed_hz = clock_hz;
+
+    run->handle = mcp320x_install(&device);
+
+    CMP_CHECK(run->handle != NULL, "install error", MCP320X_ERR_INVALID_CONFIG)
+
+    mcp320x_prepare(run->handle, run->config->channel, MCP320X_READ_MODE_SINGLE, &run->prepared);
+
+    mcp320x_get_actual_freq(run->handle, &actual_clock_hz);
+
+    for (uint32_t i = 0; i < MCP320X_BENCHMARK_OPERATION_COUNT; i++)
+    {
+        memset(&results[i], 0, sizeof(mcp320x_benchmark_result_t));
+
+        results[i].label = run->config->label != NULL ? run->config->label : "default";
+        results[i].operation = (mcp320x_benchmark_operation_t)i;
+        results[i].clock_hz = clock_hz;
+        results[i].actual_clock_hz = actual_clock_hz;
+
+        if (results[i].operation == MCP320X_BENCHMARK_CONTENDED)
+        {
+            // The clients share the handle: from here on it must be locked.
+            mcp320x_delete(run->handle);
+
+            device.locked = true;
+            run->handle = mcp320x_install(&device);
+
+            CMP_CHECK(run->handle != NULL, "install error", MCP320X_ERR_INVALID_CONFIG)
+        }
+
+        if (results[i].operation == MCP320X_BENCHMARK_STREAM)
+        {
+            benchmark_stream(run, &results[i]);
+        }
+        else if (results[i].operation >= MCP320X_BENCHMARK_CONTENDED)
+        {
+            benchmark_clients(run, &results[i]);
+        }
+        else
+        {
+            benchmark_blocking(run, &results[i]);
+        }
+    }
+
+    mcp320x_delete(run->handle);
+
+    run->handle = NULL;
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t benchmark_call(benchmark_run_t *run, mcp320x_benchmark_operation_t operation, uint32_t *samples)
+{
+    mcp320x_channel_t channel = run->config->channel;
+    uint16_t scan_values[MCP320X_CHANNEL_COUNT_MAX];
+
+    switch (operation)
+    {
+    case MCP320X_BENCHMARK_READ:
+        *samples = 1;
+        return mcp320x_read(run->handle, channel, MCP320X_READ_MODE_SINGLE, &run->values[0]);
+    case MCP320X_BENCHMARK_READ_UNCHECKED:
+        *samples = 1;
+        return mcp320x_read_unchecked(run->handle, channel, MCP320X_READ_MODE_SINGLE, &run->values[0]);
+    case MCP320X_BENCHMARK_READ_PREPARED:
+        *samples = 1;
+        return mcp320x_read_prepared(&run->prepared, &run->values[0]);
+    case MCP320X_BENCHMARK_SAMPLE:
+        *samples = MCP320X_BENCHMARK_SAMPLE_COUNT;
+        return mcp320x_sample(run->handle, channel, MCP320X_READ_MODE_SINGLE, MCP320X_BENCHMARK_SAMPLE_COUNT, &run->values[0]);
+    case MCP320X_BENCHMARK_READ_BATCH:
+        *samples = MCP320X_BENCHMARK_SAMPLE_COUNT;
+        return mcp320x_read_batch(run->handle, run->requests, MCP320X_BENCHMARK_SAMPLE_COUNT, run->values);
+    case MCP320X_BENCHMARK_SCAN:
+        *samples = (uint32_t)run->config->device.device_model;
+        return mcp320x_scan(run->handle, run->channel_mask, MCP320X_READ_MODE_SINGLE, scan_values);
+    default:
+        *samples = 0;
+        return MCP320X_ERR_INVALID_STATE;
+    }
+}
+
+static void benchmark_blocking(benchmark_run_t *run, mcp320x_benchmark_result_t *result)
+{
+    uint32_t samples;
+    uint64_t cycles = 0;
+
+    mcp320x_acquire(run->handle, portMAX_DELAY);
+
+    // Warm up: the first call can pay for lazy initializations and cache misses.
+    benchmark_call(run, result->operation, &samples);
+
+    const int64_t start_us = esp_timer_get_time();
+
+    for (uint32_t i = 0; i < run->iterations; i++)
+    {
+        const int64_t call_start_us = esp_timer_get_time();
+        const esp_cpu_cycle_count_t call_start_cycles = esp_cpu_get_cycle_count();
+
+        const mcp320x_err_t call_result = benchmark_call(run, result->operation, &samples);
+
+        const esp_cpu_cycle_count_t call_cycles = esp_cpu_get_cycle_count() - call_start_cycles;
+
+        run->latencies_us[i] = (uint32_t)(esp_timer_get_time() - call_start_us);
+        cycles += call_cycles;
+        result->calls++;
+
+        if (call_result == MCP320X_OK)
+        {
+            result->samples += samples;
+        }
+        else
+        {
+            result->errors++;
+        }
+    }
+
+    const int64_t elapsed_us = esp_timer_get_time() - start_us;
+
+    mcp320x_release(run->handle);
+
+    benchmark_summarize(run, result, elapsed_us, cycles);
+}
+
+static void benchmark_stream(benchmark_run_t *run, mcp320x_benchmark_result_t *result)
+{
+    const mcp320x_stream_config_t stream_config = {
+        .channel_mask = run->channel_mask,
+        .read_mode = MCP320X_READ_MODE_SINGLE,
+        .rate_hz = MCP320X_STREAM_RATE_MAX_HZ,
+        .ring_capacity = 4096,
+        .overflow_policy = MCP320X_STREAM_OVERFLOW_DROP_OLDEST,
+        .task_priority = uxTaskPriorityGet(NULL) + 1,
+        .task_core = tskNO_AFFINITY};
+    const int64_t duration_us = (int64_t)(run->config->stream_duration_ms != 0 ? run->config->stream_duration_ms : MCP320X_BENCHMARK_STREAM_DURATION) * 1000;
+    uint64_t cycles = 0;
+
+    if (mcp320x_stream_start(run->handle, &stream_config) != MCP320X_OK)
+    {
+        result->errors++;
+        return;
+    }
+
+    const int64_t start_us = esp_timer_get_time();
+
+    // One drain per tick, like a consumer task would do; each call empties
+    // what the acquisition stored since the previous one.
+    while (result->calls < run->iterations && esp_timer_get_time() - start_us < duration_us)
+    {
+        size_t read_count = 0;
+        size_t total_read = 0;
+
+        vTaskDelay(1);
+
+        const int64_t call_start_us = esp_timer_get_time();
+        const esp_cpu_cycle_count_t call_start_cycles = esp_cpu_get_cycle_count();
+        mcp320x_err_t call_result;
+
+        do
+        {
+            call_result = mcp320x_stream_read(run->handle, run->values, MCP320X_BENCHMARK_SAMPLE_COUNT, &read_count);
+            total_read += read_count;
+        } while (call_result == MCP320X_OK && read_count == MCP320X_BENCHMARK_SAMPLE_COUNT);
+
+        const esp_cpu_cycle_count_t call_cycles = esp_cpu_get_cycle_count() - call_start_cycles;
+
+        run->latencies_us[result->calls] = (uint32_t)(esp_timer_get_time() - call_start_us);
+        cycles += call_cycles;
+        result->calls++;
+        result->samples += (uint32_t)total_read;
+
+        if (call_result != MCP320X_OK)
+        {
+            result->errors++;
+        }
+    }
+
+    const int64_t elapsed_us = esp_timer_get_time() - start_us;
+
+    mcp320x_stream_stop(run->handle);
+
+    benchmark_summarize(run, result, elapsed_us, cycles);
+}
+
+static void benchmark_clients(benchmark_run_t *run, mcp320x_benchmark_result_t *result)
+{
+    const mcp320x_broker_config_t broker_config = {
+        .window_us = 0,
+        .task_priority = uxTaskPriorityGet(NULL) + 1,
+        .task_core = tskNO_AFFINITY};
+    benchmark_client_t clients[MCP320X_BROKER_CLIENTS_MAX];
+    const uint32_t calls = run->iterations / run->client_count;
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(run->client_count, 0);
+    uint32_t started = 0;
+
+    if (done == NULL || calls == 0 ||
+        (result->operation == MCP320X_BENCHMARK_BROKER && mcp320x_broker_start(run->handle, &broker_config) != MCP320X_OK))
+    {
+        result->errors++;
+
+        if (done != NULL)
+        {
+            vSemaphoreDelete(done);
+        }
+
+        return;
+    }
+
+    const int64_t start_us = esp_timer_get_time();
+
+    // Each client stores its latencies on its own slice of the run's.
+    for (uint32_t i = 0; i < run->client_count; i++)
+    {
+        clients[i] = (benchmark_client_t){
+            .run = run,
+            .operation = result->operation,
+            .channel = (mcp320x_channel_t)(i % (uint32_t)run->config->device.device_model),
+            .latencies_us = &run->latencies_us[i * calls],
+            .calls = calls,
+            .done = done};
+
+        if (xTaskCreate(benchmark_client_task, "mcp320x_bench", 4096, &clients[i], uxTaskPriorityGet(NULL), NULL) != pdPASS)
+        {
+            result->errors++;
+            break;
+        }
+
+        started++;
+    }
+
+    for (uint32_t i = 0; i < started; i++)
+    {
+        xSemaphoreTake(done, portMAX_DELAY);
+
+        result->calls += clients[i].calls;
+        result->samples += clients[i].calls - clients[i].errors;
+        result->errors += clients[i].errors;
+    }
+
+    const int64_t elapsed_us = esp_timer_get_time() - start_us;
+
+    if (result->operation == MCP320X_BENCHMARK_BROKER)
+    {
+        mcp320x_broker_stop(run->handle);
+    }
+
+    vSemaphoreDelete(done);
+
+    benchmark_summarize(run, result, elapsed_us, 0);
+}
+
+static void benchmark_client_task(void *arg)
+{
+    benchmark_client_t *client = (benchmark_client_t *)arg;
+    uint16_t value;
+
+    for (uint32_t i = 0; i < client->calls; i++)
+    {
+        const int64_t call_start_us = esp_timer_get_time();
+
+        const mcp320x_err_t call_result = client->operation == MCP320X_BENCHMARK_BROKER
+                                              ? mcp320x_broker_read(client->run->handle, client->channel, MCP320X_READ_MODE_SINGLE, &value)
+                                              : mcp320x_read(client->run->handle, client->channel, MCP320X_READ_MODE_SINGLE, &value);
+
+        client->latencies_us[i] = (uint32_t)(esp_timer_get_time() - call_start_us);
+
+        if (call_result != MCP320X_OK)
+        {
+            client->errors++;
+        }
+    }
+
+    xSemaphoreGive(client->done);
+
+    vTaskDelete(NULL);
+}
+
+static void benchmark_summarize(benchmark_run_t *run, mcp320x_benchmark_result_t *result, int64_t elapsed_us, uint64_t cycles)
+{
+    if (result->calls == 0)
+    {
+        return;
+    }
+
+    qsort(run->latencies_us, result->calls, sizeof(uint32_t), compare_latency);
+
+    result->latency_p50_us = run->latencies_us[(result->calls - 1) * 50 / 100];
+    result->latency_p99_us = run->latencies_us[(result->calls - 1) * 99 / 100];
+    result->latency_max_us = run->latencies_us[result->calls - 1];
+
+    if (elapsed_us > 0)
+    {
+        result->samples_per_sec = (uint32_t)((uint64_t)result->samples * 1000000 / (uint64_t)elapsed_us);
+    }
+
+    if (result->samples > 0)
+    {
+        result->cycles_per_sample = (uint32_t)(cycles / result->samples);
+    }
+}
+
+static int compare_latency(const void *a, const void *b)
+{
+    const uint32_t left = *(const uint32_t *)a;
+    const uint32_t right = *(const uint32_t *)b;
+
+    return (left > right) - (left < right);
+}
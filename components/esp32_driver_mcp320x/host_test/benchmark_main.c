@@ -0,0 +1,256 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "driver/spi_master.h"
+#include "driver/gpio.h"
+#include "sim/mcp320x_sim.h"
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+#include "mcp320x_benchmark.h"
+
+#define RESULT_CAPACITY (2 * MCP320X_BENCHMARK_CLOCK_COUNT_MAX * MCP320X_BENCHMARK_OPERATION_COUNT)
+#define DEFAULT_TOLERANCE_PERCENT 25
+
+typedef struct
+{
+    const char *csv_path;
+    const char *json_path;
+    const char *baseline_path;
+    uint32_t tolerance_percent;
+} benchmark_args_t;
+
+static bool parse_args(int argc, char **argv, benchmark_args_t *args);
+static bool write_results(const char *path, mcp320x_benchmark_format_t format, mcp320x_benchmark_result_t const *results, size_t count);
+static uint32_t check_baseline(const char *path, uint32_t tolerance_percent, mcp320x_benchmark_result_t const *results, size_t count);
+
+int main(int argc, char **argv)
+{
+    /* Host benchmark runner, against the simulated device.
+     *
+     * Usage: mcp320x_host_benchmark [--csv FILE] [--json FILE] [--baseline FILE] [--tolerance PERCENT]
+     *
+     * The results are always written to stdout as CSV. With a baseline, the run
+     * fails when any operation is slower than the baseline by more than the
+     * tolerance, or when any call fails.
+     */
+
+    benchmark_args_t args = {.tolerance_percent = DEFAULT_TOLERANCE_PERCENT};
+
+    if (!parse_args(argc, argv, &args))
+    {
+        fprintf(stderr, "usage: %s [--csv FILE] [--json FILE] [--baseline FILE] [--tolerance PERCENT]\n", argv[0]);
+        return 2;
+    }
+
+    spi_bus_config_t bus_cfg = {
+        .mosi_io_num = GPIO_NUM_23,
+        .miso_io_num = GPIO_NUM_19,
+        .sclk_io_num = GPIO_NUM_18,
+        .quadwp_io_num = GPIO_NUM_NC,
+        .quadhd_io_num = GPIO_NUM_NC,
+        .data4_io_num = GPIO_NUM_NC,
+        .data5_io_num = GPIO_NUM_NC,
+        .data6_io_num = GPIO_NUM_NC,
+        .data7_io_num = GPIO_NUM_NC,
+        .max_transfer_sz = 3, // 24 bits.
+        .flags = SPICOMMON_BUSFLAG_MASTER};
+
+    spi_bus_initialize(SPI3_HOST, &bus_cfg, 0);
+
+    // Same hardware setup as the target benchmark project.
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3204_MODEL, 5000);
+
+    mcp320x_sim_set_voltage(sim, MCP320X_CHANNEL_3, 2500);
+    mcp320x_sim_attach(sim, SPI3_HOST, GPIO_NUM_5);
+
+    const mcp320x_benchmark_config_t spi_config = {
+        .label = "spi",
+        .device = {
+            .host = SPI3_HOST,
+            .device_model = MCP3204_MODEL,
+            .reference_voltage = 5000,
+            .cs_io_num = GPIO_NUM_5},
+        .channel = MCP320X_CHANNEL_3};
+
+    // The mock transport answers instantly, so what is left is the cost of
+    // the driver itself: validation, encoding, decoding and conversions.
+    static mcp320x_transport_mock_t mock = {.codes = {[MCP320X_CHANNEL_3] = 2048}};
+    static const uint32_t mock_clocks_hz[] = {MCP320X_CLOCK_MAX_HZ};
+    const mcp320x_benchmark_config_t mock_config = {
+        .label = "mock",
+        .device = {
+            .device_model = MCP3204_MODEL,
+            .reference_voltage = 5000,
+            .transport = &mcp320x_transport_mock,
+            .transport_config = &mock},
+        .channel = MCP320X_CHANNEL_3,
+        .clocks_hz = mock_clocks_hz,
+        .clock_count = 1,
+        .iterations = 10000};
+
+    static mcp320x_benchmark_result_t results[RESULT_CAPACITY];
+    size_t count = 0;
+    size_t mock_count = 0;
+    uint32_t failures = 0;
+
+    if (mcp320x_benchmark_run(&spi_config, results, RESULT_CAPACITY, &count) != MCP320X_OK ||
+        mcp320x_benchmark_run(&mock_config, &results[count], RESULT_CAPACITY - count, &mock_count) != MCP320X_OK)
+    {
+        fprintf(stderr, "benchmark failed\n");
+        failures++;
+    }
+
+    count += mock_count;
+
+    mcp320x_benchmark_print(stdout, MCP320X_BENCHMARK_FORMAT_CSV, results, count);
+
+    if (!write_results(args.csv_path, MCP320X_BENCHMARK_FORMAT_CSV, results, count) ||
+        !write_results(args.json_path, MCP320X_BENCHMARK_FORMAT_JSON, results, count))
+    {
+        failures++;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (results[i].errors > 0)
+        {
+            fprintf(stderr, "%s %s at %lu Hz: %lu calls failed\n",
+                    results[i].label,
+                    mcp320x_benchmark_operation_name(results[i].operation),
+                    (unsigned long)results[i].clock_hz,
+                    (unsigned long)results[i].errors);
+            failures++;
+        }
+    }
+
+    if (args.baseline_path != NULL)
+    {
+        failures += check_baseline(args.baseline_path, args.tolerance_percent, results, count);
+    }
+
+    mcp320x_sim_detach(sim);
+    mcp320x_sim_delete(sim);
+    spi_bus_free(SPI3_HOST);
+
+    return failures == 0 ? 0 : 1;
+}
+
+static bool parse_args(int argc, char **argv, benchmark_args_t *args)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+
+        if (strcmp(argv[i], "--csv") == 0)
+        {
+            args->csv_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--json") == 0)
+        {
+            args->json_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--baseline") == 0)
+        {
+            args->baseline_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--tolerance") == 0)
+        {
+            args->tolerance_percent = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return args->tolerance_percent < 100;
+}
+
+static bool write_results(const char *path, mcp320x_benchmark_format_t format, mcp320x_benchmark_result_t const *results, size_t count)
+{
+    if (path == NULL)
+    {
+        return true;
+    }
+
+    FILE *file = fopen(path, "w");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "cannot write %s\n", path);
+        return false;
+    }
+
+    mcp320x_benchmark_print(file, format, results, count);
+    fclose(file);
+
+    return true;
+}
+
+static uint32_t check_baseline(const char *path, uint32_t tolerance_percent, mcp320x_benchmark_result_t const *results, size_t count)
+{
+    // The baseline has the same columns as the CSV output; only "label",
+    // "operation", "clock_hz" and "samples_per_sec" are used. Results missing
+    // from it, like the stream and mock ones that depend on the host, are not
+    // checked.
+    FILE *file = fopen(path, "r");
+    char line[256];
+    uint32_t regressions = 0;
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "cannot read %s\n", path);
+        return 1;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        char label[32];
+        char operation[32];
+        unsigned long clock_hz;
+        unsigned long baseline;
+
+        if (sscanf(line, "%31[^,],%31[^,],%lu,%*u,%*u,%*u,%*u,%lu", label, operation, &clock_hz, &baseline) != 4)
+        {
+            continue; // Header or empty line.
+        }
+
+        const uint64_t minimum = (uint64_t)baseline * (100 - tolerance_percent) / 100;
+        bool found = false;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (results[i].clock_hz != clock_hz ||
+                strcmp(results[i].label, label) != 0 ||
+                strcmp(mcp320x_benchmark_operation_name(results[i].operation), operation) != 0)
+            {
+                continue;
+            }
+
+            found = true;
+
+            if (results[i].samples_per_sec < minimum)
+            {
+                fprintf(stderr, "regression: %s %s at %lu Hz: %lu samples/s, baseline %lu samples/s\n",
+                        label,
+                        operation,
+                        clock_hz,
+                        (unsigned long)results[i].samples_per_sec,
+                        baseline);
+                regressions++;
+            }
+        }
+
+        if (!found)
+        {
+            fprintf(stderr, "regression: %s %s at %lu Hz not measured\n", label, operation, clock_hz);
+            regressions++;
+        }
+    }
+
+    fclose(file);
+
+    return regressions;
+}
@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "driver/spi_master.h"
+#include "driver/gpio.h"
+#include "sim/mcp320x_sim.h"
+
+static void print_banner(const char *text);
+
+int main(int argc, char **argv)
+{
+    /* This is just the host test runner.
+     * The real tests are on "components/#/test", the same ones run on the target.
+     */
+
+    spi_bus_config_t bus_cfg = {
+        .mosi_io_num = GPIO_NUM_23,
+        .miso_io_num = GPIO_NUM_19,
+        .sclk_io_num = GPIO_NUM_18,
+        .quadwp_io_num = GPIO_NUM_NC,
+        .quadhd_io_num = GPIO_NUM_NC,
+        .data4_io_num = GPIO_NUM_NC,
+        .data5_io_num = GPIO_NUM_NC,
+        .data6_io_num = GPIO_NUM_NC,
+        .data7_io_num = GPIO_NUM_NC,
+        .max_transfer_sz = 3, // 24 bits.
+        .flags = SPICOMMON_BUSFLAG_MASTER};
+
+    spi_bus_initialize(SPI3_HOST, &bus_cfg, 0);
+
+    // Same hardware setup as the target test project (see common_infra_test.h).
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3204_MODEL, 5000);
+
+    mcp320x_sim_set_voltage(sim, MCP320X_CHANNEL_3, 2500);
+    mcp320x_sim_attach(sim, SPI3_HOST, GPIO_NUM_5);
+
+    print_banner(argc > 1 ? argv[1] : "Running all tests");
+
+    UNITY_BEGIN();
+
+    if (argc > 1)
+    {
+        unity_run_tests_by_tag(argv[1], false);
+    }
+    else
+    {
+        unity_run_all_tests();
+    }
+
+    const int failures = UNITY_END();
+
+    mcp320x_sim_detach(sim);
+    mcp320x_sim_delete(sim);
+    spi_bus_free(SPI3_HOST);
+
+    return failures == 0 ? 0 : 1;
+}
+
+static void print_banner(const char *text)
+{
+    printf("\n#### %s #####\n\n", text);
+}
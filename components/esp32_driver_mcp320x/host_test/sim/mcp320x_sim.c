@@ -0,0 +1,446 @@
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_timer.h"
+#include "gpio_stub.h"
+#include "spi_sim.h"
+#include "mcp320x_sim.h"
+
+#define MCP320X_SIM_TCSH_NS 500         /** @brief Minimum CS disable time at 5V, from the datasheet. */
+#define MCP320X_SIM_DROOP_UV_PER_US 100 /** @brief Sample capacitor droop when the clock is too slow. */
+#define MCP320X_SIM_PI 3.14159265358979323846
+
+/**
+ * @typedef mcp320x_sim_state_t
+ * @brief Serial interface state.
+ */
+typedef enum
+{
+    MCP320X_SIM_WAIT_START,
+    MCP320X_SIM_COMMAND,
+    MCP320X_SIM_SAMPLE,
+    MCP320X_SIM_NULL_BIT,
+    MCP320X_SIM_DATA_MSB,
+    MCP320X_SIM_DATA_LSB,
+    MCP320X_SIM_DONE
+} mcp320x_sim_state_t;
+
+/**
+ * @typedef mcp320x_sim_serial_t
+ * @brief Serial interface of one transaction, from CS falling to CS rising.
+ */
+typedef struct
+{
+    bool selected;             /** @brief CS is asserted. */
+    mcp320x_sim_state_t state; /** @brief Current state. */
+    uint8_t command;           /** @brief MODE, D2, D1 and D0 bits received. */
+    int command_bits;          /** @brief Number of command bits received. */
+    int data_bit;              /** @brief Next data bit to output. */
+    uint16_t code;             /** @brief Converted code. */
+    bool converted;            /** @brief All 12 data bits were output. */
+    int64_t select_ns;         /** @brief Time of the CS falling edge. */
+    int64_t edge_ns;           /** @brief Time of the last clock rising edge, or of select. */
+} mcp320x_sim_serial_t;
+
+/**
+ * @typedef mcp320x_sim_gpio_t
+ * @brief Pins of a device attached to GPIOs.
+ */
+typedef struct
+{
+    gpio_num_t cs_io_num;   /** @brief Chip select, or GPIO_NUM_NC when not attached. */
+    gpio_num_t sclk_io_num; /** @brief Clock. */
+    gpio_num_t mosi_io_num; /** @brief Device input. */
+    gpio_num_t miso_io_num; /** @brief Device output. */
+} mcp320x_sim_gpio_t;
+
+/**
+ * @struct mcp320x_sim_t
+ * @brief Holds control data for a simulated device.
+ */
+struct mcp320x_sim_t
+{
+    mcp320x_model_t model;                                       /** @brief Device model. */
+    uint16_t reference_voltage;                                  /** @brief Reference voltage, in millivolts. */
+    mcp320x_sim_waveform_t waveforms[MCP320X_CHANNEL_COUNT_MAX]; /** @brief Voltage applied to each channel. */
+    mcp320x_sim_stats_t stats;                                   /** @brief Counters. */
+    uint32_t noise_seed;                                         /** @brief Noise generator state. */
+    spi_host_device_t host;                                      /** @brief Attached SPI host. */
+    gpio_num_t cs_io_num;                                        /** @brief Attached chip select, or GPIO_NUM_NC. */
+    mcp320x_sim_gpio_t gpio;                                     /** @brief Pins when attached to GPIOs. */
+    mcp320x_sim_serial_t serial;                                 /** @brief Serial interface of the current transaction. */
+    pthread_mutex_t lock;                                        /** @brief Protects waveforms, counters and the serial interface. */
+};
+
+static int32_t mcp320x_sim_channel_voltage(mcp320x_sim_t *sim, int channel, int64_t time_ns);
+static void mcp320x_sim_select_locked(mcp320x_sim_t *sim, int64_t time_ns);
+static int mcp320x_sim_clock_locked(mcp320x_sim_t *sim, int in, int64_t time_ns);
+static void mcp320x_sim_deselect_locked(mcp320x_sim_t *sim, int64_t time_ns);
+static void mcp320x_sim_gpio_edge(void *context, gpio_num_t io_num, uint32_t level);
+static void mcp320x_sim_spi_transfer(void *context,
+                                     uint8_t const *tx,
+                                     uint8_t *rx,
+                                     size_t bits,
+                                     uint32_t clock_hz,
+                                     int64_t start_ns);
+
+mcp320x_sim_t *mcp320x_sim_create(mcp320x_model_t model, uint16_t reference_voltage)
+{
+    mcp320x_sim_t *sim = (mcp320x_sim_t *)calloc(1, sizeof(mcp320x_sim_t));
+
+    if (sim == NULL)
+    {
+        return NULL;
+    }
+
+    sim->model = model;
+    sim->reference_voltage = reference_voltage;
+    sim->noise_seed = 0x9E3779B9;
+    sim->cs_io_num = GPIO_NUM_NC;
+    sim->gpio.cs_io_num = GPIO_NUM_NC;
+    sim->serial.state = MCP320X_SIM_DONE;
+    pthread_mutex_init(&sim->lock, NULL);
+
+    return sim;
+}
+
+void mcp320x_sim_delete(mcp320x_sim_t *sim)
+{
+    if (sim == NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_destroy(&sim->lock);
+    free(sim);
+}
+
+void mcp320x_sim_set_waveform(mcp320x_sim_t *sim, mcp320x_channel_t channel, mcp320x_sim_waveform_t const *waveform)
+{
+    pthread_mutex_lock(&sim->lock);
+    sim->waveforms[channel] = *waveform;
+    pthread_mutex_unlock(&sim->lock);
+}
+
+void mcp320x_sim_set_voltage(mcp320x_sim_t *sim, mcp320x_channel_t channel, int32_t millivolts)
+{
+    mcp320x_sim_waveform_t waveform = {
+        .type = MCP320X_SIM_WAVEFORM_CONSTANT,
+        .offset_uv = millivolts * 1000};
+
+    mcp320x_sim_set_waveform(sim, channel, &waveform);
+}
+
+uint16_t mcp320x_sim_voltage_to_code(mcp320x_sim_t const *sim, int32_t microvolts)
+{
+    // Transfer function of the datasheet: code = 4096 * Vin / Vref, truncated
+    // and saturated on both ends.
+    if (microvolts <= 0)
+    {
+        return 0;
+    }
+
+    const int64_t code = ((int64_t)microvolts * MCP320X_RESOLUTION) / ((int64_t)sim->reference_voltage * 1000);
+
+    return code >= MCP320X_RESOLUTION ? MCP320X_RESOLUTION - 1 : (uint16_t)code;
+}
+
+void mcp320x_sim_get_stats(mcp320x_sim_t *sim, mcp320x_sim_stats_t *stats)
+{
+    pthread_mutex_lock(&sim->lock);
+    *stats = sim->stats;
+    pthread_mutex_unlock(&sim->lock);
+}
+
+void mcp320x_sim_transfer(mcp320x_sim_t *sim,
+                          uint8_t const *tx,
+                          uint8_t *rx,
+                          size_t bits,
+                          uint32_t clock_hz,
+                          int64_t start_ns)
+{
+    const double clock_period_ns = 1e9 / clock_hz;
+
+    pthread_mutex_lock(&sim->lock);
+
+    mcp320x_sim_select_locked(sim, start_ns);
+
+    for (size_t i = 0; i < bits; i++)
+    {
+        const int in = (tx[i / 8] >> (7 - (i % 8))) & 1;
+        const int out = mcp320x_sim_clock_locked(sim, in, start_ns + (int64_t)((i + 1) * clock_period_ns));
+
+        if (out)
+        {
+            rx[i / 8] |= (uint8_t)(0x80 >> (i % 8));
+        }
+        else
+        {
+            rx[i / 8] &= (uint8_t)~(0x80 >> (i % 8));
+        }
+    }
+
+    mcp320x_sim_deselect_locked(sim, start_ns + (int64_t)(bits * clock_period_ns));
+
+    pthread_mutex_unlock(&sim->lock);
+}
+
+void mcp320x_sim_select(mcp320x_sim_t *sim, int64_t time_ns)
+{
+    pthread_mutex_lock(&sim->lock);
+    mcp320x_sim_select_locked(sim, time_ns);
+    pthread_mutex_unlock(&sim->lock);
+}
+
+int mcp320x_sim_clock(mcp320x_sim_t *sim, int mosi, int64_t time_ns)
+{
+    pthread_mutex_lock(&sim->lock);
+    const int miso = mcp320x_sim_clock_locked(sim, mosi, time_ns);
+    pthread_mutex_unlock(&sim->lock);
+
+    return miso;
+}
+
+void mcp320x_sim_deselect(mcp320x_sim_t *sim, int64_t time_ns)
+{
+    pthread_mutex_lock(&sim->lock);
+    mcp320x_sim_deselect_locked(sim, time_ns);
+    pthread_mutex_unlock(&sim->lock);
+}
+
+void mcp320x_sim_attach(mcp320x_sim_t *sim, spi_host_device_t host, gpio_num_t cs_io_num)
+{
+    sim->host = host;
+    sim->cs_io_num = cs_io_num;
+
+    spi_sim_attach(host, cs_io_num, mcp320x_sim_spi_transfer, MCP320X_SIM_TCSH_NS, sim);
+}
+
+void mcp320x_sim_attach_gpio(mcp320x_sim_t *sim,
+                             gpio_num_t cs_io_num,
+                             gpio_num_t sclk_io_num,
+                             gpio_num_t mosi_io_num,
+                             gpio_num_t miso_io_num)
+{
+    sim->gpio.cs_io_num = cs_io_num;
+    sim->gpio.sclk_io_num = sclk_io_num;
+    sim->gpio.mosi_io_num = mosi_io_num;
+    sim->gpio.miso_io_num = miso_io_num;
+
+    gpio_stub_set_hook(cs_io_num, mcp320x_sim_gpio_edge, sim);
+    gpio_stub_set_hook(sclk_io_num, mcp320x_sim_gpio_edge, sim);
+    gpio_stub_drive(miso_io_num, 1);
+}
+
+void mcp320x_sim_detach(mcp320x_sim_t *sim)
+{
+    if (sim->cs_io_num != GPIO_NUM_NC)
+    {
+        spi_sim_detach(sim->host, sim->cs_io_num);
+        sim->cs_io_num = GPIO_NUM_NC;
+    }
+
+    if (sim->gpio.cs_io_num != GPIO_NUM_NC)
+    {
+        gpio_stub_set_hook(sim->gpio.cs_io_num, NULL, NULL);
+        gpio_stub_set_hook(sim->gpio.sclk_io_num, NULL, NULL);
+        sim->gpio.cs_io_num = GPIO_NUM_NC;
+    }
+}
+
+static int32_t mcp320x_sim_channel_voltage(mcp320x_sim_t *sim, int channel, int64_t time_ns)
+{
+    mcp320x_sim_waveform_t const *waveform = &sim->waveforms[channel];
+    const double t = (double)time_ns / 1e9;
+    const double phase = t * waveform->frequency_hz - floor(t * waveform->frequency_hz);
+    int32_t microvolts;
+
+    switch (waveform->type)
+    {
+    case MCP320X_SIM_WAVEFORM_SINE:
+        microvolts = waveform->offset_uv + (int32_t)(waveform->amplitude_uv * sin(2 * MCP320X_SIM_PI * phase));
+        break;
+    case MCP320X_SIM_WAVEFORM_SQUARE:
+        microvolts = waveform->offset_uv + (phase < 0.5 ? waveform->amplitude_uv : -waveform->amplitude_uv);
+        break;
+    case MCP320X_SIM_WAVEFORM_RAMP:
+        microvolts = waveform->offset_uv + (int32_t)(waveform->amplitude_uv * (2 * phase - 1));
+        break;
+    case MCP320X_SIM_WAVEFORM_CUSTOM:
+        microvolts = waveform->callback(time_ns, waveform->context);
+        break;
+    case MCP320X_SIM_WAVEFORM_CONSTANT:
+    default:
+        microvolts = waveform->offset_uv;
+        break;
+    }
+
+    if (waveform->noise_uv > 0)
+    {
+        sim->noise_seed = sim->noise_seed * 1664525u + 1013904223u;
+        microvolts += (int32_t)((sim->noise_seed >> 8) % (uint32_t)(2 * waveform->noise_uv + 1)) - waveform->noise_uv;
+    }
+
+    return microvolts;
+}
+
+static void mcp320x_sim_spi_transfer(void *context,
+                                     uint8_t const *tx,
+                                     uint8_t *rx,
+                                     size_t bits,
+                                     uint32_t clock_hz,
+                                     int64_t start_ns)
+{
+    mcp320x_sim_transfer((mcp320x_sim_t *)context, tx, rx, bits, clock_hz, start_ns);
+}
+
+static void mcp320x_sim_gpio_edge(void *context, gpio_num_t io_num, uint32_t level)
+{
+    // Mode 0: CS low selects, the device reads MOSI on the rising edge of
+    // SCLK and its output is valid before the next one.
+    mcp320x_sim_t *sim = (mcp320x_sim_t *)context;
+    const int64_t now_ns = esp_timer_stub_get_time_ns();
+
+    if (io_num == sim->gpio.cs_io_num)
+    {
+        if (level == 0)
+        {
+            mcp320x_sim_select(sim, now_ns);
+        }
+        else
+        {
+            mcp320x_sim_deselect(sim, now_ns);
+            gpio_stub_drive(sim->gpio.miso_io_num, 1);
+        }
+    }
+    else if (level == 1 && gpio_stub_get_drive(sim->gpio.cs_io_num) == 0)
+    {
+        gpio_stub_drive(sim->gpio.miso_io_num, (uint32_t)mcp320x_sim_clock(sim, gpio_get_level(sim->gpio.mosi_io_num), now_ns));
+    }
+}
+
+static void mcp320x_sim_select_locked(mcp320x_sim_t *sim, int64_t time_ns)
+{
+    sim->serial.selected = true;
+    sim->serial.state = MCP320X_SIM_WAIT_START;
+    sim->serial.command = 0;
+    sim->serial.command_bits = 0;
+    sim->serial.data_bit = 0;
+    sim->serial.code = 0;
+    sim->serial.converted = false;
+    sim->serial.select_ns = time_ns;
+    sim->serial.edge_ns = time_ns;
+    sim->stats.frames++;
+}
+
+static int mcp320x_sim_clock_locked(mcp320x_sim_t *sim, int in, int64_t time_ns)
+{
+    // Bit level model of "5.0 Serial Communication" of the datasheet:
+    //
+    //   * Leading zeros are ignored until the start bit.
+    //   * Then MODE, D2, D1 and D0 are clocked in.
+    //   * The input is sampled until the falling edge of the next clock.
+    //   * A null bit is output, then B11..B0 (MSB first) and then
+    //     B1..B11 (LSB first); zeros after that.
+    //
+    // While the device is not driving the line it is high impedance, which is
+    // read as 1 to make sure the driver masks those bits.
+
+    mcp320x_sim_serial_t *serial = &sim->serial;
+    const int64_t clock_period_ns = time_ns - serial->edge_ns;
+    int out = 1;
+
+    serial->edge_ns = time_ns;
+
+    switch (serial->state)
+    {
+    case MCP320X_SIM_WAIT_START:
+        serial->state = in ? MCP320X_SIM_COMMAND : MCP320X_SIM_WAIT_START;
+        break;
+    case MCP320X_SIM_COMMAND:
+        serial->command = (uint8_t)((serial->command << 1) | in);
+        serial->state = ++serial->command_bits == 4 ? MCP320X_SIM_SAMPLE : MCP320X_SIM_COMMAND;
+        break;
+    case MCP320X_SIM_SAMPLE:
+    {
+        // Sampling ends on this clock: take the input voltage now.
+        const int mode = serial->command >> 3;
+        const int selection = serial->command & 0b111;
+        int32_t microvolts;
+
+        if (selection >= (int)sim->model)
+        {
+            microvolts = 0;
+        }
+        else if (mode == MCP320X_READ_MODE_SINGLE)
+        {
+            microvolts = mcp320x_sim_channel_voltage(sim, selection, time_ns);
+        }
+        else
+        {
+            // Differential pairs: IN+ is the selected channel and IN- its neighbour.
+            microvolts = mcp320x_sim_channel_voltage(sim, selection, time_ns) -
+                         mcp320x_sim_channel_voltage(sim, selection ^ 1, time_ns);
+        }
+
+        // Below the minimum clock the sample capacitor droops during the
+        // 12 conversion clocks.
+        if (clock_period_ns > 1000000000LL / MCP320X_CLOCK_MIN_HZ)
+        {
+            microvolts -= (int32_t)(MCP320X_SIM_DROOP_UV_PER_US * 12 * clock_period_ns / 1000);
+            sim->stats.slow_clock++;
+        }
+
+        serial->code = mcp320x_sim_voltage_to_code(sim, microvolts);
+        serial->state = MCP320X_SIM_NULL_BIT;
+        break;
+    }
+    case MCP320X_SIM_NULL_BIT:
+        out = 0;
+        serial->state = MCP320X_SIM_DATA_MSB;
+        break;
+    case MCP320X_SIM_DATA_MSB:
+        out = (serial->code >> (11 - serial->data_bit)) & 1;
+
+        if (++serial->data_bit == 12)
+        {
+            serial->converted = true;
+            serial->data_bit = 1;
+            serial->state = MCP320X_SIM_DATA_LSB;
+        }
+        break;
+    case MCP320X_SIM_DATA_LSB:
+        out = (serial->code >> serial->data_bit) & 1;
+        serial->state = ++serial->data_bit == 12 ? MCP320X_SIM_DONE : MCP320X_SIM_DATA_LSB;
+        break;
+    case MCP320X_SIM_DONE:
+    default:
+        out = 0;
+        break;
+    }
+
+    return out;
+}
+
+static void mcp320x_sim_deselect_locked(mcp320x_sim_t *sim, int64_t time_ns)
+{
+    if (!sim->serial.selected)
+    {
+        return;
+    }
+
+    sim->serial.selected = false;
+    sim->stats.bus_time_ns += (uint64_t)(time_ns - sim->serial.select_ns);
+
+    if (sim->serial.converted)
+    {
+        sim->stats.conversions++;
+    }
+    else
+    {
+        sim->stats.incomplete++;
+    }
+
+    sim->serial.state = MCP320X_SIM_DONE;
+}
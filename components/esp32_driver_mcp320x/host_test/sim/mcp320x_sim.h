@@ -0,0 +1,189 @@
+#ifndef __ESP32_DRIVER_MCP320X_HOST_TEST_MCP320X_SIM_H__
+#define __ESP32_DRIVER_MCP320X_HOST_TEST_MCP320X_SIM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef mcp320x_sim_t
+     * @brief Simulated MCP3204/MCP3208.
+     */
+    typedef struct mcp320x_sim_t mcp320x_sim_t;
+
+    /**
+     * @typedef mcp320x_sim_waveform_type_t
+     * @brief Shape of the voltage applied to a simulated channel.
+     */
+    typedef enum
+    {
+        MCP320X_SIM_WAVEFORM_CONSTANT = 0, /** @brief offset. */
+        MCP320X_SIM_WAVEFORM_SINE = 1,     /** @brief offset + amplitude * sin(2 * pi * frequency * t). */
+        MCP320X_SIM_WAVEFORM_SQUARE = 2,   /** @brief offset +/- amplitude, at frequency. */
+        MCP320X_SIM_WAVEFORM_RAMP = 3,     /** @brief offset - amplitude to offset + amplitude, at frequency. */
+        MCP320X_SIM_WAVEFORM_CUSTOM = 4    /** @brief Value returned by a callback. */
+    } mcp320x_sim_waveform_type_t;
+
+    /**
+     * @typedef mcp320x_sim_waveform_callback_t
+     * @brief Custom waveform.
+     * @param[in] time_ns Virtual time of the sample, in nanoseconds.
+     * @param[in] context User context.
+     * @return Voltage, in microvolts.
+     */
+    typedef int32_t (*mcp320x_sim_waveform_callback_t)(int64_t time_ns, void *context);
+
+    /**
+     * @typedef mcp320x_sim_waveform_t
+     * @brief Voltage applied to a simulated channel.
+     */
+    typedef struct
+    {
+        mcp320x_sim_waveform_type_t type;         /** @brief Shape. */
+        int32_t offset_uv;                        /** @brief Offset, in microvolts. */
+        int32_t amplitude_uv;                     /** @brief Amplitude, in microvolts. */
+        uint32_t frequency_hz;                    /** @brief Frequency, in Hz. */
+        int32_t noise_uv;                         /** @brief Peak uniform noise added to every sample, in microvolts. */
+        mcp320x_sim_waveform_callback_t callback; /** @brief Used by @ref MCP320X_SIM_WAVEFORM_CUSTOM. */
+        void *context;                            /** @brief Passed to \p callback. */
+    } mcp320x_sim_waveform_t;
+
+    /**
+     * @typedef mcp320x_sim_stats_t
+     * @brief Simulated device counters.
+     */
+    typedef struct
+    {
+        uint32_t frames;      /** @brief CS assertions (transactions) seen. */
+        uint32_t conversions; /** @brief Conversions completed (all 12 data bits clocked). */
+        uint32_t incomplete;  /** @brief Transactions that ended before the last data bit. */
+        uint32_t slow_clock;  /** @brief Conversions below the minimum clock, when the sample capacitor droops. */
+        uint64_t bus_time_ns; /** @brief Virtual time spent with CS asserted. */
+    } mcp320x_sim_stats_t;
+
+    /**
+     * @brief Create a simulated device. All channels start at 0V.
+     * @param[in] model Device model, defines the number of channels.
+     * @param[in] reference_voltage Reference voltage, in millivolts.
+     * @return Valid pointer, otherwise NULL.
+     */
+    mcp320x_sim_t *mcp320x_sim_create(mcp320x_model_t model, uint16_t reference_voltage);
+
+    /**
+     * @brief Free a simulated device. Must be detached from the SPI bus first.
+     * @param[in] sim Simulated device.
+     */
+    void mcp320x_sim_delete(mcp320x_sim_t *sim);
+
+    /**
+     * @brief Set the voltage applied to a channel.
+     * @param[in] sim Simulated device.
+     * @param[in] channel Channel.
+     * @param[in] waveform Waveform.
+     */
+    void mcp320x_sim_set_waveform(mcp320x_sim_t *sim, mcp320x_channel_t channel, mcp320x_sim_waveform_t const *waveform);
+
+    /**
+     * @brief Apply a constant voltage to a channel.
+     * @param[in] sim Simulated device.
+     * @param[in] channel Channel.
+     * @param[in] millivolts Voltage, in millivolts.
+     */
+    void mcp320x_sim_set_voltage(mcp320x_sim_t *sim, mcp320x_channel_t channel, int32_t millivolts);
+
+    /**
+     * @brief Get the digital code the device would output for a voltage.
+     * @param[in] sim Simulated device.
+     * @param[in] microvolts Voltage, in microvolts.
+     * @return Digital code from 0 to 4095.
+     */
+    uint16_t mcp320x_sim_voltage_to_code(mcp320x_sim_t const *sim, int32_t microvolts);
+
+    /**
+     * @brief Get the device counters.
+     * @param[in] sim Simulated device.
+     * @param[out] stats Pointer to where the counters will be stored.
+     */
+    void mcp320x_sim_get_stats(mcp320x_sim_t *sim, mcp320x_sim_stats_t *stats);
+
+    /**
+     * @brief Run one CS assertion: clock \p bits bits in and out, MSB first.
+     * @details The device ignores leading zeros until the start bit, like the real one, so both
+     * the 19 clock frames and the 24 clock frames of 8-bit MCUs are understood.
+     * @param[in] sim Simulated device.
+     * @param[in] tx Bits sent by the master.
+     * @param[out] rx Bits sent by the device; bits not clocked are left untouched.
+     * @param[in] bits Number of clocks.
+     * @param[in] clock_hz Clock frequency, in Hz.
+     * @param[in] start_ns Virtual time of the CS falling edge, in nanoseconds.
+     */
+    void mcp320x_sim_transfer(mcp320x_sim_t *sim,
+                              uint8_t const *tx,
+                              uint8_t *rx,
+                              size_t bits,
+                              uint32_t clock_hz,
+                              int64_t start_ns);
+
+    /**
+     * @brief Start a transaction clock by clock: CS falling edge.
+     * @param[in] sim Simulated device.
+     * @param[in] time_ns Virtual time of the edge, in nanoseconds.
+     */
+    void mcp320x_sim_select(mcp320x_sim_t *sim, int64_t time_ns);
+
+    /**
+     * @brief Clock one bit: SCLK rising edge.
+     * @details The clock period, which defines the sample capacitor droop, is the time since the
+     * previous edge.
+     * @param[in] sim Simulated device.
+     * @param[in] mosi Bit sent by the master.
+     * @param[in] time_ns Virtual time of the edge, in nanoseconds.
+     * @return Bit sent by the device on this clock.
+     */
+    int mcp320x_sim_clock(mcp320x_sim_t *sim, int mosi, int64_t time_ns);
+
+    /**
+     * @brief End a transaction clock by clock: CS rising edge.
+     * @param[in] sim Simulated device.
+     * @param[in] time_ns Virtual time of the edge, in nanoseconds.
+     */
+    void mcp320x_sim_deselect(mcp320x_sim_t *sim, int64_t time_ns);
+
+    /**
+     * @brief Attach a simulated device to a chip select of the simulated SPI bus.
+     * @param[in] sim Simulated device.
+     * @param[in] host SPI host.
+     * @param[in] cs_io_num Chip select GPIO.
+     */
+    void mcp320x_sim_attach(mcp320x_sim_t *sim, spi_host_device_t host, gpio_num_t cs_io_num);
+
+    /**
+     * @brief Attach a simulated device to GPIOs, for bit-banged transports.
+     * @note Only one simulated device can be attached to the same pins.
+     * @param[in] sim Simulated device.
+     * @param[in] cs_io_num Chip select GPIO.
+     * @param[in] sclk_io_num Clock GPIO.
+     * @param[in] mosi_io_num Device input GPIO.
+     * @param[in] miso_io_num Device output GPIO.
+     */
+    void mcp320x_sim_attach_gpio(mcp320x_sim_t *sim,
+                                 gpio_num_t cs_io_num,
+                                 gpio_num_t sclk_io_num,
+                                 gpio_num_t mosi_io_num,
+                                 gpio_num_t miso_io_num);
+
+    /**
+     * @brief Detach a simulated device from the simulated SPI bus and GPIOs.
+     * @param[in] sim Simulated device.
+     */
+    void mcp320x_sim_detach(mcp320x_sim_t *sim);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
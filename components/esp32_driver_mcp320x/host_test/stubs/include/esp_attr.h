@@ -0,0 +1,9 @@
+#ifndef __HOST_STUB_ESP_ATTR_H__
+#define __HOST_STUB_ESP_ATTR_H__
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define NOINLINE_ATTR __attribute__((noinline))
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef __HOST_STUB_ESP_CPU_H__
+#define __HOST_STUB_ESP_CPU_H__
+
+#include <stdint.h>
+#include "esp_timer.h"
+
+#define HOST_STUB_CPU_FREQ_MHZ 240 /** @brief Clock of the modelled CPU. */
+
+typedef uint32_t esp_cpu_cycle_count_t;
+
+// Cycles of a 240MHz CPU, derived from the esp_timer clock.
+static inline esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void)
+{
+    return (esp_cpu_cycle_count_t)(esp_timer_stub_get_time_ns() * HOST_STUB_CPU_FREQ_MHZ / 1000);
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef __HOST_STUB_ESP_LOG_H__
+#define __HOST_STUB_ESP_LOG_H__
+
+#include <stdio.h>
+#include "esp_err.h"
+
+typedef enum
+{
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+/** @brief Maximum level printed; errors only, like the test project sdkconfig. */
+#define HOST_STUB_LOG_LEVEL ESP_LOG_ERROR
+
+#define HOST_STUB_LOG(level, letter, tag, format, ...)                             \
+    do                                                                             \
+    {                                                                              \
+        if ((level) <= HOST_STUB_LOG_LEVEL)                                        \
+        {                                                                          \
+            fprintf(stderr, letter " (%s) " format "\n", tag, ##__VA_ARGS__); \
+        }                                                                          \
+    } while (0)
+
+#define ESP_LOGE(tag, format, ...) HOST_STUB_LOG(ESP_LOG_ERROR, "E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) HOST_STUB_LOG(ESP_LOG_WARN, "W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) HOST_STUB_LOG(ESP_LOG_INFO, "I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) HOST_STUB_LOG(ESP_LOG_DEBUG, "D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) HOST_STUB_LOG(ESP_LOG_VERBOSE, "V", tag, format, ##__VA_ARGS__)
+
+#define ESP_LOG_BUFFER_CHAR_LEVEL(tag, buffer, length, level) ((void)(tag), (void)(buffer), (void)(length), (void)(level))
+#define ESP_LOG_BUFFER_HEXDUMP(tag, buffer, length, level) ((void)(tag), (void)(buffer), (void)(length), (void)(level))
+
+#endif
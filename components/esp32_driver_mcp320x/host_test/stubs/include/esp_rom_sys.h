@@ -0,0 +1,21 @@
+#ifndef __HOST_STUB_ESP_ROM_SYS_H__
+#define __HOST_STUB_ESP_ROM_SYS_H__
+
+#include <stdint.h>
+#include "esp_cpu.h"
+
+static inline uint32_t esp_rom_get_cpu_ticks_per_us(void)
+{
+    return HOST_STUB_CPU_FREQ_MHZ;
+}
+
+static inline void esp_rom_delay_us(uint32_t us)
+{
+    const esp_cpu_cycle_count_t start = esp_cpu_get_cycle_count();
+
+    while (esp_cpu_get_cycle_count() - start < us * HOST_STUB_CPU_FREQ_MHZ)
+    {
+    }
+}
+
+#endif
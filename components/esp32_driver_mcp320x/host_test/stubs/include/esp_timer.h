@@ -0,0 +1,58 @@
+#ifndef __HOST_STUB_ESP_TIMER_H__
+#define __HOST_STUB_ESP_TIMER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef struct esp_timer *esp_timer_handle_t;
+    typedef void (*esp_timer_cb_t)(void *arg);
+
+    typedef enum
+    {
+        ESP_TIMER_TASK,
+        ESP_TIMER_ISR
+    } esp_timer_dispatch_t;
+
+    typedef struct
+    {
+        esp_timer_cb_t callback;
+        void *arg;
+        esp_timer_dispatch_t dispatch_method;
+        const char *name;
+        bool skip_unhandled_events;
+    } esp_timer_create_args_t;
+
+    /**
+     * @brief Microseconds since start: real monotonic time plus the virtual
+     * time consumed by simulated peripherals (see @ref esp_timer_stub_advance_ns).
+     */
+    int64_t esp_timer_get_time(void);
+
+    esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle);
+    esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us);
+    esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period);
+    esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+    esp_err_t esp_timer_delete(esp_timer_handle_t timer);
+
+    /**
+     * @brief Move the clock forward, without sleeping, by the time a
+     * simulated peripheral would have kept the CPU waiting.
+     * @param[in] ns Nanoseconds.
+     */
+    void esp_timer_stub_advance_ns(int64_t ns);
+
+    /**
+     * @brief Same clock as @ref esp_timer_get_time, in nanoseconds.
+     */
+    int64_t esp_timer_stub_get_time_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
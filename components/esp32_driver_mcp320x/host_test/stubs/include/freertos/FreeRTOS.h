@@ -0,0 +1,38 @@
+#ifndef __HOST_STUB_FREERTOS_FREERTOS_H__
+#define __HOST_STUB_FREERTOS_FREERTOS_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define configTICK_RATE_HZ 1000
+#define configMAX_PRIORITIES 25
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2
+
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFF)
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((TickType_t)(ms) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000))
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdFAIL (pdFALSE)
+#define pdPASS (pdTRUE)
+
+#define tskNO_AFFINITY ((BaseType_t)0x7FFFFFFF)
+
+// No interrupts on the host: critical sections only check their arguments.
+typedef struct
+{
+    uint32_t owner;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {.owner = 0}
+#define portMUX_INITIALIZE(mux) ((mux)->owner = 0)
+#define portENTER_CRITICAL(mux) ((void)(mux)->owner)
+#define portEXIT_CRITICAL(mux) ((void)(mux)->owner)
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef __HOST_STUB_FREERTOS_EVENT_GROUPS_H__
+#define __HOST_STUB_FREERTOS_EVENT_GROUPS_H__
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef TickType_t EventBits_t;
+    typedef struct host_stub_event_group *EventGroupHandle_t;
+
+    EventGroupHandle_t xEventGroupCreate(void);
+    EventBits_t xEventGroupSetBits(EventGroupHandle_t event_group, const EventBits_t bits_to_set);
+    EventBits_t xEventGroupClearBits(EventGroupHandle_t event_group, const EventBits_t bits_to_clear);
+    EventBits_t xEventGroupGetBits(EventGroupHandle_t event_group);
+    EventBits_t xEventGroupWaitBits(EventGroupHandle_t event_group,
+                                    const EventBits_t bits_to_wait_for,
+                                    const BaseType_t clear_on_exit,
+                                    const BaseType_t wait_for_all_bits,
+                                    TickType_t ticks_to_wait);
+    void vEventGroupDelete(EventGroupHandle_t event_group);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,28 @@
+#ifndef __HOST_STUB_FREERTOS_SEMPHR_H__
+#define __HOST_STUB_FREERTOS_SEMPHR_H__
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef struct host_stub_semaphore *SemaphoreHandle_t;
+
+    SemaphoreHandle_t xSemaphoreCreateBinary(void);
+    SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial_count);
+    SemaphoreHandle_t xSemaphoreCreateMutex(void);
+    SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void);
+    BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait);
+    BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+    BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t mutex, TickType_t ticks_to_wait);
+    BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t mutex);
+    BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t *higher_priority_task_woken);
+    UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaphore);
+    void vSemaphoreDelete(SemaphoreHandle_t semaphore);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
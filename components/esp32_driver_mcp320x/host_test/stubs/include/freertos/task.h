@@ -0,0 +1,49 @@
+#ifndef __HOST_STUB_FREERTOS_TASK_H__
+#define __HOST_STUB_FREERTOS_TASK_H__
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Tasks are POSIX threads. Priorities and core affinity are stored but
+    // not enforced; the host scheduler decides.
+
+    typedef struct tskTaskControlBlock *TaskHandle_t;
+    typedef void (*TaskFunction_t)(void *);
+
+    BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task_code,
+                                       const char *name,
+                                       uint32_t stack_depth,
+                                       void *parameters,
+                                       UBaseType_t priority,
+                                       TaskHandle_t *created_task,
+                                       BaseType_t core_id);
+    BaseType_t xTaskCreate(TaskFunction_t task_code,
+                           const char *name,
+                           uint32_t stack_depth,
+                           void *parameters,
+                           UBaseType_t priority,
+                           TaskHandle_t *created_task);
+    void vTaskDelete(TaskHandle_t task);
+    void vTaskDelay(TickType_t ticks);
+    TickType_t xTaskGetTickCount(void);
+    TaskHandle_t xTaskGetCurrentTaskHandle(void);
+    UBaseType_t uxTaskPriorityGet(TaskHandle_t task);
+    BaseType_t xTaskGetCoreID(TaskHandle_t task);
+    uint32_t ulTaskNotifyTake(BaseType_t clear_count_on_exit, TickType_t ticks_to_wait);
+    uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear_count_on_exit, TickType_t ticks_to_wait);
+    BaseType_t xTaskNotifyGive(TaskHandle_t task);
+    BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index);
+    void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken);
+    void vTaskYield(void);
+
+#define taskYIELD() vTaskYield()
+#define portYIELD_FROM_ISR(...) ((void)0)
+
+#ifdef __cplusplus
+}
+#endif
+#endif
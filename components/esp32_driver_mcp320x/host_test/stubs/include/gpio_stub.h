@@ -0,0 +1,46 @@
+#ifndef __HOST_STUB_GPIO_STUB_H__
+#define __HOST_STUB_GPIO_STUB_H__
+
+#include <stdint.h>
+#include "driver/gpio.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef gpio_stub_hook_t
+     * @brief Called when the firmware changes the level of an output pin.
+     * @param[in] context Hook context.
+     * @param[in] io_num Pin.
+     * @param[in] level New level.
+     */
+    typedef void (*gpio_stub_hook_t)(void *context, gpio_num_t io_num, uint32_t level);
+
+    /**
+     * @brief Set the hook of a pin; NULL removes it.
+     * @param[in] io_num Pin.
+     * @param[in] hook Hook.
+     * @param[in] context Hook context.
+     */
+    void gpio_stub_set_hook(gpio_num_t io_num, gpio_stub_hook_t hook, void *context);
+
+    /**
+     * @brief Drive a pin from outside the firmware, as a simulated peripheral. Hooks are not called.
+     * @param[in] io_num Pin.
+     * @param[in] level Level.
+     */
+    void gpio_stub_drive(gpio_num_t io_num, uint32_t level);
+
+    /**
+     * @brief Get the level of a pin, whoever drives it.
+     * @param[in] io_num Pin.
+     * @return Level.
+     */
+    uint32_t gpio_stub_get_drive(gpio_num_t io_num);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
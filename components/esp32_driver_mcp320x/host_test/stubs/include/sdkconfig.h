@@ -0,0 +1,13 @@
+#ifndef __HOST_STUB_SDKCONFIG_H__
+#define __HOST_STUB_SDKCONFIG_H__
+
+// Defaults of the component Kconfig. HOST_STUB_NO_CHECKS builds the
+// component as with CONFIG_MCP320X_ENABLE_CHECKS and
+// CONFIG_MCP320X_ENABLE_STATS disabled.
+
+#ifndef HOST_STUB_NO_CHECKS
+#define CONFIG_MCP320X_ENABLE_CHECKS 1
+#define CONFIG_MCP320X_ENABLE_STATS 1
+#endif
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef __HOST_STUB_SOC_SOC_CAPS_H__
+#define __HOST_STUB_SOC_SOC_CAPS_H__
+
+// Capabilities of the ESP32: no dedicated GPIO.
+#define SOC_CPU_CORES_NUM 2
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef __HOST_STUB_SPI_SIM_H__
+#define __HOST_STUB_SPI_SIM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "driver/spi_master.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef spi_sim_transfer_t
+     * @brief Simulated slave: called once per CS assertion.
+     * @param[in] context Slave context.
+     * @param[in] tx Bits sent by the master, MSB first.
+     * @param[out] rx Bits sent by the slave, MSB first.
+     * @param[in] bits Number of clocks.
+     * @param[in] clock_hz Clock frequency, in Hz.
+     * @param[in] start_ns Virtual time of the CS falling edge, in nanoseconds.
+     */
+    typedef void (*spi_sim_transfer_t)(void *context,
+                                       uint8_t const *tx,
+                                       uint8_t *rx,
+                                       size_t bits,
+                                       uint32_t clock_hz,
+                                       int64_t start_ns);
+
+    /**
+     * @typedef spi_sim_overheads_t
+     * @brief Software time added to every transaction, modelling the ESP-IDF SPI master driver.
+     */
+    typedef struct
+    {
+        uint32_t polling_ns; /** @brief spi_device_polling_transmit setup and teardown. */
+        uint32_t queued_ns;  /** @brief Gap between back-to-back queued transactions (ISR). */
+    } spi_sim_overheads_t;
+
+    /**
+     * @brief Attach a simulated slave to a chip select.
+     * @param[in] host SPI host.
+     * @param[in] cs_io_num Chip select GPIO.
+     * @param[in] transfer Slave transfer function.
+     * @param[in] cs_high_ns Minimum time CS must stay high between transactions.
+     * @param[in] context Slave context.
+     */
+    void spi_sim_attach(spi_host_device_t host, int cs_io_num, spi_sim_transfer_t transfer, uint32_t cs_high_ns, void *context);
+
+    /**
+     * @brief Detach a simulated slave from a chip select.
+     * @param[in] host SPI host.
+     * @param[in] cs_io_num Chip select GPIO.
+     */
+    void spi_sim_detach(spi_host_device_t host, int cs_io_num);
+
+    /**
+     * @brief Set the software overheads. Defaults approximate an ESP32 at 240MHz.
+     * @param[in] overheads Overheads.
+     */
+    void spi_sim_set_overheads(spi_sim_overheads_t const *overheads);
+
+    /**
+     * @brief Get the software overheads.
+     * @param[out] overheads Overheads.
+     */
+    void spi_sim_get_overheads(spi_sim_overheads_t *overheads);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
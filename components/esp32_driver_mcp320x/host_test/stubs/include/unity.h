@@ -0,0 +1,93 @@
+#ifndef __HOST_STUB_UNITY_H__
+#define __HOST_STUB_UNITY_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Subset of the Unity API used by the component tests. A failed assertion
+    // ends the running test case and marks it as failed.
+
+    void unity_stub_fail(const char *file, int line, const char *format, ...) __attribute__((noreturn, format(printf, 3, 4)));
+    void unity_stub_assert_int(int64_t expected, int64_t actual, int64_t delta, const char *file, int line);
+    void unity_stub_assert_uint(uint64_t expected, uint64_t actual, const char *file, int line);
+    void unity_stub_assert_compare(int64_t threshold, int64_t actual, int comparison, const char *file, int line);
+    void unity_stub_assert_double(double expected, double actual, double delta, const char *file, int line);
+    void unity_stub_assert_memory(void const *expected, void const *actual, size_t size, const char *file, int line);
+    int unity_stub_begin(void);
+    int unity_stub_end(void);
+
+#define UNITY_STUB_GREATER_THAN 0
+#define UNITY_STUB_GREATER_OR_EQUAL 1
+#define UNITY_STUB_LESS_THAN 2
+#define UNITY_STUB_LESS_OR_EQUAL 3
+
+#define UNITY_BEGIN() unity_stub_begin()
+#define UNITY_END() unity_stub_end()
+
+#define TEST_FAIL_MESSAGE(message) unity_stub_fail(__FILE__, __LINE__, "%s", message)
+#define TEST_FAIL() unity_stub_fail(__FILE__, __LINE__, "failed")
+#define TEST_ASSERT_MESSAGE(condition, message) \
+    do                                          \
+    {                                           \
+        if (!(condition))                       \
+        {                                       \
+            TEST_FAIL_MESSAGE(message);         \
+        }                                       \
+    } while (0)
+#define TEST_ASSERT(condition) TEST_ASSERT_MESSAGE(condition, "expected true: " #condition)
+#define TEST_ASSERT_TRUE(condition) TEST_ASSERT_MESSAGE(condition, "expected true: " #condition)
+#define TEST_ASSERT_FALSE(condition) TEST_ASSERT_MESSAGE(!(condition), "expected false: " #condition)
+#define TEST_ASSERT_NULL(pointer) TEST_ASSERT_MESSAGE((pointer) == NULL, "expected NULL: " #pointer)
+#define TEST_ASSERT_NOT_NULL(pointer) TEST_ASSERT_MESSAGE((pointer) != NULL, "expected not NULL: " #pointer)
+
+#define TEST_ASSERT_EQUAL(expected, actual) unity_stub_assert_int((int64_t)(expected), (int64_t)(actual), 0, __FILE__, __LINE__)
+#define TEST_ASSERT_EQUAL_INT(expected, actual) TEST_ASSERT_EQUAL(expected, actual)
+#define TEST_ASSERT_EQUAL_INT16(expected, actual) TEST_ASSERT_EQUAL((int16_t)(expected), (int16_t)(actual))
+#define TEST_ASSERT_EQUAL_INT32(expected, actual) TEST_ASSERT_EQUAL((int32_t)(expected), (int32_t)(actual))
+#define TEST_ASSERT_EQUAL_INT64(expected, actual) TEST_ASSERT_EQUAL((int64_t)(expected), (int64_t)(actual))
+#define TEST_ASSERT_EQUAL_UINT(expected, actual) unity_stub_assert_uint((uint64_t)(expected), (uint64_t)(actual), __FILE__, __LINE__)
+#define TEST_ASSERT_EQUAL_UINT8(expected, actual) TEST_ASSERT_EQUAL_UINT((uint8_t)(expected), (uint8_t)(actual))
+#define TEST_ASSERT_EQUAL_UINT16(expected, actual) TEST_ASSERT_EQUAL_UINT((uint16_t)(expected), (uint16_t)(actual))
+#define TEST_ASSERT_EQUAL_UINT32(expected, actual) TEST_ASSERT_EQUAL_UINT((uint32_t)(expected), (uint32_t)(actual))
+#define TEST_ASSERT_EQUAL_UINT64(expected, actual) TEST_ASSERT_EQUAL_UINT((uint64_t)(expected), (uint64_t)(actual))
+#define TEST_ASSERT_EQUAL_HEX8(expected, actual) TEST_ASSERT_EQUAL_UINT8(expected, actual)
+#define TEST_ASSERT_EQUAL_HEX16(expected, actual) TEST_ASSERT_EQUAL_UINT16(expected, actual)
+#define TEST_ASSERT_EQUAL_HEX32(expected, actual) TEST_ASSERT_EQUAL_UINT32(expected, actual)
+#define TEST_ASSERT_EQUAL_size_t(expected, actual) TEST_ASSERT_EQUAL_UINT(expected, actual)
+
+#define TEST_ASSERT_INT_WITHIN(delta, expected, actual) unity_stub_assert_int((int64_t)(expected), (int64_t)(actual), (int64_t)(delta), __FILE__, __LINE__)
+#define TEST_ASSERT_INT16_WITHIN(delta, expected, actual) TEST_ASSERT_INT_WITHIN(delta, (int16_t)(expected), (int16_t)(actual))
+#define TEST_ASSERT_INT32_WITHIN(delta, expected, actual) TEST_ASSERT_INT_WITHIN(delta, (int32_t)(expected), (int32_t)(actual))
+#define TEST_ASSERT_UINT_WITHIN(delta, expected, actual) TEST_ASSERT_INT_WITHIN(delta, expected, actual)
+#define TEST_ASSERT_UINT16_WITHIN(delta, expected, actual) TEST_ASSERT_INT_WITHIN(delta, (uint16_t)(expected), (uint16_t)(actual))
+#define TEST_ASSERT_UINT32_WITHIN(delta, expected, actual) TEST_ASSERT_INT_WITHIN(delta, (uint32_t)(expected), (uint32_t)(actual))
+#define TEST_ASSERT_DOUBLE_WITHIN(delta, expected, actual) unity_stub_assert_double((double)(expected), (double)(actual), (double)(delta), __FILE__, __LINE__)
+#define TEST_ASSERT_FLOAT_WITHIN(delta, expected, actual) TEST_ASSERT_DOUBLE_WITHIN(delta, expected, actual)
+
+#define TEST_ASSERT_GREATER_THAN(threshold, actual) unity_stub_assert_compare((int64_t)(threshold), (int64_t)(actual), UNITY_STUB_GREATER_THAN, __FILE__, __LINE__)
+#define TEST_ASSERT_GREATER_OR_EQUAL(threshold, actual) unity_stub_assert_compare((int64_t)(threshold), (int64_t)(actual), UNITY_STUB_GREATER_OR_EQUAL, __FILE__, __LINE__)
+#define TEST_ASSERT_LESS_THAN(threshold, actual) unity_stub_assert_compare((int64_t)(threshold), (int64_t)(actual), UNITY_STUB_LESS_THAN, __FILE__, __LINE__)
+#define TEST_ASSERT_LESS_OR_EQUAL(threshold, actual) unity_stub_assert_compare((int64_t)(threshold), (int64_t)(actual), UNITY_STUB_LESS_OR_EQUAL, __FILE__, __LINE__)
+#define TEST_ASSERT_GREATER_THAN_UINT32(threshold, actual) TEST_ASSERT_GREATER_THAN((uint32_t)(threshold), (uint32_t)(actual))
+#define TEST_ASSERT_GREATER_OR_EQUAL_UINT32(threshold, actual) TEST_ASSERT_GREATER_OR_EQUAL((uint32_t)(threshold), (uint32_t)(actual))
+#define TEST_ASSERT_LESS_THAN_UINT32(threshold, actual) TEST_ASSERT_LESS_THAN((uint32_t)(threshold), (uint32_t)(actual))
+#define TEST_ASSERT_LESS_OR_EQUAL_UINT32(threshold, actual) TEST_ASSERT_LESS_OR_EQUAL((uint32_t)(threshold), (uint32_t)(actual))
+#define TEST_ASSERT_GREATER_THAN_INT32(threshold, actual) TEST_ASSERT_GREATER_THAN((int32_t)(threshold), (int32_t)(actual))
+#define TEST_ASSERT_LESS_THAN_INT32(threshold, actual) TEST_ASSERT_LESS_THAN((int32_t)(threshold), (int32_t)(actual))
+
+#define TEST_ASSERT_EQUAL_MEMORY(expected, actual, size) unity_stub_assert_memory((expected), (actual), (size), __FILE__, __LINE__)
+#define TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, count) TEST_ASSERT_EQUAL_MEMORY((expected), (actual), (count) * sizeof(uint8_t))
+#define TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, actual, count) TEST_ASSERT_EQUAL_MEMORY((expected), (actual), (count) * sizeof(uint16_t))
+#define TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, actual, count) TEST_ASSERT_EQUAL_MEMORY((expected), (actual), (count) * sizeof(uint32_t))
+#define TEST_ASSERT_EQUAL_INT32_ARRAY(expected, actual, count) TEST_ASSERT_EQUAL_MEMORY((expected), (actual), (count) * sizeof(int32_t))
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,50 @@
+#ifndef __HOST_STUB_UNITY_TEST_RUNNER_H__
+#define __HOST_STUB_UNITY_TEST_RUNNER_H__
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef void (*test_func)(void);
+
+    typedef struct test_desc_t
+    {
+        const char *name;
+        const char *desc;
+        test_func fn;
+        const char *file;
+        int line;
+        struct test_desc_t *next;
+    } test_desc_t;
+
+    void unity_testcase_register(test_desc_t *desc);
+    void unity_run_all_tests(void);
+    void unity_run_tests_by_tag(const char *tag, bool invert);
+
+#define UNITY_TEST_UID_CONCAT(what, line) what##line
+#define UNITY_TEST_UID_EXPAND(what, line) UNITY_TEST_UID_CONCAT(what, line)
+#define UNITY_TEST_UID(what) UNITY_TEST_UID_EXPAND(what, __LINE__)
+
+// Same shape as the ESP-IDF macro: test cases register themselves before main.
+#define TEST_CASE(name_, desc_)                                                          \
+    static void UNITY_TEST_UID(test_func_)(void);                                        \
+    static void __attribute__((constructor)) UNITY_TEST_UID(test_reg_helper_)(void)     \
+    {                                                                                    \
+        static test_desc_t test_desc_ = {                                                \
+            .name = name_,                                                               \
+            .desc = desc_,                                                               \
+            .fn = &UNITY_TEST_UID(test_func_),                                           \
+            .file = __FILE__,                                                            \
+            .line = __LINE__,                                                            \
+            .next = NULL};                                                               \
+        unity_testcase_register(&test_desc_);                                            \
+    }                                                                                    \
+    static void UNITY_TEST_UID(test_func_)(void)
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,254 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <time.h>
+#include "esp_timer.h"
+
+// esp_timer on the host monotonic clock. Simulated peripherals add the bus
+// time they would have taken to a virtual offset, so timings measured by the
+// tests reflect the device, not the speed of the host.
+
+struct esp_timer
+{
+    esp_timer_create_args_t args;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    bool running;
+    bool thread_started;
+    bool once;
+    uint64_t period_us;
+};
+
+static atomic_int_fast64_t s_virtual_ns = 0;
+static int64_t s_start_ns = 0;
+static pthread_once_t s_start_once = PTHREAD_ONCE_INIT;
+
+static int64_t monotonic_ns(void);
+static void record_start(void);
+static esp_err_t timer_start(esp_timer_handle_t timer, uint64_t period, bool once);
+static void timer_join(esp_timer_handle_t timer);
+static void *timer_thread(void *arg);
+
+int64_t esp_timer_stub_get_time_ns(void)
+{
+    pthread_once(&s_start_once, record_start);
+
+    return monotonic_ns() - s_start_ns + atomic_load(&s_virtual_ns);
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return esp_timer_stub_get_time_ns() / 1000;
+}
+
+void esp_timer_stub_advance_ns(int64_t ns)
+{
+    atomic_fetch_add(&s_virtual_ns, ns);
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle)
+{
+    if (create_args == NULL || create_args->callback == NULL || out_handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_timer_handle_t timer = calloc(1, sizeof(struct esp_timer));
+
+    if (timer == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    timer->args = *create_args;
+    pthread_mutex_init(&timer->lock, NULL);
+    pthread_cond_init(&timer->changed, NULL);
+
+    *out_handle = timer;
+
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    return timer_start(timer, timeout_us, true);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period)
+{
+    if (period == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return timer_start(timer, period, false);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    if (timer == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&timer->lock);
+
+    if (!timer->running)
+    {
+        pthread_mutex_unlock(&timer->lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    timer->running = false;
+    pthread_cond_signal(&timer->changed);
+
+    pthread_mutex_unlock(&timer->lock);
+
+    // Like the real esp_timer, no callback runs once stop returns.
+    timer_join(timer);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    if (timer == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (timer->running)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    timer_join(timer); // A one-shot timer that fired.
+
+    pthread_cond_destroy(&timer->changed);
+    pthread_mutex_destroy(&timer->lock);
+    free(timer);
+
+    return ESP_OK;
+}
+
+static int64_t monotonic_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (int64_t)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+static void record_start(void)
+{
+    s_start_ns = monotonic_ns();
+}
+
+static esp_err_t timer_start(esp_timer_handle_t timer, uint64_t period, bool once)
+{
+    if (timer == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // A one-shot timer that fired can start again: its thread is finishing.
+    timer_join(timer);
+
+    pthread_mutex_lock(&timer->lock);
+
+    if (timer->running)
+    {
+        pthread_mutex_unlock(&timer->lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    timer->running = true;
+    timer->once = once;
+    timer->period_us = period;
+    timer->thread_started = pthread_create(&timer->thread, NULL, timer_thread, timer) == 0;
+
+    esp_err_t result = timer->thread_started ? ESP_OK : ESP_ERR_NO_MEM;
+
+    timer->running = timer->thread_started;
+
+    pthread_mutex_unlock(&timer->lock);
+
+    return result;
+}
+
+static void timer_join(esp_timer_handle_t timer)
+{
+    pthread_mutex_lock(&timer->lock);
+
+    const bool started = timer->thread_started && !timer->running;
+
+    pthread_mutex_unlock(&timer->lock);
+
+    if (started)
+    {
+        pthread_join(timer->thread, NULL);
+
+        pthread_mutex_lock(&timer->lock);
+        timer->thread_started = false;
+        pthread_mutex_unlock(&timer->lock);
+    }
+}
+
+static void *timer_thread(void *arg)
+{
+    esp_timer_handle_t timer = (esp_timer_handle_t)arg;
+    int64_t next_us = esp_timer_get_time() + (int64_t)timer->period_us;
+
+    pthread_mutex_lock(&timer->lock);
+
+    while (timer->running)
+    {
+        const int64_t now_us = esp_timer_get_time();
+
+        if (now_us < next_us)
+        {
+            // The virtual offset can jump while sleeping, so the deadline is
+            // re-evaluated on every wake up.
+            const int64_t wait_us = next_us - now_us;
+            struct timespec deadline;
+
+            clock_gettime(CLOCK_REALTIME, &deadline);
+
+            const int64_t ns = deadline.tv_nsec + wait_us * 1000;
+
+            deadline.tv_sec += (time_t)(ns / 1000000000LL);
+            deadline.tv_nsec = (long)(ns % 1000000000LL);
+
+            pthread_cond_timedwait(&timer->changed, &timer->lock, &deadline);
+            continue;
+        }
+
+        // A one-shot timer is done before its callback, so whoever it wakes can start it again.
+        if (timer->once)
+        {
+            timer->running = false;
+        }
+
+        pthread_mutex_unlock(&timer->lock);
+        timer->args.callback(timer->args.arg);
+        pthread_mutex_lock(&timer->lock);
+
+        if (timer->once)
+        {
+            break;
+        }
+
+        next_us += (int64_t)timer->period_us;
+
+        if (timer->args.skip_unhandled_events && next_us < esp_timer_get_time())
+        {
+            next_us = esp_timer_get_time() + (int64_t)timer->period_us;
+        }
+    }
+
+    pthread_mutex_unlock(&timer->lock);
+
+    return NULL;
+}
@@ -0,0 +1,519 @@
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "esp_timer.h"
+
+// FreeRTOS on POSIX threads. Enough of the API for the driver and its tests:
+// tasks, direct-to-task notifications, semaphores and event groups.
+
+struct tskTaskControlBlock
+{
+    pthread_t thread;
+    TaskFunction_t code;
+    void *parameters;
+    UBaseType_t priority;
+    BaseType_t core_id;
+    pthread_mutex_t lock;
+    pthread_cond_t notified;
+    uint32_t notifications[configTASK_NOTIFICATION_ARRAY_ENTRIES];
+};
+
+struct host_stub_semaphore
+{
+    pthread_mutex_t lock;
+    pthread_cond_t given;
+    UBaseType_t count;
+    UBaseType_t max_count;
+    pthread_t holder;      // Recursive mutexes only.
+    UBaseType_t recursion; // Recursive mutexes only: takes not given back yet.
+};
+
+struct host_stub_event_group
+{
+    pthread_mutex_t lock;
+    pthread_cond_t set;
+    EventBits_t bits;
+};
+
+static _Thread_local TaskHandle_t s_current_task = NULL;
+
+static TaskHandle_t task_alloc(TaskFunction_t code, void *parameters, UBaseType_t priority, BaseType_t core_id);
+static void *task_entry(void *arg);
+static bool wait_until(pthread_cond_t *cond, pthread_mutex_t *lock, struct timespec const *deadline);
+static void deadline_after(TickType_t ticks, struct timespec *deadline);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task_code,
+                                   const char *name,
+                                   uint32_t stack_depth,
+                                   void *parameters,
+                                   UBaseType_t priority,
+                                   TaskHandle_t *created_task,
+                                   BaseType_t core_id)
+{
+    (void)name;
+    (void)stack_depth;
+
+    TaskHandle_t task = task_alloc(task_code, parameters, priority, core_id);
+
+    if (task == NULL)
+    {
+        return pdFAIL;
+    }
+
+    // Publish the handle before the task runs, like FreeRTOS does.
+    if (created_task != NULL)
+    {
+        *created_task = task;
+    }
+
+    if (pthread_create(&task->thread, NULL, task_entry, task) != 0)
+    {
+        free(task);
+        return pdFAIL;
+    }
+
+    pthread_detach(task->thread);
+
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t task_code,
+                       const char *name,
+                       uint32_t stack_depth,
+                       void *parameters,
+                       UBaseType_t priority,
+                       TaskHandle_t *created_task)
+{
+    return xTaskCreatePinnedToCore(task_code, name, stack_depth, parameters, priority, created_task, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    // Only self deletion is supported. The control block is not freed so
+    // late notifications to a finished task stay harmless.
+    if (task == NULL || task == s_current_task)
+    {
+        pthread_exit(NULL);
+    }
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    struct timespec duration = {
+        .tv_sec = ticks / configTICK_RATE_HZ,
+        .tv_nsec = (long)(ticks % configTICK_RATE_HZ) * (1000000000L / configTICK_RATE_HZ)};
+
+    while (nanosleep(&duration, &duration) != 0 && errno == EINTR)
+    {
+    }
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(esp_timer_get_time() / (1000000 / configTICK_RATE_HZ));
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    // Threads not created by xTaskCreate (e.g. main) get a control block on first use.
+    if (s_current_task == NULL)
+    {
+        s_current_task = task_alloc(NULL, NULL, 1, 0);
+
+        if (s_current_task != NULL)
+        {
+            s_current_task->thread = pthread_self();
+        }
+    }
+
+    return s_current_task;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task)
+{
+    if (task == NULL)
+    {
+        task = xTaskGetCurrentTaskHandle();
+    }
+
+    return task->priority;
+}
+
+BaseType_t xTaskGetCoreID(TaskHandle_t task)
+{
+    if (task == NULL)
+    {
+        task = xTaskGetCurrentTaskHandle();
+    }
+
+    return task->core_id;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_count_on_exit, TickType_t ticks_to_wait)
+{
+    return ulTaskNotifyTakeIndexed(0, clear_count_on_exit, ticks_to_wait);
+}
+
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear_count_on_exit, TickType_t ticks_to_wait)
+{
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    struct timespec deadline;
+
+    deadline_after(ticks_to_wait, &deadline);
+
+    pthread_mutex_lock(&task->lock);
+
+    while (task->notifications[index] == 0 && ticks_to_wait != 0)
+    {
+        if (!wait_until(&task->notified, &task->lock, ticks_to_wait == portMAX_DELAY ? NULL : &deadline))
+        {
+            break;
+        }
+    }
+
+    const uint32_t value = task->notifications[index];
+
+    if (value > 0)
+    {
+        task->notifications[index] = clear_count_on_exit ? 0 : value - 1;
+    }
+
+    pthread_mutex_unlock(&task->lock);
+
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    return xTaskNotifyGiveIndexed(task, 0);
+}
+
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index)
+{
+    pthread_mutex_lock(&task->lock);
+
+    task->notifications[index]++;
+    pthread_cond_signal(&task->notified);
+
+    pthread_mutex_unlock(&task->lock);
+
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken)
+{
+    xTaskNotifyGive(task);
+
+    if (higher_priority_task_woken != NULL)
+    {
+        *higher_priority_task_woken = pdFALSE;
+    }
+}
+
+void vTaskYield(void)
+{
+    sched_yield();
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial_count)
+{
+    SemaphoreHandle_t semaphore = calloc(1, sizeof(struct host_stub_semaphore));
+
+    if (semaphore == NULL)
+    {
+        return NULL;
+    }
+
+    pthread_mutex_init(&semaphore->lock, NULL);
+    pthread_cond_init(&semaphore->given, NULL);
+    semaphore->count = initial_count;
+    semaphore->max_count = max_count;
+
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return xSemaphoreCreateCounting(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    // No priority inheritance: the host scheduler ignores priorities anyway.
+    return xSemaphoreCreateCounting(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void)
+{
+    return xSemaphoreCreateCounting(1, 1);
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t mutex, TickType_t ticks_to_wait)
+{
+    pthread_mutex_lock(&mutex->lock);
+    const bool held = mutex->recursion > 0 && pthread_equal(mutex->holder, pthread_self());
+
+    if (held)
+    {
+        mutex->recursion++;
+    }
+
+    pthread_mutex_unlock(&mutex->lock);
+
+    if (held)
+    {
+        return pdTRUE;
+    }
+
+    if (!xSemaphoreTake(mutex, ticks_to_wait))
+    {
+        return pdFALSE;
+    }
+
+    pthread_mutex_lock(&mutex->lock);
+    mutex->holder = pthread_self();
+    mutex->recursion = 1;
+    pthread_mutex_unlock(&mutex->lock);
+
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t mutex)
+{
+    pthread_mutex_lock(&mutex->lock);
+    const bool held = mutex->recursion > 0 && pthread_equal(mutex->holder, pthread_self());
+    const bool last = held && --mutex->recursion == 0;
+    pthread_mutex_unlock(&mutex->lock);
+
+    if (!held)
+    {
+        return pdFALSE;
+    }
+
+    return last ? xSemaphoreGive(mutex) : pdTRUE;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait)
+{
+    struct timespec deadline;
+
+    deadline_after(ticks_to_wait, &deadline);
+
+    pthread_mutex_lock(&semaphore->lock);
+
+    while (semaphore->count == 0 && ticks_to_wait != 0)
+    {
+        if (!wait_until(&semaphore->given, &semaphore->lock, ticks_to_wait == portMAX_DELAY ? NULL : &deadline))
+        {
+            break;
+        }
+    }
+
+    const BaseType_t taken = semaphore->count > 0 ? pdTRUE : pdFALSE;
+
+    if (taken)
+    {
+        semaphore->count--;
+    }
+
+    pthread_mutex_unlock(&semaphore->lock);
+
+    return taken;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    BaseType_t given = pdFALSE;
+
+    pthread_mutex_lock(&semaphore->lock);
+
+    if (semaphore->count < semaphore->max_count)
+    {
+        semaphore->count++;
+        given = pdTRUE;
+        pthread_cond_signal(&semaphore->given);
+    }
+
+    pthread_mutex_unlock(&semaphore->lock);
+
+    return given;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t *higher_priority_task_woken)
+{
+    if (higher_priority_task_woken != NULL)
+    {
+        *higher_priority_task_woken = pdFALSE;
+    }
+
+    return xSemaphoreGive(semaphore);
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaphore)
+{
+    pthread_mutex_lock(&semaphore->lock);
+    const UBaseType_t count = semaphore->count;
+    pthread_mutex_unlock(&semaphore->lock);
+
+    return count;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+    pthread_cond_destroy(&semaphore->given);
+    pthread_mutex_destroy(&semaphore->lock);
+    free(semaphore);
+}
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    EventGroupHandle_t event_group = calloc(1, sizeof(struct host_stub_event_group));
+
+    if (event_group == NULL)
+    {
+        return NULL;
+    }
+
+    pthread_mutex_init(&event_group->lock, NULL);
+    pthread_cond_init(&event_group->set, NULL);
+
+    return event_group;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t event_group, const EventBits_t bits_to_set)
+{
+    pthread_mutex_lock(&event_group->lock);
+    event_group->bits |= bits_to_set;
+    const EventBits_t bits = event_group->bits;
+    pthread_cond_broadcast(&event_group->set);
+    pthread_mutex_unlock(&event_group->lock);
+
+    return bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t event_group, const EventBits_t bits_to_clear)
+{
+    pthread_mutex_lock(&event_group->lock);
+    const EventBits_t bits = event_group->bits;
+    event_group->bits &= ~bits_to_clear;
+    pthread_mutex_unlock(&event_group->lock);
+
+    return bits;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t event_group)
+{
+    pthread_mutex_lock(&event_group->lock);
+    const EventBits_t bits = event_group->bits;
+    pthread_mutex_unlock(&event_group->lock);
+
+    return bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t event_group,
+                                const EventBits_t bits_to_wait_for,
+                                const BaseType_t clear_on_exit,
+                                const BaseType_t wait_for_all_bits,
+                                TickType_t ticks_to_wait)
+{
+    struct timespec deadline;
+
+    deadline_after(ticks_to_wait, &deadline);
+
+    pthread_mutex_lock(&event_group->lock);
+
+    for (;;)
+    {
+        const EventBits_t matched = event_group->bits & bits_to_wait_for;
+
+        if ((wait_for_all_bits ? matched == bits_to_wait_for : matched != 0) || ticks_to_wait == 0)
+        {
+            break;
+        }
+
+        if (!wait_until(&event_group->set, &event_group->lock, ticks_to_wait == portMAX_DELAY ? NULL : &deadline))
+        {
+            break;
+        }
+    }
+
+    // Like FreeRTOS: the bits before clearing, whether the wait was met or timed out.
+    const EventBits_t bits = event_group->bits;
+    const EventBits_t matched = bits & bits_to_wait_for;
+
+    if (clear_on_exit && (wait_for_all_bits ? matched == bits_to_wait_for : matched != 0))
+    {
+        event_group->bits &= ~bits_to_wait_for;
+    }
+
+    pthread_mutex_unlock(&event_group->lock);
+
+    return bits;
+}
+
+void vEventGroupDelete(EventGroupHandle_t event_group)
+{
+    pthread_cond_destroy(&event_group->set);
+    pthread_mutex_destroy(&event_group->lock);
+    free(event_group);
+}
+
+static TaskHandle_t task_alloc(TaskFunction_t code, void *parameters, UBaseType_t priority, BaseType_t core_id)
+{
+    TaskHandle_t task = calloc(1, sizeof(struct tskTaskControlBlock));
+
+    if (task == NULL)
+    {
+        return NULL;
+    }
+
+    task->code = code;
+    task->parameters = parameters;
+    task->priority = priority;
+    task->core_id = core_id;
+    pthread_mutex_init(&task->lock, NULL);
+    pthread_cond_init(&task->notified, NULL);
+
+    return task;
+}
+
+static void *task_entry(void *arg)
+{
+    s_current_task = (TaskHandle_t)arg;
+    s_current_task->code(s_current_task->parameters);
+
+    // FreeRTOS tasks must not return; treat it as self deletion.
+    return NULL;
+}
+
+static bool wait_until(pthread_cond_t *cond, pthread_mutex_t *lock, struct timespec const *deadline)
+{
+    if (deadline == NULL)
+    {
+        pthread_cond_wait(cond, lock);
+        return true;
+    }
+
+    return pthread_cond_timedwait(cond, lock, deadline) != ETIMEDOUT;
+}
+
+static void deadline_after(TickType_t ticks, struct timespec *deadline)
+{
+    clock_gettime(CLOCK_REALTIME, deadline);
+
+    if (ticks == portMAX_DELAY)
+    {
+        return;
+    }
+
+    const uint64_t ns = (uint64_t)deadline->tv_nsec + (uint64_t)ticks * (1000000000ULL / configTICK_RATE_HZ);
+
+    deadline->tv_sec += (time_t)(ns / 1000000000ULL);
+    deadline->tv_nsec = (long)(ns % 1000000000ULL);
+}
@@ -0,0 +1,103 @@
+#include <pthread.h>
+#include <stdbool.h>
+#include "driver/gpio.h"
+#include "gpio_stub.h"
+
+// GPIO levels in memory. Simulated peripherals watch output pins with hooks
+// and answer by driving input pins.
+
+typedef struct
+{
+    uint32_t level;
+    gpio_stub_hook_t hook;
+    void *context;
+} gpio_stub_pin_t;
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static gpio_stub_pin_t s_pins[GPIO_NUM_MAX];
+
+esp_err_t gpio_config(const gpio_config_t *config)
+{
+    if (config == NULL || (config->pin_bit_mask >> GPIO_NUM_MAX) != 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num)
+{
+    return (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) ? ESP_ERR_INVALID_ARG : ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    level = level ? 1 : 0;
+
+    pthread_mutex_lock(&s_lock);
+
+    const bool changed = s_pins[gpio_num].level != level;
+    const gpio_stub_hook_t hook = s_pins[gpio_num].hook;
+    void *context = s_pins[gpio_num].context;
+
+    s_pins[gpio_num].level = level;
+
+    pthread_mutex_unlock(&s_lock);
+
+    if (changed && hook != NULL)
+    {
+        hook(context, gpio_num, level);
+    }
+
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    return (int)gpio_stub_get_drive(gpio_num);
+}
+
+void gpio_stub_set_hook(gpio_num_t io_num, gpio_stub_hook_t hook, void *context)
+{
+    if (io_num < 0 || io_num >= GPIO_NUM_MAX)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s_lock);
+    s_pins[io_num].hook = hook;
+    s_pins[io_num].context = context;
+    pthread_mutex_unlock(&s_lock);
+}
+
+void gpio_stub_drive(gpio_num_t io_num, uint32_t level)
+{
+    if (io_num < 0 || io_num >= GPIO_NUM_MAX)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s_lock);
+    s_pins[io_num].level = level ? 1 : 0;
+    pthread_mutex_unlock(&s_lock);
+}
+
+uint32_t gpio_stub_get_drive(gpio_num_t io_num)
+{
+    if (io_num < 0 || io_num >= GPIO_NUM_MAX)
+    {
+        return 0;
+    }
+
+    pthread_mutex_lock(&s_lock);
+    const uint32_t level = s_pins[io_num].level;
+    pthread_mutex_unlock(&s_lock);
+
+    return level;
+}
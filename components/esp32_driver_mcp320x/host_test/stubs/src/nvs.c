@@ -0,0 +1,157 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nvs.h"
+
+// NVS on files: each key of a namespace is a file named
+// "<namespace>.<key>.nvs", on the directory given by the HOST_STUB_NVS_DIR
+// environment variable, or the current one. Blobs written on the host can be
+// inspected, or loaded by the next run.
+
+#define NVS_HANDLES_MAX 8
+#define NVS_NAME_SIZE 16 // Like ESP-IDF: 15 characters and the terminator.
+
+static char s_namespaces[NVS_HANDLES_MAX][NVS_NAME_SIZE];
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static esp_err_t nvs_path(nvs_handle_t handle, const char *key, char *path, size_t size);
+
+esp_err_t nvs_open(const char *namespace_name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle)
+{
+    (void)open_mode;
+
+    if (namespace_name == NULL || out_handle == NULL || strlen(namespace_name) >= NVS_NAME_SIZE)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&s_lock);
+
+    for (nvs_handle_t i = 0; i < NVS_HANDLES_MAX; i++)
+    {
+        if (s_namespaces[i][0] == '\0')
+        {
+            strcpy(s_namespaces[i], namespace_name);
+            pthread_mutex_unlock(&s_lock);
+
+            *out_handle = i + 1;
+
+            return ESP_OK;
+        }
+    }
+
+    pthread_mutex_unlock(&s_lock);
+
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+    char path[512];
+    esp_err_t result = nvs_path(handle, key, path, sizeof(path));
+
+    if (result != ESP_OK)
+    {
+        return result;
+    }
+
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL)
+    {
+        return ESP_FAIL;
+    }
+
+    result = fwrite(value, 1, length, file) == length ? ESP_OK : ESP_FAIL;
+    fclose(file);
+
+    return result;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length)
+{
+    char path[512];
+    esp_err_t result = nvs_path(handle, key, path, sizeof(path));
+
+    if (result != ESP_OK)
+    {
+        return result;
+    }
+
+    FILE *file = fopen(path, "rb");
+
+    if (file == NULL)
+    {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+
+    fseek(file, 0, SEEK_END);
+    const size_t stored = (size_t)ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    // Like ESP-IDF: without a buffer, only the length is returned.
+    if (out_value == NULL)
+    {
+        *length = stored;
+        result = ESP_OK;
+    }
+    else if (*length < stored)
+    {
+        result = ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    else
+    {
+        *length = fread(out_value, 1, stored, file);
+        result = *length == stored ? ESP_OK : ESP_FAIL;
+    }
+
+    fclose(file);
+
+    return result;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key)
+{
+    char path[512];
+    const esp_err_t result = nvs_path(handle, key, path, sizeof(path));
+
+    if (result != ESP_OK)
+    {
+        return result;
+    }
+
+    return remove(path) == 0 ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    // Files are written on set.
+    return handle > 0 && handle <= NVS_HANDLES_MAX ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+void nvs_close(nvs_handle_t handle)
+{
+    if (handle > 0 && handle <= NVS_HANDLES_MAX)
+    {
+        pthread_mutex_lock(&s_lock);
+        s_namespaces[handle - 1][0] = '\0';
+        pthread_mutex_unlock(&s_lock);
+    }
+}
+
+static esp_err_t nvs_path(nvs_handle_t handle, const char *key, char *path, size_t size)
+{
+    const char *directory = getenv("HOST_STUB_NVS_DIR");
+
+    if (handle == 0 || handle > NVS_HANDLES_MAX || key == NULL || strlen(key) >= NVS_NAME_SIZE)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&s_lock);
+    snprintf(path, size, "%s/%s.%s.nvs", directory != NULL ? directory : ".", s_namespaces[handle - 1], key);
+    pthread_mutex_unlock(&s_lock);
+
+    return ESP_OK;
+}
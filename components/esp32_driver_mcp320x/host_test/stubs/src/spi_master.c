@@ -0,0 +1,400 @@
+#include <pthread.h>
+#include <string.h>
+#include "driver/spi_master.h"
+#include "esp_timer.h"
+#include "spi_sim.h"
+
+// Simulated SPI master. Transactions run synchronously on the caller thread
+// against the slave attached to the chip select, and move the virtual clock
+// forward by the time the real peripheral would take.
+
+#define SPI_SIM_APB_CLOCK_HZ 80000000
+#define SPI_SIM_CS_MAX 64
+
+typedef struct
+{
+    spi_sim_transfer_t transfer;
+    uint32_t cs_high_ns;
+    void *context;
+} spi_sim_slave_t;
+
+typedef struct
+{
+    bool initialized;
+    spi_device_handle_t owner; // Device holding the bus; NULL when free.
+    pthread_cond_t released;
+} spi_sim_bus_t;
+
+struct spi_device_t
+{
+    spi_host_device_t host;
+    spi_device_interface_config_t config;
+    uint32_t actual_clock_hz;
+    spi_transaction_t **results; // Completed queued transactions, FIFO.
+    int results_head;
+    int results_count;
+};
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static spi_sim_bus_t s_buses[SPI_HOST_MAX] = {
+    {false, NULL, PTHREAD_COND_INITIALIZER},
+    {false, NULL, PTHREAD_COND_INITIALIZER},
+    {false, NULL, PTHREAD_COND_INITIALIZER}};
+static spi_sim_slave_t s_slaves[SPI_HOST_MAX][SPI_SIM_CS_MAX];
+static spi_sim_overheads_t s_overheads = {
+    .polling_ns = 8000,
+    .queued_ns = 4000};
+
+static void spi_sim_run(spi_device_handle_t handle, spi_transaction_t *trans, uint32_t overhead_ns);
+static void spi_sim_wait_bus(spi_device_handle_t handle);
+
+esp_err_t spi_bus_initialize(spi_host_device_t host_id, const spi_bus_config_t *bus_config, spi_common_dma_t dma_chan)
+{
+    (void)dma_chan;
+
+    if (host_id <= SPI1_HOST || host_id >= SPI_HOST_MAX || bus_config == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&s_lock);
+
+    esp_err_t result = s_buses[host_id].initialized ? ESP_ERR_INVALID_STATE : ESP_OK;
+    s_buses[host_id].initialized = true;
+
+    pthread_mutex_unlock(&s_lock);
+
+    return result;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t host_id)
+{
+    if (host_id <= SPI1_HOST || host_id >= SPI_HOST_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&s_lock);
+    s_buses[host_id].initialized = false;
+    pthread_mutex_unlock(&s_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host_id, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle)
+{
+    if (host_id < SPI1_HOST || host_id >= SPI_HOST_MAX || dev_config == NULL || handle == NULL ||
+        dev_config->clock_speed_hz <= 0 || dev_config->clock_speed_hz > SPI_SIM_APB_CLOCK_HZ ||
+        dev_config->queue_size <= 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&s_lock);
+    bool initialized = s_buses[host_id].initialized;
+    pthread_mutex_unlock(&s_lock);
+
+    if (!initialized)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    spi_device_handle_t device = calloc(1, sizeof(struct spi_device_t));
+
+    if (device == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    device->results = calloc((size_t)dev_config->queue_size, sizeof(spi_transaction_t *));
+
+    if (device->results == NULL)
+    {
+        free(device);
+        return ESP_ERR_NO_MEM;
+    }
+
+    uint32_t divider = (SPI_SIM_APB_CLOCK_HZ + (uint32_t)dev_config->clock_speed_hz - 1) / (uint32_t)dev_config->clock_speed_hz;
+
+    device->host = host_id;
+    device->config = *dev_config;
+    device->actual_clock_hz = SPI_SIM_APB_CLOCK_HZ / divider;
+
+    *handle = device;
+
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle)
+{
+    if (handle == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&s_lock);
+
+    bool busy = handle->results_count > 0 || s_buses[handle->host].owner == handle;
+
+    pthread_mutex_unlock(&s_lock);
+
+    if (busy)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    free(handle->results);
+    free(handle);
+
+    return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+
+    if (handle == NULL || trans_desc == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&s_lock);
+
+    if (handle->results_count == handle->config.queue_size)
+    {
+        // The real driver would block forever: nobody collects results while we wait.
+        pthread_mutex_unlock(&s_lock);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    spi_sim_wait_bus(handle);
+    spi_sim_run(handle, trans_desc, s_overheads.queued_ns);
+
+    int tail = (handle->results_head + handle->results_count) % handle->config.queue_size;
+    handle->results[tail] = trans_desc;
+    handle->results_count++;
+
+    pthread_mutex_unlock(&s_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc, TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+
+    if (handle == NULL || trans_desc == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&s_lock);
+
+    if (handle->results_count == 0)
+    {
+        pthread_mutex_unlock(&s_lock);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    *trans_desc = handle->results[handle->results_head];
+    handle->results_head = (handle->results_head + 1) % handle->config.queue_size;
+    handle->results_count--;
+
+    pthread_mutex_unlock(&s_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc)
+{
+    spi_transaction_t *result;
+    esp_err_t ret = spi_device_queue_trans(handle, trans_desc, portMAX_DELAY);
+
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    return spi_device_get_trans_result(handle, &result, portMAX_DELAY);
+}
+
+esp_err_t spi_device_polling_start(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+
+    if (handle == NULL || trans_desc == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&s_lock);
+
+    spi_sim_wait_bus(handle);
+    spi_sim_run(handle, trans_desc, s_overheads.polling_ns);
+
+    pthread_mutex_unlock(&s_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t spi_device_polling_end(spi_device_handle_t handle, TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+
+    return handle == NULL ? ESP_ERR_INVALID_ARG : ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc)
+{
+    esp_err_t ret = spi_device_polling_start(handle, trans_desc, portMAX_DELAY);
+
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    return spi_device_polling_end(handle, portMAX_DELAY);
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait)
+{
+    (void)wait;
+
+    if (device == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&s_lock);
+
+    spi_sim_wait_bus(device);
+    s_buses[device->host].owner = device;
+
+    pthread_mutex_unlock(&s_lock);
+
+    return ESP_OK;
+}
+
+void spi_device_release_bus(spi_device_handle_t dev)
+{
+    if (dev == NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s_lock);
+
+    if (s_buses[dev->host].owner == dev)
+    {
+        s_buses[dev->host].owner = NULL;
+        pthread_cond_broadcast(&s_buses[dev->host].released);
+    }
+
+    pthread_mutex_unlock(&s_lock);
+}
+
+esp_err_t spi_device_get_actual_freq(spi_device_handle_t handle, int *freq_khz)
+{
+    if (handle == NULL || freq_khz == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *freq_khz = (int)(handle->actual_clock_hz / 1000);
+
+    return ESP_OK;
+}
+
+void spi_sim_attach(spi_host_device_t host, int cs_io_num, spi_sim_transfer_t transfer, uint32_t cs_high_ns, void *context)
+{
+    if (host < SPI1_HOST || host >= SPI_HOST_MAX || cs_io_num < 0 || cs_io_num >= SPI_SIM_CS_MAX)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s_lock);
+
+    s_slaves[host][cs_io_num].transfer = transfer;
+    s_slaves[host][cs_io_num].cs_high_ns = cs_high_ns;
+    s_slaves[host][cs_io_num].context = context;
+
+    pthread_mutex_unlock(&s_lock);
+}
+
+void spi_sim_detach(spi_host_device_t host, int cs_io_num)
+{
+    spi_sim_attach(host, cs_io_num, NULL, 0, NULL);
+}
+
+void spi_sim_set_overheads(spi_sim_overheads_t const *overheads)
+{
+    pthread_mutex_lock(&s_lock);
+    s_overheads = *overheads;
+    pthread_mutex_unlock(&s_lock);
+}
+
+void spi_sim_get_overheads(spi_sim_overheads_t *overheads)
+{
+    pthread_mutex_lock(&s_lock);
+    *overheads = s_overheads;
+    pthread_mutex_unlock(&s_lock);
+}
+
+// Must be called with s_lock held.
+static void spi_sim_wait_bus(spi_device_handle_t handle)
+{
+    spi_sim_bus_t *bus = &s_buses[handle->host];
+
+    while (bus->owner != NULL && bus->owner != handle)
+    {
+        pthread_cond_wait(&bus->released, &s_lock);
+    }
+}
+
+// Must be called with s_lock held; the lock also serializes the bus.
+static void spi_sim_run(spi_device_handle_t handle, spi_transaction_t *trans, uint32_t overhead_ns)
+{
+    uint8_t const *tx = (trans->flags & SPI_TRANS_USE_TXDATA) ? trans->tx_data : (uint8_t const *)trans->tx_buffer;
+    uint8_t *rx = (trans->flags & SPI_TRANS_USE_RXDATA) ? trans->rx_data : (uint8_t *)trans->rx_buffer;
+    size_t bits = trans->length;
+    size_t bytes = (bits + 7) / 8;
+    uint8_t tx_zeros[bytes > 0 ? bytes : 1];
+    uint8_t rx_scratch[bytes > 0 ? bytes : 1];
+
+    if (tx == NULL)
+    {
+        memset(tx_zeros, 0, sizeof(tx_zeros));
+        tx = tx_zeros;
+    }
+
+    if (rx == NULL)
+    {
+        rx = rx_scratch;
+    }
+
+    // MISO has a pull-up: unclocked or unattached slaves read as ones.
+    memset(rx, 0xFF, bytes);
+
+    if (handle->config.pre_cb != NULL)
+    {
+        handle->config.pre_cb(trans);
+    }
+
+    spi_sim_slave_t const *slave = &s_slaves[handle->host][handle->config.spics_io_num & (SPI_SIM_CS_MAX - 1)];
+    int64_t bus_ns = (int64_t)((bits * 1000000000ULL) / handle->actual_clock_hz);
+    int64_t cs_high_ns = slave->cs_high_ns > overhead_ns ? (int64_t)(slave->cs_high_ns - overhead_ns) : 0;
+
+    esp_timer_stub_advance_ns(overhead_ns + cs_high_ns);
+
+    if (slave->transfer != NULL)
+    {
+        slave->transfer(slave->context, tx, rx, bits, handle->actual_clock_hz, esp_timer_stub_get_time_ns());
+    }
+
+    esp_timer_stub_advance_ns(bus_ns);
+
+    if (handle->config.post_cb != NULL)
+    {
+        handle->config.post_cb(trans);
+    }
+}
@@ -0,0 +1,174 @@
+#include <math.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "unity_test_runner.h"
+
+// Minimal Unity runner. Assertions must be made from the thread running the
+// test case: a failure jumps back to the runner.
+
+static test_desc_t *s_first = NULL;
+static test_desc_t *s_last = NULL;
+static jmp_buf s_abort;
+static int s_tests = 0;
+static int s_failures = 0;
+
+static void run_test(test_desc_t const *test);
+
+void unity_testcase_register(test_desc_t *desc)
+{
+    // Keep registration order: it is the order of the source files.
+    desc->next = NULL;
+
+    if (s_last == NULL)
+    {
+        s_first = desc;
+    }
+    else
+    {
+        s_last->next = desc;
+    }
+
+    s_last = desc;
+}
+
+void unity_run_all_tests(void)
+{
+    for (test_desc_t const *test = s_first; test != NULL; test = test->next)
+    {
+        run_test(test);
+    }
+}
+
+void unity_run_tests_by_tag(const char *tag, bool invert)
+{
+    for (test_desc_t const *test = s_first; test != NULL; test = test->next)
+    {
+        if ((strstr(test->desc, tag) != NULL) != invert)
+        {
+            run_test(test);
+        }
+    }
+}
+
+int unity_stub_begin(void)
+{
+    s_tests = 0;
+    s_failures = 0;
+
+    return 0;
+}
+
+int unity_stub_end(void)
+{
+    printf("\n-----------------------\n%d Tests %d Failures 0 Ignored\n%s\n", s_tests, s_failures, s_failures == 0 ? "OK" : "FAIL");
+
+    return s_failures;
+}
+
+void unity_stub_fail(const char *file, int line, const char *format, ...)
+{
+    va_list args;
+
+    printf(":FAIL: %s:%d: ", file, line);
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+
+    longjmp(s_abort, 1);
+}
+
+void unity_stub_assert_int(int64_t expected, int64_t actual, int64_t delta, const char *file, int line)
+{
+    const int64_t difference = actual > expected ? actual - expected : expected - actual;
+
+    if (difference > delta)
+    {
+        if (delta == 0)
+        {
+            unity_stub_fail(file, line, "Expected %lld Was %lld", (long long)expected, (long long)actual);
+        }
+
+        unity_stub_fail(file, line, "Values Not Within Delta %lld. Expected %lld Was %lld", (long long)delta, (long long)expected, (long long)actual);
+    }
+}
+
+void unity_stub_assert_uint(uint64_t expected, uint64_t actual, const char *file, int line)
+{
+    if (expected != actual)
+    {
+        unity_stub_fail(file, line, "Expected %llu Was %llu", (unsigned long long)expected, (unsigned long long)actual);
+    }
+}
+
+void unity_stub_assert_compare(int64_t threshold, int64_t actual, int comparison, const char *file, int line)
+{
+    static const char *const operators[] = {">", ">=", "<", "<="};
+    bool passed;
+
+    switch (comparison)
+    {
+    case UNITY_STUB_GREATER_THAN:
+        passed = actual > threshold;
+        break;
+    case UNITY_STUB_GREATER_OR_EQUAL:
+        passed = actual >= threshold;
+        break;
+    case UNITY_STUB_LESS_THAN:
+        passed = actual < threshold;
+        break;
+    default:
+        passed = actual <= threshold;
+        break;
+    }
+
+    if (!passed)
+    {
+        unity_stub_fail(file, line, "Expected %lld %s %lld", (long long)actual, operators[comparison], (long long)threshold);
+    }
+}
+
+void unity_stub_assert_double(double expected, double actual, double delta, const char *file, int line)
+{
+    if (!(fabs(actual - expected) <= delta))
+    {
+        unity_stub_fail(file, line, "Values Not Within Delta %g. Expected %g Was %g", delta, expected, actual);
+    }
+}
+
+void unity_stub_assert_memory(void const *expected, void const *actual, size_t size, const char *file, int line)
+{
+    uint8_t const *e = (uint8_t const *)expected;
+    uint8_t const *a = (uint8_t const *)actual;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        if (e[i] != a[i])
+        {
+            unity_stub_fail(file, line, "Memory Mismatch at byte %zu. Expected 0x%02X Was 0x%02X", i, e[i], a[i]);
+        }
+    }
+}
+
+static void run_test(test_desc_t const *test)
+{
+    s_tests++;
+
+    printf("%s:%d:%s", test->file, test->line, test->name);
+    fflush(stdout);
+
+    if (setjmp(s_abort) == 0)
+    {
+        test->fn();
+        printf(":PASS\n");
+    }
+    else
+    {
+        s_failures++;
+    }
+
+    fflush(stdout);
+}
@@ -0,0 +1,242 @@
+#include <math.h>
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "sim/mcp320x_sim.h"
+#include "esp32_driver_mcp320x/mcp320x_alarm.h"
+
+// The window comparator against synthetic waveforms: generated codes, to
+// control the noise exactly, and a simulated device read through the driver.
+
+#define ALARM_CS GPIO_NUM_21
+#define ALARM_PERIOD 2000
+#define ALARM_PERIODS 10
+#define ALARM_BIT (1 << 5)
+#define ALARM_STOP_BIT (1 << 6)
+
+typedef struct
+{
+    uint32_t transitions[3]; // By new state.
+} alarm_counter_t;
+
+typedef struct
+{
+    EventGroupHandle_t event_group;
+    SemaphoreHandle_t woken;
+    SemaphoreHandle_t stopped;
+    volatile uint32_t wakeups;
+} alarm_waiter_t;
+
+static void alarm_count(uint8_t channel, mcp320x_alarm_state_t state, uint16_t code, void *context)
+{
+    (void)channel;
+    (void)code;
+
+    ((alarm_counter_t *)context)->transitions[state]++;
+}
+
+static uint32_t alarm_noisy_sine(uint16_t *codes, size_t count, uint32_t noise)
+{
+    // 2048 +- 1500, with +-40 codes of noise: every crossing of 3000 and 1000
+    // is many codes long.
+    for (size_t i = 0; i < count; i++)
+    {
+        noise = noise * 1103515245u + 12345u;
+        codes[i] = (uint16_t)(2048.0 + 1500.0 * sin(2.0 * M_PI * (double)i / ALARM_PERIOD) + (double)((noise >> 16) % 81) - 40.0);
+    }
+
+    return noise;
+}
+
+static void alarm_waiter(void *arg)
+{
+    alarm_waiter_t *waiter = (alarm_waiter_t *)arg;
+
+    // Sleeps until a transition, instead of polling.
+    for (;;)
+    {
+        const EventBits_t bits = xEventGroupWaitBits(waiter->event_group, ALARM_BIT | ALARM_STOP_BIT, pdTRUE, pdFALSE, portMAX_DELAY);
+
+        if (bits & ALARM_STOP_BIT)
+        {
+            xSemaphoreGive(waiter->stopped);
+            vTaskDelete(NULL);
+        }
+
+        waiter->wakeups++;
+        xSemaphoreGive(waiter->woken);
+    }
+}
+
+TEST_CASE("Alarm without hysteresis chatters on noise", "[alarm][sim]")
+{
+    static uint16_t codes[ALARM_PERIOD * ALARM_PERIODS];
+    mcp320x_alarm_t alarm;
+    alarm_counter_t counter = {0};
+    const mcp320x_alarm_config_t config = {
+        .channels = {{.low = 1000, .high = 3000}},
+        .channel_count = 1,
+        .callback = alarm_count,
+        .callback_context = &counter};
+
+    alarm_noisy_sine(codes, ALARM_PERIOD * ALARM_PERIODS, 1);
+    mcp320x_alarm_init(&alarm, &config);
+    mcp320x_alarm_process(&alarm, codes, ALARM_PERIOD * ALARM_PERIODS);
+
+    // The control of the next test: the noise toggles the state on each crossing.
+    TEST_ASSERT_GREATER_THAN(2 * ALARM_PERIODS, counter.transitions[MCP320X_ALARM_STATE_HIGH]);
+}
+
+TEST_CASE("Alarm with hysteresis fires once per crossing", "[alarm][sim]")
+{
+    static uint16_t codes[ALARM_PERIOD * ALARM_PERIODS];
+    mcp320x_alarm_t alarm;
+    alarm_counter_t counter = {0};
+    const mcp320x_alarm_config_t config = {
+        .channels = {{.low = 1000, .high = 3000, .hysteresis = 100}},
+        .channel_count = 1,
+        .callback = alarm_count,
+        .callback_context = &counter};
+
+    alarm_noisy_sine(codes, ALARM_PERIOD * ALARM_PERIODS, 1);
+    mcp320x_alarm_init(&alarm, &config);
+
+    // Blocks of odd sizes, like partial stream reads.
+    for (size_t i = 0; i < ALARM_PERIOD * ALARM_PERIODS; i += 77)
+    {
+        const size_t count = ALARM_PERIOD * ALARM_PERIODS - i < 77 ? ALARM_PERIOD * ALARM_PERIODS - i : 77;
+
+        mcp320x_alarm_process(&alarm, &codes[i], count);
+    }
+
+    // Per period: NORMAL -> HIGH -> NORMAL -> LOW -> NORMAL.
+    TEST_ASSERT_EQUAL(ALARM_PERIODS, counter.transitions[MCP320X_ALARM_STATE_HIGH]);
+    TEST_ASSERT_EQUAL(ALARM_PERIODS, counter.transitions[MCP320X_ALARM_STATE_LOW]);
+    TEST_ASSERT_EQUAL(2 * ALARM_PERIODS, counter.transitions[MCP320X_ALARM_STATE_NORMAL]);
+}
+
+TEST_CASE("Alarm with debounce ignores glitches", "[alarm][sim]")
+{
+    static uint16_t codes[ALARM_PERIOD * ALARM_PERIODS];
+    mcp320x_alarm_t alarm;
+    alarm_counter_t counter = {0};
+    const mcp320x_alarm_config_t config = {
+        .channels = {{.low = 0, .high = 3000, .hysteresis = 100, .debounce = 4}},
+        .channel_count = 1,
+        .callback = alarm_count,
+        .callback_context = &counter};
+
+    // A quiet input with single code glitches to full scale.
+    for (size_t i = 0; i < ALARM_PERIOD * ALARM_PERIODS; i++)
+    {
+        codes[i] = (i % 37 == 0 || i % 53 == 0) ? 4095 : 2048;
+    }
+
+    mcp320x_alarm_init(&alarm, &config);
+    mcp320x_alarm_process(&alarm, codes, ALARM_PERIOD * ALARM_PERIODS);
+
+    TEST_ASSERT_EQUAL(0, counter.transitions[MCP320X_ALARM_STATE_HIGH]);
+}
+
+TEST_CASE("Alarm follows a simulated square wave", "[alarm][sim]")
+{
+    static uint16_t codes[2000];
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3204_MODEL, 5000);
+    const mcp320x_sim_waveform_t square = {
+        .type = MCP320X_SIM_WAVEFORM_SQUARE,
+        .offset_uv = 2500000,
+        .amplitude_uv = 2000000,
+        .frequency_hz = 1000,
+        .noise_uv = 50000};
+    const mcp320x_config_t device_config = {
+        .host = SPI3_HOST,
+        .cs_io_num = ALARM_CS,
+        .device_model = MCP3204_MODEL,
+        .clock_speed_hz = 2 * 1000 * 1000,
+        .reference_voltage = 5000};
+    mcp320x_request_t requests[100];
+    mcp320x_alarm_t alarm;
+    alarm_counter_t counter = {0};
+    const mcp320x_alarm_config_t config = {
+        .channels = {{.low = 1000, .high = 3000, .hysteresis = 50}},
+        .channel_count = 1,
+        .callback = alarm_count,
+        .callback_context = &counter};
+    uint32_t edges = 0;
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        requests[i] = (mcp320x_request_t){.channel = MCP320X_CHANNEL_1, .read_mode = MCP320X_READ_MODE_SINGLE};
+    }
+
+    mcp320x_sim_set_waveform(sim, MCP320X_CHANNEL_1, &square);
+    mcp320x_sim_attach(sim, SPI3_HOST, ALARM_CS);
+
+    mcp320x_t *handle = mcp320x_install(&device_config);
+
+    for (size_t i = 0; i < 2000; i += 100)
+    {
+        TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_read_batch(handle, requests, 100, &codes[i]));
+    }
+
+    mcp320x_delete(handle);
+    mcp320x_sim_detach(sim);
+    mcp320x_sim_delete(sim);
+
+    mcp320x_alarm_init(&alarm, &config);
+    mcp320x_alarm_process(&alarm, codes, 2000);
+
+    // The edges of the square wave: between 0.5V and 4.5V, far from both thresholds.
+    for (size_t i = 1; i < 2000; i++)
+    {
+        edges += (codes[i] > 2048) != (codes[i - 1] > 2048);
+    }
+
+    // Always out of the window: one transition out of NORMAL, then one per edge, straight between HIGH and LOW.
+    TEST_ASSERT_GREATER_THAN(4, edges);
+    TEST_ASSERT_EQUAL(0, counter.transitions[MCP320X_ALARM_STATE_NORMAL]);
+    TEST_ASSERT_EQUAL(edges + 1, counter.transitions[MCP320X_ALARM_STATE_HIGH] + counter.transitions[MCP320X_ALARM_STATE_LOW]);
+}
+
+TEST_CASE("Alarm wakes a waiting task only on transitions", "[alarm][sim]")
+{
+    static uint16_t codes[ALARM_PERIOD];
+    alarm_waiter_t waiter = {
+        .event_group = xEventGroupCreate(),
+        .woken = xSemaphoreCreateCounting(16, 0),
+        .stopped = xSemaphoreCreateBinary()};
+    mcp320x_alarm_t alarm;
+    const mcp320x_alarm_config_t config = {
+        .channels = {{.low = 0, .high = 3000, .hysteresis = 100, .event_bits = ALARM_BIT}},
+        .channel_count = 1,
+        .event_group = waiter.event_group};
+
+    mcp320x_alarm_init(&alarm, &config);
+    xTaskCreate(alarm_waiter, "alarm_waiter", 4096, &waiter, 5, NULL);
+
+    // Quiet: inside the window.
+    for (size_t i = 0; i < ALARM_PERIOD; i++)
+    {
+        codes[i] = (uint16_t)(2000 + i % 50);
+    }
+
+    mcp320x_alarm_process(&alarm, codes, ALARM_PERIOD);
+    const BaseType_t woken_quiet = xSemaphoreTake(waiter.woken, pdMS_TO_TICKS(20));
+
+    codes[0] = 3500;
+    mcp320x_alarm_process(&alarm, codes, 1);
+    const BaseType_t woken_crossing = xSemaphoreTake(waiter.woken, pdMS_TO_TICKS(1000));
+
+    xEventGroupSetBits(waiter.event_group, ALARM_STOP_BIT);
+    xSemaphoreTake(waiter.stopped, portMAX_DELAY);
+    vEventGroupDelete(waiter.event_group);
+    vSemaphoreDelete(waiter.woken);
+    vSemaphoreDelete(waiter.stopped);
+
+    TEST_ASSERT_EQUAL(pdFALSE, woken_quiet);
+    TEST_ASSERT_EQUAL(pdTRUE, woken_crossing);
+    TEST_ASSERT_EQUAL(1, waiter.wakeups);
+}
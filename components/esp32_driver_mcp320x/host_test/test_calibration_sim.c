@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "sim/mcp320x_sim.h"
+#include "esp32_driver_mcp320x/mcp320x_calibration.h"
+
+// A front end with errors between the true voltage and the MCP3208 input:
+// 2% of gain, 15mV of offset, and a bow 40mV low at mid scale. Points are
+// captured at known voltages, then the voltages in between are read back
+// uncorrected, with the two points line and with the table through every
+// point. Prints the worst error of each.
+
+#define CALIBRATION_CS GPIO_NUM_22
+#define CALIBRATION_POINTS 5
+#define CALIBRATION_CHECKS 9
+
+static const int32_t CALIBRATION_VOLTAGES[CALIBRATION_POINTS] = {200000, 1300000, 2400000, 3500000, 4600000};
+static const int32_t CALIBRATION_CHECK_VOLTAGES[CALIBRATION_CHECKS] = {300000, 750000, 1000000, 1800000, 2500000, 2900000, 3200000, 4000000, 4500000};
+
+static int32_t table[MCP320X_CALIBRATION_TABLE_SIZE];
+
+static int32_t front_end(int32_t microvolts)
+{
+    const double x = (microvolts - 2500000) / 2500000.0;
+
+    return (int32_t)(microvolts * 1.02 + 15000 - 40000 * (1 - x * x));
+}
+
+static void calibration_apply_voltage(mcp320x_sim_t *sim, int32_t microvolts)
+{
+    const mcp320x_sim_waveform_t waveform = {
+        .type = MCP320X_SIM_WAVEFORM_CONSTANT,
+        .offset_uv = front_end(microvolts),
+        .noise_uv = 3000};
+
+    mcp320x_sim_set_waveform(sim, MCP320X_CHANNEL_6, &waveform);
+}
+
+static int32_t calibration_worst_error(mcp320x_sim_t *sim, mcp320x_t *handle, mcp320x_calibration_t const *calibration)
+{
+    int32_t worst = 0;
+
+    for (int i = 0; i < CALIBRATION_CHECKS; i++)
+    {
+        mcp320x_calibration_point_t point;
+        int32_t microvolts;
+
+        calibration_apply_voltage(sim, CALIBRATION_CHECK_VOLTAGES[i]);
+
+        // The mean of 256 reads, so the error left is the one of the correction, not the noise.
+        TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_calibration_capture(handle, MCP320X_CHANNEL_6, MCP320X_READ_MODE_SINGLE, 0, &point));
+
+        const uint16_t code = (uint16_t)((point.code_x16 + 8) >> 4);
+
+        mcp320x_calibration_apply(calibration, MCP320X_CHANNEL_6, &code, &microvolts, 1);
+
+        const int32_t error = abs(microvolts - CALIBRATION_CHECK_VOLTAGES[i]);
+
+        worst = error > worst ? error : worst;
+    }
+
+    return worst;
+}
+
+TEST_CASE("Can calibrate simulated front end", "[calibration][sim]")
+{
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3208_MODEL, 5000);
+    const mcp320x_config_t device_config = {
+        .host = SPI3_HOST,
+        .cs_io_num = CALIBRATION_CS,
+        .device_model = MCP3208_MODEL,
+        .clock_speed_hz = 2 * 1000 * 1000,
+        .reference_voltage = 5000};
+    mcp320x_calibration_point_t points[CALIBRATION_POINTS];
+    mcp320x_calibration_t uncalibrated;
+    mcp320x_calibration_t linear;
+    mcp320x_calibration_t tabled;
+
+    mcp320x_sim_attach(sim, SPI3_HOST, CALIBRATION_CS);
+
+    mcp320x_t *handle = mcp320x_install(&device_config);
+
+    for (int i = 0; i < CALIBRATION_POINTS; i++)
+    {
+        calibration_apply_voltage(sim, CALIBRATION_VOLTAGES[i]);
+
+        TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_calibration_capture(handle, MCP320X_CHANNEL_6, MCP320X_READ_MODE_SINGLE, CALIBRATION_VOLTAGES[i], &points[i]));
+    }
+
+    const mcp320x_calibration_point_t ends[2] = {points[0], points[CALIBRATION_POINTS - 1]};
+
+    mcp320x_calibration_init(&uncalibrated, 5000);
+    mcp320x_calibration_init(&linear, 5000);
+    mcp320x_calibration_init(&tabled, 5000);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_calibration_set_points(&linear, MCP320X_CHANNEL_6, ends, 2, NULL));
+    TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_calibration_set_points(&tabled, MCP320X_CHANNEL_6, points, CALIBRATION_POINTS, table));
+
+    const int32_t error_uncalibrated = calibration_worst_error(sim, handle, &uncalibrated);
+    const int32_t error_linear = calibration_worst_error(sim, handle, &linear);
+    const int32_t error_tabled = calibration_worst_error(sim, handle, &tabled);
+
+    mcp320x_delete(handle);
+    mcp320x_sim_detach(sim);
+    mcp320x_sim_delete(sim);
+
+    printf("calibration worst error: uncorrected %ld uV, two points %ld uV, %d points table %ld uV\n",
+           (long)error_uncalibrated,
+           (long)error_linear,
+           CALIBRATION_POINTS,
+           (long)error_tabled);
+
+    TEST_ASSERT_GREATER_THAN_INT32(60000, error_uncalibrated);
+    TEST_ASSERT_LESS_THAN_INT32(error_uncalibrated / 2, error_linear);
+    TEST_ASSERT_LESS_THAN_INT32(10000, error_tabled); // The bow left between points, and a code of rounding.
+}
+
+TEST_CASE("Can save and load calibration on NVS", "[calibration][sim]")
+{
+    mcp320x_calibration_t calibration;
+    mcp320x_calibration_t loaded;
+    nvs_handle_t nvs;
+    const mcp320x_calibration_point_t points[2] = {
+        {.code_x16 = 100 * 16, .microvolts = 120000},
+        {.code_x16 = 4000 * 16, .microvolts = 4890000}};
+    const uint16_t codes[3] = {0, 2048, 4095};
+    int32_t expected[3];
+    int32_t actual[3];
+
+    mcp320x_calibration_init(&calibration, 5000);
+    mcp320x_calibration_init(&loaded, 5000);
+    mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_7, points, 2, NULL);
+
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_open("mcp320x", NVS_READWRITE, &nvs));
+
+    nvs_erase_key(nvs, "calibration");
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, mcp320x_calibration_load(&loaded, nvs, "calibration", NULL));
+    TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_calibration_save(&calibration, nvs, "calibration"));
+    TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_calibration_load(&loaded, nvs, "calibration", NULL));
+
+    nvs_erase_key(nvs, "calibration");
+    nvs_close(nvs);
+
+    mcp320x_calibration_apply(&calibration, MCP320X_CHANNEL_7, codes, expected, 3);
+    mcp320x_calibration_apply(&loaded, MCP320X_CHANNEL_7, codes, actual, 3);
+
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, actual, 3);
+}
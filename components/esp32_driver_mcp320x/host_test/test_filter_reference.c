@@ -0,0 +1,241 @@
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "esp32_driver_mcp320x/mcp320x_filter.h"
+
+// Each fixed-point filter against the same filter in double precision, with
+// the same Q15 coefficients and the same priming, on a noisy sine over two
+// interleaved channels. Also reports the throughput of each filter on the
+// host, which only compares them with each other: the target is far slower.
+
+#define REFERENCE_CHANNELS 2
+#define REFERENCE_CODES 4000
+#define THROUGHPUT_CODES (1000 * 1000)
+#define THROUGHPUT_BLOCK 256
+
+static uint16_t reference_input[REFERENCE_CODES];
+
+static void reference_make_input(void)
+{
+    uint32_t noise = 12345;
+
+    for (size_t i = 0; i < REFERENCE_CODES; i++)
+    {
+        const size_t n = i / REFERENCE_CHANNELS;
+        const double amplitude = (i % REFERENCE_CHANNELS) ? 1500.0 : 400.0;
+
+        noise = noise * 1103515245u + 12345u;
+
+        // Steps every 500 samples, to exercise the transients too.
+        reference_input[i] = (uint16_t)(2048.0 + amplitude * sin(2.0 * M_PI * (double)n / 97.0) + (((n / 500) % 2) ? 300.0 : -300.0) + (double)((noise >> 16) % 64) - 32.0);
+    }
+}
+
+static uint16_t reference_to_code(double value)
+{
+    const double code = floor(value + 0.5);
+
+    return code < 0.0 ? 0 : (code > 65535.0 ? 65535 : (uint16_t)code);
+}
+
+static void reference_filter(mcp320x_filter_stage_config_t const *stage, uint16_t const *input, uint16_t *output, size_t count)
+{
+    for (size_t channel = 0; channel < REFERENCE_CHANNELS; channel++)
+    {
+        double history[MCP320X_FILTER_TAPS_MAX];
+        double y1 = 0.0;
+        double y2 = 0.0;
+
+        for (size_t i = channel; i < count; i += REFERENCE_CHANNELS)
+        {
+            const double x = input[i];
+            double y = 0.0;
+
+            if (i == channel)
+            {
+                for (size_t k = 0; k < MCP320X_FILTER_TAPS_MAX; k++)
+                {
+                    history[k] = x;
+                }
+
+                y1 = y2 = x;
+            }
+
+            switch (stage->type)
+            {
+            case MCP320X_FILTER_EMA:
+                y = y1 + stage->alpha / 32768.0 * (x - y1);
+                y1 = y;
+                break;
+            case MCP320X_FILTER_BOXCAR:
+            case MCP320X_FILTER_FIR:
+                for (size_t k = MCP320X_FILTER_TAPS_MAX - 1; k > 0; k--)
+                {
+                    history[k] = history[k - 1];
+                }
+
+                history[0] = x;
+
+                for (size_t k = 0; k < stage->length; k++)
+                {
+                    y += history[k] * (stage->type == MCP320X_FILTER_BOXCAR ? 1.0 / stage->length : stage->coefficients[k] / 32768.0);
+                }
+                break;
+            default:
+                y = (stage->coefficients[0] * x + stage->coefficients[1] * history[0] + stage->coefficients[2] * history[1] - stage->coefficients[3] * y1 - stage->coefficients[4] * y2) / 32768.0;
+                history[1] = history[0];
+                history[0] = x;
+                y2 = y1;
+                y1 = y;
+                break;
+            }
+
+            output[i] = reference_to_code(y);
+        }
+    }
+}
+
+static mcp320x_filter_stage_config_t reference_stage(mcp320x_filter_type_t type)
+{
+    mcp320x_filter_stage_config_t stage = {.type = type};
+
+    switch (type)
+    {
+    case MCP320X_FILTER_EMA:
+        stage.alpha = MCP320X_Q15(0.05);
+        break;
+    case MCP320X_FILTER_BOXCAR:
+        stage.length = 10;
+        break;
+    case MCP320X_FILTER_FIR:
+        // Windowed sinc low-pass, cut at fs / 8.
+        stage.length = 15;
+
+        for (int k = 0; k < 15; k++)
+        {
+            const double t = k - 7;
+            const double sinc = t == 0 ? 0.25 : sin(M_PI * t / 4.0) / (M_PI * t);
+            const double hamming = 0.54 - 0.46 * cos(2.0 * M_PI * k / 14.0);
+
+            stage.coefficients[k] = MCP320X_Q15(sinc * hamming);
+        }
+        break;
+    default:
+    {
+        // Butterworth low-pass, cut at fs / 20.
+        const double k = tan(M_PI / 20.0);
+        const double norm = 1.0 / (1.0 + M_SQRT2 * k + k * k);
+
+        stage.coefficients[0] = MCP320X_Q15(k * k * norm);
+        stage.coefficients[1] = MCP320X_Q15(2.0 * k * k * norm);
+        stage.coefficients[2] = MCP320X_Q15(k * k * norm);
+        stage.coefficients[3] = MCP320X_Q15(2.0 * (k * k - 1.0) * norm);
+        stage.coefficients[4] = MCP320X_Q15((1.0 - M_SQRT2 * k + k * k) * norm);
+        break;
+    }
+    }
+
+    return stage;
+}
+
+static void reference_check(mcp320x_filter_type_t type, int tolerance)
+{
+    static mcp320x_filter_t filter;
+    static uint16_t codes[REFERENCE_CODES];
+    static uint16_t expected[REFERENCE_CODES];
+    const mcp320x_filter_config_t config = {
+        .stages = {reference_stage(type)},
+        .stage_count = 1,
+        .channel_count = REFERENCE_CHANNELS};
+    int worst = 0;
+
+    reference_make_input();
+    reference_filter(&config.stages[0], reference_input, expected, REFERENCE_CODES);
+
+    for (size_t i = 0; i < REFERENCE_CODES; i++)
+    {
+        codes[i] = reference_input[i];
+    }
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_filter_init(&filter, &config));
+
+    // Blocks of odd sizes, like partial stream reads.
+    for (size_t i = 0; i < REFERENCE_CODES; i += 333)
+    {
+        const size_t count = REFERENCE_CODES - i < 333 ? REFERENCE_CODES - i : 333;
+
+        TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_filter_process(&filter, &codes[i], count));
+    }
+
+    for (size_t i = 0; i < REFERENCE_CODES; i++)
+    {
+        const int error = abs((int)codes[i] - (int)expected[i]);
+
+        worst = error > worst ? error : worst;
+    }
+
+    TEST_ASSERT_LESS_OR_EQUAL(tolerance, worst);
+}
+
+static void reference_throughput(mcp320x_filter_type_t type, const char *label)
+{
+    static mcp320x_filter_t filter;
+    static uint16_t codes[THROUGHPUT_BLOCK];
+    const mcp320x_filter_config_t config = {
+        .stages = {reference_stage(type)},
+        .stage_count = 1,
+        .channel_count = REFERENCE_CHANNELS};
+    struct timespec start;
+    struct timespec end;
+
+    reference_make_input();
+    mcp320x_filter_init(&filter, &config);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (size_t done = 0; done < THROUGHPUT_CODES; done += THROUGHPUT_BLOCK)
+    {
+        for (size_t i = 0; i < THROUGHPUT_BLOCK; i++)
+        {
+            codes[i] = reference_input[(done + i) % REFERENCE_CODES];
+        }
+
+        mcp320x_filter_process(&filter, codes, THROUGHPUT_BLOCK);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    const double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+    printf("filter %-6s: %6.1f Mcodes/s on the host\n", label, THROUGHPUT_CODES / seconds / 1e6);
+}
+
+TEST_CASE("EMA filter matches double precision", "[filter][sim]")
+{
+    reference_check(MCP320X_FILTER_EMA, 1);
+}
+
+TEST_CASE("Boxcar filter matches double precision", "[filter][sim]")
+{
+    reference_check(MCP320X_FILTER_BOXCAR, 1);
+}
+
+TEST_CASE("FIR filter matches double precision", "[filter][sim]")
+{
+    reference_check(MCP320X_FILTER_FIR, 1);
+}
+
+TEST_CASE("Biquad filter matches double precision", "[filter][sim]")
+{
+    reference_check(MCP320X_FILTER_BIQUAD, 2);
+}
+
+TEST_CASE("Filter throughput", "[filter][sim]")
+{
+    reference_throughput(MCP320X_FILTER_EMA, "ema");
+    reference_throughput(MCP320X_FILTER_BOXCAR, "boxcar");
+    reference_throughput(MCP320X_FILTER_FIR, "fir");
+    reference_throughput(MCP320X_FILTER_BIQUAD, "biquad");
+}
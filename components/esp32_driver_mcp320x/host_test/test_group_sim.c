@@ -0,0 +1,83 @@
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "esp_timer.h"
+#include "sim/mcp320x_sim.h"
+#include "esp32_driver_mcp320x/mcp320x_group.h"
+
+// Four MCP3208 on one bus, as on the boards the group was made for: 32
+// channels per pass.
+
+#define GROUP_DEVICES 4
+#define GROUP_CS_FIRST GPIO_NUM_12
+
+static int32_t group_millivolts(int device, int channel)
+{
+    // Every channel of every device has its own code.
+    return 100 + 150 * (device * MCP320X_CHANNEL_COUNT_MAX + channel);
+}
+
+TEST_CASE("Group scans many devices on one bus", "[group][sim]")
+{
+    mcp320x_sim_t *sims[GROUP_DEVICES];
+    mcp320x_config_t configs[GROUP_DEVICES];
+    uint16_t values[GROUP_DEVICES][MCP320X_CHANNEL_COUNT_MAX];
+    uint16_t sequential[GROUP_DEVICES][MCP320X_CHANNEL_COUNT_MAX];
+    mcp320x_sim_stats_t stats[GROUP_DEVICES];
+
+    for (int device = 0; device < GROUP_DEVICES; device++)
+    {
+        sims[device] = mcp320x_sim_create(MCP3208_MODEL, 5000);
+
+        for (int channel = 0; channel < MCP320X_CHANNEL_COUNT_MAX; channel++)
+        {
+            mcp320x_sim_set_voltage(sims[device], (mcp320x_channel_t)channel, group_millivolts(device, channel));
+        }
+
+        mcp320x_sim_attach(sims[device], SPI3_HOST, (gpio_num_t)(GROUP_CS_FIRST + device));
+
+        configs[device] = (mcp320x_config_t){
+            .host = SPI3_HOST,
+            .cs_io_num = (gpio_num_t)(GROUP_CS_FIRST + device),
+            .device_model = MCP3208_MODEL,
+            .clock_speed_hz = 2 * 1000 * 1000,
+            .reference_voltage = 5000};
+    }
+
+    mcp320x_group_t *group = mcp320x_group_install(configs, GROUP_DEVICES);
+
+    mcp320x_err_t result = mcp320x_group_scan(group, 0xFF, MCP320X_READ_MODE_SINGLE, values);
+
+    for (int device = 0; device < GROUP_DEVICES; device++)
+    {
+        mcp320x_sim_get_stats(sims[device], &stats[device]);
+    }
+
+    // The same channels, one device after the other.
+    for (int device = 0; device < GROUP_DEVICES; device++)
+    {
+        mcp320x_t *handle;
+
+        mcp320x_group_get_device(group, (size_t)device, &handle);
+        mcp320x_scan(handle, 0xFF, MCP320X_READ_MODE_SINGLE, sequential[device]);
+    }
+
+    mcp320x_group_delete(group);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+
+    for (int device = 0; device < GROUP_DEVICES; device++)
+    {
+        TEST_ASSERT_EQUAL(MCP320X_CHANNEL_COUNT_MAX, stats[device].conversions);
+
+        for (int channel = 0; channel < MCP320X_CHANNEL_COUNT_MAX; channel++)
+        {
+            const uint16_t expected = mcp320x_sim_voltage_to_code(sims[device], group_millivolts(device, channel) * 1000);
+
+            TEST_ASSERT_EQUAL(expected, values[device][channel]);
+            TEST_ASSERT_EQUAL(expected, sequential[device][channel]);
+        }
+
+        mcp320x_sim_detach(sims[device]);
+        mcp320x_sim_delete(sims[device]);
+    }
+}
@@ -0,0 +1,143 @@
+#include <pthread.h>
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "sim/mcp320x_sim.h"
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+// Many threads hammering one locked handle, each on its own channel. Without
+// the lock, the shared frame buffers and the bus would mix their conversions.
+
+#define STRESS_CS GPIO_NUM_4
+#define STRESS_THREADS MCP320X_CHANNEL_COUNT_MAX
+#define STRESS_ITERATIONS 300
+
+typedef struct
+{
+    mcp320x_t *handle;
+    mcp320x_channel_t channel;
+    uint16_t expected;
+    uint32_t mismatches;
+    uint32_t errors;
+} stress_worker_t;
+
+static void stress_check(stress_worker_t *worker, mcp320x_err_t result, uint16_t const *values, size_t count)
+{
+    if (result != MCP320X_OK)
+    {
+        worker->errors++;
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (values[i] != worker->expected)
+        {
+            worker->mismatches++;
+        }
+    }
+}
+
+static void *stress_worker(void *arg)
+{
+    stress_worker_t *worker = (stress_worker_t *)arg;
+    const mcp320x_channel_t channels[3] = {worker->channel, worker->channel, worker->channel};
+    const mcp320x_request_t requests[2] = {
+        {.channel = worker->channel, .read_mode = MCP320X_READ_MODE_SINGLE},
+        {.channel = worker->channel, .read_mode = MCP320X_READ_MODE_SINGLE}};
+    uint16_t values[3];
+    mcp320x_err_t result;
+
+    for (int i = 0; i < STRESS_ITERATIONS; i++)
+    {
+        // Mixes every locking path: single, batch, many, sample and an
+        // explicit acquisition with unchecked reads inside.
+        switch (i % 5)
+        {
+        case 0:
+            result = mcp320x_read(worker->handle, worker->channel, MCP320X_READ_MODE_SINGLE, &values[0]);
+            stress_check(worker, result, values, 1);
+            break;
+        case 1:
+            result = mcp320x_read_batch(worker->handle, requests, 2, values);
+            stress_check(worker, result, values, 2);
+            break;
+        case 2:
+            result = mcp320x_read_many(worker->handle, channels, 3, MCP320X_READ_MODE_SINGLE, values);
+            stress_check(worker, result, values, 3);
+            break;
+        case 3:
+            result = mcp320x_sample(worker->handle, worker->channel, MCP320X_READ_MODE_SINGLE, 20, &values[0]);
+            stress_check(worker, result, values, 1);
+            break;
+        default:
+            mcp320x_acquire(worker->handle, portMAX_DELAY);
+            result = mcp320x_read_unchecked(worker->handle, worker->channel, MCP320X_READ_MODE_SINGLE, &values[0]);
+            stress_check(worker, result, values, 1);
+            result = mcp320x_read_unchecked(worker->handle, worker->channel, MCP320X_READ_MODE_SINGLE, &values[0]);
+            stress_check(worker, result, values, 1);
+            mcp320x_release(worker->handle);
+            break;
+        }
+
+        // Poison, so a read that doesn't store is caught.
+        values[0] = values[1] = values[2] = 0xFFFF;
+    }
+
+    return NULL;
+}
+
+TEST_CASE("Locked handle survives many threads", "[lock][stress]")
+{
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3208_MODEL, 5000);
+    mcp320x_config_t config = {
+        .host = SPI3_HOST,
+        .cs_io_num = STRESS_CS,
+        .device_model = MCP3208_MODEL,
+        .clock_speed_hz = 2 * 1000 * 1000,
+        .reference_voltage = 5000,
+        .locked = true};
+    stress_worker_t workers[STRESS_THREADS];
+    pthread_t threads[STRESS_THREADS];
+    mcp320x_lock_stats_t stats;
+
+    mcp320x_sim_attach(sim, SPI3_HOST, STRESS_CS);
+
+    mcp320x_t *handle = mcp320x_install(&config);
+
+    for (int i = 0; i < STRESS_THREADS; i++)
+    {
+        // 500mV steps: every channel has its own code.
+        mcp320x_sim_set_voltage(sim, (mcp320x_channel_t)i, 500 * (i + 1));
+
+        workers[i] = (stress_worker_t){
+            .handle = handle,
+            .channel = (mcp320x_channel_t)i,
+            .expected = mcp320x_sim_voltage_to_code(sim, 500 * 1000 * (i + 1))};
+    }
+
+    for (int i = 0; i < STRESS_THREADS; i++)
+    {
+        pthread_create(&threads[i], NULL, stress_worker, &workers[i]);
+    }
+
+    for (int i = 0; i < STRESS_THREADS; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    mcp320x_get_lock_stats(handle, &stats);
+    mcp320x_delete(handle);
+    mcp320x_sim_detach(sim);
+    mcp320x_sim_delete(sim);
+
+    for (int i = 0; i < STRESS_THREADS; i++)
+    {
+        TEST_ASSERT_EQUAL(0, workers[i].errors);
+        TEST_ASSERT_EQUAL(0, workers[i].mismatches);
+    }
+
+    // One acquisition per iteration: unchecked reads never take the lock.
+    TEST_ASSERT_EQUAL(STRESS_THREADS * STRESS_ITERATIONS, stats.acquisitions);
+    TEST_ASSERT_TRUE(stats.contentions <= stats.acquisitions);
+    TEST_ASSERT_TRUE(stats.wait_max_us <= stats.wait_total_us);
+}
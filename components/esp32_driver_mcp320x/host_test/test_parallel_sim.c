@@ -0,0 +1,157 @@
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/spi_master.h"
+#include "sim/mcp320x_sim.h"
+#include "esp32_driver_mcp320x/mcp320x_parallel.h"
+
+// Two MCP3208 on each SPI host, one worker per host. The workers run on their
+// own threads, so the merge sees them racing as on two cores; the virtual
+// clock of the sim is shared, which keeps the timestamps comparable but does
+// not show the throughput gain of the second bus.
+
+#define PARALLEL_DEVICES 2
+#define PARALLEL_SCANS 400
+
+static const spi_host_device_t parallel_hosts[MCP320X_PARALLEL_WORKERS_MAX] = {SPI3_HOST, SPI2_HOST};
+static const gpio_num_t parallel_cs_first[MCP320X_PARALLEL_WORKERS_MAX] = {GPIO_NUM_12, GPIO_NUM_14};
+
+static int32_t parallel_millivolts(int worker, int device, int channel)
+{
+    // Every channel of every device of every worker has its own code.
+    return 100 + 100 * ((worker * PARALLEL_DEVICES + device) * MCP320X_CHANNEL_COUNT_MAX + channel);
+}
+
+static void parallel_run(uint32_t rate_hz)
+{
+    static mcp320x_parallel_scan_t scans[32];
+    mcp320x_sim_t *sims[MCP320X_PARALLEL_WORKERS_MAX][PARALLEL_DEVICES];
+    mcp320x_group_t *groups[MCP320X_PARALLEL_WORKERS_MAX];
+    size_t per_worker[MCP320X_PARALLEL_WORKERS_MAX] = {0};
+    mcp320x_parallel_stats_t stats;
+    int64_t last_us = INT64_MIN;
+    size_t total = 0;
+
+    spi_bus_config_t bus_cfg = {
+        .mosi_io_num = GPIO_NUM_13,
+        .miso_io_num = GPIO_NUM_12,
+        .sclk_io_num = GPIO_NUM_14,
+        .quadwp_io_num = GPIO_NUM_NC,
+        .quadhd_io_num = GPIO_NUM_NC,
+        .data4_io_num = GPIO_NUM_NC,
+        .data5_io_num = GPIO_NUM_NC,
+        .data6_io_num = GPIO_NUM_NC,
+        .data7_io_num = GPIO_NUM_NC,
+        .max_transfer_sz = 3, // 24 bits.
+        .flags = SPICOMMON_BUSFLAG_MASTER};
+
+    spi_bus_initialize(SPI2_HOST, &bus_cfg, 0);
+
+    mcp320x_parallel_config_t config = {
+        .worker_count = MCP320X_PARALLEL_WORKERS_MAX,
+        .read_mode = MCP320X_READ_MODE_SINGLE,
+        .rate_hz = rate_hz,
+        .ring_capacity = 64,
+        .task_priority = 1};
+
+    for (int worker = 0; worker < MCP320X_PARALLEL_WORKERS_MAX; worker++)
+    {
+        mcp320x_config_t configs[PARALLEL_DEVICES];
+
+        for (int device = 0; device < PARALLEL_DEVICES; device++)
+        {
+            const gpio_num_t cs = (gpio_num_t)(parallel_cs_first[worker] + device);
+
+            sims[worker][device] = mcp320x_sim_create(MCP3208_MODEL, 5000);
+
+            for (int channel = 0; channel < MCP320X_CHANNEL_COUNT_MAX; channel++)
+            {
+                mcp320x_sim_set_voltage(sims[worker][device], (mcp320x_channel_t)channel, parallel_millivolts(worker, device, channel));
+            }
+
+            mcp320x_sim_attach(sims[worker][device], parallel_hosts[worker], cs);
+
+            configs[device] = (mcp320x_config_t){
+                .host = parallel_hosts[worker],
+                .cs_io_num = cs,
+                .device_model = MCP3208_MODEL,
+                .clock_speed_hz = 2 * 1000 * 1000,
+                .reference_voltage = 5000};
+        }
+
+        groups[worker] = mcp320x_group_install(configs, PARALLEL_DEVICES);
+
+        config.workers[worker] = (mcp320x_parallel_worker_config_t){
+            .group = groups[worker],
+            .channel_mask = 0xFF,
+            .task_core = worker};
+    }
+
+    mcp320x_parallel_t *parallel = mcp320x_parallel_start(&config);
+
+    TEST_ASSERT_NOT_NULL(parallel);
+
+    while (total < PARALLEL_SCANS)
+    {
+        size_t read_count = 0;
+
+        TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_parallel_read(parallel, scans, 32, &read_count));
+
+        for (size_t i = 0; i < read_count; i++)
+        {
+            const int worker = scans[i].worker;
+
+            // The merged stream never goes back in time, whichever worker the scan came from.
+            TEST_ASSERT_TRUE(scans[i].timestamp_us >= last_us);
+            TEST_ASSERT_TRUE(worker < MCP320X_PARALLEL_WORKERS_MAX);
+
+            for (int device = 0; device < PARALLEL_DEVICES; device++)
+            {
+                for (int channel = 0; channel < MCP320X_CHANNEL_COUNT_MAX; channel++)
+                {
+                    const uint16_t expected = mcp320x_sim_voltage_to_code(sims[worker][device], parallel_millivolts(worker, device, channel) * 1000);
+
+                    TEST_ASSERT_EQUAL(expected, scans[i].values[device][channel]);
+                }
+            }
+
+            last_us = scans[i].timestamp_us;
+            per_worker[worker]++;
+        }
+
+        total += read_count;
+
+        vTaskDelay(1);
+    }
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_parallel_get_stats(parallel, &stats));
+    TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_parallel_stop(parallel));
+
+    TEST_ASSERT_EQUAL(0, stats.errors);
+    TEST_ASSERT_GREATER_THAN(0, per_worker[0]);
+    TEST_ASSERT_GREATER_THAN(0, per_worker[1]);
+
+    for (int worker = 0; worker < MCP320X_PARALLEL_WORKERS_MAX; worker++)
+    {
+        mcp320x_group_delete(groups[worker]);
+
+        for (int device = 0; device < PARALLEL_DEVICES; device++)
+        {
+            mcp320x_sim_detach(sims[worker][device]);
+            mcp320x_sim_delete(sims[worker][device]);
+        }
+    }
+
+    spi_bus_free(SPI2_HOST);
+}
+
+TEST_CASE("Parallel merges workers back-to-back in time order", "[parallel][sim]")
+{
+    parallel_run(0);
+}
+
+TEST_CASE("Parallel merges workers at fixed rate in time order", "[parallel][sim]")
+{
+    parallel_run(2000);
+}
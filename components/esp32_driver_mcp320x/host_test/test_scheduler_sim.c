@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "esp_timer.h"
+#include "sim/mcp320x_sim.h"
+#include "esp32_driver_mcp320x/mcp320x_scheduler.h"
+
+// Three channels of a simulated MCP3208: a fast current (sine), a slow
+// voltage (ramp) and a temperature (constant). Same weights to start with:
+// the adaptation should move the bus time to the current. Prints the
+// effective rate of each channel, against the virtual clock of the bus.
+
+#define SCHEDULER_CS GPIO_NUM_22
+#define SCHEDULER_CONVERSIONS 20000
+#define SCHEDULER_SLOTS 3
+
+static const char *const SCHEDULER_LABELS[SCHEDULER_SLOTS] = {"current", "voltage", "temperature"};
+
+static void scheduler_run(mcp320x_scheduler_config_t const *config, const char *label, mcp320x_scheduler_stats_t *stats)
+{
+    static uint8_t slots[SCHEDULER_CONVERSIONS];
+    static uint16_t values[SCHEDULER_CONVERSIONS];
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3208_MODEL, 5000);
+    const mcp320x_sim_waveform_t waveforms[SCHEDULER_SLOTS] = {
+        {.type = MCP320X_SIM_WAVEFORM_SINE, .offset_uv = 2500000, .amplitude_uv = 2000000, .frequency_hz = 500, .noise_uv = 5000},
+        {.type = MCP320X_SIM_WAVEFORM_RAMP, .offset_uv = 3300000, .amplitude_uv = 20000, .frequency_hz = 10, .noise_uv = 5000},
+        {.type = MCP320X_SIM_WAVEFORM_CONSTANT, .offset_uv = 1200000, .noise_uv = 2000}};
+    const mcp320x_config_t device_config = {
+        .host = SPI3_HOST,
+        .cs_io_num = SCHEDULER_CS,
+        .device_model = MCP3208_MODEL,
+        .clock_speed_hz = 2 * 1000 * 1000,
+        .reference_voltage = 5000};
+    mcp320x_scheduler_t scheduler;
+
+    for (int i = 0; i < SCHEDULER_SLOTS; i++)
+    {
+        mcp320x_sim_set_waveform(sim, (mcp320x_channel_t)i, &waveforms[i]);
+    }
+
+    mcp320x_sim_attach(sim, SPI3_HOST, SCHEDULER_CS);
+
+    mcp320x_t *handle = mcp320x_install(&device_config);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_scheduler_init(&scheduler, config));
+
+    const int64_t start_us = esp_timer_get_time();
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_scheduler_read(&scheduler, handle, slots, values, SCHEDULER_CONVERSIONS));
+
+    const int64_t elapsed_us = esp_timer_get_time() - start_us;
+
+    mcp320x_scheduler_get_stats(&scheduler, stats);
+
+    mcp320x_delete(handle);
+    mcp320x_sim_detach(sim);
+    mcp320x_sim_delete(sim);
+
+    printf("scheduler %s, %lu conversions/s:\n", label, (unsigned long)(SCHEDULER_CONVERSIONS * 1000000LL / elapsed_us));
+
+    for (int i = 0; i < SCHEDULER_SLOTS; i++)
+    {
+        printf("  %-11s weight %2u, %5.1f%% of the bus, %7lu Hz\n",
+               SCHEDULER_LABELS[i],
+               stats->weights[i],
+               100.0 * stats->conversions[i] / SCHEDULER_CONVERSIONS,
+               (unsigned long)(stats->conversions[i] * 1000000LL / elapsed_us));
+    }
+}
+
+static mcp320x_scheduler_config_t scheduler_config(mcp320x_scheduler_policy_t policy, uint16_t window)
+{
+    mcp320x_scheduler_config_t config = {
+        .slot_count = SCHEDULER_SLOTS,
+        .policy = policy,
+        .window = window,
+        .variance_high = 2000, // Codes²: about 45 codes of standard deviation.
+        .variance_low = 100};
+
+    for (int i = 0; i < SCHEDULER_SLOTS; i++)
+    {
+        config.slots[i] = (mcp320x_scheduler_slot_config_t){
+            .request = {.channel = (mcp320x_channel_t)i, .read_mode = MCP320X_READ_MODE_SINGLE},
+            .weight = 4,
+            .weight_min = 1,
+            .weight_max = 32};
+    }
+
+    return config;
+}
+
+TEST_CASE("Scheduler with fixed weights shares the bus evenly", "[scheduler][sim]")
+{
+    const mcp320x_scheduler_config_t config = scheduler_config(MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN, 0);
+    mcp320x_scheduler_stats_t stats;
+
+    scheduler_run(&config, "fixed", &stats);
+
+    for (int i = 0; i < SCHEDULER_SLOTS; i++)
+    {
+        TEST_ASSERT_UINT32_WITHIN(1, SCHEDULER_CONVERSIONS / SCHEDULER_SLOTS, stats.conversions[i]);
+    }
+}
+
+TEST_CASE("Scheduler adapts weighted round-robin to the signals", "[scheduler][sim]")
+{
+    const mcp320x_scheduler_config_t config = scheduler_config(MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN, 32);
+    mcp320x_scheduler_stats_t stats;
+
+    scheduler_run(&config, "adaptive round-robin", &stats);
+
+    TEST_ASSERT_EQUAL(32, stats.weights[0]);
+    TEST_ASSERT_EQUAL(1, stats.weights[2]);
+    TEST_ASSERT_GREATER_THAN(10 * stats.conversions[2], stats.conversions[0]);
+}
+
+TEST_CASE("Scheduler adapts earliest deadline to the signals", "[scheduler][sim]")
+{
+    const mcp320x_scheduler_config_t config = scheduler_config(MCP320X_SCHEDULER_POLICY_EARLIEST_DEADLINE, 32);
+    mcp320x_scheduler_stats_t stats;
+
+    scheduler_run(&config, "adaptive earliest deadline", &stats);
+
+    TEST_ASSERT_EQUAL(32, stats.weights[0]);
+    TEST_ASSERT_EQUAL(1, stats.weights[2]);
+    TEST_ASSERT_GREATER_THAN(10 * stats.conversions[2], stats.conversions[0]);
+}
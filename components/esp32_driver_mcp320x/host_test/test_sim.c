@@ -0,0 +1,113 @@
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "sim/mcp320x_sim.h"
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+// Tests of the simulated device itself. The driver tests run against it from
+// main.c; these make sure it behaves like the datasheet says.
+
+static uint16_t sim_convert(mcp320x_sim_t *sim, uint8_t const *tx, size_t bits, uint32_t clock_hz, int64_t start_ns)
+{
+    uint8_t rx[3] = {0};
+
+    mcp320x_sim_transfer(sim, tx, rx, bits, clock_hz, start_ns);
+
+    // The last clock carries B0, whatever the number of leading zeros.
+    const uint32_t word = ((uint32_t)rx[0] << 16) | ((uint32_t)rx[1] << 8) | rx[2];
+
+    return (uint16_t)((word >> (24 - bits)) & 0xFFF);
+}
+
+TEST_CASE("Simulator decodes single-ended command", "[sim]")
+{
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3208_MODEL, 5000);
+    const uint8_t tx[3] = {0x80 | (1 << 6) | (5 << 3), 0, 0};
+
+    mcp320x_sim_set_voltage(sim, MCP320X_CHANNEL_5, 1250);
+
+    const uint16_t code = sim_convert(sim, tx, 19, 1000000, 0);
+
+    mcp320x_sim_delete(sim);
+
+    TEST_ASSERT_EQUAL(1024, code);
+}
+
+TEST_CASE("Simulator decodes differential command", "[sim]")
+{
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3204_MODEL, 5000);
+    const uint8_t positive[3] = {0x80 | (3 << 3), 0, 0};
+    const uint8_t negative[3] = {0x80 | (2 << 3), 0, 0};
+
+    mcp320x_sim_set_voltage(sim, MCP320X_CHANNEL_2, 1000);
+    mcp320x_sim_set_voltage(sim, MCP320X_CHANNEL_3, 2250);
+
+    const uint16_t positive_code = sim_convert(sim, positive, 19, 1000000, 0);
+    const uint16_t negative_code = sim_convert(sim, negative, 19, 1000000, 0);
+
+    mcp320x_sim_delete(sim);
+
+    TEST_ASSERT_EQUAL(1024, positive_code);
+    TEST_ASSERT_EQUAL(0, negative_code);
+}
+
+TEST_CASE("Simulator ignores leading zeros", "[sim]")
+{
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3204_MODEL, 5000);
+
+    // 8-bit MCU framing: 5 leading zeros, 24 clocks.
+    const uint8_t tx[3] = {0b00000110, 0b11000000, 0};
+
+    mcp320x_sim_set_voltage(sim, MCP320X_CHANNEL_3, 2500);
+
+    const uint16_t code = sim_convert(sim, tx, 24, 1000000, 0);
+
+    mcp320x_sim_delete(sim);
+
+    TEST_ASSERT_EQUAL(2048, code);
+}
+
+TEST_CASE("Simulator models conversion timing", "[sim]")
+{
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3204_MODEL, 5000);
+    const uint8_t tx[3] = {0x80 | (1 << 6), 0, 0};
+    mcp320x_sim_stats_t stats;
+
+    mcp320x_sim_set_voltage(sim, MCP320X_CHANNEL_0, 2500);
+
+    const uint16_t fast_code = sim_convert(sim, tx, 19, 1000000, 0);
+    const uint16_t slow_code = sim_convert(sim, tx, 19, MCP320X_CLOCK_MIN_HZ / 10, 0);
+    sim_convert(sim, tx, 10, 1000000, 0);
+
+    mcp320x_sim_get_stats(sim, &stats);
+    mcp320x_sim_delete(sim);
+
+    TEST_ASSERT_EQUAL(3, stats.frames);
+    TEST_ASSERT_EQUAL(2, stats.conversions);
+    TEST_ASSERT_EQUAL(1, stats.incomplete);
+    TEST_ASSERT_EQUAL(1, stats.slow_clock);
+    TEST_ASSERT_EQUAL(19000 + 19 * 1000000 / (MCP320X_CLOCK_MIN_HZ / 10) * 1000 + 10000, stats.bus_time_ns);
+    TEST_ASSERT_EQUAL(2048, fast_code);
+    TEST_ASSERT_LESS_THAN(fast_code, slow_code);
+}
+
+TEST_CASE("Simulator generates waveforms", "[sim]")
+{
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3204_MODEL, 5000);
+    const uint8_t tx[3] = {0x80 | (1 << 6), 0, 0};
+    const mcp320x_sim_waveform_t sine = {
+        .type = MCP320X_SIM_WAVEFORM_SINE,
+        .offset_uv = 2500000,
+        .amplitude_uv = 2000000,
+        .frequency_hz = 1000};
+
+    mcp320x_sim_set_waveform(sim, MCP320X_CHANNEL_0, &sine);
+
+    // The input is sampled 6 clocks (6us) after the CS falling edge.
+    const uint16_t peak = sim_convert(sim, tx, 19, 1000000, 250000 - 6000);
+    const uint16_t trough = sim_convert(sim, tx, 19, 1000000, 750000 - 6000);
+
+    mcp320x_sim_delete(sim);
+
+    TEST_ASSERT_INT16_WITHIN(1, 3686, peak);
+    TEST_ASSERT_INT16_WITHIN(1, 409, trough);
+}
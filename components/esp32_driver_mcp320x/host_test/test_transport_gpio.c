@@ -0,0 +1,56 @@
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "sim/mcp320x_sim.h"
+#include "esp32_driver_mcp320x/mcp320x.h"
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+
+// The bit-bang transport needs a device on free GPIOs, which the target test
+// setup doesn't have: it is tested against a simulated device here.
+
+#define GPIO_TEST_CS GPIO_NUM_12
+#define GPIO_TEST_SCLK GPIO_NUM_13
+#define GPIO_TEST_MOSI GPIO_NUM_14
+#define GPIO_TEST_MISO GPIO_NUM_15
+
+TEST_CASE("Can read with gpio transport", "[transport]")
+{
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3208_MODEL, 5000);
+    mcp320x_transport_gpio_config_t pins = {
+        .sclk_io_num = GPIO_TEST_SCLK,
+        .mosi_io_num = GPIO_TEST_MOSI,
+        .miso_io_num = GPIO_TEST_MISO};
+    mcp320x_config_t config = {
+        .cs_io_num = GPIO_TEST_CS,
+        .device_model = MCP3208_MODEL,
+        .clock_speed_hz = 1000000,
+        .reference_voltage = 5000,
+        .transport = &mcp320x_transport_gpio,
+        .transport_config = &pins};
+    mcp320x_sim_stats_t stats;
+    uint16_t value = 0;
+    uint16_t values[MCP320X_CHANNEL_COUNT_MAX] = {0};
+    uint32_t frequency = 0;
+
+    mcp320x_sim_set_voltage(sim, MCP320X_CHANNEL_6, 1250);
+    mcp320x_sim_set_voltage(sim, MCP320X_CHANNEL_7, 3750);
+    mcp320x_sim_attach_gpio(sim, GPIO_TEST_CS, GPIO_TEST_SCLK, GPIO_TEST_MOSI, GPIO_TEST_MISO);
+
+    mcp320x_t *handle = mcp320x_install(&config);
+    mcp320x_err_t read_result = mcp320x_read(handle, MCP320X_CHANNEL_6, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_err_t scan_result = mcp320x_scan(handle, 0b11000000, MCP320X_READ_MODE_SINGLE, values);
+    mcp320x_get_actual_freq(handle, &frequency);
+    mcp320x_delete(handle);
+
+    mcp320x_sim_get_stats(sim, &stats);
+    mcp320x_sim_detach(sim);
+    mcp320x_sim_delete(sim);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, read_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, scan_result);
+    TEST_ASSERT_EQUAL(1024, value);
+    TEST_ASSERT_EQUAL(1024, values[MCP320X_CHANNEL_6]);
+    TEST_ASSERT_EQUAL(3072, values[MCP320X_CHANNEL_7]);
+    TEST_ASSERT_EQUAL(3, stats.conversions);
+    TEST_ASSERT_EQUAL(0, stats.incomplete);
+    TEST_ASSERT_EQUAL(1000000, frequency);
+}
@@ -0,0 +1,138 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "sim/mcp320x_sim.h"
+#include "esp32_driver_mcp320x/mcp320x_units.h"
+#include "units_thermistor_10k.h"
+
+// A 10K NTC (beta 3950) under a 10K resistor on a simulated MCP3208, swept
+// from -20C to 100C. The generated table, 257 entries interpolated, against
+// the beta equation in float per code, the way it's done without the table.
+// Also reports the throughput of both on the host, which only compares them
+// with each other: the target computes logf in software, far slower.
+
+#define UNITS_CS GPIO_NUM_22
+#define UNITS_STEPS 25
+#define UNITS_READS 64
+#define UNITS_THROUGHPUT_CODES (1000 * 1000)
+#define UNITS_THROUGHPUT_BLOCK 256
+
+static float units_thermistor_celsius(uint16_t code)
+{
+    const float resistance = 10000.0f * code / (4096.0f - code);
+
+    return 1.0f / (1.0f / 298.15f + logf(resistance / 10000.0f) / 3950.0f) - 273.15f;
+}
+
+static int32_t units_thermistor_microvolts(double celsius)
+{
+    const double resistance = 10000.0 * exp(3950.0 * (1.0 / (celsius + 273.15) - 1.0 / 298.15));
+
+    return (int32_t)(5000000.0 * resistance / (resistance + 10000.0));
+}
+
+TEST_CASE("Can convert simulated thermistor to Celsius", "[units][sim]")
+{
+    mcp320x_sim_t *sim = mcp320x_sim_create(MCP3208_MODEL, 5000);
+    const mcp320x_config_t device_config = {
+        .host = SPI3_HOST,
+        .cs_io_num = UNITS_CS,
+        .device_model = MCP3208_MODEL,
+        .clock_speed_hz = 2 * 1000 * 1000,
+        .reference_voltage = 5000};
+    mcp320x_units_t units;
+    uint16_t codes[UNITS_READS];
+    int32_t values[UNITS_READS];
+    int32_t worst = 0;
+
+    mcp320x_sim_attach(sim, SPI3_HOST, UNITS_CS);
+
+    mcp320x_t *handle = mcp320x_install(&device_config);
+
+    mcp320x_units_init(&units);
+    TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_units_set_table(&units, MCP320X_CHANNEL_5, units_thermistor_10k, UNITS_THERMISTOR_10K_SIZE));
+
+    for (int step = 0; step < UNITS_STEPS; step++)
+    {
+        const double celsius = -20.0 + step * 5.0;
+        const mcp320x_sim_waveform_t waveform = {
+            .type = MCP320X_SIM_WAVEFORM_CONSTANT,
+            .offset_uv = units_thermistor_microvolts(celsius),
+            .noise_uv = 4000};
+
+        mcp320x_sim_set_waveform(sim, MCP320X_CHANNEL_5, &waveform);
+
+        for (int i = 0; i < UNITS_READS; i++)
+        {
+            TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_read(handle, MCP320X_CHANNEL_5, MCP320X_READ_MODE_SINGLE, &codes[i]));
+        }
+
+        TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_units_convert(&units, MCP320X_CHANNEL_5, codes, values, UNITS_READS));
+
+        for (int i = 0; i < UNITS_READS; i++)
+        {
+            const int32_t reference = (int32_t)lroundf(units_thermistor_celsius(codes[i]) * 1000.0f);
+            const int32_t error = abs(values[i] - reference);
+
+            worst = error > worst ? error : worst;
+        }
+    }
+
+    mcp320x_delete(handle);
+    mcp320x_sim_detach(sim);
+    mcp320x_sim_delete(sim);
+
+    printf("units thermistor worst error against the equation, -20C to 100C: %ld mC\n", (long)worst);
+
+    TEST_ASSERT_LESS_THAN_INT32(50, worst);
+}
+
+TEST_CASE("Can report units throughput", "[units][sim]")
+{
+    mcp320x_units_t units;
+    uint16_t codes[UNITS_THROUGHPUT_BLOCK];
+    int32_t values[UNITS_THROUGHPUT_BLOCK];
+    float celsius[UNITS_THROUGHPUT_BLOCK];
+    volatile float sink = 0.0f;
+
+    for (int i = 0; i < UNITS_THROUGHPUT_BLOCK; i++)
+    {
+        codes[i] = (uint16_t)(400 + i * 13);
+    }
+
+    mcp320x_units_init(&units);
+    mcp320x_units_set_table(&units, MCP320X_CHANNEL_5, units_thermistor_10k, UNITS_THERMISTOR_10K_SIZE);
+
+    clock_t start = clock();
+
+    for (int done = 0; done < UNITS_THROUGHPUT_CODES; done += UNITS_THROUGHPUT_BLOCK)
+    {
+        mcp320x_units_convert(&units, MCP320X_CHANNEL_5, codes, values, UNITS_THROUGHPUT_BLOCK);
+        sink += (float)values[done % UNITS_THROUGHPUT_BLOCK];
+    }
+
+    const double table_s = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+
+    for (int done = 0; done < UNITS_THROUGHPUT_CODES; done += UNITS_THROUGHPUT_BLOCK)
+    {
+        for (int i = 0; i < UNITS_THROUGHPUT_BLOCK; i++)
+        {
+            celsius[i] = units_thermistor_celsius(codes[i]);
+        }
+
+        sink += celsius[done % UNITS_THROUGHPUT_BLOCK];
+    }
+
+    const double equation_s = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("units throughput: table %.1f Mcodes/s, equation %.1f Mcodes/s\n",
+           UNITS_THROUGHPUT_CODES / 1e6 / (table_s > 0 ? table_s : 1e-9),
+           UNITS_THROUGHPUT_CODES / 1e6 / (equation_s > 0 ? equation_s : 1e-9));
+
+    TEST_ASSERT_TRUE(sink != 0.0f);
+}
@@ -1,6 +1,8 @@
 #ifndef __ESP32_DRIVER_MCP320X_MCP320X_H__
 #define __ESP32_DRIVER_MCP320X_MCP320X_H__
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
@@ -17,6 +19,12 @@ extern "C"
 #define MCP320X_CLOCK_MAX_HZ (2 * 1000 * 1000) /** @brief Maximum clock speed supported = 2Mhz at 5V. */
 #define MCP320X_REF_VOLTAGE_MIN 250            /** @brief Minimum reference voltage, in mV = 250mV. */
 #define MCP320X_REF_VOLTAGE_MAX 7000           /** @brief Maximum reference voltage, in mV = 7000mV. The max safe voltage is 5000mV. */
+#define MCP320X_BATCH_QUEUE_SIZE 16            /** @brief Maximum number of transactions queued back-to-back by batch reads. */
+#define MCP320X_CHANNEL_COUNT_MAX 8            /** @brief Number of channels of the biggest model (MCP3208). */
+#define MCP320X_OVERSAMPLE_BITS_MAX 4          /** @brief Maximum extra bits of oversampled reads: 16 bits from 4^4 = 256 samples. */
+#define MCP320X_PREPARED_SIZE 64               /** @brief Bytes reserved for the transport on a prepared read; same as MCP320X_TRANSPORT_PREPARED_SIZE. */
+#define MCP320X_SAMPLE_STATS_STACK_SIZE 64     /** @brief Maximum samples of @ref mcp320x_sample_stats without a caller buffer: kept on the stack. */
+#define MCP320X_SAMPLE_STATS_TRIM_MAX 49       /** @brief Maximum percent trimmed from each end for the trimmed mean. */
 
     // Result codes
 
@@ -25,9 +33,13 @@ extern "C"
 #define MCP320X_ERR_INVALID_HANDLE 10       /** @brief Failure: invalid handle. */
 #define MCP320X_ERR_INVALID_VALUE_HANDLE 11 /** @brief Failure: invalid value handle. */
 #define MCP320X_ERR_INVALID_SAMPLE_COUNT 12 /** @brief Failure: invalid sample count. */
+#define MCP320X_ERR_INVALID_CONFIG 13       /** @brief Failure: invalid configuration. */
 #define MCP320X_ERR_INVALID_CHANNEL 20      /** @brief Failure: invalid channel. */
 #define MCP320X_ERR_SPI_BUS 30              /** @brief Failure: error communicating with SPI bus. */
 #define MCP320X_ERR_SPI_BUS_ACQUIRE 31      /** @brief Failure: error communicating with SPI bus to acquire it. */
+#define MCP320X_ERR_INVALID_STATE 40        /** @brief Failure: operation not allowed on the current state. */
+#define MCP320X_ERR_NO_MEMORY 41            /** @brief Failure: not enough memory. */
+#define MCP320X_ERR_TIMEOUT 42              /** @brief Failure: the operation did not complete in time. */
 
     /**
      * @typedef mcp320x_err_t
@@ -41,6 +53,12 @@ extern "C"
      */
     typedef struct mcp320x_t mcp320x_t;
 
+    /**
+     * @typedef mcp320x_transport_t
+     * @brief Transport used to talk to the device, see mcp320x_transport.h.
+     */
+    typedef struct mcp320x_transport_t mcp320x_transport_t;
+
     /**
      * @typedef mcp320x_model_t
      * @brief MCP320X model.
@@ -77,28 +95,82 @@ extern "C"
         MCP320X_READ_MODE_SINGLE = 1
     } mcp320x_read_mode_t;
 
+    /**
+     * @typedef mcp320x_request_t
+     * @brief A single conversion request used by batch reads.
+     */
+    typedef struct
+    {
+        mcp320x_channel_t channel;     /** @brief Channel to read from. */
+        mcp320x_read_mode_t read_mode; /** @brief Read mode. */
+    } mcp320x_request_t;
+
+    /**
+     * @typedef mcp320x_prepared_t
+     * @brief A single conversion request encoded once, to be read many times with @ref mcp320x_read_prepared.
+     * @details Owned by the caller, who chooses where it lives: a static one can be placed in internal
+     * memory with DRAM_ATTR. All fields are private.
+     */
+    typedef struct
+    {
+        mcp320x_t *handle;                             /** @brief Device the request was prepared for. */
+        uint8_t tx[4];                                 /** @brief Encoded frame. */
+        uint64_t transport[MCP320X_PREPARED_SIZE / 8]; /** @brief Transport specific transfer, built once. */
+    } mcp320x_prepared_t;
+
+    /**
+     * @typedef mcp320x_sample_stats_t
+     * @brief Robust statistics of a set of digital codes.
+     */
+    typedef struct
+    {
+        uint16_t count;         /** @brief Number of codes. */
+        uint16_t min;           /** @brief Smallest code. */
+        uint16_t max;           /** @brief Biggest code. */
+        uint16_t mean;          /** @brief Mean, rounded to the nearest code. */
+        uint16_t median;        /** @brief Median, rounded to the nearest code when the count is even. */
+        uint16_t trimmed_mean;  /** @brief Mean without the trimmed codes on each end, rounded to the nearest code. */
+        uint32_t variance;      /** @brief Population variance, in codes^2, rounded to the nearest. */
+        uint32_t stddev_mcodes; /** @brief Population standard deviation, in thousandths of a code. */
+    } mcp320x_sample_stats_t;
+
+    /**
+     * @typedef mcp320x_lock_stats_t
+     * @brief Contention of the internal lock of a locked handle.
+     */
+    typedef struct
+    {
+        uint32_t acquisitions;  /** @brief Times the lock was taken, nested takes included. */
+        uint32_t contentions;   /** @brief Acquisitions that had to wait for another task. */
+        uint32_t wait_max_us;   /** @brief Longest wait for the lock, in microseconds. */
+        uint64_t wait_total_us; /** @brief Sum of all waits for the lock, in microseconds. */
+    } mcp320x_lock_stats_t;
+
     /**
      * @typedef mcp320x_config_t
      * @brief Configuration for a MCP320X IC.
      */
     typedef struct
     {
-        spi_host_device_t host;       /** @brief SPI peripheral used to communicate with the device. */
-        gpio_num_t cs_io_num;         /** @brief GPIO pin used for Chip Select (CS). */
-        mcp320x_model_t device_model; /** @brief MCP320X model used with this configuration. */
-        uint32_t clock_speed_hz;      /** @brief Clock speed, in Hz. Recommended the use of divisors of 80MHz. */
-        uint16_t reference_voltage;   /** @brief Reference voltage, in millivolts. */
+        spi_host_device_t host;               /** @brief SPI peripheral used to communicate with the device. */
+        gpio_num_t cs_io_num;                 /** @brief GPIO pin used for Chip Select (CS). */
+        mcp320x_model_t device_model;         /** @brief MCP320X model used with this configuration. */
+        uint32_t clock_speed_hz;              /** @brief Clock speed, in Hz. Recommended the use of divisors of 80MHz. */
+        uint16_t reference_voltage;           /** @brief Reference voltage, in millivolts. */
+        mcp320x_transport_t const *transport; /** @brief Transport; NULL uses the SPI master, queued (mcp320x_transport_spi_queued). */
+        void *transport_config;               /** @brief Transport specific configuration, if the transport requires one. */
+        bool locked;                          /** @brief Serialize the calls on the handle with an internal mutex, so many tasks can share it. */
     } mcp320x_config_t;
 
     /**
-     * @brief Add a MCP320X device to an already configured SPI bus.
+     * @brief Add a MCP320X device to an already configured SPI bus, or to the configured transport.
      * @param[in] config Pointer to a @ref mcp320x_config_t struct specifying how the device should be initialized.
      * @return Valid pointer, otherwise NULL.
      */
     mcp320x_t *mcp320x_install(mcp320x_config_t const *config);
 
     /**
-     * @brief Remove a MCP320X device from a SPI bus.
+     * @brief Remove a MCP320X device from a SPI bus, or from the configured transport.
      * @param[in] handle MCP320X handle.
      * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
      */
@@ -106,18 +178,21 @@ extern "C"
 
     /**
      * @brief Occupy the SPI bus for continuous readings.
+     * @details Calls nest: only the first one occupies the bus. On a locked handle, the lock is also held until the
+     * bus is released, so the calling task can read many times while the others wait.
      * @note The bus must be released using the @ref mcp320x_release function.
-     * @note This function is not thread safe when multiple tasks access the same SPI device.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
      * @param[in] handle MCP320X handle.
-     * @param[in] timeout Time to wait before the bus is occupied by the device. Currently MUST BE set to portMAX_DELAY.
+     * @param[in] timeout Time to wait for the lock and the bus. The bus currently MUST BE waited with portMAX_DELAY.
      * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
      */
     mcp320x_err_t mcp320x_acquire(mcp320x_t *handle, TickType_t timeout);
 
     /**
      * @brief Release the SPI bus occupied by the ADC. All other devices on the bus can start sending transactions.
+     * @details Releases the bus, and the lock of a locked handle, on the call matching the first @ref mcp320x_acquire.
      * @note The bus must be acquired using the @ref mcp320x_acquire function.
-     * @note This function is not thread safe when multiple tasks access the same SPI device.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
      * @param[in] handle MCP320X handle.
      * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
      */
@@ -131,9 +206,25 @@ extern "C"
      */
     mcp320x_err_t mcp320x_get_actual_freq(mcp320x_t *handle, uint32_t *frequency_hz);
 
+    /**
+     * @brief Get the capabilities of the transport, so callers can choose the fastest path.
+     * @param[in] handle MCP320X handle.
+     * @param[out] capabilities Pointer to where the MCP320X_TRANSPORT_CAP_* flags will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_get_capabilities(mcp320x_t *handle, uint32_t *capabilities);
+
+    /**
+     * @brief Get the contention of the internal lock.
+     * @param[in] handle MCP320X handle, installed with \p locked.
+     * @param[out] stats Pointer to where the statistics will be stored.
+     * @return MCP320X_OK when success, MCP320X_ERR_INVALID_STATE when the handle is not locked, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_get_lock_stats(mcp320x_t *handle, mcp320x_lock_stats_t *stats);
+
     /**
      * @brief Read a digital code from 0 to 4096 (MCP320X_RESOLUTION).
-     * @note This function is not thread safe when multiple tasks access the same SPI device.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
      * @param[in] handle MCP320X handle.
      * @param[in] channel Channel to read from.
      * @param[in] read_mode Read mode.
@@ -146,8 +237,104 @@ extern "C"
                                uint16_t *value);
 
     /**
-     * @brief Read a voltage, in millivolts.
-     * @note This function is not thread safe when multiple tasks access the same SPI device.
+     * @brief Read a digital code from 0 to 4096 (MCP320X_RESOLUTION), without validating the arguments nor logging.
+     * @details Fast path for tight loops: the arguments must be valid, which can be checked once with @ref mcp320x_read
+     * before the loop. Placed in IRAM when CONFIG_MCP320X_HOT_PATH_IN_IRAM is enabled. Not counted on the performance
+     * counters nor traced.
+     * @note Invalid arguments are undefined behavior.
+     * @note This function is not thread safe when multiple tasks access the same SPI device. It never takes the lock:
+     * on a locked handle, call it between @ref mcp320x_acquire and @ref mcp320x_release.
+     * @param[in] handle MCP320X handle.
+     * @param[in] channel Channel to read from.
+     * @param[in] read_mode Read mode.
+     * @param[out] value Pointer to where the value will be stored. Not valid when the bus fails.
+     * @return MCP320X_OK when success, otherwise the error reported by the transport.
+     */
+    mcp320x_err_t mcp320x_read_unchecked(mcp320x_t *handle,
+                                         mcp320x_channel_t channel,
+                                         mcp320x_read_mode_t read_mode,
+                                         uint16_t *value);
+
+    /**
+     * @brief Encode a conversion request once, so it can be read many times with @ref mcp320x_read_prepared.
+     * @details Transports that support it also build their transaction, so reads only send it.
+     * @note The prepared request is valid until the handle is deleted.
+     * @param[in] handle MCP320X handle.
+     * @param[in] channel Channel to read from.
+     * @param[in] read_mode Read mode.
+     * @param[out] prepared Pointer to where the prepared request will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_prepare(mcp320x_t *handle,
+                                  mcp320x_channel_t channel,
+                                  mcp320x_read_mode_t read_mode,
+                                  mcp320x_prepared_t *prepared);
+
+    /**
+     * @brief Read a digital code from 0 to 4096 (MCP320X_RESOLUTION) using a prepared request.
+     * @details Nothing is encoded nor built: the channel and handle were validated by @ref mcp320x_prepare.
+     * Placed in IRAM when CONFIG_MCP320X_HOT_PATH_IN_IRAM is enabled. Not counted on the performance counters nor traced.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, nor the same prepared request.
+     * It never takes the lock: on a locked handle, call it between @ref mcp320x_acquire and @ref mcp320x_release.
+     * @param[in] prepared Request prepared by @ref mcp320x_prepare.
+     * @param[out] value Pointer to where the value will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_read_prepared(mcp320x_prepared_t *prepared, uint16_t *value);
+
+    /**
+     * @brief Read many digital codes from 0 to 4096 (MCP320X_RESOLUTION), one for each request.
+     * @details Conversions are queued back-to-back, up to @ref MCP320X_BATCH_QUEUE_SIZE at a time,
+     * and decoded after the whole queue completes.
+     * @note For high \p count it's recommended to aquire the SPI bus using the @ref mcp320x_acquire function.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
+     * @param[in] handle MCP320X handle.
+     * @param[in] requests Array of \p count conversion requests.
+     * @param[in] count How many requests to execute.
+     * @param[out] values Array of \p count elements where the values will be stored, in the requests order.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_read_batch(mcp320x_t *handle,
+                                     mcp320x_request_t const *requests,
+                                     size_t count,
+                                     uint16_t *values);
+
+    /**
+     * @brief Read many channels in one call, returning a digital code from 0 to 4096 (MCP320X_RESOLUTION) for each.
+     * @details The channels are validated once and all conversions are queued back-to-back.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
+     * @param[in] handle MCP320X handle.
+     * @param[in] channel_mask Channels to read; bit N = channel N.
+     * @param[in] read_mode Read mode used by all channels.
+     * @param[out] values Array indexed by channel where the values will be stored. Channels not in \p channel_mask are left untouched.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_scan(mcp320x_t *handle,
+                               uint8_t channel_mask,
+                               mcp320x_read_mode_t read_mode,
+                               uint16_t values[MCP320X_CHANNEL_COUNT_MAX]);
+
+    /**
+     * @brief Read many channels, in any order and with repetitions, returning a digital code from 0 to 4096 (MCP320X_RESOLUTION) for each.
+     * @details The lock, on a locked handle, and the SPI bus are taken once for all conversions, which are queued
+     * back-to-back, up to @ref MCP320X_BATCH_QUEUE_SIZE at a time. Other tasks wait for the whole call.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
+     * @param[in] handle MCP320X handle.
+     * @param[in] channels Array of \p count channels to read from.
+     * @param[in] count How many channels to read.
+     * @param[in] read_mode Read mode used by all channels.
+     * @param[out] values Array of \p count elements where the values will be stored, in the channels order.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_read_many(mcp320x_t *handle,
+                                    mcp320x_channel_t const *channels,
+                                    size_t count,
+                                    mcp320x_read_mode_t read_mode,
+                                    uint16_t *values);
+
+    /**
+     * @brief Read a voltage, in millivolts, rounded to the nearest millivolt.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
      * @param[in] handle MCP320X handle.
      * @param[in] channel Channel to read from.
      * @param[in] read_mode Read mode.
@@ -159,10 +346,24 @@ extern "C"
                                        mcp320x_read_mode_t read_mode,
                                        uint16_t *voltage);
 
+    /**
+     * @brief Read a voltage, in microvolts, rounded to the nearest microvolt.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
+     * @param[in] handle MCP320X handle.
+     * @param[in] channel Channel to read from.
+     * @param[in] read_mode Read mode.
+     * @param[out] voltage Pointer to where the value will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_read_microvolts(mcp320x_t *handle,
+                                          mcp320x_channel_t channel,
+                                          mcp320x_read_mode_t read_mode,
+                                          uint32_t *voltage);
+
     /**
      * @brief Sample a channel, returning a digital code from 0 to 4096 (MCP320X_RESOLUTION).
      * @note For high \p sample_count it's recommended to aquire the SPI bus using the @ref mcp320x_acquire function.
-     * @note This function is not thread safe when multiple tasks access the same SPI device.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
      * @param[in] handle MCP320X handle.
      * @param[in] channel Channel to read from.
      * @param[in] read_mode Read mode.
@@ -177,9 +378,66 @@ extern "C"
                                  uint16_t *value);
 
     /**
-     * @brief Sample a channel, returning a voltage, in millivolts.
+     * @brief Oversample a channel 4^\p extra_bits times and decimate, returning a digital code with 12 + \p extra_bits bits.
+     * @details The samples are summed and shifted right by \p extra_bits, rounding to the nearest. The code goes
+     * from 0 to 4095 * 2^\p extra_bits; divide by 2^\p extra_bits to compare with 12 bits codes.
+     * @note The extra bits are only meaningful when the input has, at least, 1 LSB of noise (or dither).
+     * @note For high \p extra_bits it's recommended to aquire the SPI bus using the @ref mcp320x_acquire function.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
+     * @param[in] handle MCP320X handle.
+     * @param[in] channel Channel to read from.
+     * @param[in] read_mode Read mode.
+     * @param[in] extra_bits Bits to add, from 1 to @ref MCP320X_OVERSAMPLE_BITS_MAX: 4, 16, 64 or 256 samples.
+     * @param[out] value Pointer to where the value will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_sample_oversampled(mcp320x_t *handle,
+                                             mcp320x_channel_t channel,
+                                             mcp320x_read_mode_t read_mode,
+                                             uint8_t extra_bits,
+                                             uint16_t *value);
+
+    /**
+     * @brief Sample a channel, returning robust statistics: min, max, mean, variance, median and trimmed mean.
+     * @details Unlike @ref mcp320x_sample, the median and the trimmed mean are not skewed by a few spikes.
+     * The samples are stored on \p buffer and reordered by a linear time selection; nothing is allocated.
      * @note For high \p sample_count it's recommended to aquire the SPI bus using the @ref mcp320x_acquire function.
-     * @note This function is not thread safe when multiple tasks access the same SPI device.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
+     * @param[in] handle MCP320X handle.
+     * @param[in] channel Channel to read from.
+     * @param[in] read_mode Read mode.
+     * @param[in] sample_count How many samples to take.
+     * @param[in] trim_percent Percent of the samples discarded from each end for the trimmed mean, up to @ref MCP320X_SAMPLE_STATS_TRIM_MAX.
+     * @param[out] buffer Array of, at least, \p sample_count elements; NULL to use the stack when \p sample_count is up to @ref MCP320X_SAMPLE_STATS_STACK_SIZE.
+     * @param[out] stats Pointer to where the statistics will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_sample_stats(mcp320x_t *handle,
+                                       mcp320x_channel_t channel,
+                                       mcp320x_read_mode_t read_mode,
+                                       uint16_t sample_count,
+                                       uint8_t trim_percent,
+                                       uint16_t *buffer,
+                                       mcp320x_sample_stats_t *stats);
+
+    /**
+     * @brief Compute robust statistics of digital codes, like the ones returned by bulk reads and streams.
+     * @details One pass for min, max, mean and variance, plus a linear time selection for the median and trimmed mean.
+     * @param[in,out] codes Array of \p count digital codes. Reordered.
+     * @param[in] count Number of digital codes.
+     * @param[in] trim_percent Percent of the codes discarded from each end for the trimmed mean, up to @ref MCP320X_SAMPLE_STATS_TRIM_MAX.
+     * @param[out] stats Pointer to where the statistics will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_codes_stats(uint16_t *codes,
+                                      uint16_t count,
+                                      uint8_t trim_percent,
+                                      mcp320x_sample_stats_t *stats);
+
+    /**
+     * @brief Sample a channel, returning the mean voltage, in millivolts, rounded to the nearest millivolt.
+     * @note For high \p sample_count it's recommended to aquire the SPI bus using the @ref mcp320x_acquire function.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
      * @param[in] handle MCP320X handle.
      * @param[in] channel Channel to read from.
      * @param[in] read_mode Read mode.
@@ -193,6 +451,51 @@ extern "C"
                                          uint16_t sample_count,
                                          uint16_t *voltage);
 
+    /**
+     * @brief Sample a channel, returning the mean voltage, in microvolts, rounded to the nearest microvolt.
+     * @note For high \p sample_count it's recommended to aquire the SPI bus using the @ref mcp320x_acquire function.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
+     * @param[in] handle MCP320X handle.
+     * @param[in] channel Channel to read from.
+     * @param[in] read_mode Read mode.
+     * @param[in] sample_count How many samples to take.
+     * @param[out] voltage Pointer to where the value will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_sample_microvolts(mcp320x_t *handle,
+                                            mcp320x_channel_t channel,
+                                            mcp320x_read_mode_t read_mode,
+                                            uint16_t sample_count,
+                                            uint32_t *voltage);
+
+    /**
+     * @brief Convert many digital codes to voltages, in millivolts, rounded to the nearest millivolt.
+     * @note Uses integer arithmetic only; safe to call from ISRs and on chips without FPU.
+     * @param[in] handle MCP320X handle.
+     * @param[in] codes Array of \p count digital codes.
+     * @param[out] voltages Array of \p count elements where the voltages will be stored. Can be the same as \p codes.
+     * @param[in] count How many digital codes to convert.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_codes_to_millivolts(mcp320x_t *handle,
+                                              uint16_t const *codes,
+                                              uint16_t *voltages,
+                                              size_t count);
+
+    /**
+     * @brief Convert many digital codes to voltages, in microvolts, rounded to the nearest microvolt.
+     * @note Uses integer arithmetic only; safe to call from ISRs and on chips without FPU.
+     * @param[in] handle MCP320X handle.
+     * @param[in] codes Array of \p count digital codes.
+     * @param[out] voltages Array of \p count elements where the voltages will be stored.
+     * @param[in] count How many digital codes to convert.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_codes_to_microvolts(mcp320x_t *handle,
+                                              uint16_t const *codes,
+                                              uint32_t *voltages,
+                                              size_t count);
+
 #ifdef __cplusplus
 }
 #endif
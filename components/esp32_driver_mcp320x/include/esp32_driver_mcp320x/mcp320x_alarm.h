@@ -0,0 +1,132 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_ALARM_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_ALARM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_ALARM_EVENT_BITS_MASK 0x00FFFFFF /** @brief Event group bits usable by alarms; FreeRTOS keeps the top 8 bits. */
+
+    /**
+     * @typedef mcp320x_alarm_state_t
+     * @brief Where a channel is, relative to its window.
+     */
+    typedef enum
+    {
+        MCP320X_ALARM_STATE_NORMAL = 0, /** @brief Inside the window. */
+        MCP320X_ALARM_STATE_LOW = 1,    /** @brief Below the low threshold. */
+        MCP320X_ALARM_STATE_HIGH = 2    /** @brief Above the high threshold. */
+    } mcp320x_alarm_state_t;
+
+    /**
+     * @typedef mcp320x_alarm_callback_t
+     * @brief Called on every transition of a channel, by the task processing the codes.
+     * @note On a stream, that's the acquisition task. Its default stack, @ref MCP320X_STREAM_TASK_STACK_SIZE_DEFAULT,
+     * leaves the callback around 1KB: enough to set bits or notify a task, not to log. Raise
+     * mcp320x_stream_config_t.task_stack_size for heavier callbacks.
+     * @param[in] channel Channel on the input, from 0 to channel_count - 1.
+     * @param[in] state New state.
+     * @param[in] code Digital code that completed the transition.
+     * @param[in] context User context.
+     */
+    typedef void (*mcp320x_alarm_callback_t)(uint8_t channel, mcp320x_alarm_state_t state, uint16_t code, void *context);
+
+    /**
+     * @typedef mcp320x_alarm_channel_config_t
+     * @brief Window of one channel, in digital codes.
+     */
+    typedef struct
+    {
+        uint16_t low;           /** @brief Below it the channel goes LOW; 0 disables it. */
+        uint16_t high;          /** @brief Above it the channel goes HIGH; 65535 disables it. */
+        uint16_t hysteresis;    /** @brief Codes the channel must come back into the window to return to NORMAL. Twice it must fit the window. */
+        uint8_t debounce;       /** @brief Consecutive codes on the new state needed to change to it; 0 or 1 change on the first one. */
+        EventBits_t event_bits; /** @brief Set on event_group on every transition of the channel; 0 sets none. */
+    } mcp320x_alarm_channel_config_t;
+
+    /**
+     * @typedef mcp320x_alarm_config_t
+     * @brief Configuration of a window comparator.
+     */
+    typedef struct
+    {
+        mcp320x_alarm_channel_config_t channels[MCP320X_CHANNEL_COUNT_MAX]; /** @brief Window of each channel; the first \p channel_count are used. */
+        uint8_t channel_count;                                              /** @brief Interleaved channels on the input, like a stream scan, from 1 to @ref MCP320X_CHANNEL_COUNT_MAX. */
+        mcp320x_alarm_callback_t callback;                                  /** @brief Called on every transition; NULL for none. */
+        void *callback_context;                                             /** @brief Passed to \p callback. */
+        EventGroupHandle_t event_group;                                     /** @brief Receives the event_bits of the channels; NULL for none. */
+    } mcp320x_alarm_config_t;
+
+    /**
+     * @typedef mcp320x_alarm_channel_t
+     * @brief State of one channel. All fields are private.
+     */
+    typedef struct
+    {
+        uint16_t low;           /** @brief Enters LOW below it. */
+        uint16_t low_exit;      /** @brief Leaves LOW from it: low + hysteresis. */
+        uint16_t high;          /** @brief Enters HIGH above it. */
+        uint16_t high_exit;     /** @brief Leaves HIGH from it: high - hysteresis. */
+        uint8_t debounce;       /** @brief Codes needed to change state, at least 1. */
+        uint8_t count;          /** @brief Consecutive codes on the pending state. */
+        uint8_t state;          /** @brief Current @ref mcp320x_alarm_state_t. */
+        uint8_t pending;        /** @brief @ref mcp320x_alarm_state_t being debounced. */
+        EventBits_t event_bits; /** @brief Set on every transition. */
+    } mcp320x_alarm_channel_t;
+
+    /**
+     * @typedef mcp320x_alarm_t
+     * @brief Window comparator with state per channel. Owned by the caller; all fields are private.
+     */
+    typedef struct
+    {
+        mcp320x_alarm_channel_t channels[MCP320X_CHANNEL_COUNT_MAX]; /** @brief Channels. */
+        uint8_t channel_count;                                       /** @brief Interleaved channels. */
+        uint8_t channel;                                             /** @brief Channel of the next input. */
+        mcp320x_alarm_callback_t callback;                           /** @brief Called on every transition. */
+        void *callback_context;                                      /** @brief Passed to callback. */
+        EventGroupHandle_t event_group;                              /** @brief Receives the event bits. */
+    } mcp320x_alarm_t;
+
+    /**
+     * @brief Initialize, or reset, a window comparator. Every channel starts NORMAL.
+     * @param[out] alarm Window comparator.
+     * @param[in] config Pointer to a @ref mcp320x_alarm_config_t struct specifying the windows.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_alarm_init(mcp320x_alarm_t *alarm, mcp320x_alarm_config_t const *config);
+
+    /**
+     * @brief Compare digital codes with the windows, like the ones returned by bulk reads and streams.
+     * @details Each code costs two comparisons; the callback and the event bits only run on transitions, so a task
+     * can wait on the event group instead of polling the channel. With many channels, the codes are interleaved
+     * (channel 0, 1, ..., 0, 1, ...), and the position is carried to the next call.
+     * @param[in,out] alarm Window comparator.
+     * @param[in] codes Array of \p count digital codes.
+     * @param[in] count Number of digital codes.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_alarm_process(mcp320x_alarm_t *alarm, uint16_t const *codes, size_t count);
+
+    /**
+     * @brief Get the state of a channel. Can be called from any task, while another one processes codes.
+     * @param[in] alarm Window comparator.
+     * @param[in] channel Channel on the input, from 0 to channel_count - 1.
+     * @param[out] state State of the channel.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_alarm_get_state(mcp320x_alarm_t const *alarm, uint8_t channel, mcp320x_alarm_state_t *state);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
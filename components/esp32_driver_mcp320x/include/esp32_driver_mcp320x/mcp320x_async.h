@@ -0,0 +1,74 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_ASYNC_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_ASYNC_H__
+
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_ASYNC_QUEUE_SIZE MCP320X_BATCH_QUEUE_SIZE /** @brief Maximum asynchronous reads not collected, per device. */
+
+    /**
+     * @typedef mcp320x_async_callback_t
+     * @brief Completion of an asynchronous read.
+     * @details With the SPI transports it runs from the SPI interrupt: it must be short, placed in IRAM and use only
+     * ISR safe functions, like vTaskNotifyGiveFromISR. With transports that complete on submission, like the GPIO
+     * and mock ones, it runs on the task that called @ref mcp320x_read_async, before it returns.
+     * @param[in] handle MCP320X handle.
+     * @param[in] value Digital code from 0 to 4096 (MCP320X_RESOLUTION).
+     * @param[in] context Pointer given to @ref mcp320x_read_async.
+     */
+    typedef void (*mcp320x_async_callback_t)(mcp320x_t *handle, uint16_t value, void *context);
+
+    /**
+     * @brief Start a read and return without waiting for it.
+     * @details The conversion is queued on the SPI driver, so the task can work while the frame is transferred.
+     * Every read must be collected, in the same order, with @ref mcp320x_get_result, also when a callback is used.
+     * @note Don't use blocking functions of the same handle while reads are pending.
+     * @note This function is not thread safe when multiple tasks access the same SPI device. It never takes the lock:
+     * on a locked handle, call it between @ref mcp320x_acquire and @ref mcp320x_release.
+     * @param[in] handle MCP320X handle.
+     * @param[in] channel Channel to read from.
+     * @param[in] read_mode Read mode.
+     * @param[in] callback Called when the conversion completes; NULL to only collect it.
+     * @param[in] context Passed to \p callback.
+     * @return MCP320X_OK when success, MCP320X_ERR_INVALID_STATE when @ref MCP320X_ASYNC_QUEUE_SIZE reads are pending,
+     * otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_read_async(mcp320x_t *handle,
+                                     mcp320x_channel_t channel,
+                                     mcp320x_read_mode_t read_mode,
+                                     mcp320x_async_callback_t callback,
+                                     void *context);
+
+    /**
+     * @brief Collect the oldest asynchronous read, returning a digital code from 0 to 4096 (MCP320X_RESOLUTION).
+     * @details With a timeout of 0 it polls: MCP320X_ERR_TIMEOUT means the read is still running.
+     * @param[in] handle MCP320X handle.
+     * @param[out] value Pointer to where the value will be stored.
+     * @param[in] timeout Time to wait for the read.
+     * @return MCP320X_OK when success, MCP320X_ERR_TIMEOUT when the read is still running,
+     * MCP320X_ERR_INVALID_STATE when no read is pending, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_get_result(mcp320x_t *handle,
+                                     uint16_t *value,
+                                     TickType_t timeout);
+
+    /**
+     * @brief Get how many asynchronous reads were not collected yet.
+     * @param[in] handle MCP320X handle.
+     * @param[out] count Pointer to where the count will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_get_pending(mcp320x_t *handle, uint8_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
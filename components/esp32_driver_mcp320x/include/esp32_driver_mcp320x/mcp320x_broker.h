@@ -0,0 +1,87 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_BROKER_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_BROKER_H__
+
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_BROKER_CLIENTS_MAX 16               /** @brief Maximum reads waiting on a broker at the same time. */
+#define MCP320X_BROKER_WINDOW_MAX_US 1000           /** @brief Maximum time a burst waits for more requests, in microseconds. */
+#define MCP320X_BROKER_TASK_STACK_SIZE_DEFAULT 2048 /** @brief Stack, in bytes, of the broker task when task_stack_size is 0. */
+
+    /**
+     * @typedef mcp320x_broker_config_t
+     * @brief Configuration for a request broker.
+     */
+    typedef struct
+    {
+        uint32_t window_us;        /** @brief Time a burst waits, after its first request, for others to join; up to @ref MCP320X_BROKER_WINDOW_MAX_US. The broker task blocks meanwhile. */
+        UBaseType_t task_priority; /** @brief Priority of the broker task; higher than the clients. */
+        BaseType_t task_core;      /** @brief Core the broker task is pinned to, or tskNO_AFFINITY. */
+        uint32_t task_stack_size;  /** @brief Stack of the broker task, in bytes; 0 for @ref MCP320X_BROKER_TASK_STACK_SIZE_DEFAULT. */
+    } mcp320x_broker_config_t;
+
+    /**
+     * @typedef mcp320x_broker_stats_t
+     * @brief Request broker counters.
+     */
+    typedef struct
+    {
+        uint32_t requests;    /** @brief Reads requested by the clients. */
+        uint32_t bursts;      /** @brief Batches sent to the device. */
+        uint32_t conversions; /** @brief Conversions done: requests of the same channel and mode on a burst share one. */
+        uint32_t errors;      /** @brief Bursts that failed to convert. */
+    } mcp320x_broker_stats_t;
+
+    /**
+     * @brief Start serving reads of many tasks with a broker, which coalesces them.
+     * @details The requests pending when the broker task runs, or arriving within the window, are sent as a single
+     * batch, with one conversion per distinct channel and read mode. While a batch converts, the next one gathers.
+     * @param[in] handle MCP320X handle.
+     * @param[in] config Pointer to a @ref mcp320x_broker_config_t struct specifying how to coalesce.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_broker_start(mcp320x_t *handle, mcp320x_broker_config_t const *config);
+
+    /**
+     * @brief Stop the broker, after serving the pending reads.
+     * @note No task can be calling @ref mcp320x_broker_read on the handle, nor call it afterwards.
+     * @param[in] handle MCP320X handle.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_broker_stop(mcp320x_t *handle);
+
+    /**
+     * @brief Read a digital code from 0 to 4096 (MCP320X_RESOLUTION) through the broker, waiting for it.
+     * @details Safe to call from many tasks at the same time, up to @ref MCP320X_BROKER_CLIENTS_MAX.
+     * @param[in] handle MCP320X handle.
+     * @param[in] channel Channel to read from.
+     * @param[in] read_mode Read mode.
+     * @param[out] value Pointer to where the value will be stored.
+     * @return MCP320X_OK when success, MCP320X_ERR_INVALID_STATE when the broker is not running or
+     * @ref MCP320X_BROKER_CLIENTS_MAX reads are waiting, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_broker_read(mcp320x_t *handle,
+                                      mcp320x_channel_t channel,
+                                      mcp320x_read_mode_t read_mode,
+                                      uint16_t *value);
+
+    /**
+     * @brief Get the request broker counters.
+     * @param[in] handle MCP320X handle.
+     * @param[out] stats Pointer to where the counters will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_broker_get_stats(mcp320x_t *handle, mcp320x_broker_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,180 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_CALIBRATION_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_CALIBRATION_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "nvs.h"
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_CALIBRATION_POINTS_MAX 16   /** @brief Maximum points of a channel. */
+#define MCP320X_CALIBRATION_TABLE_SIZE 4096 /** @brief Entries of a lookup table: one per digital code. */
+#define MCP320X_CALIBRATION_BLOB_SIZE_MAX (6 + MCP320X_CHANNEL_COUNT_MAX * (2 + MCP320X_CALIBRATION_POINTS_MAX * 6) + 2) /** @brief Bytes of a serialized calibration with every channel at the maximum points. */
+
+    /**
+     * @typedef mcp320x_calibration_point_t
+     * @brief A known voltage and the code read for it.
+     */
+    typedef struct
+    {
+        uint16_t code_x16;  /** @brief Digital code read, times 16: the mean of many reads keeps 4 more bits. From 0 to 65520. */
+        int32_t microvolts; /** @brief Voltage applied, in microvolts. */
+    } mcp320x_calibration_point_t;
+
+    /**
+     * @typedef mcp320x_calibration_channel_t
+     * @brief Correction of one channel. All fields are private.
+     */
+    typedef struct
+    {
+        int32_t gain;                                                       /** @brief Microvolts per code, Q16. */
+        int64_t bias;                                                       /** @brief Offset, in microvolts, Q16, plus half for the rounding. */
+        int32_t const *table;                                               /** @brief Microvolts of every code; NULL for the linear correction. */
+        mcp320x_calibration_point_t points[MCP320X_CALIBRATION_POINTS_MAX]; /** @brief Points the correction was computed from. */
+        uint8_t point_count;                                                /** @brief Points used; 0 when uncalibrated. */
+    } mcp320x_calibration_channel_t;
+
+    /**
+     * @typedef mcp320x_calibration_t
+     * @brief Correction of every channel of a device. Owned by the caller; all fields are private.
+     */
+    typedef struct
+    {
+        mcp320x_calibration_channel_t channels[MCP320X_CHANNEL_COUNT_MAX]; /** @brief Channels. */
+        uint16_t reference_voltage;                                       /** @brief Used by uncalibrated channels, in millivolts. */
+    } mcp320x_calibration_t;
+
+    /**
+     * @brief Initialize, or reset, a calibration. Every channel starts uncalibrated, converting like @ref mcp320x_read_microvolts.
+     * @param[out] calibration Calibration.
+     * @param[in] reference_voltage Reference voltage of the device, in millivolts.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_calibration_init(mcp320x_calibration_t *calibration, uint16_t reference_voltage);
+
+    /**
+     * @brief Capture a calibration point: read a channel 256 times while a known voltage is applied to it.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
+     * @param[in] handle MCP320X handle.
+     * @param[in] channel Channel to read from.
+     * @param[in] read_mode Read mode.
+     * @param[in] microvolts Voltage applied, in microvolts.
+     * @param[out] point Pointer to where the point will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_calibration_capture(mcp320x_t *handle,
+                                              mcp320x_channel_t channel,
+                                              mcp320x_read_mode_t read_mode,
+                                              int32_t microvolts,
+                                              mcp320x_calibration_point_t *point);
+
+    /**
+     * @brief Compute the correction of a channel from its points.
+     * @details Without \p table, the line through the first and the last points: a gain and an offset, applied
+     * with a multiplication and a shift. With \p table, every code is interpolated between the two points around
+     * it, correcting the nonlinearity; the codes beyond the first and the last points extend their segments.
+     * @param[in,out] calibration Calibration.
+     * @param[in] channel Channel.
+     * @param[in] points Array of \p count points, in increasing code order.
+     * @param[in] count Number of points, from 2 to @ref MCP320X_CALIBRATION_POINTS_MAX.
+     * @param[out] table Array of @ref MCP320X_CALIBRATION_TABLE_SIZE entries, filled and used until the channel
+     * is calibrated again; NULL for the linear correction.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_calibration_set_points(mcp320x_calibration_t *calibration,
+                                                 mcp320x_channel_t channel,
+                                                 mcp320x_calibration_point_t const *points,
+                                                 uint8_t count,
+                                                 int32_t *table);
+
+    /**
+     * @brief Convert digital codes of a channel to corrected voltages, in microvolts.
+     * @details No division nor floating point: a table lookup, or a 64 bits multiplication and a shift per code.
+     * @param[in] calibration Calibration.
+     * @param[in] channel Channel the codes were read from.
+     * @param[in] codes Array of \p count digital codes.
+     * @param[out] microvolts Array of \p count elements where the voltages will be stored.
+     * @param[in] count Number of digital codes.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_calibration_apply(mcp320x_calibration_t const *calibration,
+                                            mcp320x_channel_t channel,
+                                            uint16_t const *codes,
+                                            int32_t *microvolts,
+                                            size_t count);
+
+    /**
+     * @brief Read a corrected voltage, in microvolts.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
+     * @param[in] handle MCP320X handle.
+     * @param[in] calibration Calibration of the device.
+     * @param[in] channel Channel to read from.
+     * @param[in] read_mode Read mode.
+     * @param[out] microvolts Pointer to where the voltage will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_calibration_read(mcp320x_t *handle,
+                                           mcp320x_calibration_t const *calibration,
+                                           mcp320x_channel_t channel,
+                                           mcp320x_read_mode_t read_mode,
+                                           int32_t *microvolts);
+
+    /**
+     * @brief Serialize the points of the calibrated channels to a compact binary blob, little-endian and checksummed.
+     * @details Two points per channel take 14 bytes, plus 8 bytes of header and checksum. The corrections are
+     * computed again when loaded.
+     * @param[in] calibration Calibration.
+     * @param[out] buffer Array of \p capacity bytes; @ref MCP320X_CALIBRATION_BLOB_SIZE_MAX always fits.
+     * @param[in] capacity Size of \p buffer, in bytes.
+     * @param[out] size Pointer to where the bytes written will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_calibration_serialize(mcp320x_calibration_t const *calibration, uint8_t *buffer, size_t capacity, size_t *size);
+
+    /**
+     * @brief Load a calibration serialized by @ref mcp320x_calibration_serialize.
+     * @details Nothing changes when the blob is invalid.
+     * @param[in,out] calibration Calibration, initialized with the reference voltage.
+     * @param[in] buffer Blob.
+     * @param[in] size Size of \p buffer, in bytes.
+     * @param[out] tables Lookup tables of the channels serialized with one, indexed by channel; NULL when none has.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_calibration_deserialize(mcp320x_calibration_t *calibration,
+                                                  uint8_t const *buffer,
+                                                  size_t size,
+                                                  int32_t *const tables[MCP320X_CHANNEL_COUNT_MAX]);
+
+    /**
+     * @brief Store a calibration on NVS, serialized. On the host build, NVS keys are files.
+     * @param[in] calibration Calibration.
+     * @param[in] nvs NVS handle, opened for writing.
+     * @param[in] key Key of the blob.
+     * @return MCP320X_OK when success, MCP320X_ERR_FAIL when NVS fails, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_calibration_save(mcp320x_calibration_t const *calibration, nvs_handle_t nvs, const char *key);
+
+    /**
+     * @brief Load a calibration stored by @ref mcp320x_calibration_save.
+     * @param[in,out] calibration Calibration, initialized with the reference voltage.
+     * @param[in] nvs NVS handle.
+     * @param[in] key Key of the blob.
+     * @param[out] tables Lookup tables of the channels saved with one, indexed by channel; NULL when none has.
+     * @return MCP320X_OK when success, MCP320X_ERR_INVALID_STATE when nothing is stored on \p key, MCP320X_ERR_FAIL
+     * when NVS fails, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_calibration_load(mcp320x_calibration_t *calibration,
+                                           nvs_handle_t nvs,
+                                           const char *key,
+                                           int32_t *const tables[MCP320X_CHANNEL_COUNT_MAX]);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
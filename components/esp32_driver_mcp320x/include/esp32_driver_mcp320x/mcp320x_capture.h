@@ -0,0 +1,91 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_CAPTURE_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_CAPTURE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_CAPTURE_TIMER_RATE_MAX_HZ 20000 /** @brief Maximum rate triggered by a timer, limited by the esp_timer minimum period (50us). */
+#define MCP320X_CAPTURE_SPIN_RATE_MAX_HZ 100000 /** @brief Maximum rate triggered by spinning: the device throughput at 5V (100ksps). */
+
+    /**
+     * @typedef mcp320x_capture_trigger_t
+     * @brief What starts each conversion.
+     */
+    typedef enum
+    {
+        MCP320X_CAPTURE_TRIGGER_TIMER = 0, /** @brief A periodic esp_timer wakes the calling task; the CPU is free between samples. */
+        MCP320X_CAPTURE_TRIGGER_SPIN = 1   /** @brief The calling task busy-waits each deadline: lowest jitter, the core is kept busy. */
+    } mcp320x_capture_trigger_t;
+
+    /**
+     * @typedef mcp320x_capture_config_t
+     * @brief Configuration for a fixed rate capture.
+     */
+    typedef struct
+    {
+        mcp320x_channel_t channel;         /** @brief Channel to read from. */
+        mcp320x_read_mode_t read_mode;     /** @brief Read mode. */
+        uint32_t rate_hz;                  /** @brief Samples per second, up to the trigger maximum. */
+        mcp320x_capture_trigger_t trigger; /** @brief What starts each conversion. */
+    } mcp320x_capture_config_t;
+
+    /**
+     * @typedef mcp320x_capture_sample_t
+     * @brief A timestamped digital code.
+     */
+    typedef struct
+    {
+        uint32_t timestamp_us; /** @brief Start of the conversion, in microseconds since the capture started. Ideally N * period. */
+        uint16_t value;        /** @brief Digital code from 0 to 4096 (MCP320X_RESOLUTION). */
+    } mcp320x_capture_sample_t;
+
+    /**
+     * @typedef mcp320x_capture_stats_t
+     * @brief Timing of a capture: the error of each sample interval against the period.
+     * @details A late sample whose interval spans more than one period and a half counts the skipped periods as
+     * missed; its error is measured against the nearest multiple of the period.
+     */
+    typedef struct
+    {
+        uint32_t samples;         /** @brief Samples converted. */
+        uint32_t missed;          /** @brief Periods without a conversion: the previous one, or the task, was late. */
+        int32_t error_min_us;     /** @brief Most negative interval error (interval shorter than the period), in microseconds. */
+        int32_t error_max_us;     /** @brief Most positive interval error (interval longer than the period), in microseconds. */
+        uint32_t error_stddev_ns; /** @brief Standard deviation of the interval error: the jitter, in nanoseconds. */
+    } mcp320x_capture_stats_t;
+
+    /**
+     * @brief Convert one channel at a fixed rate, storing each digital code with its timestamp.
+     * @details The SPI bus is acquired, and each request prepared, once for the whole capture. Timestamps come from
+     * esp_timer_get_time, taken right before each conversion. Spinning, deadlines are absolute: a late sample doesn't
+     * delay the next ones, and deadlines already passed are skipped. The timer skips late ticks, restarting its period.
+     * @note Blocks until \p count samples are converted. The timer trigger takes the last notification index of the
+     * calling task, configTASK_NOTIFICATION_ARRAY_ENTRIES - 1, and clears it: with a single entry, the ESP-IDF default,
+     * that's the index of xTaskNotifyGive and ulTaskNotifyTake. Set CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES
+     * to 2 or more to keep them.
+     * The jitter depends on the calling task priority: use a high one, pinned to a core.
+     * @param[in] handle MCP320X handle.
+     * @param[in] config Pointer to a @ref mcp320x_capture_config_t struct specifying how to capture.
+     * @param[out] samples Array of \p count elements where the samples will be stored.
+     * @param[in] count Number of samples to capture.
+     * @param[out] stats Pointer to where the timing statistics will be stored; may be NULL.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_capture(mcp320x_t *handle,
+                                  mcp320x_capture_config_t const *config,
+                                  mcp320x_capture_sample_t *samples,
+                                  size_t count,
+                                  mcp320x_capture_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
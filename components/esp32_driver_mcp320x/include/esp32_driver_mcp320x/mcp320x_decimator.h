@@ -0,0 +1,81 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_DECIMATOR_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_DECIMATOR_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_DECIMATOR_ORDER_MAX 3        /** @brief Maximum number of CIC stages. */
+#define MCP320X_DECIMATOR_RATIO_MAX 1024     /** @brief Maximum decimation ratio. */
+#define MCP320X_DECIMATOR_OUTPUT_BITS_MIN 12 /** @brief Minimum bits of the decimated codes: the device resolution. */
+#define MCP320X_DECIMATOR_OUTPUT_BITS_MAX 16 /** @brief Maximum bits of the decimated codes. */
+#define MCP320X_DECIMATOR_GROWTH_MAX 20      /** @brief Maximum order * log2(ratio): the bits a CIC adds to 12 bits codes must fit 32 bits. */
+
+    /**
+     * @typedef mcp320x_decimator_config_t
+     * @brief Configuration of a streaming decimator.
+     */
+    typedef struct
+    {
+        uint8_t order;         /** @brief CIC stages, from 1 to @ref MCP320X_DECIMATOR_ORDER_MAX; 1 is a boxcar (moving sum) filter. */
+        uint16_t ratio;        /** @brief Digital codes per decimated code, per channel. Power of two, up to @ref MCP320X_DECIMATOR_RATIO_MAX. */
+        uint8_t output_bits;   /** @brief Bits of the decimated codes, from 12 to 16. */
+        uint8_t channel_count; /** @brief Interleaved channels on the input, like a stream scan, from 1 to @ref MCP320X_CHANNEL_COUNT_MAX. */
+    } mcp320x_decimator_config_t;
+
+    /**
+     * @typedef mcp320x_decimator_t
+     * @brief Streaming CIC decimator. Owned by the caller; all fields are private.
+     */
+    typedef struct
+    {
+        uint8_t order;                                                                /** @brief CIC stages. */
+        uint8_t shift;                                                                /** @brief Bits removed from the CIC output to get output_bits. */
+        uint8_t channel_count;                                                        /** @brief Interleaved channels. */
+        uint8_t channel;                                                              /** @brief Channel of the next input. */
+        uint16_t ratio;                                                               /** @brief Inputs per output, per channel. */
+        uint16_t phase;                                                               /** @brief Inputs of the current output, per channel. */
+        uint32_t integrators[MCP320X_DECIMATOR_ORDER_MAX][MCP320X_CHANNEL_COUNT_MAX]; /** @brief Integrator stages, run at the input rate. */
+        uint32_t combs[MCP320X_DECIMATOR_ORDER_MAX][MCP320X_CHANNEL_COUNT_MAX];       /** @brief Comb stages delay, run at the output rate. */
+    } mcp320x_decimator_t;
+
+    /**
+     * @brief Initialize, or reset, a decimator.
+     * @param[out] decimator Decimator.
+     * @param[in] config Pointer to a @ref mcp320x_decimator_config_t struct specifying how to decimate.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_decimator_init(mcp320x_decimator_t *decimator, mcp320x_decimator_config_t const *config);
+
+    /**
+     * @brief Decimate digital codes, like the ones returned by bulk reads and streams.
+     * @details Each code costs one addition per stage; each output, one subtraction per stage. Inputs don't need to
+     * be a multiple of the ratio: the state carries to the next call. With many channels, the inputs are interleaved
+     * (channel 0, 1, ..., 0, 1, ...) and so are the outputs.
+     * @note The first \p order - 1 outputs of each channel are the filter settling.
+     * @param[in,out] decimator Decimator.
+     * @param[in] codes Array of \p count digital codes.
+     * @param[in] count Number of digital codes.
+     * @param[out] outputs Array where the decimated codes will be stored, from 0 to (2^12 - 1) * 2^(output_bits - 12).
+     * @param[in] capacity Number of elements of \p outputs; at least \p count / ratio + channel count.
+     * @param[out] output_count Pointer to where the number of decimated codes will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_decimator_process(mcp320x_decimator_t *decimator,
+                                            uint16_t const *codes,
+                                            size_t count,
+                                            uint16_t *outputs,
+                                            size_t capacity,
+                                            size_t *output_count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
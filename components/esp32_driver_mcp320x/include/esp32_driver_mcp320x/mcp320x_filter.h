@@ -0,0 +1,115 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_FILTER_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_FILTER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_FILTER_STAGES_MAX 4                                /** @brief Maximum filters on a chain. */
+#define MCP320X_FILTER_TAPS_MAX 16                                 /** @brief Maximum length of boxcar and FIR filters. */
+#define MCP320X_FILTER_ONE 32768                                   /** @brief 1.0 in Q15. */
+#define MCP320X_FILTER_BIQUAD_COEFFICIENT_MAX (4 * MCP320X_FILTER_ONE) /** @brief Biquad coefficients must be above -4.0 and below 4.0, in Q15. */
+
+/**
+ * @brief Convert a constant to Q15, rounding to the nearest, so coefficients can be written as decimals at compile time.
+ * @param value Value to convert.
+ */
+#define MCP320X_Q15(value) ((int32_t)((value) * 32768.0 + ((value) >= 0 ? 0.5 : -0.5)))
+
+    /**
+     * @typedef mcp320x_filter_type_t
+     * @brief Filter of a stage.
+     */
+    typedef enum
+    {
+        MCP320X_FILTER_EMA = 0,    /** @brief Exponential moving average: y += alpha * (x - y). */
+        MCP320X_FILTER_BOXCAR = 1, /** @brief Mean of the last \p length codes, kept as a running sum. */
+        MCP320X_FILTER_FIR = 2,    /** @brief Finite impulse response: y = sum(taps[k] * x[n - k]). */
+        MCP320X_FILTER_BIQUAD = 3  /** @brief Second order IIR, direct form I: y = b0 x0 + b1 x1 + b2 x2 - a1 y1 - a2 y2. */
+    } mcp320x_filter_type_t;
+
+    /**
+     * @typedef mcp320x_filter_stage_config_t
+     * @brief Configuration of one filter of a chain.
+     */
+    typedef struct
+    {
+        mcp320x_filter_type_t type;                    /** @brief Filter. */
+        uint16_t alpha;                                /** @brief EMA: weight of the new code, Q15, from 1 to @ref MCP320X_FILTER_ONE. */
+        uint8_t length;                                /** @brief Boxcar: codes averaged; FIR: taps. From 1 to @ref MCP320X_FILTER_TAPS_MAX. */
+        int32_t coefficients[MCP320X_FILTER_TAPS_MAX]; /** @brief FIR: taps, Q15, from -1.0 to 1.0; biquad: b0, b1, b2, a1 and a2, Q15, normalized to a0 = 1. */
+    } mcp320x_filter_stage_config_t;
+
+    /**
+     * @typedef mcp320x_filter_config_t
+     * @brief Configuration of a filter chain.
+     */
+    typedef struct
+    {
+        mcp320x_filter_stage_config_t stages[MCP320X_FILTER_STAGES_MAX]; /** @brief Filters, applied in order; the first \p stage_count are used. */
+        uint8_t stage_count;                                             /** @brief Number of filters, from 1 to @ref MCP320X_FILTER_STAGES_MAX. */
+        uint8_t channel_count;                                           /** @brief Interleaved channels on the input, like a stream scan, from 1 to @ref MCP320X_CHANNEL_COUNT_MAX. */
+    } mcp320x_filter_config_t;
+
+    /**
+     * @typedef mcp320x_filter_stage_t
+     * @brief State of one filter of a chain. All fields are private.
+     */
+    typedef struct
+    {
+        mcp320x_filter_type_t type;                                           /** @brief Filter. */
+        uint8_t length;                                                       /** @brief Boxcar and FIR length. */
+        int32_t coefficients[MCP320X_FILTER_TAPS_MAX];                        /** @brief EMA alpha, FIR taps or biquad coefficients, Q15. */
+        uint16_t history[MCP320X_CHANNEL_COUNT_MAX][MCP320X_FILTER_TAPS_MAX]; /** @brief Last inputs of each channel; boxcar and FIR as a ring, biquad x1 and x2. */
+        int32_t state[MCP320X_CHANNEL_COUNT_MAX][2];                          /** @brief EMA output, boxcar running sum or biquad y1 and y2. */
+        uint8_t position[MCP320X_CHANNEL_COUNT_MAX];                          /** @brief Oldest input on the history ring of each channel. */
+    } mcp320x_filter_stage_t;
+
+    /**
+     * @typedef mcp320x_filter_t
+     * @brief Chain of filters with state per channel. Owned by the caller; all fields are private.
+     */
+    typedef struct
+    {
+        mcp320x_filter_stage_t stages[MCP320X_FILTER_STAGES_MAX]; /** @brief Filters. */
+        uint8_t stage_count;                                      /** @brief Filters used. */
+        uint8_t channel_count;                                    /** @brief Interleaved channels. */
+        uint8_t channel;                                          /** @brief Channel of the next input. */
+        uint8_t primed;                                           /** @brief Channels already seen; bit N = channel N. */
+    } mcp320x_filter_t;
+
+    /**
+     * @brief Initialize, or reset, a filter chain.
+     * @param[out] filter Filter chain.
+     * @param[in] config Pointer to a @ref mcp320x_filter_config_t struct specifying the filters.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_filter_init(mcp320x_filter_t *filter, mcp320x_filter_config_t const *config);
+
+    /**
+     * @brief Filter digital codes in place, like the ones returned by bulk reads and streams.
+     * @details Integer arithmetic only, Q15 coefficients. Each filter runs over the whole array before the next one.
+     * With many channels, the codes are interleaved (channel 0, 1, ..., 0, 1, ...) and each channel has its own
+     * state, carried to the next call.
+     * @note The state of each channel starts from its first code, as if the input had always been it: there's no
+     * settling from 0. That's exact for filters with unit gain at DC, like all low-pass ones.
+     * @note Outputs are clamped from 0 to 65535: filters that go negative, like high-pass ones, are meaningless
+     * on digital codes.
+     * @param[in,out] filter Filter chain.
+     * @param[in,out] codes Array of \p count digital codes, replaced by the filtered ones.
+     * @param[in] count Number of digital codes.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_filter_process(mcp320x_filter_t *filter, uint16_t *codes, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
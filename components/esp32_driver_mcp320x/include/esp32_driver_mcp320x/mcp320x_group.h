@@ -0,0 +1,71 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_GROUP_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_GROUP_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_GROUP_DEVICES_MAX 8 /** @brief Maximum devices on a group. */
+
+    /**
+     * @typedef mcp320x_group_t
+     * @brief MCP320X device group handle.
+     */
+    typedef struct mcp320x_group_t mcp320x_group_t;
+
+    /**
+     * @brief Install many MCP320X devices as a group, usually on the same SPI bus with different chip selects.
+     * @details Each configuration installs a device like @ref mcp320x_install. The group owns the devices.
+     * @param[in] configs Array of \p count configurations.
+     * @param[in] count Number of devices, from 1 to @ref MCP320X_GROUP_DEVICES_MAX.
+     * @return Group handle when success, NULL otherwise.
+     */
+    mcp320x_group_t *mcp320x_group_install(mcp320x_config_t const *configs, size_t count);
+
+    /**
+     * @brief Remove the devices of a group and free it.
+     * @param[in] group Group handle.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_group_delete(mcp320x_group_t *group);
+
+    /**
+     * @brief Get the handle of a device of the group, to use it on its own.
+     * @note The handle belongs to the group: don't delete it.
+     * @param[in] group Group handle.
+     * @param[in] index Device index, in the order of the configurations.
+     * @param[out] handle Pointer to where the handle will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_group_get_device(mcp320x_group_t *group, size_t index, mcp320x_t **handle);
+
+    /**
+     * @brief Read the same channels of every device in one pass, returning digital codes from 0 to 4096 (MCP320X_RESOLUTION).
+     * @details With transports that queue (the SPI ones) every conversion is queued before waiting for any, alternating
+     * the devices, so the SPI driver sends them back-to-back; the bus is not acquired, as ESP-IDF only lets one device
+     * hold it. Devices without a queue are scanned afterwards, one at a time.
+     * Only the elements of the selected channels are written.
+     * @note Locked devices are locked during the whole pass. Devices with the bus acquired, a stream running or
+     * asynchronous reads pending return MCP320X_ERR_INVALID_STATE.
+     * @param[in] group Group handle.
+     * @param[in] channel_mask Channels to read, bit N = channel N; must exist on every device.
+     * @param[in] read_mode Read mode.
+     * @param[out] values Array of one row per device, indexed by channel: values[device][channel].
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_group_scan(mcp320x_group_t *group,
+                                     uint8_t channel_mask,
+                                     mcp320x_read_mode_t read_mode,
+                                     uint16_t values[][MCP320X_CHANNEL_COUNT_MAX]);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,121 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_PARALLEL_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_PARALLEL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "esp32_driver_mcp320x/mcp320x.h"
+#include "esp32_driver_mcp320x/mcp320x_group.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_PARALLEL_WORKERS_MAX 2                /** @brief Maximum workers: one per SPI host free for devices (SPI2 and SPI3). */
+#define MCP320X_PARALLEL_RATE_MAX_HZ 20000            /** @brief Maximum scan rate of each worker, in Hz, limited by the esp_timer minimum period (50us). */
+#define MCP320X_PARALLEL_TASK_STACK_SIZE_DEFAULT 2048 /** @brief Stack, in bytes, of each worker task when task_stack_size is 0. */
+
+    /**
+     * @typedef mcp320x_parallel_t
+     * @brief MCP320X parallel acquisition handle.
+     */
+    typedef struct mcp320x_parallel_t mcp320x_parallel_t;
+
+    /**
+     * @typedef mcp320x_parallel_worker_config_t
+     * @brief Configuration of one worker of a parallel acquisition.
+     */
+    typedef struct
+    {
+        mcp320x_group_t *group; /** @brief Devices scanned by the worker, usually all on its own SPI host. Not shared with other workers. */
+        uint8_t channel_mask;   /** @brief Channels to convert on every device; bit N = channel N. */
+        BaseType_t task_core;   /** @brief Core the worker task is pinned to, or tskNO_AFFINITY. */
+    } mcp320x_parallel_worker_config_t;
+
+    /**
+     * @typedef mcp320x_parallel_config_t
+     * @brief Configuration for a parallel acquisition.
+     */
+    typedef struct
+    {
+        mcp320x_parallel_worker_config_t workers[MCP320X_PARALLEL_WORKERS_MAX]; /** @brief Workers; the first \p worker_count are used. */
+        size_t worker_count;                                                    /** @brief Number of workers, from 1 to @ref MCP320X_PARALLEL_WORKERS_MAX. */
+        mcp320x_read_mode_t read_mode;                                          /** @brief Read mode used by all channels. */
+        uint32_t rate_hz;                                                       /** @brief Scans per second of each worker, up to @ref MCP320X_PARALLEL_RATE_MAX_HZ; 0 scans back-to-back. */
+        size_t ring_capacity;                                                   /** @brief Scans each worker can hold until read. Rounded up to a power of two. */
+        UBaseType_t task_priority;                                              /** @brief Priority of the worker tasks. */
+        uint32_t task_stack_size;                                               /** @brief Stack of each worker task, in bytes; 0 for @ref MCP320X_PARALLEL_TASK_STACK_SIZE_DEFAULT. */
+    } mcp320x_parallel_config_t;
+
+    /**
+     * @typedef mcp320x_parallel_scan_t
+     * @brief One pass of a worker over its group.
+     */
+    typedef struct
+    {
+        int64_t timestamp_us;                                                 /** @brief esp_timer time taken right before the pass. */
+        uint8_t worker;                                                       /** @brief Index of the worker on @ref mcp320x_parallel_config_t.workers. */
+        uint16_t values[MCP320X_GROUP_DEVICES_MAX][MCP320X_CHANNEL_COUNT_MAX]; /** @brief Digital codes, values[device][channel]; only the selected channels of the group devices are valid. */
+    } mcp320x_parallel_scan_t;
+
+    /**
+     * @typedef mcp320x_parallel_stats_t
+     * @brief Parallel acquisition counters, summed over the workers.
+     */
+    typedef struct
+    {
+        uint32_t scans;   /** @brief Scans stored. */
+        uint32_t dropped; /** @brief Scans not converted because the worker ring was full. */
+        uint32_t errors;  /** @brief Scans that failed to convert. */
+    } mcp320x_parallel_stats_t;
+
+    /**
+     * @brief Start converting groups in parallel, one worker task each, merging their scans by time.
+     * @details Each worker scans its group with @ref mcp320x_group_scan, at the configured rate or back-to-back, and
+     * stores the timestamped scans on its own lock-free ring. With each group on its own SPI host and each worker
+     * pinned to its own core, the throughput grows with the workers.
+     * @note A back-to-back worker only leaves its core while waiting for the bus: give it a low priority.
+     * @param[in] config Pointer to a @ref mcp320x_parallel_config_t struct specifying what to acquire.
+     * @return Parallel acquisition handle when success, NULL otherwise.
+     */
+    mcp320x_parallel_t *mcp320x_parallel_start(mcp320x_parallel_config_t const *config);
+
+    /**
+     * @brief Stop the workers and free the parallel acquisition. The groups are left installed.
+     * @note Not read scans are lost.
+     * @param[in] parallel Parallel acquisition handle.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_parallel_stop(mcp320x_parallel_t *parallel);
+
+    /**
+     * @brief Read scans of all workers in timestamp order, without waiting.
+     * @details A scan is only returned once every other worker is known to have nothing older, so the newest ones
+     * wait up to a period of the slowest worker.
+     * @note Only one task can read from a parallel acquisition.
+     * @param[in] parallel Parallel acquisition handle.
+     * @param[out] scans Array where the scans will be stored.
+     * @param[in] length Maximum number of scans to read.
+     * @param[out] read_count Pointer to where the number of scans read will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_parallel_read(mcp320x_parallel_t *parallel,
+                                        mcp320x_parallel_scan_t *scans,
+                                        size_t length,
+                                        size_t *read_count);
+
+    /**
+     * @brief Get the parallel acquisition counters.
+     * @param[in] parallel Parallel acquisition handle.
+     * @param[out] stats Pointer to where the counters will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_parallel_get_stats(mcp320x_parallel_t *parallel, mcp320x_parallel_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,152 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_SCHEDULER_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_SCHEDULER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_SCHEDULER_WEIGHT_MAX 64    /** @brief Maximum weight of a slot. */
+#define MCP320X_SCHEDULER_WINDOW_MAX 1024  /** @brief Maximum conversions of a slot per variance window. */
+#define MCP320X_SCHEDULER_TIME_SCALE 65536 /** @brief Virtual time of one round, where a slot of weight W is due every SCALE / W. */
+
+    /**
+     * @typedef mcp320x_scheduler_policy_t
+     * @brief How the conversions of the slots are interleaved.
+     */
+    typedef enum
+    {
+        MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN = 0, /** @brief Smooth weighted round-robin: every W conversions of a slot are spread over the round. */
+        MCP320X_SCHEDULER_POLICY_EARLIEST_DEADLINE = 1     /** @brief Each slot is due every 1 / W of a round; the earliest due is converted first. */
+    } mcp320x_scheduler_policy_t;
+
+    /**
+     * @typedef mcp320x_scheduler_slot_config_t
+     * @brief A channel to schedule.
+     */
+    typedef struct
+    {
+        mcp320x_request_t request; /** @brief Channel and read mode. */
+        uint8_t weight;            /** @brief Conversions per round, relative to the other slots, from 1 to @ref MCP320X_SCHEDULER_WEIGHT_MAX. */
+        uint8_t weight_min;        /** @brief Lowest weight the adaptation can set; ignored without adaptation. */
+        uint8_t weight_max;        /** @brief Highest weight the adaptation can set; ignored without adaptation. */
+    } mcp320x_scheduler_slot_config_t;
+
+    /**
+     * @typedef mcp320x_scheduler_config_t
+     * @brief Configuration of a conversion scheduler.
+     */
+    typedef struct
+    {
+        mcp320x_scheduler_slot_config_t slots[MCP320X_CHANNEL_COUNT_MAX]; /** @brief Slots; the first \p slot_count are used. */
+        uint8_t slot_count;                                               /** @brief Number of slots, from 1 to @ref MCP320X_CHANNEL_COUNT_MAX. */
+        mcp320x_scheduler_policy_t policy;                                /** @brief How the conversions are interleaved. */
+        uint16_t window;                                                  /** @brief Conversions of a slot per variance window, up to @ref MCP320X_SCHEDULER_WINDOW_MAX; 0 disables the adaptation. */
+        uint32_t variance_high;                                           /** @brief Variance, in codes², above which the weight of a slot doubles. */
+        uint32_t variance_low;                                            /** @brief Variance, in codes², below which the weight of a slot halves. Below \p variance_high. */
+    } mcp320x_scheduler_config_t;
+
+    /**
+     * @typedef mcp320x_scheduler_slot_t
+     * @brief State of a slot. All fields are private.
+     */
+    typedef struct
+    {
+        mcp320x_request_t request; /** @brief Channel and read mode. */
+        uint8_t weight;            /** @brief Current weight. */
+        uint8_t weight_min;        /** @brief Lowest weight. */
+        uint8_t weight_max;        /** @brief Highest weight. */
+        int16_t credit;            /** @brief Weighted round-robin: current weight. */
+        uint32_t deadline;         /** @brief Earliest deadline: virtual time it's due. */
+        uint16_t window_count;     /** @brief Conversions on the current window. */
+        uint32_t sum;              /** @brief Sum of the codes of the current window. */
+        uint64_t sum_squares;      /** @brief Sum of the squared codes of the current window. */
+        uint32_t variance;         /** @brief Variance of the last complete window, in codes². */
+        uint32_t conversions;      /** @brief Conversions scheduled since init. */
+    } mcp320x_scheduler_slot_t;
+
+    /**
+     * @typedef mcp320x_scheduler_t
+     * @brief Conversion scheduler. Owned by the caller; all fields are private.
+     */
+    typedef struct
+    {
+        mcp320x_scheduler_slot_t slots[MCP320X_CHANNEL_COUNT_MAX]; /** @brief Slots. */
+        uint8_t slot_count;                                        /** @brief Slots used. */
+        mcp320x_scheduler_policy_t policy;                         /** @brief How the conversions are interleaved. */
+        uint16_t window;                                           /** @brief Conversions per variance window; 0 without adaptation. */
+        uint32_t variance_high;                                    /** @brief Doubles the weight above it. */
+        uint32_t variance_low;                                     /** @brief Halves the weight below it. */
+    } mcp320x_scheduler_t;
+
+    /**
+     * @typedef mcp320x_scheduler_stats_t
+     * @brief Per slot counters of a scheduler.
+     */
+    typedef struct
+    {
+        uint32_t conversions[MCP320X_CHANNEL_COUNT_MAX]; /** @brief Conversions scheduled since init. Divided by their total, the share of the bus of each slot. */
+        uint8_t weights[MCP320X_CHANNEL_COUNT_MAX];      /** @brief Current weight. */
+        uint32_t variances[MCP320X_CHANNEL_COUNT_MAX];   /** @brief Variance of the last complete window, in codes²; 0 without adaptation. */
+    } mcp320x_scheduler_stats_t;
+
+    /**
+     * @brief Initialize, or reset, a conversion scheduler.
+     * @param[out] scheduler Conversion scheduler.
+     * @param[in] config Pointer to a @ref mcp320x_scheduler_config_t struct specifying the slots.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_scheduler_init(mcp320x_scheduler_t *scheduler, mcp320x_scheduler_config_t const *config);
+
+    /**
+     * @brief Get the next conversions of the sequence, to read them with @ref mcp320x_read_batch.
+     * @param[in,out] scheduler Conversion scheduler.
+     * @param[out] requests Array of \p count requests.
+     * @param[out] slots Array of \p count slot indexes, one per request.
+     * @param[in] count Number of conversions.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_scheduler_next(mcp320x_scheduler_t *scheduler, mcp320x_request_t *requests, uint8_t *slots, size_t count);
+
+    /**
+     * @brief Feed the codes of the conversions to the adaptation, which changes the weights at the end of each window.
+     * @param[in,out] scheduler Conversion scheduler.
+     * @param[in] slots Array of \p count slot indexes, as returned by @ref mcp320x_scheduler_next.
+     * @param[in] codes Array of \p count digital codes.
+     * @param[in] count Number of digital codes.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_scheduler_update(mcp320x_scheduler_t *scheduler, uint8_t const *slots, uint16_t const *codes, size_t count);
+
+    /**
+     * @brief Read the next conversions of the sequence and feed them to the adaptation.
+     * @details Reads @ref MCP320X_BATCH_QUEUE_SIZE conversions per batch, and adapts the weights between batches.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
+     * For high \p count, acquire the handle with @ref mcp320x_acquire.
+     * @param[in,out] scheduler Conversion scheduler.
+     * @param[in] handle MCP320X handle.
+     * @param[out] slots Array of \p count slot indexes, telling the slot of each code.
+     * @param[out] values Array of \p count digital codes.
+     * @param[in] count Number of conversions.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_scheduler_read(mcp320x_scheduler_t *scheduler, mcp320x_t *handle, uint8_t *slots, uint16_t *values, size_t count);
+
+    /**
+     * @brief Get the counters of each slot.
+     * @param[in] scheduler Conversion scheduler.
+     * @param[out] stats Pointer to where the counters will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_scheduler_get_stats(mcp320x_scheduler_t const *scheduler, mcp320x_scheduler_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,108 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_STATS_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_STATS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef mcp320x_stats_t
+     * @brief Performance counters of a handle.
+     */
+    typedef struct
+    {
+        uint32_t transactions;           /** @brief Transport transfers: one per single read, one per batch of up to @ref MCP320X_BATCH_QUEUE_SIZE frames, one per queued frame. */
+        uint32_t samples;                /** @brief Conversions completed. */
+        uint32_t errors;                 /** @brief Failed transactions and bus acquisitions. */
+        uint32_t errors_spi_bus;         /** @brief Errors with code MCP320X_ERR_SPI_BUS. */
+        uint32_t errors_spi_bus_acquire; /** @brief Errors with code MCP320X_ERR_SPI_BUS_ACQUIRE. */
+        uint32_t errors_timeout;         /** @brief Errors with code MCP320X_ERR_TIMEOUT. */
+        uint32_t errors_other;           /** @brief Errors with any other code. */
+        uint32_t bus_acquisitions;       /** @brief Times the bus was occupied by @ref mcp320x_acquire; nested calls are not counted. */
+        uint32_t bus_wait_max_us;        /** @brief Longest wait to occupy the bus, in microseconds. */
+        uint64_t bus_wait_total_us;      /** @brief Sum of all waits to occupy the bus, in microseconds. */
+        uint32_t transaction_max_us;     /** @brief Longest transfer, in microseconds. */
+        uint64_t transaction_total_us;   /** @brief Sum of all transfers, in microseconds. Queued frames are not timed. */
+    } mcp320x_stats_t;
+
+    /**
+     * @typedef mcp320x_trace_event_t
+     * @brief Operation traced by the hooks.
+     */
+    typedef enum
+    {
+        MCP320X_TRACE_TRANSFER = 0, /** @brief Transfer of frames through the transport. */
+        MCP320X_TRACE_ACQUIRE = 1   /** @brief Occupation of the bus by @ref mcp320x_acquire. */
+    } mcp320x_trace_event_t;
+
+    /**
+     * @typedef mcp320x_trace_begin_t
+     * @brief Called right before a traced operation.
+     * @param[in] handle MCP320X handle.
+     * @param[in] event Operation about to start.
+     * @param[in] frames Frames transferred; 0 for @ref MCP320X_TRACE_ACQUIRE.
+     * @param[in] context Pointer given to @ref mcp320x_set_trace_hooks.
+     */
+    typedef void (*mcp320x_trace_begin_t)(mcp320x_t *handle, mcp320x_trace_event_t event, size_t frames, void *context);
+
+    /**
+     * @typedef mcp320x_trace_end_t
+     * @brief Called right after a traced operation.
+     * @param[in] handle MCP320X handle.
+     * @param[in] event Operation finished.
+     * @param[in] result Result of the operation.
+     * @param[in] context Pointer given to @ref mcp320x_set_trace_hooks.
+     */
+    typedef void (*mcp320x_trace_end_t)(mcp320x_t *handle, mcp320x_trace_event_t event, mcp320x_err_t result, void *context);
+
+    /**
+     * @typedef mcp320x_trace_hooks_t
+     * @brief Trace hooks of a handle, to mark the operations on a tracer like SystemView.
+     */
+    typedef struct
+    {
+        mcp320x_trace_begin_t begin; /** @brief Called before the operation; may be NULL. */
+        mcp320x_trace_end_t end;     /** @brief Called after the operation; may be NULL. */
+    } mcp320x_trace_hooks_t;
+
+    /**
+     * @brief Get the performance counters of a handle.
+     * @details Counted by the task using the handle, without atomics: on a locked handle the lock is taken to copy them,
+     * otherwise read them when the handle is idle.
+     * @note Only available when CONFIG_MCP320X_ENABLE_STATS is enabled.
+     * @param[in] handle MCP320X handle.
+     * @param[out] stats Pointer to where the counters will be stored.
+     * @return MCP320X_OK when success, MCP320X_ERR_INVALID_STATE when the counters are disabled, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_get_stats(mcp320x_t *handle, mcp320x_stats_t *stats);
+
+    /**
+     * @brief Zero the performance counters of a handle.
+     * @note Only available when CONFIG_MCP320X_ENABLE_STATS is enabled.
+     * @param[in] handle MCP320X handle.
+     * @return MCP320X_OK when success, MCP320X_ERR_INVALID_STATE when the counters are disabled, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_reset_stats(mcp320x_t *handle);
+
+    /**
+     * @brief Set the hooks called around every transfer and bus acquisition of a handle.
+     * @details Frames queued by asynchronous reads and device groups are not traced: they complete while the caller works.
+     * Neither are @ref mcp320x_read_unchecked and @ref mcp320x_read_prepared, kept bare for tight loops.
+     * @note The hooks run on the task doing the operation, inside the lock of a locked handle: keep them short.
+     * @note Only available when CONFIG_MCP320X_ENABLE_STATS is enabled.
+     * @param[in] handle MCP320X handle.
+     * @param[in] hooks Pointer to the hooks, copied; NULL to remove them.
+     * @param[in] context Passed to the hooks.
+     * @return MCP320X_OK when success, MCP320X_ERR_INVALID_STATE when the hooks are disabled, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_set_trace_hooks(mcp320x_t *handle, mcp320x_trace_hooks_t const *hooks, void *context);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,108 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_STREAM_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_STREAM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "esp32_driver_mcp320x/mcp320x.h"
+#include "esp32_driver_mcp320x/mcp320x_filter.h"
+#include "esp32_driver_mcp320x/mcp320x_alarm.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_STREAM_RATE_MAX_HZ 20000           /** @brief Maximum scan rate, in Hz, limited by the esp_timer minimum period (50us). */
+#define MCP320X_STREAM_TASK_STACK_SIZE_DEFAULT 2048 /** @brief Stack, in bytes, of the acquisition task when task_stack_size is 0. */
+
+    /**
+     * @typedef mcp320x_stream_overflow_t
+     * @brief What to do when the ring is full.
+     */
+    typedef enum
+    {
+        MCP320X_STREAM_OVERFLOW_DROP_OLDEST = 0, /** @brief Discard the oldest scans to store the new one. */
+        MCP320X_STREAM_OVERFLOW_BLOCK = 1        /** @brief Stop converting until the consumer frees space. */
+    } mcp320x_stream_overflow_t;
+
+    /**
+     * @typedef mcp320x_stream_config_t
+     * @brief Configuration for a background acquisition.
+     */
+    typedef struct
+    {
+        uint8_t channel_mask;                      /** @brief Channels to convert on each scan; bit N = channel N. */
+        mcp320x_read_mode_t read_mode;             /** @brief Read mode used by all channels. */
+        uint32_t rate_hz;                          /** @brief Scans per second, up to @ref MCP320X_STREAM_RATE_MAX_HZ. */
+        size_t ring_capacity;                      /** @brief Digital codes the ring can hold. Rounded up to a power of two. */
+        mcp320x_stream_overflow_t overflow_policy; /** @brief What to do when the ring is full. */
+        UBaseType_t task_priority;                 /** @brief Priority of the acquisition task. */
+        BaseType_t task_core;                      /** @brief Core the acquisition task is pinned to, or tskNO_AFFINITY. */
+        uint32_t task_stack_size;                  /** @brief Stack of the acquisition task, in bytes; 0 for @ref MCP320X_STREAM_TASK_STACK_SIZE_DEFAULT. It also runs the filter and the alarm callback. */
+        mcp320x_filter_t *filter;                  /** @brief Applied to every scan before it's stored, with one channel per converted channel; NULL stores the codes. Used by the acquisition task until stopped. */
+        mcp320x_alarm_t *alarm;                    /** @brief Compares every scan, after the filter, with one channel per converted channel; NULL for none. Its callback runs on the acquisition task. */
+    } mcp320x_stream_config_t;
+
+    /**
+     * @typedef mcp320x_stream_stats_t
+     * @brief Background acquisition counters.
+     */
+    typedef struct
+    {
+        uint32_t scans;    /** @brief Scans converted. */
+        uint32_t samples;  /** @brief Digital codes stored on the ring. */
+        uint32_t dropped;  /** @brief Digital codes discarded by @ref MCP320X_STREAM_OVERFLOW_DROP_OLDEST. */
+        uint32_t blocked;  /** @brief Times the acquisition waited for space with @ref MCP320X_STREAM_OVERFLOW_BLOCK. */
+        uint32_t overruns; /** @brief Scans not converted because the previous one was still running. */
+        uint32_t errors;   /** @brief Scans that failed to convert. */
+    } mcp320x_stream_stats_t;
+
+    /**
+     * @brief Start converting in background, storing the digital codes on a ring.
+     * @details Each scan stores one digital code per channel in \p channel_mask, in ascending channel order.
+     * The acquisition task occupies the SPI bus until @ref mcp320x_stream_stop is called. On a locked handle, it
+     * takes the lock and the bus for each scan only, so other tasks can keep using the handle.
+     * @note Read the ring in multiples of the channel count to keep the scans aligned.
+     * @param[in] handle MCP320X handle.
+     * @param[in] config Pointer to a @ref mcp320x_stream_config_t struct specifying how to acquire.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_stream_start(mcp320x_t *handle, mcp320x_stream_config_t const *config);
+
+    /**
+     * @brief Stop converting in background and release the SPI bus.
+     * @note Not read digital codes are lost.
+     * @param[in] handle MCP320X handle.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_stream_stop(mcp320x_t *handle);
+
+    /**
+     * @brief Read digital codes stored by the background acquisition, without waiting.
+     * @note Only one task can read from a stream.
+     * @param[in] handle MCP320X handle.
+     * @param[out] values Array where the values will be stored.
+     * @param[in] length Maximum number of values to read.
+     * @param[out] read_count Pointer to where the number of values read will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_stream_read(mcp320x_t *handle,
+                                      uint16_t *values,
+                                      size_t length,
+                                      size_t *read_count);
+
+    /**
+     * @brief Get the background acquisition counters.
+     * @param[in] handle MCP320X handle.
+     * @param[out] stats Pointer to where the counters will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_stream_get_stats(mcp320x_t *handle, mcp320x_stream_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,186 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_TRANSPORT_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_TRANSPORT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "driver/gpio.h"
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_TRANSPORT_FRAME_BITS 19                        /** @brief Clocks of one frame: 5 command, 2 sample/null and 12 data. */
+#define MCP320X_TRANSPORT_FRAME_SIZE 4                         /** @brief Bytes between two frames on frame buffers; frames are sent MSB first. */
+#define MCP320X_TRANSPORT_PREPARED_SIZE MCP320X_PREPARED_SIZE /** @brief Bytes a transport can use to store a prepared transfer. */
+
+    // Capabilities
+
+#define MCP320X_TRANSPORT_CAP_BATCH (1 << 0) /** @brief Frames of one transfer go back-to-back: a transfer of many frames is faster than many transfers. */
+#define MCP320X_TRANSPORT_CAP_DMA (1 << 1)   /** @brief Frame buffers must be on DMA capable memory. */
+
+    /**
+     * @typedef mcp320x_transport_done_t
+     * @brief Completion of a frame queued by @ref mcp320x_transport_t.submit. Called from the transport interrupt.
+     * @param[in] user Pointer given to submit.
+     * @param[in] rx Frame of @ref MCP320X_TRANSPORT_FRAME_SIZE bytes with the answer.
+     */
+    typedef void (*mcp320x_transport_done_t)(void *user, uint8_t const *rx);
+
+    /**
+     * @typedef mcp320x_transport_t
+     * @brief How the driver talks to the device. All functions receive the
+     * context created by install.
+     */
+    struct mcp320x_transport_t
+    {
+        uint32_t capabilities; /** @brief MCP320X_TRANSPORT_CAP_* flags. */
+
+        /**
+         * @brief Create the transport context.
+         * @param[in] config Device configuration; \p transport_config holds the transport specific one.
+         * @param[out] context Pointer to where the context will be stored.
+         * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+         */
+        mcp320x_err_t (*install)(mcp320x_config_t const *config, void **context);
+
+        /**
+         * @brief Free the transport context.
+         * @param[in] context Transport context.
+         * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+         */
+        mcp320x_err_t (*remove)(void *context);
+
+        /**
+         * @brief Send frames, each one on its own chip select assertion, and receive the answers.
+         * @param[in] context Transport context.
+         * @param[in] tx Buffer with \p count frames of @ref MCP320X_TRANSPORT_FRAME_SIZE bytes.
+         * @param[out] rx Buffer with \p count frames of @ref MCP320X_TRANSPORT_FRAME_SIZE bytes.
+         * @param[in] count Number of frames, from 1 to @ref MCP320X_BATCH_QUEUE_SIZE.
+         * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+         */
+        mcp320x_err_t (*transfer)(void *context, uint8_t const *tx, uint8_t *rx, size_t count);
+
+        /**
+         * @brief Occupy the bus. Optional.
+         * @param[in] context Transport context.
+         * @param[in] timeout Time to wait for the bus.
+         * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+         */
+        mcp320x_err_t (*acquire)(void *context, TickType_t timeout);
+
+        /**
+         * @brief Release the bus. Optional.
+         * @param[in] context Transport context.
+         * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+         */
+        mcp320x_err_t (*release)(void *context);
+
+        /**
+         * @brief Get the actual clock frequency.
+         * @param[in] context Transport context.
+         * @param[out] frequency_hz Pointer to where the frequency in Hertz will be stored.
+         * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+         */
+        mcp320x_err_t (*get_actual_freq)(void *context, uint32_t *frequency_hz);
+
+        /**
+         * @brief Build, once, everything needed to send a frame, so it can be sent many times. Optional.
+         * @note When NULL, prepared reads send the pre-encoded frame with \p transfer.
+         * @param[in] context Transport context.
+         * @param[in] tx Frame of @ref MCP320X_TRANSPORT_FRAME_SIZE bytes.
+         * @param[out] prepared Storage of @ref MCP320X_TRANSPORT_PREPARED_SIZE bytes, aligned to 8 bytes.
+         * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+         */
+        mcp320x_err_t (*prepare)(void *context, uint8_t const *tx, void *prepared);
+
+        /**
+         * @brief Send a frame built by \p prepare and receive the answer. Set if, and only if, \p prepare is set.
+         * @param[in] context Transport context.
+         * @param[in,out] prepared Storage filled by \p prepare.
+         * @param[out] rx Frame of @ref MCP320X_TRANSPORT_FRAME_SIZE bytes.
+         * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+         */
+        mcp320x_err_t (*transfer_prepared)(void *context, void *prepared, uint8_t *rx);
+
+        /**
+         * @brief Queue a frame and return without waiting for it. Optional.
+         * @note When NULL, asynchronous reads are sent with \p transfer when submitted.
+         * @note The driver never has more than @ref MCP320X_BATCH_QUEUE_SIZE frames submitted and not collected.
+         * @param[in] context Transport context.
+         * @param[in] tx Frame of @ref MCP320X_TRANSPORT_FRAME_SIZE bytes. Copied.
+         * @param[in] done Called when the frame is transferred, from the transport interrupt.
+         * @param[in] user Passed to \p done.
+         * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+         */
+        mcp320x_err_t (*submit)(void *context, uint8_t const *tx, mcp320x_transport_done_t done, void *user);
+
+        /**
+         * @brief Wait for the oldest submitted frame and receive its answer. Set if, and only if, \p submit is set.
+         * @param[in] context Transport context.
+         * @param[out] rx Frame of @ref MCP320X_TRANSPORT_FRAME_SIZE bytes.
+         * @param[in] timeout Time to wait for the frame.
+         * @return MCP320X_OK when success, MCP320X_ERR_TIMEOUT when the frame is still being transferred, otherwise any MCP320X_ERR* code.
+         */
+        mcp320x_err_t (*collect)(void *context, uint8_t *rx, TickType_t timeout);
+    };
+
+    /**
+     * @typedef mcp320x_transport_gpio_config_t
+     * @brief Configuration of the bit-bang transport. Chip select is @ref mcp320x_config_t.cs_io_num.
+     */
+    typedef struct
+    {
+        gpio_num_t sclk_io_num; /** @brief GPIO pin used for the clock (CLK). */
+        gpio_num_t mosi_io_num; /** @brief GPIO pin used for the device input (DIN). */
+        gpio_num_t miso_io_num; /** @brief GPIO pin used for the device output (DOUT). */
+    } mcp320x_transport_gpio_config_t;
+
+    /**
+     * @typedef mcp320x_transport_mock_t
+     * @brief In-memory device of the mock transport, owned by the caller.
+     */
+    typedef struct
+    {
+        uint16_t codes[MCP320X_CHANNEL_COUNT_MAX]; /** @brief Digital code returned by each channel; differential reads return the code of IN+. */
+        uint32_t transfers;                        /** @brief Transfers done. */
+        uint32_t frames;                           /** @brief Frames transferred. */
+        uint32_t acquired;                         /** @brief Times the bus was acquired and not released yet. */
+    } mcp320x_transport_mock_t;
+
+    /**
+     * @brief ESP-IDF SPI master, queuing batches back-to-back; single frames are polled.
+     * @details Default transport. Uses @ref mcp320x_config_t.host and @ref mcp320x_config_t.cs_io_num.
+     */
+    extern const mcp320x_transport_t mcp320x_transport_spi_queued;
+
+    /**
+     * @brief ESP-IDF SPI master, polling every frame. Lowest latency, no interrupts; the CPU busy-waits.
+     * @details Uses @ref mcp320x_config_t.host and @ref mcp320x_config_t.cs_io_num.
+     */
+    extern const mcp320x_transport_t mcp320x_transport_spi_polling;
+
+    /**
+     * @brief Bit-bang over GPIOs, for boards without a free SPI host.
+     * @details Uses dedicated GPIOs on chips that have them, otherwise the GPIO driver.
+     * Requires a @ref mcp320x_transport_gpio_config_t as \p transport_config.
+     * The clock is timed with busy waits. The pins belong to the handle, so acquire and release do nothing.
+     * @note Each frame runs in a critical section, because a stopped clock corrupts the conversion: interrupts on
+     * the core are held off for 19 clocks, 9.5us at 2MHz but 1.9ms at @ref MCP320X_CLOCK_MIN_HZ.
+     */
+    extern const mcp320x_transport_t mcp320x_transport_gpio;
+
+    /**
+     * @brief In-memory device, for tests without hardware.
+     * @details Requires a @ref mcp320x_transport_mock_t as \p transport_config, which must outlive the handle.
+     */
+    extern const mcp320x_transport_t mcp320x_transport_mock;
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,96 @@
+#ifndef __ESP32_DRIVER_MCP320X_MCP320X_UNITS_H__
+#define __ESP32_DRIVER_MCP320X_MCP320X_UNITS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp32_driver_mcp320x/mcp320x.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Constants
+
+#define MCP320X_UNITS_TABLE_SIZE 4096                  /** @brief Entries of a direct table: one per digital code. */
+#define MCP320X_UNITS_TABLE_SIZE_MIN 3                 /** @brief Entries of the smallest interpolated table: codes 0, 2048 and 4096. */
+#define MCP320X_UNITS_TABLE_SIZE_MAX_INTERPOLATED 2049 /** @brief Entries of the largest interpolated table: every 2 codes. */
+
+    /**
+     * @typedef mcp320x_units_channel_t
+     * @brief Transfer function of one channel. All fields are private.
+     */
+    typedef struct
+    {
+        int32_t const *table; /** @brief Values at every 2^shift codes; NULL converts to the code itself. */
+        uint16_t size;        /** @brief Entries of the table. */
+        uint8_t shift;        /** @brief Codes between entries, as a power of 2; 0 for a direct table. */
+    } mcp320x_units_channel_t;
+
+    /**
+     * @typedef mcp320x_units_t
+     * @brief Transfer functions of every channel of a device. Owned by the caller; all fields are private.
+     */
+    typedef struct
+    {
+        mcp320x_units_channel_t channels[MCP320X_CHANNEL_COUNT_MAX]; /** @brief Channels. */
+    } mcp320x_units_t;
+
+    /**
+     * @brief Initialize, or reset, the transfer functions. Every channel starts converting to the code itself.
+     * @param[out] units Transfer functions.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_units_init(mcp320x_units_t *units);
+
+    /**
+     * @brief Set the transfer function of a channel as a table of its values, in any unit.
+     * @details Generate tables at build time with mcp320x_units_add_table, from tools/mcp320x_units.cmake, out of a
+     * description of a linear, polynomial, piecewise or thermistor transfer function.
+     * @param[in,out] units Transfer functions.
+     * @param[in] channel Channel.
+     * @param[in] table Array of \p size values, used until the channel is set again: one per code with
+     * @ref MCP320X_UNITS_TABLE_SIZE, otherwise at every 4096 / (size - 1) codes, from code 0 to 4096.
+     * @param[in] size Number of values: @ref MCP320X_UNITS_TABLE_SIZE, or 4096 / 2^k + 1 from
+     * @ref MCP320X_UNITS_TABLE_SIZE_MIN to @ref MCP320X_UNITS_TABLE_SIZE_MAX_INTERPOLATED.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_units_set_table(mcp320x_units_t *units, mcp320x_channel_t channel, int32_t const *table, uint16_t size);
+
+    /**
+     * @brief Convert digital codes of a channel to its unit.
+     * @details No floating point: a lookup per code with a direct table, or two lookups and a linear interpolation
+     * with an interpolated one.
+     * @param[in] units Transfer functions.
+     * @param[in] channel Channel the codes were read from.
+     * @param[in] codes Array of \p count digital codes.
+     * @param[out] values Array of \p count elements where the values will be stored.
+     * @param[in] count Number of digital codes.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_units_convert(mcp320x_units_t const *units,
+                                        mcp320x_channel_t channel,
+                                        uint16_t const *codes,
+                                        int32_t *values,
+                                        size_t count);
+
+    /**
+     * @brief Read a channel and convert it to its unit.
+     * @note This function is not thread safe when multiple tasks access the same SPI device, unless the handle is locked.
+     * @param[in] handle MCP320X handle.
+     * @param[in] units Transfer functions of the device.
+     * @param[in] channel Channel to read from.
+     * @param[in] read_mode Read mode.
+     * @param[out] value Pointer to where the value will be stored.
+     * @return MCP320X_OK when success, otherwise any MCP320X_ERR* code.
+     */
+    mcp320x_err_t mcp320x_units_read(mcp320x_t *handle,
+                                     mcp320x_units_t const *units,
+                                     mcp320x_channel_t channel,
+                                     mcp320x_read_mode_t read_mode,
+                                     int32_t *value);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
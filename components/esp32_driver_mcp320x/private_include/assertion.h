@@ -1,6 +1,7 @@
 #ifndef __ESP32_DRIVER_MCP320X_ASSERTION_H__
 #define __ESP32_DRIVER_MCP320X_ASSERTION_H__
 
+#include "sdkconfig.h"
 #include "log.h"
 
 #ifdef __cplusplus
@@ -23,6 +24,21 @@ extern "C"
         return (return_value);                                   \
     }
 
+/**
+ * @brief Return a given value if an argument is not valid.
+ * @note Compiled out, with its message, when CONFIG_MCP320X_ENABLE_CHECKS is disabled.
+ * @param condition Condition to evaluate.
+ * @param message Message to be logged if the condition is false.
+ * @param return_value Value to be returned if the condition is false.
+ * @return \p return_value if the condition is false, otherwise the
+ * method will continue.
+ */
+#if CONFIG_MCP320X_ENABLE_CHECKS
+#define CMP_CHECK_ARG(condition, message, return_value) CMP_CHECK(condition, message, return_value)
+#else
+#define CMP_CHECK_ARG(condition, message, return_value)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
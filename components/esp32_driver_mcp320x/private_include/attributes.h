@@ -0,0 +1,23 @@
+#ifndef __ESP32_DRIVER_MCP320X_ATTRIBUTES_H__
+#define __ESP32_DRIVER_MCP320X_ATTRIBUTES_H__
+
+#include "sdkconfig.h"
+#include "esp_attr.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if CONFIG_MCP320X_HOT_PATH_IN_IRAM
+/** @brief Placement of the functions of the single conversion path. */
+#define MCP320X_HOT_ATTR IRAM_ATTR
+#else
+/** @brief Placement of the functions of the single conversion path. */
+#define MCP320X_HOT_ATTR
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif
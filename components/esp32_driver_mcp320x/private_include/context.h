@@ -0,0 +1,84 @@
+#ifndef __ESP32_DRIVER_MCP320X_CONTEXT_H__
+#define __ESP32_DRIVER_MCP320X_CONTEXT_H__
+
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp32_driver_mcp320x/mcp320x.h"
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+#include "esp32_driver_mcp320x/mcp320x_async.h"
+#include "esp32_driver_mcp320x/mcp320x_group.h"
+#include "esp32_driver_mcp320x/mcp320x_stats.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef mcp320x_stream_t
+     * @brief Background acquisition state, owned by the stream module.
+     */
+    typedef struct mcp320x_stream_t mcp320x_stream_t;
+
+    /**
+     * @typedef mcp320x_broker_t
+     * @brief Request broker state, owned by the broker module.
+     */
+    typedef struct mcp320x_broker_t mcp320x_broker_t;
+
+    /**
+     * @typedef mcp320x_async_slot_t
+     * @brief An asynchronous read not collected yet.
+     */
+    typedef struct
+    {
+        mcp320x_t *handle;                        /** @brief Device the read belongs to. */
+        mcp320x_async_callback_t callback;        /** @brief Completion callback; may be NULL. */
+        void *context;                            /** @brief Passed to the callback. */
+        uint8_t rx[MCP320X_TRANSPORT_FRAME_SIZE]; /** @brief Answer, when the transport completes on submission. */
+    } mcp320x_async_slot_t;
+
+    /**
+     * @struct mcp320x_t
+     * @brief Holds control data for a context.
+     */
+    struct mcp320x_t
+    {
+        mcp320x_transport_t const *transport;                       /** @brief Transport functions. */
+        void *transport_context;                                    /** @brief Transport context, created by the transport install. */
+        mcp320x_model_t mcp_model;                                  /** @brief Device model. */
+        uint16_t reference_voltage;                                 /** @brief Reference voltage, in millivolts. */
+        uint32_t microvolts_scale;                                  /** @brief Microvolts per digital code, Q23.9 (Vref * 1000 / MCP320X_RESOLUTION). */
+        uint8_t *tx_frames;                                         /** @brief Request frames of batch reads, on DMA capable memory if the transport requires. */
+        uint8_t *rx_frames;                                         /** @brief Response frames of batch reads, on DMA capable memory if the transport requires. */
+        mcp320x_stream_t *stream;                                   /** @brief Background acquisition, NULL when not streaming. */
+        mcp320x_broker_t *broker;                                   /** @brief Request broker, NULL when not started. */
+        mcp320x_async_slot_t async_slots[MCP320X_ASYNC_QUEUE_SIZE]; /** @brief Asynchronous reads, collected in order. */
+        uint8_t async_head;                                         /** @brief Slot of the oldest asynchronous read. */
+        uint8_t async_count;                                        /** @brief Asynchronous reads not collected yet. */
+        uint8_t acquired;                                           /** @brief Nesting of bus acquisitions; the bus is occupied on the first. */
+        SemaphoreHandle_t lock;                                     /** @brief Recursive mutex of a locked handle, otherwise NULL. */
+        mcp320x_lock_stats_t lock_stats;                            /** @brief Lock contention; only changed by the lock holder. */
+#if CONFIG_MCP320X_ENABLE_STATS
+        mcp320x_stats_t stats;                                      /** @brief Performance counters; only changed by the task using the handle. */
+        mcp320x_trace_hooks_t trace_hooks;                          /** @brief Called around transfers and bus acquisitions. */
+        void *trace_context;                                        /** @brief Passed to the trace hooks. */
+#endif
+    };
+
+    /**
+     * @struct mcp320x_group_t
+     * @brief Holds control data for a device group.
+     */
+    struct mcp320x_group_t
+    {
+        mcp320x_t *devices[MCP320X_GROUP_DEVICES_MAX]; /** @brief Devices, in the order of the configurations. */
+        size_t count;                                  /** @brief Devices installed. */
+        mcp320x_model_t model;                         /** @brief Smallest model, whose channels every device has. */
+    };
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,80 @@
+#ifndef __ESP32_DRIVER_MCP320X_CONVERSION_H__
+#define __ESP32_DRIVER_MCP320X_CONVERSION_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Conversions are done with integers only, rounding to the nearest value:
+//
+//   millivolts = round(code * Vref / 4096)
+//              = (code * Vref + 2048) >> 12
+//
+//   microvolts = round(code * Vref * 1000 / 4096)
+//              = round(code * (Vref * 125) / 512)
+//              = (code * (Vref * 125) + 256) >> 9
+//
+// With code <= 4095 and Vref <= MCP320X_REF_VOLTAGE_MAX (7000mV) both
+// products fit in 32 bits: 4095 * 7000 * 125 = 3583125000.
+
+/** @brief Precomputed microvolts scale for a reference voltage, in millivolts. */
+#define MCP320X_MICROVOLTS_SCALE(reference_voltage) ((uint32_t)(reference_voltage) * 125)
+
+    /**
+     * @brief Convert a digital code to millivolts.
+     * @param[in] code Digital code from 0 to 4095.
+     * @param[in] reference_voltage Reference voltage, in millivolts.
+     * @return Voltage, in millivolts.
+     */
+    static inline uint16_t mcp320x_code_to_millivolts(uint32_t code, uint32_t reference_voltage)
+    {
+        return (uint16_t)((code * reference_voltage + 2048) >> 12);
+    }
+
+    /**
+     * @brief Convert a digital code to microvolts.
+     * @param[in] code Digital code from 0 to 4095.
+     * @param[in] microvolts_scale Scale from @ref MCP320X_MICROVOLTS_SCALE.
+     * @return Voltage, in microvolts.
+     */
+    static inline uint32_t mcp320x_code_to_microvolts(uint32_t code, uint32_t microvolts_scale)
+    {
+        return (code * microvolts_scale + 256) >> 9;
+    }
+
+    /**
+     * @brief Convert the sum of many digital codes to their mean voltage, in millivolts.
+     * @note Rounding is done once, over the sum, keeping the extra resolution of the mean.
+     * @param[in] sum Sum of the digital codes.
+     * @param[in] count How many digital codes were summed.
+     * @param[in] reference_voltage Reference voltage, in millivolts.
+     * @return Voltage, in millivolts.
+     */
+    static inline uint16_t mcp320x_sum_to_millivolts(uint64_t sum, uint32_t count, uint32_t reference_voltage)
+    {
+        const uint64_t divisor = (uint64_t)count << 12;
+
+        return (uint16_t)((sum * reference_voltage + (divisor >> 1)) / divisor);
+    }
+
+    /**
+     * @brief Convert the sum of many digital codes to their mean voltage, in microvolts.
+     * @param[in] sum Sum of the digital codes.
+     * @param[in] count How many digital codes were summed.
+     * @param[in] microvolts_scale Scale from @ref MCP320X_MICROVOLTS_SCALE.
+     * @return Voltage, in microvolts.
+     */
+    static inline uint32_t mcp320x_sum_to_microvolts(uint64_t sum, uint32_t count, uint32_t microvolts_scale)
+    {
+        const uint64_t divisor = (uint64_t)count << 9;
+
+        return (uint32_t)((sum * microvolts_scale + (divisor >> 1)) / divisor);
+    }
+
+#ifdef __cplusplus
+}
+#endif
+#endif
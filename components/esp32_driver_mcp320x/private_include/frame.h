@@ -0,0 +1,61 @@
+#ifndef __ESP32_DRIVER_MCP320X_FRAME_H__
+#define __ESP32_DRIVER_MCP320X_FRAME_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp32_driver_mcp320x/mcp320x.h"
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define MCP320X_FRAME_BITS MCP320X_TRANSPORT_FRAME_BITS /** @brief Clocks needed by one conversion: 5 command, 2 sample/null and 12 data. */
+#define MCP320X_FRAME_SIZE MCP320X_TRANSPORT_FRAME_SIZE /** @brief Bytes used by one frame on frame buffers; word sized so every frame is word aligned. */
+
+    /**
+     * @brief Encode a conversion request into a frame.
+     * @param[in] channel Channel to read from.
+     * @param[in] read_mode Read mode.
+     * @param[out] frame Frame with @ref MCP320X_FRAME_SIZE bytes.
+     */
+    void mcp320x_frame_encode(mcp320x_channel_t channel, mcp320x_read_mode_t read_mode, uint8_t *frame);
+
+    /**
+     * @brief Decode the digital code of a received frame.
+     * @param[in] frame Frame with @ref MCP320X_FRAME_SIZE bytes.
+     * @return Digital code from 0 to 4096 (MCP320X_RESOLUTION).
+     */
+    uint16_t mcp320x_frame_decode(uint8_t const *frame);
+
+    /**
+     * @brief Decode the digital codes of many contiguous received frames.
+     * @note Uses @ref mcp320x_decode_frames_word unless MCP320X_DECODE_FRAMES_SCALAR is defined.
+     * @param[in] rx Buffer with \p count frames of @ref MCP320X_FRAME_SIZE bytes each.
+     * @param[in] count Number of frames.
+     * @param[out] values Array of \p count elements where the values will be stored.
+     */
+    void mcp320x_decode_frames(uint8_t const *rx, size_t count, uint16_t *values);
+
+    /**
+     * @brief Reference implementation of @ref mcp320x_decode_frames, one byte at a time.
+     * @param[in] rx Buffer with \p count frames of @ref MCP320X_FRAME_SIZE bytes each.
+     * @param[in] count Number of frames.
+     * @param[out] values Array of \p count elements where the values will be stored.
+     */
+    void mcp320x_decode_frames_scalar(uint8_t const *rx, size_t count, uint16_t *values);
+
+    /**
+     * @brief Implementation of @ref mcp320x_decode_frames loading one 32-bit word per frame.
+     * @note \p rx doesn't need to be aligned.
+     * @param[in] rx Buffer with \p count frames of @ref MCP320X_FRAME_SIZE bytes each.
+     * @param[in] count Number of frames.
+     * @param[out] values Array of \p count elements where the values will be stored.
+     */
+    void mcp320x_decode_frames_word(uint8_t const *rx, size_t count, uint16_t *values);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,47 @@
+#ifndef __ESP32_DRIVER_MCP320X_ISQRT_H__
+#define __ESP32_DRIVER_MCP320X_ISQRT_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Integer square root, bit by bit.
+     * @param[in] value Value.
+     * @return floor(sqrt(value)).
+     */
+    static inline uint32_t mcp320x_isqrt(uint64_t value)
+    {
+        uint64_t root = 0;
+        uint64_t bit = 1ULL << 62;
+
+        while (bit > value)
+        {
+            bit >>= 2;
+        }
+
+        while (bit != 0)
+        {
+            if (value >= root + bit)
+            {
+                value -= root + bit;
+                root = (root >> 1) + bit;
+            }
+            else
+            {
+                root >>= 1;
+            }
+
+            bit >>= 2;
+        }
+
+        return (uint32_t)root;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+#endif
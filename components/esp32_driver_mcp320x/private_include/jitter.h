@@ -0,0 +1,54 @@
+#ifndef __ESP32_DRIVER_MCP320X_JITTER_H__
+#define __ESP32_DRIVER_MCP320X_JITTER_H__
+
+#include <stdint.h>
+#include "esp32_driver_mcp320x/mcp320x_capture.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef mcp320x_jitter_t
+     * @brief Accumulates the interval errors of timestamps taken at a fixed period.
+     * @note Only depends on the timestamps given, so it can be fed by any clock, virtual ones included.
+     */
+    typedef struct
+    {
+        uint32_t period_us;     /** @brief Expected interval. */
+        uint32_t last_us;       /** @brief Previous timestamp. */
+        uint32_t intervals;     /** @brief Intervals accumulated. */
+        uint32_t missed;        /** @brief Periods skipped. */
+        int32_t error_min_us;   /** @brief Smallest error. */
+        int32_t error_max_us;   /** @brief Biggest error. */
+        int64_t error_sum;      /** @brief Sum of the errors, in microseconds. */
+        uint64_t error_squares; /** @brief Sum of the squared errors, in microseconds^2. */
+    } mcp320x_jitter_t;
+
+    /**
+     * @brief Initialize an accumulator.
+     * @param[out] jitter Accumulator.
+     * @param[in] period_us Expected interval, from 1us to 1s.
+     * @param[in] start_us Timestamp the first interval starts from.
+     */
+    void mcp320x_jitter_init(mcp320x_jitter_t *jitter, uint32_t period_us, uint32_t start_us);
+
+    /**
+     * @brief Accumulate the interval ending at a timestamp.
+     * @param[in,out] jitter Accumulator.
+     * @param[in] timestamp_us Timestamp, after the previous one. Wraps around like an uint32_t.
+     */
+    void mcp320x_jitter_add(mcp320x_jitter_t *jitter, uint32_t timestamp_us);
+
+    /**
+     * @brief Get the statistics of the intervals accumulated.
+     * @param[in] jitter Accumulator.
+     * @param[out] stats Pointer to where the statistics will be stored.
+     */
+    void mcp320x_jitter_get_stats(mcp320x_jitter_t const *jitter, mcp320x_capture_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
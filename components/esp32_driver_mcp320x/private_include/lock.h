@@ -0,0 +1,31 @@
+#ifndef __ESP32_DRIVER_MCP320X_LOCK_H__
+#define __ESP32_DRIVER_MCP320X_LOCK_H__
+
+#include "freertos/FreeRTOS.h"
+#include "context.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Take the lock of a handle. Does nothing when the handle is not locked.
+     * @details The lock is recursive: the holder can take it again, giving it back as many times. Waits are counted
+     * on the lock statistics.
+     * @param[in] handle MCP320X handle.
+     * @param[in] timeout Time to wait for the lock.
+     * @return MCP320X_OK when success, otherwise MCP320X_ERR_TIMEOUT.
+     */
+    mcp320x_err_t mcp320x_lock_take(mcp320x_t *handle, TickType_t timeout);
+
+    /**
+     * @brief Give back the lock of a handle. Does nothing when the handle is not locked.
+     * @param[in] handle MCP320X handle.
+     */
+    void mcp320x_lock_give(mcp320x_t *handle);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -8,8 +8,8 @@ extern "C"
 {
 #endif
 
-    /** @brief Description text used for logging. */
-    static const char *TAG = "MCP320X";
+    /** @brief Description text used for logging. Unused on files whose only logs are compiled out argument checks. */
+    __attribute__((unused)) static const char *TAG = "MCP320X";
 
 /**
  * @brief Log a verbose message.
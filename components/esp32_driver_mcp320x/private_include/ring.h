@@ -0,0 +1,88 @@
+#ifndef __ESP32_DRIVER_MCP320X_RING_H__
+#define __ESP32_DRIVER_MCP320X_RING_H__
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef mcp320x_ring_t
+     * @brief Single-producer/single-consumer lock-free ring of digital codes.
+     * @note Head and tail are free running counters; the slot is obtained
+     * by masking them, so the capacity must be a power of two.
+     */
+    typedef struct
+    {
+        uint16_t *buffer;   /** @brief Storage, with @ref capacity elements. */
+        size_t capacity;    /** @brief Number of elements; power of two. */
+        atomic_size_t head; /** @brief Next position to write. Only moved by the producer. */
+        atomic_size_t tail; /** @brief Next position to read. Moved by the consumer, and by the producer when overwriting. */
+    } mcp320x_ring_t;
+
+    /**
+     * @brief Initialize a ring over an existing buffer.
+     * @param[in] ring Ring to initialize.
+     * @param[in] buffer Storage with \p capacity elements.
+     * @param[in] capacity Number of elements. Must be a power of two.
+     * @return True when success, otherwise false.
+     */
+    bool mcp320x_ring_init(mcp320x_ring_t *ring, uint16_t *buffer, size_t capacity);
+
+    /**
+     * @brief Round a capacity up to the next power of two.
+     * @param[in] capacity Desired capacity.
+     * @return The smallest power of two greater than or equal to \p capacity.
+     */
+    size_t mcp320x_ring_round_capacity(size_t capacity);
+
+    /**
+     * @brief Number of elements available to read.
+     * @note Can be called by both the producer and the consumer.
+     * @param[in] ring Ring.
+     * @return Number of elements.
+     */
+    size_t mcp320x_ring_size(mcp320x_ring_t *ring);
+
+    /**
+     * @brief Write all values, only if there is space for all of them.
+     * @note Producer side only.
+     * @param[in] ring Ring.
+     * @param[in] values Values to write.
+     * @param[in] count How many values to write.
+     * @return True when written, false when there is no space.
+     */
+    bool mcp320x_ring_push(mcp320x_ring_t *ring, uint16_t const *values, size_t count);
+
+    /**
+     * @brief Write all values, discarding the oldest ones in blocks of \p count
+     * elements to open space.
+     * @note Producer side only.
+     * @note Discarding in blocks of \p count keeps the alignment of readers that
+     * always consume multiples of \p count elements.
+     * @param[in] ring Ring.
+     * @param[in] values Values to write.
+     * @param[in] count How many values to write. Must not be greater than the capacity.
+     * @return How many values were discarded.
+     */
+    size_t mcp320x_ring_push_overwrite(mcp320x_ring_t *ring, uint16_t const *values, size_t count);
+
+    /**
+     * @brief Read up to \p count values.
+     * @note Consumer side only.
+     * @param[in] ring Ring.
+     * @param[out] values Where the values will be stored.
+     * @param[in] count Maximum number of values to read.
+     * @return How many values were read.
+     */
+    size_t mcp320x_ring_pop(mcp320x_ring_t *ring, uint16_t *values, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
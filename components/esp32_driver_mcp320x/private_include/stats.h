@@ -0,0 +1,170 @@
+#ifndef __ESP32_DRIVER_MCP320X_STATS_H__
+#define __ESP32_DRIVER_MCP320X_STATS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "esp_timer.h"
+#include "context.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Counters are plain fields of the handle, changed by the task using it: on a
+// locked handle that's the lock holder. With CONFIG_MCP320X_ENABLE_STATS
+// disabled the functions are empty and the fields don't exist, so nothing is
+// left on the conversion path, not even the clock reads.
+
+#if CONFIG_MCP320X_ENABLE_STATS
+
+    /**
+     * @brief Count an error by its code.
+     * @param[in] handle MCP320X handle.
+     * @param[in] result Error code.
+     */
+    static inline void mcp320x_stats_error(mcp320x_t *handle, mcp320x_err_t result)
+    {
+        handle->stats.errors++;
+
+        switch (result)
+        {
+        case MCP320X_ERR_SPI_BUS:
+            handle->stats.errors_spi_bus++;
+            break;
+        case MCP320X_ERR_SPI_BUS_ACQUIRE:
+            handle->stats.errors_spi_bus_acquire++;
+            break;
+        case MCP320X_ERR_TIMEOUT:
+            handle->stats.errors_timeout++;
+            break;
+        default:
+            handle->stats.errors_other++;
+            break;
+        }
+    }
+
+    /**
+     * @brief Start timing an operation, calling the begin trace hook.
+     * @param[in] handle MCP320X handle.
+     * @param[in] event Operation about to start.
+     * @param[in] frames Frames transferred; 0 for MCP320X_TRACE_ACQUIRE.
+     * @return Start time, to be given to @ref mcp320x_stats_end.
+     */
+    static inline int64_t mcp320x_stats_begin(mcp320x_t *handle, mcp320x_trace_event_t event, size_t frames)
+    {
+        if (handle->trace_hooks.begin != NULL)
+        {
+            handle->trace_hooks.begin(handle, event, frames, handle->trace_context);
+        }
+
+        return esp_timer_get_time();
+    }
+
+    /**
+     * @brief Count an operation started by @ref mcp320x_stats_begin, calling the end trace hook.
+     * @param[in] handle MCP320X handle.
+     * @param[in] event Operation finished.
+     * @param[in] start Time returned by @ref mcp320x_stats_begin.
+     * @param[in] frames Frames transferred; 0 for MCP320X_TRACE_ACQUIRE.
+     * @param[in] result Result of the operation.
+     */
+    static inline void mcp320x_stats_end(mcp320x_t *handle, mcp320x_trace_event_t event, int64_t start, size_t frames, mcp320x_err_t result)
+    {
+        const uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - start);
+
+        if (event == MCP320X_TRACE_TRANSFER)
+        {
+            handle->stats.transactions++;
+            handle->stats.transaction_total_us += elapsed_us;
+
+            if (elapsed_us > handle->stats.transaction_max_us)
+            {
+                handle->stats.transaction_max_us = elapsed_us;
+            }
+
+            if (result == MCP320X_OK)
+            {
+                handle->stats.samples += frames;
+            }
+        }
+        else
+        {
+            handle->stats.bus_acquisitions++;
+            handle->stats.bus_wait_total_us += elapsed_us;
+
+            if (elapsed_us > handle->stats.bus_wait_max_us)
+            {
+                handle->stats.bus_wait_max_us = elapsed_us;
+            }
+        }
+
+        if (result != MCP320X_OK)
+        {
+            mcp320x_stats_error(handle, result);
+        }
+
+        if (handle->trace_hooks.end != NULL)
+        {
+            handle->trace_hooks.end(handle, event, result, handle->trace_context);
+        }
+    }
+
+    /**
+     * @brief Count a queued frame when it is collected. Not timed nor traced.
+     * @param[in] handle MCP320X handle.
+     * @param[in] result Result of the frame.
+     */
+    static inline void mcp320x_stats_collected(mcp320x_t *handle, mcp320x_err_t result)
+    {
+        handle->stats.transactions++;
+
+        if (result == MCP320X_OK)
+        {
+            handle->stats.samples++;
+        }
+        else
+        {
+            mcp320x_stats_error(handle, result);
+        }
+    }
+
+#else
+
+    static inline void mcp320x_stats_error(mcp320x_t *handle, mcp320x_err_t result)
+    {
+        (void)handle;
+        (void)result;
+    }
+
+    static inline int64_t mcp320x_stats_begin(mcp320x_t *handle, mcp320x_trace_event_t event, size_t frames)
+    {
+        (void)handle;
+        (void)event;
+        (void)frames;
+
+        return 0;
+    }
+
+    static inline void mcp320x_stats_end(mcp320x_t *handle, mcp320x_trace_event_t event, int64_t start, size_t frames, mcp320x_err_t result)
+    {
+        (void)handle;
+        (void)event;
+        (void)start;
+        (void)frames;
+        (void)result;
+    }
+
+    static inline void mcp320x_stats_collected(mcp320x_t *handle, mcp320x_err_t result)
+    {
+        (void)handle;
+        (void)result;
+    }
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif
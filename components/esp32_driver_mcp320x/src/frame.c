@@ -0,0 +1,138 @@
+#include <string.h>
+#include "frame.h"
+#include "attributes.h"
+
+// A frame is the shortest sequence that completes a conversion: the start
+// bit is sent on the very first clock instead of after the five filler bits
+// used by 8-bit MCUs, which takes 19 clocks instead of 24.
+// More information on section "5.0 Serial Communication" of the MCP320X datasheet.
+//
+// Frames are stored MCP320X_FRAME_SIZE bytes apart, so the buffers of
+// consecutive conversions are word aligned and can be used by DMA directly.
+
+MCP320X_HOT_ATTR void mcp320x_frame_encode(mcp320x_channel_t channel, mcp320x_read_mode_t read_mode, uint8_t *frame)
+{
+    // Request format (tx):
+    //
+    // 1 MODE C2 C1 C0 D D D _ D D D D D D D D _ D D D X X X X X _ X X X X X X X X
+    // |---------------|   |-------------|   |-------------|   |-------------|
+    //
+    // Where:
+    //   * 1: start bit.
+    //   * MODE:
+    //     - 0: differential conversion.
+    //     - 1: single conversion.
+    //   * C [0 1 2]:
+    //     -  0 0 0: channel 0
+    //     -  0 0 1: channel 1
+    //     -  0 1 0: channel 2
+    //     -  0 1 1: channel 3
+    //     -  1 0 0: channel 4
+    //     -  1 0 1: channel 5
+    //     -  1 1 0: channel 6
+    //     -  1 1 1: channel 7
+    //   * D: don't care bits, sent while the device samples and outputs data.
+    //   * X: not clocked.
+
+    frame[0] = (uint8_t)(0b10000000 | (read_mode << 6) | (channel << 3));
+    frame[1] = 0;
+    frame[2] = 0;
+    frame[3] = 0;
+}
+
+MCP320X_HOT_ATTR uint16_t mcp320x_frame_decode(uint8_t const *frame)
+{
+    // Response format (rx):
+    //
+    // X X X X X S 0 B11 _ B10 B9 B8 B7 B6 B5 B4 B3 _ B2 B1 B0 X X X X X _ X X X X X X X X
+    // |---------------|   |---------------------|   |-----------------|   |-------------|
+    //
+    // Where:
+    //   * X: dummy bits; any value.
+    //   * S: sample bit; any value.
+    //   * 0: null bit.
+    //   * B [0 1 2 3 4 5 6 7 8 9 10 11]: digital output code, uint16_t bits, big-endian.
+    //     - B11: most significant bit.
+    //     - B0: least significant bit.
+    //
+    // Result logic, taking the following sequence as example:
+    //
+    // 1270 = X X X X X X 0 0 _ 1 0 0 1 1 1 1 0 _ 1 1 0 X X X X X
+    //        |--- rx[0] ---|   |--- rx[1] ---|   |--- rx[2] ---|
+    //
+    // 1) Concat the first three bytes.
+    //    > result = X X X X X X 0 0 1 0 0 1 1 1 1 0 1 1 0 X X X X X
+    //
+    // 2) Move 5 bits to the right to drop the bits after B0.
+    //    > result = 0 0 0 0 0 X X X X X X 0 0 1 0 0 1 1 1 1 0 1 1 0
+    //
+    // 3) Clear dummy bits.
+    //    > result = 0 0 0 0 0 X X X X X X 0 0 1 0 0 1 1 1 1 0 1 1 0
+    //    > mask   = 0 0 0 0 0 0 0 0 0 0 0 0 1 1 1 1 1 1 1 1 1 1 1 1
+    //    > result = 0 0 0 0 0 0 0 0 0 0 0 0 0 1 0 0 1 1 1 1 0 1 1 0
+
+    const uint32_t bits = ((uint32_t)frame[0] << 16) | ((uint32_t)frame[1] << 8) | frame[2];
+
+    return (uint16_t)((bits >> 5) & 0b0000111111111111);
+}
+
+void mcp320x_decode_frames(uint8_t const *rx, size_t count, uint16_t *values)
+{
+#ifdef MCP320X_DECODE_FRAMES_SCALAR
+    mcp320x_decode_frames_scalar(rx, count, values);
+#else
+    mcp320x_decode_frames_word(rx, count, values);
+#endif
+}
+
+void mcp320x_decode_frames_scalar(uint8_t const *rx, size_t count, uint16_t *values)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = mcp320x_frame_decode(&rx[i * MCP320X_FRAME_SIZE]);
+    }
+}
+
+/**
+ * @brief Load a big-endian 32-bit word from any address.
+ * @note memcpy is turned into a single load where unaligned access is allowed,
+ * and into byte loads otherwise.
+ */
+static inline uint32_t mcp320x_load_be32(uint8_t const *bytes)
+{
+    uint32_t word;
+
+    memcpy(&word, bytes, sizeof(word));
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    word = __builtin_bswap32(word);
+#endif
+
+    return word;
+}
+
+void mcp320x_decode_frames_word(uint8_t const *rx, size_t count, uint16_t *values)
+{
+    // Same logic as mcp320x_frame_decode, but the whole frame is one word:
+    // B11 is bit 24 and B0 is bit 13. Unrolled by four to hide load latency.
+
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const uint32_t w0 = mcp320x_load_be32(&rx[(i + 0) * MCP320X_FRAME_SIZE]);
+        const uint32_t w1 = mcp320x_load_be32(&rx[(i + 1) * MCP320X_FRAME_SIZE]);
+        const uint32_t w2 = mcp320x_load_be32(&rx[(i + 2) * MCP320X_FRAME_SIZE]);
+        const uint32_t w3 = mcp320x_load_be32(&rx[(i + 3) * MCP320X_FRAME_SIZE]);
+
+        values[i + 0] = (uint16_t)((w0 >> 13) & 0b0000111111111111);
+        values[i + 1] = (uint16_t)((w1 >> 13) & 0b0000111111111111);
+        values[i + 2] = (uint16_t)((w2 >> 13) & 0b0000111111111111);
+        values[i + 3] = (uint16_t)((w3 >> 13) & 0b0000111111111111);
+    }
+
+    for (; i < count; i++)
+    {
+        values[i] = (uint16_t)((mcp320x_load_be32(&rx[i * MCP320X_FRAME_SIZE]) >> 13) & 0b0000111111111111);
+    }
+}
@@ -0,0 +1,65 @@
+#include <string.h>
+#include "jitter.h"
+#include "isqrt.h"
+
+void mcp320x_jitter_init(mcp320x_jitter_t *jitter, uint32_t period_us, uint32_t start_us)
+{
+    memset(jitter, 0, sizeof(mcp320x_jitter_t));
+
+    jitter->period_us = period_us;
+    jitter->last_us = start_us;
+}
+
+void mcp320x_jitter_add(mcp320x_jitter_t *jitter, uint32_t timestamp_us)
+{
+    const uint32_t interval = timestamp_us - jitter->last_us;
+    uint32_t periods = (interval + jitter->period_us / 2) / jitter->period_us;
+
+    // Intervals shorter than half a period still fill one slot.
+    if (periods == 0)
+    {
+        periods = 1;
+    }
+
+    const int32_t error = (int32_t)(interval - periods * jitter->period_us);
+
+    if (jitter->intervals == 0 || error < jitter->error_min_us)
+    {
+        jitter->error_min_us = error;
+    }
+
+    if (jitter->intervals == 0 || error > jitter->error_max_us)
+    {
+        jitter->error_max_us = error;
+    }
+
+    jitter->last_us = timestamp_us;
+    jitter->intervals++;
+    jitter->missed += periods - 1;
+    jitter->error_sum += error;
+    jitter->error_squares += (uint64_t)((int64_t)error * error);
+}
+
+void mcp320x_jitter_get_stats(mcp320x_jitter_t const *jitter, mcp320x_capture_stats_t *stats)
+{
+    stats->samples = jitter->intervals;
+    stats->missed = jitter->missed;
+    stats->error_min_us = jitter->error_min_us;
+    stats->error_max_us = jitter->error_max_us;
+    stats->error_stddev_ns = 0;
+
+    if (jitter->intervals == 0)
+    {
+        return;
+    }
+
+    // Variance = E[e^2] - E[e]^2, in ns^2. Errors are within one period
+    // (1s), so E[e^2] in ns^2 fits 64 bits; the remainder keeps the
+    // fraction of the microseconds.
+    const uint64_t n = jitter->intervals;
+    const uint64_t squares_ns = (jitter->error_squares / n) * 1000000 + (jitter->error_squares % n) * 1000000 / n;
+    const int64_t mean_ns = jitter->error_sum * 1000 / (int64_t)n;
+    const uint64_t mean_squared_ns = (uint64_t)(mean_ns * mean_ns);
+
+    stats->error_stddev_ns = squares_ns > mean_squared_ns ? mcp320x_isqrt(squares_ns - mean_squared_ns) : 0;
+}
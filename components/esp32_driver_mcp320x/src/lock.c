@@ -0,0 +1,56 @@
+#include "esp_timer.h"
+#include "attributes.h"
+#include "lock.h"
+
+// A FreeRTOS mutex, not a spinlock: conversions block on the SPI driver, which
+// can't be done with interrupts disabled. Mutexes inherit the priority of the
+// waiters, so a low priority holder can't be starved by a medium priority
+// task, and waiters are woken by priority, first come first served within one.
+//
+// The statistics are only changed by the holder, so they need no atomics. The
+// clock is only read when the lock is busy.
+
+MCP320X_HOT_ATTR mcp320x_err_t mcp320x_lock_take(mcp320x_t *handle, TickType_t timeout)
+{
+    if (handle->lock == NULL)
+    {
+        return MCP320X_OK;
+    }
+
+    if (xSemaphoreTakeRecursive(handle->lock, 0) != pdTRUE)
+    {
+        if (timeout == 0)
+        {
+            return MCP320X_ERR_TIMEOUT;
+        }
+
+        const int64_t start = esp_timer_get_time();
+
+        if (xSemaphoreTakeRecursive(handle->lock, timeout) != pdTRUE)
+        {
+            return MCP320X_ERR_TIMEOUT;
+        }
+
+        const uint32_t wait_us = (uint32_t)(esp_timer_get_time() - start);
+
+        handle->lock_stats.contentions++;
+        handle->lock_stats.wait_total_us += wait_us;
+
+        if (wait_us > handle->lock_stats.wait_max_us)
+        {
+            handle->lock_stats.wait_max_us = wait_us;
+        }
+    }
+
+    handle->lock_stats.acquisitions++;
+
+    return MCP320X_OK;
+}
+
+MCP320X_HOT_ATTR void mcp320x_lock_give(mcp320x_t *handle)
+{
+    if (handle->lock != NULL)
+    {
+        xSemaphoreGiveRecursive(handle->lock);
+    }
+}
@@ -1,17 +1,45 @@
 #include "esp32_driver_mcp320x/mcp320x.h"
+#include "esp32_driver_mcp320x/mcp320x_stream.h"
+#include "esp32_driver_mcp320x/mcp320x_broker.h"
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "attributes.h"
+#include "context.h"
+#include "frame.h"
+#include "conversion.h"
+#include "lock.h"
+#include "stats.h"
 #include "assertion.h"
 #include "log.h"
 
-/**
- * @struct mcp320x_t
- * @brief Holds control data for a context.
- */
-struct mcp320x_t
-{
-    spi_device_handle_t spi_handle;       /** @brief SPI device handle. */
-    mcp320x_model_t mcp_model;            /** @brief Device model. */
-    float millivolts_per_resolution_step; /** @brief Millivolts per resolution step (Vref / MCP320X_RESOLUTION). */
-};
+// Scans are sent with a single batch.
+_Static_assert(MCP320X_CHANNEL_COUNT_MAX <= MCP320X_BATCH_QUEUE_SIZE, "MCP320X_BATCH_QUEUE_SIZE must fit all channels");
+_Static_assert(sizeof(((mcp320x_prepared_t *)0)->tx) == MCP320X_FRAME_SIZE, "A prepared request must hold one frame");
+
+static mcp320x_err_t mcp320x_transmit_batch(mcp320x_t *handle,
+                                            mcp320x_request_t const *requests,
+                                            size_t count,
+                                            uint16_t *values);
+static mcp320x_err_t mcp320x_sample_sum(mcp320x_t *handle,
+                                        mcp320x_channel_t channel,
+                                        mcp320x_read_mode_t read_mode,
+                                        uint32_t sample_count,
+                                        uint32_t *sum);
+static mcp320x_err_t mcp320x_sample_stats_into(mcp320x_t *handle,
+                                               mcp320x_channel_t channel,
+                                               mcp320x_read_mode_t read_mode,
+                                               uint16_t sample_count,
+                                               uint8_t trim_percent,
+                                               uint16_t *samples,
+                                               mcp320x_sample_stats_t *stats);
+static mcp320x_err_t mcp320x_sample_stats_on_stack(mcp320x_t *handle,
+                                                   mcp320x_channel_t channel,
+                                                   mcp320x_read_mode_t read_mode,
+                                                   uint16_t sample_count,
+                                                   uint8_t trim_percent,
+                                                   mcp320x_sample_stats_t *stats);
+static void mcp320x_free(mcp320x_t *handle);
 
 mcp320x_t *mcp320x_install(mcp320x_config_t const *config)
 {
@@ -21,31 +49,44 @@ mcp320x_t *mcp320x_install(mcp320x_config_t const *config)
     CMP_CHECK((config->clock_speed_hz >= MCP320X_CLOCK_MIN_HZ), "clock speed error(<MCP320X_CLOCK_MIN_HZ)", NULL)
     CMP_CHECK((config->clock_speed_hz <= MCP320X_CLOCK_MAX_HZ), "clock speed error(>MCP320X_CLOCK_MAX_HZ)", NULL)
 
-    spi_device_interface_config_t dev_cfg = {
-        .command_bits = 0,
-        .address_bits = 0,
-        .dummy_bits = 0,
-        .mode = 0, // Clock idle: low, clock phase: leading, data write: CS on and CLK fall, data read: CS on and CLK rise.
-        .clock_source = SPI_CLK_SRC_DEFAULT,
-        .duty_cycle_pos = 128,
-        .cs_ena_pretrans = 0,
-        .cs_ena_posttrans = 0,
-        .clock_speed_hz = (int)config->clock_speed_hz,
-        .input_delay_ns = 0,
-        .spics_io_num = config->cs_io_num,
-        .flags = SPI_DEVICE_NO_DUMMY,
-        .queue_size = 1,
-        .pre_cb = NULL,
-        .post_cb = NULL};
-
-    spi_device_handle_t spi_device_handle;
-
-    CMP_CHECK(spi_bus_add_device(config->host, &dev_cfg, &spi_device_handle) == ESP_OK, "bus error(spi_bus_add_device)", NULL)
-
-    mcp320x_t *dev = (mcp320x_t *)malloc(sizeof(mcp320x_t));
-    dev->spi_handle = spi_device_handle;
+    mcp320x_transport_t const *transport = config->transport != NULL ? config->transport : &mcp320x_transport_spi_queued;
+
+    CMP_CHECK((transport->install != NULL && transport->remove != NULL && transport->transfer != NULL && transport->get_actual_freq != NULL), "transport error(incomplete)", NULL)
+    CMP_CHECK(((transport->prepare == NULL) == (transport->transfer_prepared == NULL)), "transport error(prepare and transfer_prepared must be set together)", NULL)
+    CMP_CHECK(((transport->submit == NULL) == (transport->collect == NULL)), "transport error(submit and collect must be set together)", NULL)
+
+    void *transport_context;
+
+    CMP_CHECK((transport->install(config, &transport_context) == MCP320X_OK), "transport error(install)", NULL)
+
+    // Frame buffers are allocated once, on DMA capable memory when the
+    // transport needs it, so batches don't need bounce buffers nor per call
+    // allocations.
+    const uint32_t frame_caps = (transport->capabilities & MCP320X_TRANSPORT_CAP_DMA) ? MALLOC_CAP_DMA : MALLOC_CAP_DEFAULT;
+    mcp320x_t *dev = (mcp320x_t *)calloc(1, sizeof(mcp320x_t));
+
+    if (dev != NULL)
+    {
+        dev->tx_frames = (uint8_t *)heap_caps_calloc(MCP320X_BATCH_QUEUE_SIZE, MCP320X_FRAME_SIZE, frame_caps);
+        dev->rx_frames = (uint8_t *)heap_caps_calloc(MCP320X_BATCH_QUEUE_SIZE, MCP320X_FRAME_SIZE, frame_caps);
+        dev->lock = config->locked ? xSemaphoreCreateRecursiveMutex() : NULL;
+    }
+
+    if (dev == NULL || dev->tx_frames == NULL || dev->rx_frames == NULL || (config->locked && dev->lock == NULL))
+    {
+        mcp320x_free(dev);
+        transport->remove(transport_context);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "handle error(no memory)");
+        return NULL;
+    }
+
+    dev->transport = transport;
+    dev->transport_context = transport_context;
     dev->mcp_model = config->device_model;
-    dev->millivolts_per_resolution_step = (float)config->reference_voltage / (float)MCP320X_RESOLUTION;
+    dev->reference_voltage = config->reference_voltage;
+    dev->microvolts_scale = MCP320X_MICROVOLTS_SCALE(config->reference_voltage);
+    dev->stream = NULL;
+    dev->broker = NULL;
 
     return dev;
 }
@@ -53,9 +94,24 @@ mcp320x_t *mcp320x_install(mcp320x_config_t const *config)
 mcp320x_err_t mcp320x_delete(mcp320x_t *handle)
 {
     CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
-    CMP_CHECK(spi_bus_remove_device(handle->spi_handle) == ESP_OK, "bus error(spi_bus_remove_device)", MCP320X_ERR_SPI_BUS)
 
-    free(handle);
+    CMP_CHECK((handle->async_count == 0), "async error(reads pending)", MCP320X_ERR_INVALID_STATE)
+
+    if (handle->stream != NULL)
+    {
+        mcp320x_stream_stop(handle);
+    }
+
+    if (handle->broker != NULL)
+    {
+        mcp320x_broker_stop(handle);
+    }
+
+    mcp320x_err_t result = handle->transport->remove(handle->transport_context);
+
+    CMP_CHECK((result == MCP320X_OK), "transport error(remove)", result)
+
+    mcp320x_free(handle);
 
     return MCP320X_OK;
 }
@@ -63,7 +119,25 @@ mcp320x_err_t mcp320x_delete(mcp320x_t *handle)
 mcp320x_err_t mcp320x_acquire(mcp320x_t *handle, TickType_t timeout)
 {
     CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
-    CMP_CHECK((spi_device_acquire_bus(handle->spi_handle, timeout) == ESP_OK), "device error(spi_device_acquire_bus)", MCP320X_ERR_SPI_BUS_ACQUIRE)
+    CMP_CHECK((mcp320x_lock_take(handle, timeout) == MCP320X_OK), "lock error(timeout)", MCP320X_ERR_TIMEOUT)
+
+    // The lock, when there's one, is held until the matching release.
+    if (handle->acquired == 0 && handle->transport->acquire != NULL)
+    {
+        const int64_t start = mcp320x_stats_begin(handle, MCP320X_TRACE_ACQUIRE, 0);
+        const mcp320x_err_t result = handle->transport->acquire(handle->transport_context, timeout) == MCP320X_OK ? MCP320X_OK : MCP320X_ERR_SPI_BUS_ACQUIRE;
+
+        mcp320x_stats_end(handle, MCP320X_TRACE_ACQUIRE, start, 0, result);
+
+        if (result != MCP320X_OK)
+        {
+            mcp320x_lock_give(handle);
+            CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "transport error(acquire)");
+            return result;
+        }
+    }
+
+    handle->acquired++;
 
     return MCP320X_OK;
 }
@@ -71,10 +145,18 @@ mcp320x_err_t mcp320x_acquire(mcp320x_t *handle, TickType_t timeout)
 mcp320x_err_t mcp320x_release(mcp320x_t *handle)
 {
     CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((handle->acquired > 0), "bus error(not acquired)", MCP320X_ERR_INVALID_STATE)
 
-    spi_device_release_bus(handle->spi_handle);
+    mcp320x_err_t result = MCP320X_OK;
 
-    return MCP320X_OK;
+    if (--handle->acquired == 0 && handle->transport->release != NULL)
+    {
+        result = handle->transport->release(handle->transport_context);
+    }
+
+    mcp320x_lock_give(handle);
+
+    return result;
 }
 
 mcp320x_err_t mcp320x_get_actual_freq(mcp320x_t *handle,
@@ -83,98 +165,238 @@ mcp320x_err_t mcp320x_get_actual_freq(mcp320x_t *handle,
     CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
     CMP_CHECK((frequency_hz != NULL), "frequency_hz error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
 
-    int calculated_freq_khz;
+    return handle->transport->get_actual_freq(handle->transport_context, frequency_hz);
+}
 
-    CMP_CHECK((spi_device_get_actual_freq(handle->spi_handle, &calculated_freq_khz) == ESP_OK), "device error(spi_device_get_actual_freq)", MCP320X_ERR_FAIL)
+mcp320x_err_t mcp320x_get_capabilities(mcp320x_t *handle, uint32_t *capabilities)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((capabilities != NULL), "capabilities error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
 
-    *frequency_hz = (uint32_t)calculated_freq_khz * 1000;
+    *capabilities = handle->transport->capabilities;
 
     return MCP320X_OK;
 }
 
-mcp320x_err_t mcp320x_read(mcp320x_t *handle,
-                           mcp320x_channel_t channel,
-                           mcp320x_read_mode_t read_mode,
-                           uint16_t *value)
+mcp320x_err_t mcp320x_get_lock_stats(mcp320x_t *handle, mcp320x_lock_stats_t *stats)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((stats != NULL), "stats error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK((handle->lock != NULL), "handle error(not locked)", MCP320X_ERR_INVALID_STATE)
+
+    // Taken directly, so reading the statistics doesn't change them.
+    xSemaphoreTakeRecursive(handle->lock, portMAX_DELAY);
+    *stats = handle->lock_stats;
+    xSemaphoreGiveRecursive(handle->lock);
+
+    return MCP320X_OK;
+}
+
+MCP320X_HOT_ATTR mcp320x_err_t mcp320x_read(mcp320x_t *handle,
+                                            mcp320x_channel_t channel,
+                                            mcp320x_read_mode_t read_mode,
+                                            uint16_t *value)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG(((int)channel < (int)handle->mcp_model), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG((value != NULL), "value error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    mcp320x_lock_take(handle, portMAX_DELAY);
+
+    // Counted here rather than in mcp320x_read_unchecked, which stays bare.
+    const int64_t start = mcp320x_stats_begin(handle, MCP320X_TRACE_TRANSFER, 1);
+
+    mcp320x_err_t result = mcp320x_read_unchecked(handle, channel, read_mode, value);
+
+    mcp320x_stats_end(handle, MCP320X_TRACE_TRANSFER, start, 1, result);
+
+    mcp320x_lock_give(handle);
+
+    CMP_CHECK((result == MCP320X_OK), "transport error(transfer)", result)
+
+    return MCP320X_OK;
+}
+
+MCP320X_HOT_ATTR mcp320x_err_t mcp320x_read_unchecked(mcp320x_t *handle,
+                                                      mcp320x_channel_t channel,
+                                                      mcp320x_read_mode_t read_mode,
+                                                      uint16_t *value)
+{
+    // A single frame never needs DMA: transports send it from their own registers.
+    WORD_ALIGNED_ATTR uint8_t tx[MCP320X_FRAME_SIZE];
+    WORD_ALIGNED_ATTR uint8_t rx[MCP320X_FRAME_SIZE];
+
+    mcp320x_frame_encode(channel, read_mode, tx);
+
+    mcp320x_err_t result = handle->transport->transfer(handle->transport_context, tx, rx, 1);
+
+    *value = mcp320x_frame_decode(rx);
+
+    return result;
+}
+
+mcp320x_err_t mcp320x_prepare(mcp320x_t *handle,
+                              mcp320x_channel_t channel,
+                              mcp320x_read_mode_t read_mode,
+                              mcp320x_prepared_t *prepared)
 {
     CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
     CMP_CHECK(((int)channel < (int)handle->mcp_model), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
-    CMP_CHECK((value != NULL), "value error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
-
-    spi_transaction_t transaction = {
-        .flags = SPI_TRANS_USE_RXDATA | SPI_TRANS_USE_TXDATA,
-        .cmd = 0,
-        .addr = 0,
-        .length = 24};
-
-    // Request format (tx_data) is eight bits aligned.
-    //
-    // 0 0 0 0 0 1 MODE C2 _ C1 C0 S N D D D D _ D D D D D D D D
-    // |-----------------|   |---------------|   |-------------|
-    //
-    // Where:
-    //   * 0: filler bits, must be zero.
-    //   * 1: start bit.
-    //   * MODE:
-    //     - 0: differential conversion.
-    //     - 1: single conversion.
-    //   * C [0 1 2]:
-    //     -  0 0 0: channel 0
-    //     -  0 0 1: channel 1
-    //     -  0 1 0: channel 2
-    //     -  0 1 1: channel 3
-    //     -  1 0 0: channel 4
-    //     -  1 0 1: channel 5
-    //     -  1 1 0: channel 6
-    //     -  1 1 1: channel 7
-    //   * S: sample bit because one more clock is required to complete the sample and hold period.
-    //   * N: low null bit.
-    //   * D: data output bits.
-
-    transaction.tx_data[0] = (uint8_t)(0b00000100 | (read_mode << 1) | (channel >> 2));
-    transaction.tx_data[1] = (uint8_t)(channel << 6);
-    transaction.tx_data[2] = 0;
-
-    CMP_CHECK(spi_device_polling_transmit(handle->spi_handle, &transaction) == ESP_OK, "device error(spi_device_polling_transmit)", MCP320X_ERR_SPI_BUS)
-
-    // Response format (rx_data):
-    //
-    // X X X X X X X X _ X X X 0 B11 B10 B9 B8 _ B7 B6 B5 B4 B3 B2 B1 B0
-    // |-------------|   |-------------------|   |---------------------|
-    //
-    // Where:
-    //   * X: dummy bits; any value.
-    //   * 0: start bit.
-    //   * B [0 1 2 3 4 5 6 7 8 9 10 11]: digital output code, uint16_t bits, big-endian.
-    //     - B11: most significant bit.
-    //     - B0: least significant bit.
-    //
-    // More information on section "6.1 Using the MCP3204/3208 with Microcontroller (MCU) SPI Ports"
-    // of the MCP320X datasheet.
-    //
-    // Result logic, taking the following sequence as example:
-    //
-    // 1270 = X X X X X X X X _ X X X X 0 1 0 0 _ 1 1 1 1 0 1 1 0
-    //        |--- rx[0] ---|   |--- rx[1] ---|   |--- rx[2] ---|
-    //             dummy          first part        second part
-    //
-    // 1) Move first_part 8 bits to the left to open space for second_part.
-    //    > first_part  = X X X X X 1 0 0 0 0 0 0 0 0 0 0
-    //
-    // 2) Concat first_part with second_part.
-    //    > first_part  = X X X X X 1 0 0 0 0 0 0 0 0 0 0
-    //    > second_part = 0 0 0 0 0 0 0 0 1 1 1 1 0 1 1 0
-    //    > result      = X X X X X 1 0 0 1 1 1 1 0 1 1 0
-    //
-    // 3) Clear dummy bits.
-    //    > result      = X X X X X 1 0 0 1 1 1 1 0 1 1 0
-    //    > mask        = 0 0 0 0 1 1 1 1 1 1 1 1 1 1 1 1
-    //    > result      = 0 0 0 0 0 1 0 0 1 1 1 1 0 1 1 0
-
-    const uint16_t first_part = transaction.rx_data[1];
-    const uint16_t second_part = transaction.rx_data[2];
-
-    *value = ((first_part << 8) | second_part) & 0b0000111111111111;
+    CMP_CHECK((prepared != NULL), "prepared error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    prepared->handle = handle;
+
+    mcp320x_frame_encode(channel, read_mode, prepared->tx);
+
+    if (handle->transport->prepare != NULL)
+    {
+        CMP_CHECK((handle->transport->prepare(handle->transport_context, prepared->tx, prepared->transport) == MCP320X_OK), "transport error(prepare)", MCP320X_ERR_FAIL)
+    }
+
+    return MCP320X_OK;
+}
+
+MCP320X_HOT_ATTR mcp320x_err_t mcp320x_read_prepared(mcp320x_prepared_t *prepared, uint16_t *value)
+{
+    CMP_CHECK_ARG((prepared != NULL), "prepared error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((value != NULL), "value error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    mcp320x_t *handle = prepared->handle;
+    WORD_ALIGNED_ATTR uint8_t rx[MCP320X_FRAME_SIZE];
+    mcp320x_err_t result;
+
+    if (handle->transport->transfer_prepared != NULL)
+    {
+        result = handle->transport->transfer_prepared(handle->transport_context, prepared->transport, rx);
+    }
+    else
+    {
+        result = handle->transport->transfer(handle->transport_context, prepared->tx, rx, 1);
+    }
+
+    CMP_CHECK((result == MCP320X_OK), "transport error(transfer)", result)
+
+    *value = mcp320x_frame_decode(rx);
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_read_batch(mcp320x_t *handle,
+                                 mcp320x_request_t const *requests,
+                                 size_t count,
+                                 uint16_t *values)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((requests != NULL), "requests error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((values != NULL), "values error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((count > 0), "count error(0)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+
+    for (size_t i = 0; i < count; i++)
+    {
+        CMP_CHECK_ARG(((int)requests[i].channel < (int)handle->mcp_model), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    }
+
+    mcp320x_err_t result = MCP320X_OK;
+
+    mcp320x_lock_take(handle, portMAX_DELAY);
+
+    for (size_t offset = 0; offset < count && result == MCP320X_OK; offset += MCP320X_BATCH_QUEUE_SIZE)
+    {
+        const size_t remaining = count - offset;
+        const size_t chunk = remaining < MCP320X_BATCH_QUEUE_SIZE ? remaining : MCP320X_BATCH_QUEUE_SIZE;
+
+        result = mcp320x_transmit_batch(handle, &requests[offset], chunk, &values[offset]);
+    }
+
+    mcp320x_lock_give(handle);
+
+    return result;
+}
+
+mcp320x_err_t mcp320x_read_many(mcp320x_t *handle,
+                                mcp320x_channel_t const *channels,
+                                size_t count,
+                                mcp320x_read_mode_t read_mode,
+                                uint16_t *values)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((channels != NULL), "channels error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((values != NULL), "values error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((count > 0), "count error(0)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+
+    for (size_t i = 0; i < count; i++)
+    {
+        CMP_CHECK_ARG(((int)channels[i] < (int)handle->mcp_model), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    }
+
+    // Takes the lock and the bus once; nested when the caller already did.
+    mcp320x_err_t result = mcp320x_acquire(handle, portMAX_DELAY);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
+
+    mcp320x_request_t requests[MCP320X_BATCH_QUEUE_SIZE];
+
+    for (size_t offset = 0; offset < count && result == MCP320X_OK; offset += MCP320X_BATCH_QUEUE_SIZE)
+    {
+        const size_t remaining = count - offset;
+        const size_t chunk = remaining < MCP320X_BATCH_QUEUE_SIZE ? remaining : MCP320X_BATCH_QUEUE_SIZE;
+
+        for (size_t i = 0; i < chunk; i++)
+        {
+            requests[i].channel = channels[offset + i];
+            requests[i].read_mode = read_mode;
+        }
+
+        result = mcp320x_transmit_batch(handle, requests, chunk, &values[offset]);
+    }
+
+    mcp320x_release(handle);
+
+    return result;
+}
+
+mcp320x_err_t mcp320x_scan(mcp320x_t *handle,
+                           uint8_t channel_mask,
+                           mcp320x_read_mode_t read_mode,
+                           uint16_t values[MCP320X_CHANNEL_COUNT_MAX])
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((channel_mask != 0), "channel_mask error(0)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG(((channel_mask >> (int)handle->mcp_model) == 0), "channel_mask error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG((values != NULL), "values error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    mcp320x_request_t requests[MCP320X_CHANNEL_COUNT_MAX];
+    uint16_t samples[MCP320X_CHANNEL_COUNT_MAX];
+    size_t count = 0;
+
+    for (int channel = 0; channel < (int)handle->mcp_model; channel++)
+    {
+        if (channel_mask & (1 << channel))
+        {
+            requests[count].channel = (mcp320x_channel_t)channel;
+            requests[count].read_mode = read_mode;
+            count++;
+        }
+    }
+
+    mcp320x_lock_take(handle, portMAX_DELAY);
+
+    mcp320x_err_t result = mcp320x_transmit_batch(handle, requests, count, samples);
+
+    mcp320x_lock_give(handle);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        values[requests[i].channel] = samples[i];
+    }
 
     return MCP320X_OK;
 }
@@ -184,13 +406,43 @@ mcp320x_err_t mcp320x_read_voltage(mcp320x_t *handle,
                                    mcp320x_read_mode_t read_mode,
                                    uint16_t *voltage)
 {
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((voltage != NULL), "voltage error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
     uint16_t value = 0;
 
     mcp320x_err_t result = mcp320x_read(handle, channel, read_mode, &value);
 
-    *voltage = (uint16_t)(value * handle->millivolts_per_resolution_step);
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
 
-    return result;
+    *voltage = mcp320x_code_to_millivolts(value, handle->reference_voltage);
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_read_microvolts(mcp320x_t *handle,
+                                      mcp320x_channel_t channel,
+                                      mcp320x_read_mode_t read_mode,
+                                      uint32_t *voltage)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((voltage != NULL), "voltage error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    uint16_t value = 0;
+
+    mcp320x_err_t result = mcp320x_read(handle, channel, read_mode, &value);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
+
+    *voltage = mcp320x_code_to_microvolts(value, handle->microvolts_scale);
+
+    return MCP320X_OK;
 }
 
 mcp320x_err_t mcp320x_sample(mcp320x_t *handle,
@@ -199,39 +451,299 @@ mcp320x_err_t mcp320x_sample(mcp320x_t *handle,
                              uint16_t sample_count,
                              uint16_t *value)
 {
-    CMP_CHECK((sample_count > 0), "sample_count error(0)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG(((int)channel < (int)handle->mcp_model), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG((value != NULL), "value error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((sample_count > 0), "sample_count error(0)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
 
     uint32_t sum = 0;
-    uint16_t sample = 0;
 
-    for (uint16_t i = 0; i < sample_count; i++)
+    mcp320x_err_t result = mcp320x_sample_sum(handle, channel, read_mode, sample_count, &sum);
+
+    if (result != MCP320X_OK)
     {
-        mcp320x_err_t result = mcp320x_read(handle, channel, read_mode, &sample);
+        return result;
+    }
 
-        if (result != MCP320X_OK)
-        {
-            return result;
-        }
+    *value = (uint16_t)(sum / sample_count);
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_sample_oversampled(mcp320x_t *handle,
+                                         mcp320x_channel_t channel,
+                                         mcp320x_read_mode_t read_mode,
+                                         uint8_t extra_bits,
+                                         uint16_t *value)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG(((int)channel < (int)handle->mcp_model), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG((value != NULL), "value error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((extra_bits > 0), "extra_bits error(0)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+    CMP_CHECK_ARG((extra_bits <= MCP320X_OVERSAMPLE_BITS_MAX), "extra_bits error(>MCP320X_OVERSAMPLE_BITS_MAX)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+
+    // Each extra bit takes 4 times more samples: the sum of 4^n samples has
+    // 12 + 2n bits, of which n are kept. It's a shift instead of the division
+    // of a mean, and the fraction is kept instead of truncated.
+    uint32_t sum = 0;
 
-        sum += sample;
+    mcp320x_err_t result = mcp320x_sample_sum(handle, channel, read_mode, 1UL << (2 * extra_bits), &sum);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
     }
 
-    *value = (uint16_t)(sum / sample_count);
+    *value = (uint16_t)((sum + (1UL << (extra_bits - 1))) >> extra_bits);
 
     return MCP320X_OK;
 }
 
+mcp320x_err_t mcp320x_sample_stats(mcp320x_t *handle,
+                                   mcp320x_channel_t channel,
+                                   mcp320x_read_mode_t read_mode,
+                                   uint16_t sample_count,
+                                   uint8_t trim_percent,
+                                   uint16_t *buffer,
+                                   mcp320x_sample_stats_t *stats)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG(((int)channel < (int)handle->mcp_model), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG((stats != NULL), "stats error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((sample_count > 0), "sample_count error(0)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+    CMP_CHECK_ARG((trim_percent <= MCP320X_SAMPLE_STATS_TRIM_MAX), "trim_percent error(>MCP320X_SAMPLE_STATS_TRIM_MAX)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+    CMP_CHECK_ARG((buffer != NULL || sample_count <= MCP320X_SAMPLE_STATS_STACK_SIZE), "buffer error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    if (buffer == NULL)
+    {
+        return mcp320x_sample_stats_on_stack(handle, channel, read_mode, sample_count, trim_percent, stats);
+    }
+
+    return mcp320x_sample_stats_into(handle, channel, read_mode, sample_count, trim_percent, buffer, stats);
+}
+
 mcp320x_err_t mcp320x_sample_voltage(mcp320x_t *handle,
                                      mcp320x_channel_t channel,
                                      mcp320x_read_mode_t read_mode,
                                      uint16_t sample_count,
                                      uint16_t *voltage)
 {
-    uint16_t sample = 0;
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG(((int)channel < (int)handle->mcp_model), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG((voltage != NULL), "voltage error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((sample_count > 0), "sample_count error(0)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+
+    uint32_t sum = 0;
+
+    mcp320x_err_t result = mcp320x_sample_sum(handle, channel, read_mode, sample_count, &sum);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
+
+    *voltage = mcp320x_sum_to_millivolts(sum, sample_count, handle->reference_voltage);
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_sample_microvolts(mcp320x_t *handle,
+                                        mcp320x_channel_t channel,
+                                        mcp320x_read_mode_t read_mode,
+                                        uint16_t sample_count,
+                                        uint32_t *voltage)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG(((int)channel < (int)handle->mcp_model), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG((voltage != NULL), "voltage error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((sample_count > 0), "sample_count error(0)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+
+    uint32_t sum = 0;
+
+    mcp320x_err_t result = mcp320x_sample_sum(handle, channel, read_mode, sample_count, &sum);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
+
+    *voltage = mcp320x_sum_to_microvolts(sum, sample_count, handle->microvolts_scale);
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_codes_to_millivolts(mcp320x_t *handle,
+                                          uint16_t const *codes,
+                                          uint16_t *voltages,
+                                          size_t count)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((codes != NULL), "codes error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((voltages != NULL), "voltages error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
 
-    mcp320x_err_t result = mcp320x_sample(handle, channel, read_mode, sample_count, &sample);
+    const uint32_t reference_voltage = handle->reference_voltage;
 
-    *voltage = (uint16_t)(sample * handle->millivolts_per_resolution_step);
+    for (size_t i = 0; i < count; i++)
+    {
+        voltages[i] = mcp320x_code_to_millivolts(codes[i], reference_voltage);
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_codes_to_microvolts(mcp320x_t *handle,
+                                          uint16_t const *codes,
+                                          uint32_t *voltages,
+                                          size_t count)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((codes != NULL), "codes error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((voltages != NULL), "voltages error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    const uint32_t microvolts_scale = handle->microvolts_scale;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        voltages[i] = mcp320x_code_to_microvolts(codes[i], microvolts_scale);
+    }
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_sample_sum(mcp320x_t *handle,
+                                        mcp320x_channel_t channel,
+                                        mcp320x_read_mode_t read_mode,
+                                        uint32_t sample_count,
+                                        uint32_t *sum)
+{
+    mcp320x_request_t requests[MCP320X_BATCH_QUEUE_SIZE];
+    uint16_t samples[MCP320X_BATCH_QUEUE_SIZE];
+
+    for (size_t i = 0; i < MCP320X_BATCH_QUEUE_SIZE; i++)
+    {
+        requests[i].channel = channel;
+        requests[i].read_mode = read_mode;
+    }
+
+    mcp320x_err_t result = MCP320X_OK;
+
+    *sum = 0;
+
+    mcp320x_lock_take(handle, portMAX_DELAY);
+
+    for (uint32_t taken = 0; taken < sample_count && result == MCP320X_OK;)
+    {
+        const uint32_t remaining = sample_count - taken;
+        const uint32_t chunk = remaining < MCP320X_BATCH_QUEUE_SIZE ? remaining : MCP320X_BATCH_QUEUE_SIZE;
+
+        result = mcp320x_transmit_batch(handle, requests, chunk, samples);
+
+        for (uint32_t i = 0; i < chunk && result == MCP320X_OK; i++)
+        {
+            *sum += samples[i];
+        }
+
+        taken += chunk;
+    }
+
+    mcp320x_lock_give(handle);
 
     return result;
 }
+
+static mcp320x_err_t mcp320x_sample_stats_into(mcp320x_t *handle,
+                                               mcp320x_channel_t channel,
+                                               mcp320x_read_mode_t read_mode,
+                                               uint16_t sample_count,
+                                               uint8_t trim_percent,
+                                               uint16_t *samples,
+                                               mcp320x_sample_stats_t *stats)
+{
+    mcp320x_request_t requests[MCP320X_BATCH_QUEUE_SIZE];
+
+    for (size_t i = 0; i < MCP320X_BATCH_QUEUE_SIZE; i++)
+    {
+        requests[i].channel = channel;
+        requests[i].read_mode = read_mode;
+    }
+
+    mcp320x_err_t result = MCP320X_OK;
+
+    mcp320x_lock_take(handle, portMAX_DELAY);
+
+    for (uint32_t taken = 0; taken < sample_count && result == MCP320X_OK;)
+    {
+        const uint32_t remaining = sample_count - taken;
+        const uint32_t chunk = remaining < MCP320X_BATCH_QUEUE_SIZE ? remaining : MCP320X_BATCH_QUEUE_SIZE;
+
+        result = mcp320x_transmit_batch(handle, requests, chunk, &samples[taken]);
+
+        taken += chunk;
+    }
+
+    mcp320x_lock_give(handle);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
+
+    return mcp320x_codes_stats(samples, sample_count, trim_percent, stats);
+}
+
+// Kept out of line so only the calls without a caller buffer take the stack.
+NOINLINE_ATTR static mcp320x_err_t mcp320x_sample_stats_on_stack(mcp320x_t *handle,
+                                                                 mcp320x_channel_t channel,
+                                                                 mcp320x_read_mode_t read_mode,
+                                                                 uint16_t sample_count,
+                                                                 uint8_t trim_percent,
+                                                                 mcp320x_sample_stats_t *stats)
+{
+    uint16_t samples[MCP320X_SAMPLE_STATS_STACK_SIZE];
+
+    return mcp320x_sample_stats_into(handle, channel, read_mode, sample_count, trim_percent, samples, stats);
+}
+
+static mcp320x_err_t mcp320x_transmit_batch(mcp320x_t *handle,
+                                            mcp320x_request_t const *requests,
+                                            size_t count,
+                                            uint16_t *values)
+{
+    // Frames are packed on contiguous buffers, handed to the transport in one
+    // call, and decoded all at once at the end. Transports with
+    // MCP320X_TRANSPORT_CAP_BATCH send them back-to-back.
+
+    for (size_t i = 0; i < count; i++)
+    {
+        mcp320x_frame_encode(requests[i].channel, requests[i].read_mode, &handle->tx_frames[i * MCP320X_FRAME_SIZE]);
+    }
+
+    const int64_t start = mcp320x_stats_begin(handle, MCP320X_TRACE_TRANSFER, count);
+
+    mcp320x_err_t result = handle->transport->transfer(handle->transport_context, handle->tx_frames, handle->rx_frames, count);
+
+    mcp320x_stats_end(handle, MCP320X_TRACE_TRANSFER, start, count, result);
+
+    CMP_CHECK((result == MCP320X_OK), "transport error(transfer)", result)
+
+    mcp320x_decode_frames(handle->rx_frames, count, values);
+
+    return MCP320X_OK;
+}
+
+static void mcp320x_free(mcp320x_t *handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    if (handle->lock != NULL)
+    {
+        vSemaphoreDelete(handle->lock);
+    }
+
+    heap_caps_free(handle->tx_frames);
+    heap_caps_free(handle->rx_frames);
+    free(handle);
+}
@@ -0,0 +1,134 @@
+#include <string.h>
+#include "esp32_driver_mcp320x/mcp320x_alarm.h"
+#include "assertion.h"
+
+// Window comparator with hysteresis and debounce. Every code is compared with
+// the thresholds of its current state only: entering a state uses low/high,
+// leaving it uses the thresholds moved by the hysteresis, so noise around a
+// threshold can't toggle the state. A new state must then hold for
+// "debounce" consecutive codes, which rejects single spikes.
+
+static void mcp320x_alarm_transition(mcp320x_alarm_t *alarm, uint8_t channel, uint16_t code);
+
+mcp320x_err_t mcp320x_alarm_init(mcp320x_alarm_t *alarm, mcp320x_alarm_config_t const *config)
+{
+    CMP_CHECK((alarm != NULL), "alarm error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((config != NULL), "config error(NULL)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->channel_count > 0 && config->channel_count <= MCP320X_CHANNEL_COUNT_MAX), "channel_count error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+
+    for (uint8_t i = 0; i < config->channel_count; i++)
+    {
+        mcp320x_alarm_channel_config_t const *channel = &config->channels[i];
+
+        CMP_CHECK((channel->low <= channel->high), "low error(above high)", MCP320X_ERR_INVALID_CONFIG)
+        CMP_CHECK((2 * (uint32_t)channel->hysteresis <= (uint32_t)(channel->high - channel->low)), "hysteresis error(wider than half the window)", MCP320X_ERR_INVALID_CONFIG)
+        CMP_CHECK(((channel->event_bits & ~(EventBits_t)MCP320X_ALARM_EVENT_BITS_MASK) == 0), "event_bits error(>MCP320X_ALARM_EVENT_BITS_MASK)", MCP320X_ERR_INVALID_CONFIG)
+        CMP_CHECK((channel->event_bits == 0 || config->event_group != NULL), "event_group error(NULL with event_bits)", MCP320X_ERR_INVALID_CONFIG)
+    }
+
+    memset(alarm, 0, sizeof(mcp320x_alarm_t));
+
+    alarm->channel_count = config->channel_count;
+    alarm->callback = config->callback;
+    alarm->callback_context = config->callback_context;
+    alarm->event_group = config->event_group;
+
+    for (uint8_t i = 0; i < config->channel_count; i++)
+    {
+        mcp320x_alarm_channel_config_t const *channel = &config->channels[i];
+
+        alarm->channels[i].low = channel->low;
+        alarm->channels[i].low_exit = (uint16_t)(channel->low + channel->hysteresis);
+        alarm->channels[i].high = channel->high;
+        alarm->channels[i].high_exit = (uint16_t)(channel->high - channel->hysteresis);
+        alarm->channels[i].debounce = channel->debounce > 0 ? channel->debounce : 1;
+        alarm->channels[i].state = MCP320X_ALARM_STATE_NORMAL;
+        alarm->channels[i].pending = MCP320X_ALARM_STATE_NORMAL;
+        alarm->channels[i].event_bits = channel->event_bits;
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_alarm_process(mcp320x_alarm_t *alarm, uint16_t const *codes, size_t count)
+{
+    CMP_CHECK_ARG((alarm != NULL), "alarm error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((codes != NULL || count == 0), "codes error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    uint8_t channel = alarm->channel;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        mcp320x_alarm_channel_t *state = &alarm->channels[channel];
+        const uint16_t code = codes[i];
+        uint8_t target;
+
+        switch (state->state)
+        {
+        case MCP320X_ALARM_STATE_LOW:
+            target = code > state->high ? MCP320X_ALARM_STATE_HIGH : (code >= state->low_exit ? MCP320X_ALARM_STATE_NORMAL : MCP320X_ALARM_STATE_LOW);
+            break;
+        case MCP320X_ALARM_STATE_HIGH:
+            target = code < state->low ? MCP320X_ALARM_STATE_LOW : (code <= state->high_exit ? MCP320X_ALARM_STATE_NORMAL : MCP320X_ALARM_STATE_HIGH);
+            break;
+        default:
+            target = code < state->low ? MCP320X_ALARM_STATE_LOW : (code > state->high ? MCP320X_ALARM_STATE_HIGH : MCP320X_ALARM_STATE_NORMAL);
+            break;
+        }
+
+        if (target == state->state)
+        {
+            state->count = 0;
+        }
+        else
+        {
+            // A different new state restarts the debounce.
+            if (target != state->pending)
+            {
+                state->pending = target;
+                state->count = 0;
+            }
+
+            if (++state->count >= state->debounce)
+            {
+                state->state = target;
+                state->count = 0;
+                mcp320x_alarm_transition(alarm, channel, code);
+            }
+        }
+
+        if (++channel == alarm->channel_count)
+        {
+            channel = 0;
+        }
+    }
+
+    alarm->channel = channel;
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_alarm_get_state(mcp320x_alarm_t const *alarm, uint8_t channel, mcp320x_alarm_state_t *state)
+{
+    CMP_CHECK((alarm != NULL), "alarm error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((channel < alarm->channel_count), "channel error(>=channel_count)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK((state != NULL), "state error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    // A single byte, written at once by the processing task.
+    *state = (mcp320x_alarm_state_t)alarm->channels[channel].state;
+
+    return MCP320X_OK;
+}
+
+static void mcp320x_alarm_transition(mcp320x_alarm_t *alarm, uint8_t channel, uint16_t code)
+{
+    if (alarm->callback != NULL)
+    {
+        alarm->callback(channel, (mcp320x_alarm_state_t)alarm->channels[channel].state, code, alarm->callback_context);
+    }
+
+    if (alarm->channels[channel].event_bits != 0)
+    {
+        xEventGroupSetBits(alarm->event_group, alarm->channels[channel].event_bits);
+    }
+}
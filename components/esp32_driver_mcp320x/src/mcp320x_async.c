@@ -0,0 +1,118 @@
+#include "esp32_driver_mcp320x/mcp320x_async.h"
+#include "esp_attr.h"
+#include "context.h"
+#include "frame.h"
+#include "stats.h"
+#include "assertion.h"
+#include "log.h"
+
+static void mcp320x_async_done(void *user, uint8_t const *rx);
+
+mcp320x_err_t mcp320x_read_async(mcp320x_t *handle,
+                                 mcp320x_channel_t channel,
+                                 mcp320x_read_mode_t read_mode,
+                                 mcp320x_async_callback_t callback,
+                                 void *context)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG(((int)channel < (int)handle->mcp_model), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK((handle->async_count < MCP320X_ASYNC_QUEUE_SIZE), "async error(queue full)", MCP320X_ERR_INVALID_STATE)
+
+    mcp320x_async_slot_t *slot = &handle->async_slots[(handle->async_head + handle->async_count) % MCP320X_ASYNC_QUEUE_SIZE];
+    WORD_ALIGNED_ATTR uint8_t tx[MCP320X_FRAME_SIZE];
+
+    // The slot is filled before the frame is submitted: the completion can
+    // run before submit returns.
+    slot->handle = handle;
+    slot->callback = callback;
+    slot->context = context;
+
+    mcp320x_frame_encode(channel, read_mode, tx);
+
+    if (handle->transport->submit != NULL)
+    {
+        if (handle->transport->submit(handle->transport_context, tx, mcp320x_async_done, slot) != MCP320X_OK)
+        {
+            mcp320x_stats_error(handle, MCP320X_ERR_SPI_BUS);
+            CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "transport error(submit)");
+            return MCP320X_ERR_SPI_BUS;
+        }
+
+        handle->async_count++;
+
+        return MCP320X_OK;
+    }
+
+    // Transports without a queue complete now; the answer waits on the slot
+    // to be collected.
+    const int64_t start = mcp320x_stats_begin(handle, MCP320X_TRACE_TRANSFER, 1);
+    const mcp320x_err_t result = handle->transport->transfer(handle->transport_context, tx, slot->rx, 1) == MCP320X_OK ? MCP320X_OK : MCP320X_ERR_SPI_BUS;
+
+    mcp320x_stats_end(handle, MCP320X_TRACE_TRANSFER, start, 1, result);
+
+    CMP_CHECK((result == MCP320X_OK), "transport error(transfer)", result)
+
+    handle->async_count++;
+
+    mcp320x_async_done(slot, slot->rx);
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_get_result(mcp320x_t *handle,
+                                 uint16_t *value,
+                                 TickType_t timeout)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((value != NULL), "value error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK((handle->async_count > 0), "async error(no read pending)", MCP320X_ERR_INVALID_STATE)
+
+    mcp320x_async_slot_t *slot = &handle->async_slots[handle->async_head];
+
+    if (handle->transport->collect != NULL)
+    {
+        mcp320x_err_t result = handle->transport->collect(handle->transport_context, slot->rx, timeout);
+
+        if (result == MCP320X_ERR_TIMEOUT)
+        {
+            return result; // Still running; not an error when polling.
+        }
+
+        mcp320x_stats_collected(handle, result);
+
+        CMP_CHECK((result == MCP320X_OK), "transport error(collect)", result)
+    }
+
+    handle->async_head = (uint8_t)((handle->async_head + 1) % MCP320X_ASYNC_QUEUE_SIZE);
+    handle->async_count--;
+
+    *value = mcp320x_frame_decode(slot->rx);
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_get_pending(mcp320x_t *handle, uint8_t *count)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((count != NULL), "count error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    *count = handle->async_count;
+
+    return MCP320X_OK;
+}
+
+IRAM_ATTR static void mcp320x_async_done(void *user, uint8_t const *rx)
+{
+    mcp320x_async_slot_t const *slot = (mcp320x_async_slot_t const *)user;
+
+    if (slot->callback == NULL)
+    {
+        return;
+    }
+
+    // Same as mcp320x_frame_decode, which may be in flash: this runs from
+    // the SPI interrupt.
+    const uint16_t value = (uint16_t)(((((uint32_t)rx[0] << 16) | ((uint32_t)rx[1] << 8) | rx[2]) >> 5) & 0x0FFF);
+
+    slot->callback(slot->handle, value, slot->context);
+}
@@ -0,0 +1,341 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp32_driver_mcp320x/mcp320x_broker.h"
+#include "context.h"
+#include "assertion.h"
+#include "log.h"
+
+#define MCP320X_BROKER_MODES 2
+
+// A burst has at most one request per channel and mode, so it's a single batch.
+_Static_assert(MCP320X_BROKER_MODES * MCP320X_CHANNEL_COUNT_MAX <= MCP320X_BATCH_QUEUE_SIZE, "A burst must fit one batch");
+_Static_assert(MCP320X_BROKER_CLIENTS_MAX <= 16, "Clients are tracked on 16 bits masks");
+
+/**
+ * @typedef mcp320x_broker_client_t
+ * @brief A read waiting on the broker.
+ */
+typedef struct
+{
+    SemaphoreHandle_t done; /** @brief Given by the broker when the read completes. */
+    uint16_t value;         /** @brief Digital code read. */
+    mcp320x_err_t result;   /** @brief Result of the burst. */
+} mcp320x_broker_client_t;
+
+/**
+ * @struct mcp320x_broker_t
+ * @brief Holds control data for a request broker.
+ */
+struct mcp320x_broker_t
+{
+    mcp320x_t *handle;                                                 /** @brief Device being read. */
+    uint32_t window_us;                                                /** @brief Time a burst waits for more requests. */
+    esp_timer_handle_t window_timer;                                   /** @brief One-shot timer ending the window; NULL without a window. */
+    SemaphoreHandle_t window_end;                                      /** @brief Given by the window timer. */
+    SemaphoreHandle_t mutex;                                           /** @brief Protects the pending requests, the clients and the counters. */
+    uint16_t waiting[MCP320X_BROKER_MODES][MCP320X_CHANNEL_COUNT_MAX]; /** @brief Clients waiting for each read mode and channel; bit N = client N. */
+    uint16_t pending;                                                  /** @brief Clients waiting for the next burst. */
+    uint16_t busy;                                                     /** @brief Clients in use. */
+    mcp320x_broker_client_t clients[MCP320X_BROKER_CLIENTS_MAX];       /** @brief One per read in flight. */
+    bool accepting;                                                    /** @brief Cleared by the stop, so no more reads are queued. */
+    volatile bool running;                                             /** @brief Cleared to ask the broker task to exit. */
+    TaskHandle_t task;                                                 /** @brief Broker task. */
+    SemaphoreHandle_t stopped;                                         /** @brief Given by the broker task when it exits. */
+    mcp320x_broker_stats_t stats;                                      /** @brief Counters. */
+};
+
+static void mcp320x_broker_window_callback(void *arg);
+static void mcp320x_broker_task(void *arg);
+static void mcp320x_broker_burst(mcp320x_broker_t *broker);
+static void mcp320x_broker_free(mcp320x_broker_t *broker);
+
+mcp320x_err_t mcp320x_broker_start(mcp320x_t *handle, mcp320x_broker_config_t const *config)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((config != NULL), "config error(NULL)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((handle->broker == NULL), "broker error(already started)", MCP320X_ERR_INVALID_STATE)
+    CMP_CHECK((config->window_us <= MCP320X_BROKER_WINDOW_MAX_US), "window_us error(>MCP320X_BROKER_WINDOW_MAX_US)", MCP320X_ERR_INVALID_CONFIG)
+
+    mcp320x_broker_t *broker = (mcp320x_broker_t *)calloc(1, sizeof(mcp320x_broker_t));
+
+    CMP_CHECK((broker != NULL), "broker error(no memory)", MCP320X_ERR_NO_MEMORY)
+
+    broker->handle = handle;
+    broker->window_us = config->window_us;
+    broker->mutex = xSemaphoreCreateMutex();
+    broker->stopped = xSemaphoreCreateBinary();
+
+    bool created = broker->mutex != NULL && broker->stopped != NULL;
+
+    for (size_t i = 0; i < MCP320X_BROKER_CLIENTS_MAX && created; i++)
+    {
+        broker->clients[i].done = xSemaphoreCreateBinary();
+        created = broker->clients[i].done != NULL;
+    }
+
+    if (created && broker->window_us > 0)
+    {
+        broker->window_end = xSemaphoreCreateBinary();
+        created = broker->window_end != NULL;
+    }
+
+    if (!created)
+    {
+        mcp320x_broker_free(broker);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "broker error(no memory)");
+        return MCP320X_ERR_NO_MEMORY;
+    }
+
+    if (broker->window_us > 0)
+    {
+        const esp_timer_create_args_t timer_args = {
+            .callback = mcp320x_broker_window_callback,
+            .arg = broker->window_end,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "mcp320x_broker"};
+
+        if (esp_timer_create(&timer_args, &broker->window_timer) != ESP_OK)
+        {
+            broker->window_timer = NULL;
+            mcp320x_broker_free(broker);
+            CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "timer error(esp_timer_create)");
+            return MCP320X_ERR_FAIL;
+        }
+    }
+
+    broker->accepting = true;
+    broker->running = true;
+
+    if (xTaskCreatePinnedToCore(mcp320x_broker_task,
+                                "mcp320x_broker",
+                                config->task_stack_size != 0 ? config->task_stack_size : MCP320X_BROKER_TASK_STACK_SIZE_DEFAULT,
+                                broker,
+                                config->task_priority,
+                                &broker->task,
+                                config->task_core) != pdPASS)
+    {
+        mcp320x_broker_free(broker);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "task error(xTaskCreatePinnedToCore)");
+        return MCP320X_ERR_NO_MEMORY;
+    }
+
+    handle->broker = broker;
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_broker_stop(mcp320x_t *handle)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((handle->broker != NULL), "broker error(not started)", MCP320X_ERR_INVALID_STATE)
+
+    mcp320x_broker_t *broker = handle->broker;
+
+    xSemaphoreTake(broker->mutex, portMAX_DELAY);
+    broker->accepting = false;
+    xSemaphoreGive(broker->mutex);
+
+    // The task serves what is pending before exiting.
+    broker->running = false;
+    xTaskNotifyGive(broker->task);
+    xSemaphoreTake(broker->stopped, portMAX_DELAY);
+
+    handle->broker = NULL;
+
+    mcp320x_broker_free(broker);
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_broker_read(mcp320x_t *handle,
+                                  mcp320x_channel_t channel,
+                                  mcp320x_read_mode_t read_mode,
+                                  uint16_t *value)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG(((int)channel < (int)handle->mcp_model), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG((value != NULL), "value error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK((handle->broker != NULL), "broker error(not started)", MCP320X_ERR_INVALID_STATE)
+
+    mcp320x_broker_t *broker = handle->broker;
+    size_t index = 0;
+
+    xSemaphoreTake(broker->mutex, portMAX_DELAY);
+
+    while (index < MCP320X_BROKER_CLIENTS_MAX && (broker->busy & (1U << index)))
+    {
+        index++;
+    }
+
+    if (!broker->accepting || index == MCP320X_BROKER_CLIENTS_MAX)
+    {
+        xSemaphoreGive(broker->mutex);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "broker error(stopping or too many clients)");
+        return MCP320X_ERR_INVALID_STATE;
+    }
+
+    const uint16_t client = (uint16_t)(1U << index);
+
+    // Only the first request of a burst wakes the broker; the others join it.
+    const bool first = broker->pending == 0;
+
+    broker->busy |= client;
+    broker->pending |= client;
+    broker->waiting[read_mode & 1][channel] |= client;
+    broker->stats.requests++;
+
+    xSemaphoreGive(broker->mutex);
+
+    if (first)
+    {
+        xTaskNotifyGive(broker->task);
+    }
+
+    xSemaphoreTake(broker->clients[index].done, portMAX_DELAY);
+
+    *value = broker->clients[index].value;
+    const mcp320x_err_t result = broker->clients[index].result;
+
+    xSemaphoreTake(broker->mutex, portMAX_DELAY);
+    broker->busy &= (uint16_t)~client;
+    xSemaphoreGive(broker->mutex);
+
+    return result;
+}
+
+mcp320x_err_t mcp320x_broker_get_stats(mcp320x_t *handle, mcp320x_broker_stats_t *stats)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((stats != NULL), "stats error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK((handle->broker != NULL), "broker error(not started)", MCP320X_ERR_INVALID_STATE)
+
+    xSemaphoreTake(handle->broker->mutex, portMAX_DELAY);
+    *stats = handle->broker->stats;
+    xSemaphoreGive(handle->broker->mutex);
+
+    return MCP320X_OK;
+}
+
+static void mcp320x_broker_window_callback(void *arg)
+{
+    xSemaphoreGive((SemaphoreHandle_t)arg);
+}
+
+static void mcp320x_broker_task(void *arg)
+{
+    mcp320x_broker_t *broker = (mcp320x_broker_t *)arg;
+
+    while (broker->running)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Blocked, not spinning, so clients on the same core can run and join
+        // the burst. The timer always fires, so it's idle once this returns.
+        if (broker->window_timer != NULL && broker->running && esp_timer_start_once(broker->window_timer, broker->window_us) == ESP_OK)
+        {
+            xSemaphoreTake(broker->window_end, portMAX_DELAY);
+        }
+
+        mcp320x_broker_burst(broker);
+    }
+
+    // Reads queued before the stop closed the broker.
+    mcp320x_broker_burst(broker);
+
+    xSemaphoreGive(broker->stopped);
+
+    vTaskDelete(NULL);
+}
+
+static void mcp320x_broker_burst(mcp320x_broker_t *broker)
+{
+    uint16_t waiting[MCP320X_BROKER_MODES][MCP320X_CHANNEL_COUNT_MAX];
+    uint16_t clients[MCP320X_BATCH_QUEUE_SIZE];
+    mcp320x_request_t requests[MCP320X_BATCH_QUEUE_SIZE];
+    uint16_t values[MCP320X_BATCH_QUEUE_SIZE];
+    size_t count = 0;
+
+    // Take the pending requests; new ones gather for the next burst while
+    // this one converts.
+    xSemaphoreTake(broker->mutex, portMAX_DELAY);
+    memcpy(waiting, broker->waiting, sizeof(waiting));
+    memset(broker->waiting, 0, sizeof(broker->waiting));
+    broker->pending = 0;
+    xSemaphoreGive(broker->mutex);
+
+    for (int mode = 0; mode < MCP320X_BROKER_MODES; mode++)
+    {
+        for (int channel = 0; channel < MCP320X_CHANNEL_COUNT_MAX; channel++)
+        {
+            if (waiting[mode][channel] != 0)
+            {
+                requests[count].channel = (mcp320x_channel_t)channel;
+                requests[count].read_mode = (mcp320x_read_mode_t)mode;
+                clients[count] = waiting[mode][channel];
+                count++;
+            }
+        }
+    }
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    const mcp320x_err_t result = mcp320x_read_batch(broker->handle, requests, count, values);
+
+    xSemaphoreTake(broker->mutex, portMAX_DELAY);
+    broker->stats.bursts++;
+    broker->stats.conversions += (uint32_t)count;
+    broker->stats.errors += result != MCP320X_OK ? 1 : 0;
+    xSemaphoreGive(broker->mutex);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        for (size_t index = 0; index < MCP320X_BROKER_CLIENTS_MAX; index++)
+        {
+            if (clients[i] & (1U << index))
+            {
+                broker->clients[index].value = values[i];
+                broker->clients[index].result = result;
+                xSemaphoreGive(broker->clients[index].done);
+            }
+        }
+    }
+}
+
+static void mcp320x_broker_free(mcp320x_broker_t *broker)
+{
+    if (broker->window_timer != NULL)
+    {
+        esp_timer_delete(broker->window_timer);
+    }
+
+    if (broker->window_end != NULL)
+    {
+        vSemaphoreDelete(broker->window_end);
+    }
+
+    if (broker->mutex != NULL)
+    {
+        vSemaphoreDelete(broker->mutex);
+    }
+
+    if (broker->stopped != NULL)
+    {
+        vSemaphoreDelete(broker->stopped);
+    }
+
+    for (size_t i = 0; i < MCP320X_BROKER_CLIENTS_MAX; i++)
+    {
+        if (broker->clients[i].done != NULL)
+        {
+            vSemaphoreDelete(broker->clients[i].done);
+        }
+    }
+
+    free(broker);
+}
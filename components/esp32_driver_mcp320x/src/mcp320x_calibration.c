@@ -0,0 +1,442 @@
+#include <string.h>
+#include "esp32_driver_mcp320x/mcp320x_calibration.h"
+#include "assertion.h"
+#include "log.h"
+
+// Every correction is computed when the points are set, so converting a code
+// costs no division nor floating point:
+//
+//   microvolts = (code * gain + bias) >> 16
+//
+// with the gain in microvolts per code and the bias in microvolts, both Q16,
+// the bias including the half that rounds to the nearest. An uncalibrated
+// channel uses the ideal line, gain = Vref * 1000 / 4096 = Vref * 16000 in Q16,
+// which gives the same microvolts as mcp320x_read_microvolts.
+//
+// Blob: "MCPC", version, channel count, then per channel its index (bit 7 set
+// when it has a table), its point count and the points (code_x16 on 2 bytes,
+// microvolts on 4), all little-endian, and a Fletcher-16 checksum.
+
+#define MCP320X_CALIBRATION_VERSION 1
+#define MCP320X_CALIBRATION_HEADER_SIZE 6
+#define MCP320X_CALIBRATION_POINT_SIZE 6
+#define MCP320X_CALIBRATION_TABLE_FLAG 0x80
+#define MCP320X_CALIBRATION_CODE_X16_MAX (4095 * 16)
+
+static const uint8_t MCP320X_CALIBRATION_MAGIC[4] = {'M', 'C', 'P', 'C'};
+
+static mcp320x_err_t mcp320x_calibration_check_points(mcp320x_calibration_point_t const *points, uint8_t count);
+static void mcp320x_calibration_reset_channel(mcp320x_calibration_t *calibration, mcp320x_channel_t channel);
+static void mcp320x_calibration_fill_table(mcp320x_calibration_point_t const *points, uint8_t count, int32_t *table);
+static int64_t mcp320x_calibration_divide(int64_t numerator, int64_t denominator);
+static uint16_t mcp320x_calibration_checksum(uint8_t const *buffer, size_t size);
+static void mcp320x_calibration_read_point(uint8_t const *buffer, mcp320x_calibration_point_t *point);
+
+mcp320x_err_t mcp320x_calibration_init(mcp320x_calibration_t *calibration, uint16_t reference_voltage)
+{
+    CMP_CHECK((calibration != NULL), "calibration error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((reference_voltage >= MCP320X_REF_VOLTAGE_MIN), "reference voltage error(<MCP320X_REF_VOLTAGE_MIN)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((reference_voltage <= MCP320X_REF_VOLTAGE_MAX), "reference voltage error(>MCP320X_REF_VOLTAGE_MAX)", MCP320X_ERR_INVALID_CONFIG)
+
+    memset(calibration, 0, sizeof(mcp320x_calibration_t));
+
+    calibration->reference_voltage = reference_voltage;
+
+    for (uint8_t channel = 0; channel < MCP320X_CHANNEL_COUNT_MAX; channel++)
+    {
+        mcp320x_calibration_reset_channel(calibration, (mcp320x_channel_t)channel);
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_calibration_capture(mcp320x_t *handle,
+                                          mcp320x_channel_t channel,
+                                          mcp320x_read_mode_t read_mode,
+                                          int32_t microvolts,
+                                          mcp320x_calibration_point_t *point)
+{
+    CMP_CHECK((point != NULL), "point error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    uint16_t code_x16 = 0;
+
+    // 4 extra bits: the mean of 256 reads, times 16.
+    const mcp320x_err_t result = mcp320x_sample_oversampled(handle, channel, read_mode, 4, &code_x16);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
+
+    point->code_x16 = code_x16;
+    point->microvolts = microvolts;
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_calibration_set_points(mcp320x_calibration_t *calibration,
+                                             mcp320x_channel_t channel,
+                                             mcp320x_calibration_point_t const *points,
+                                             uint8_t count,
+                                             int32_t *table)
+{
+    CMP_CHECK((calibration != NULL), "calibration error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((channel <= MCP320X_CHANNEL_7), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK((points != NULL), "points error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    const mcp320x_err_t result = mcp320x_calibration_check_points(points, count);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
+
+    mcp320x_calibration_point_t const *first = &points[0];
+    mcp320x_calibration_point_t const *last = &points[count - 1];
+    const int64_t gain = mcp320x_calibration_divide(((int64_t)last->microvolts - first->microvolts) << 20, last->code_x16 - first->code_x16);
+    mcp320x_calibration_channel_t *state = &calibration->channels[channel];
+
+    state->gain = (int32_t)gain;
+    state->bias = ((int64_t)first->microvolts << 16) - ((gain * first->code_x16) >> 4) + (1 << 15);
+    state->table = NULL;
+
+    if (table != NULL)
+    {
+        mcp320x_calibration_fill_table(points, count, table);
+        state->table = table;
+    }
+
+    memcpy(state->points, points, count * sizeof(mcp320x_calibration_point_t));
+    state->point_count = count;
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_calibration_apply(mcp320x_calibration_t const *calibration,
+                                        mcp320x_channel_t channel,
+                                        uint16_t const *codes,
+                                        int32_t *microvolts,
+                                        size_t count)
+{
+    CMP_CHECK_ARG((calibration != NULL), "calibration error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((channel <= MCP320X_CHANNEL_7), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG((codes != NULL || count == 0), "codes error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((microvolts != NULL || count == 0), "microvolts error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    mcp320x_calibration_channel_t const *state = &calibration->channels[channel];
+
+    if (state->table != NULL)
+    {
+        int32_t const *table = state->table;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            microvolts[i] = table[codes[i] & (MCP320X_CALIBRATION_TABLE_SIZE - 1)];
+        }
+    }
+    else
+    {
+        const int64_t gain = state->gain;
+        const int64_t bias = state->bias;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            microvolts[i] = (int32_t)((codes[i] * gain + bias) >> 16);
+        }
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_calibration_read(mcp320x_t *handle,
+                                       mcp320x_calibration_t const *calibration,
+                                       mcp320x_channel_t channel,
+                                       mcp320x_read_mode_t read_mode,
+                                       int32_t *microvolts)
+{
+    CMP_CHECK_ARG((calibration != NULL), "calibration error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((microvolts != NULL), "microvolts error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    uint16_t value = 0;
+
+    const mcp320x_err_t result = mcp320x_read(handle, channel, read_mode, &value);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
+
+    return mcp320x_calibration_apply(calibration, channel, &value, microvolts, 1);
+}
+
+mcp320x_err_t mcp320x_calibration_serialize(mcp320x_calibration_t const *calibration, uint8_t *buffer, size_t capacity, size_t *size)
+{
+    CMP_CHECK((calibration != NULL), "calibration error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((buffer != NULL), "buffer error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK((size != NULL), "size error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    size_t needed = MCP320X_CALIBRATION_HEADER_SIZE + 2;
+    uint8_t channel_count = 0;
+
+    for (uint8_t channel = 0; channel < MCP320X_CHANNEL_COUNT_MAX; channel++)
+    {
+        if (calibration->channels[channel].point_count > 0)
+        {
+            needed += 2 + calibration->channels[channel].point_count * MCP320X_CALIBRATION_POINT_SIZE;
+            channel_count++;
+        }
+    }
+
+    CMP_CHECK((capacity >= needed), "capacity error(too small)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+
+    uint8_t *cursor = buffer;
+
+    memcpy(cursor, MCP320X_CALIBRATION_MAGIC, sizeof(MCP320X_CALIBRATION_MAGIC));
+    cursor += sizeof(MCP320X_CALIBRATION_MAGIC);
+    *cursor++ = MCP320X_CALIBRATION_VERSION;
+    *cursor++ = channel_count;
+
+    for (uint8_t channel = 0; channel < MCP320X_CHANNEL_COUNT_MAX; channel++)
+    {
+        mcp320x_calibration_channel_t const *state = &calibration->channels[channel];
+
+        if (state->point_count == 0)
+        {
+            continue;
+        }
+
+        *cursor++ = (uint8_t)(channel | (state->table != NULL ? MCP320X_CALIBRATION_TABLE_FLAG : 0));
+        *cursor++ = state->point_count;
+
+        for (uint8_t i = 0; i < state->point_count; i++)
+        {
+            const uint32_t microvolts = (uint32_t)state->points[i].microvolts;
+
+            *cursor++ = (uint8_t)(state->points[i].code_x16);
+            *cursor++ = (uint8_t)(state->points[i].code_x16 >> 8);
+            *cursor++ = (uint8_t)(microvolts);
+            *cursor++ = (uint8_t)(microvolts >> 8);
+            *cursor++ = (uint8_t)(microvolts >> 16);
+            *cursor++ = (uint8_t)(microvolts >> 24);
+        }
+    }
+
+    const uint16_t checksum = mcp320x_calibration_checksum(buffer, (size_t)(cursor - buffer));
+
+    *cursor++ = (uint8_t)(checksum);
+    *cursor++ = (uint8_t)(checksum >> 8);
+
+    *size = needed;
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_calibration_deserialize(mcp320x_calibration_t *calibration,
+                                              uint8_t const *buffer,
+                                              size_t size,
+                                              int32_t *const tables[MCP320X_CHANNEL_COUNT_MAX])
+{
+    CMP_CHECK((calibration != NULL), "calibration error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((buffer != NULL), "buffer error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK((size >= MCP320X_CALIBRATION_HEADER_SIZE + 2), "blob error(truncated)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((memcmp(buffer, MCP320X_CALIBRATION_MAGIC, sizeof(MCP320X_CALIBRATION_MAGIC)) == 0), "blob error(not a calibration)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((buffer[4] == MCP320X_CALIBRATION_VERSION), "blob error(unknown version)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((mcp320x_calibration_checksum(buffer, size - 2) == (uint16_t)(buffer[size - 2] | (buffer[size - 1] << 8))), "blob error(checksum)", MCP320X_ERR_INVALID_CONFIG)
+
+    const uint8_t channel_count = buffer[5];
+    size_t offset = MCP320X_CALIBRATION_HEADER_SIZE;
+    uint8_t seen = 0;
+
+    CMP_CHECK((channel_count <= MCP320X_CHANNEL_COUNT_MAX), "blob error(too many channels)", MCP320X_ERR_INVALID_CONFIG)
+
+    // Validated whole before changing anything, so an invalid blob leaves the calibration as it was.
+    for (uint8_t i = 0; i < channel_count; i++)
+    {
+        CMP_CHECK((offset + 2 <= size - 2), "blob error(truncated)", MCP320X_ERR_INVALID_CONFIG)
+
+        const uint8_t channel = buffer[offset] & ~MCP320X_CALIBRATION_TABLE_FLAG;
+        const uint8_t count = buffer[offset + 1];
+        mcp320x_calibration_point_t points[MCP320X_CALIBRATION_POINTS_MAX];
+
+        CMP_CHECK((channel < MCP320X_CHANNEL_COUNT_MAX && !(seen & (1 << channel))), "blob error(invalid channel)", MCP320X_ERR_INVALID_CONFIG)
+        CMP_CHECK((count >= 2 && count <= MCP320X_CALIBRATION_POINTS_MAX), "blob error(invalid point count)", MCP320X_ERR_INVALID_CONFIG)
+        CMP_CHECK((offset + 2 + (size_t)count * MCP320X_CALIBRATION_POINT_SIZE <= size - 2), "blob error(truncated)", MCP320X_ERR_INVALID_CONFIG)
+        CMP_CHECK((!(buffer[offset] & MCP320X_CALIBRATION_TABLE_FLAG) || (tables != NULL && tables[channel] != NULL)), "tables error(NULL for a channel with a table)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+        for (uint8_t k = 0; k < count; k++)
+        {
+            mcp320x_calibration_read_point(&buffer[offset + 2 + k * MCP320X_CALIBRATION_POINT_SIZE], &points[k]);
+        }
+
+        if (mcp320x_calibration_check_points(points, count) != MCP320X_OK)
+        {
+            return MCP320X_ERR_INVALID_CONFIG;
+        }
+
+        seen |= (uint8_t)(1 << channel);
+        offset += 2 + (size_t)count * MCP320X_CALIBRATION_POINT_SIZE;
+    }
+
+    CMP_CHECK((offset == size - 2), "blob error(trailing bytes)", MCP320X_ERR_INVALID_CONFIG)
+
+    for (uint8_t channel = 0; channel < MCP320X_CHANNEL_COUNT_MAX; channel++)
+    {
+        mcp320x_calibration_reset_channel(calibration, (mcp320x_channel_t)channel);
+    }
+
+    offset = MCP320X_CALIBRATION_HEADER_SIZE;
+
+    for (uint8_t i = 0; i < channel_count; i++)
+    {
+        const uint8_t channel = buffer[offset] & ~MCP320X_CALIBRATION_TABLE_FLAG;
+        const uint8_t count = buffer[offset + 1];
+        mcp320x_calibration_point_t points[MCP320X_CALIBRATION_POINTS_MAX];
+
+        for (uint8_t k = 0; k < count; k++)
+        {
+            mcp320x_calibration_read_point(&buffer[offset + 2 + k * MCP320X_CALIBRATION_POINT_SIZE], &points[k]);
+        }
+
+        const mcp320x_err_t result = mcp320x_calibration_set_points(calibration,
+                                                                    (mcp320x_channel_t)channel,
+                                                                    points,
+                                                                    count,
+                                                                    (buffer[offset] & MCP320X_CALIBRATION_TABLE_FLAG) ? tables[channel] : NULL);
+
+        if (result != MCP320X_OK)
+        {
+            return result;
+        }
+
+        offset += 2 + (size_t)count * MCP320X_CALIBRATION_POINT_SIZE;
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_calibration_save(mcp320x_calibration_t const *calibration, nvs_handle_t nvs, const char *key)
+{
+    CMP_CHECK((key != NULL), "key error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    uint8_t blob[MCP320X_CALIBRATION_BLOB_SIZE_MAX];
+    size_t size = 0;
+
+    const mcp320x_err_t result = mcp320x_calibration_serialize(calibration, blob, sizeof(blob), &size);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
+
+    if (nvs_set_blob(nvs, key, blob, size) != ESP_OK || nvs_commit(nvs) != ESP_OK)
+    {
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "nvs error(nvs_set_blob)");
+        return MCP320X_ERR_FAIL;
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_calibration_load(mcp320x_calibration_t *calibration,
+                                       nvs_handle_t nvs,
+                                       const char *key,
+                                       int32_t *const tables[MCP320X_CHANNEL_COUNT_MAX])
+{
+    CMP_CHECK((calibration != NULL), "calibration error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((key != NULL), "key error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    uint8_t blob[MCP320X_CALIBRATION_BLOB_SIZE_MAX];
+    size_t size = sizeof(blob);
+
+    const esp_err_t result = nvs_get_blob(nvs, key, blob, &size);
+
+    if (result == ESP_ERR_NVS_NOT_FOUND)
+    {
+        return MCP320X_ERR_INVALID_STATE;
+    }
+
+    if (result != ESP_OK)
+    {
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "nvs error(nvs_get_blob)");
+        return MCP320X_ERR_FAIL;
+    }
+
+    return mcp320x_calibration_deserialize(calibration, blob, size, tables);
+}
+
+static mcp320x_err_t mcp320x_calibration_check_points(mcp320x_calibration_point_t const *points, uint8_t count)
+{
+    CMP_CHECK((count >= 2 && count <= MCP320X_CALIBRATION_POINTS_MAX), "count error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        CMP_CHECK((points[i].code_x16 <= MCP320X_CALIBRATION_CODE_X16_MAX), "points error(code_x16 above 4095 * 16)", MCP320X_ERR_INVALID_CONFIG)
+        CMP_CHECK((i == 0 || points[i].code_x16 > points[i - 1].code_x16), "points error(codes not increasing)", MCP320X_ERR_INVALID_CONFIG)
+    }
+
+    // Checked here, not when setting, so a blob is rejected before anything changes.
+    const int64_t gain = mcp320x_calibration_divide(((int64_t)points[count - 1].microvolts - points[0].microvolts) << 20,
+                                                    points[count - 1].code_x16 - points[0].code_x16);
+
+    CMP_CHECK((gain >= INT32_MIN && gain <= INT32_MAX), "points error(gain out of range)", MCP320X_ERR_INVALID_CONFIG)
+
+    return MCP320X_OK;
+}
+
+static void mcp320x_calibration_reset_channel(mcp320x_calibration_t *calibration, mcp320x_channel_t channel)
+{
+    mcp320x_calibration_channel_t *state = &calibration->channels[channel];
+
+    state->gain = (int32_t)calibration->reference_voltage * 16000;
+    state->bias = 1 << 15;
+    state->table = NULL;
+    state->point_count = 0;
+}
+
+static void mcp320x_calibration_fill_table(mcp320x_calibration_point_t const *points, uint8_t count, int32_t *table)
+{
+    uint8_t segment = 0;
+
+    // Codes are visited in order, so the segment only moves forward.
+    for (int32_t code = 0; code < MCP320X_CALIBRATION_TABLE_SIZE; code++)
+    {
+        const int32_t code_x16 = code * 16;
+
+        while (segment < count - 2 && code_x16 > points[segment + 1].code_x16)
+        {
+            segment++;
+        }
+
+        mcp320x_calibration_point_t const *start = &points[segment];
+        mcp320x_calibration_point_t const *end = &points[segment + 1];
+
+        table[code] = start->microvolts + (int32_t)mcp320x_calibration_divide(((int64_t)end->microvolts - start->microvolts) * (code_x16 - start->code_x16),
+                                                                              end->code_x16 - start->code_x16);
+    }
+}
+
+static int64_t mcp320x_calibration_divide(int64_t numerator, int64_t denominator)
+{
+    // Rounds to the nearest, away from 0 on halves; the denominator is positive.
+    return numerator >= 0 ? (numerator + denominator / 2) / denominator : -((-numerator + denominator / 2) / denominator);
+}
+
+static uint16_t mcp320x_calibration_checksum(uint8_t const *buffer, size_t size)
+{
+    uint16_t sum1 = 0;
+    uint16_t sum2 = 0;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        sum1 = (uint16_t)((sum1 + buffer[i]) % 255);
+        sum2 = (uint16_t)((sum2 + sum1) % 255);
+    }
+
+    return (uint16_t)((sum2 << 8) | sum1);
+}
+
+static void mcp320x_calibration_read_point(uint8_t const *buffer, mcp320x_calibration_point_t *point)
+{
+    point->code_x16 = (uint16_t)(buffer[0] | (buffer[1] << 8));
+    point->microvolts = (int32_t)((uint32_t)buffer[2] | ((uint32_t)buffer[3] << 8) | ((uint32_t)buffer[4] << 16) | ((uint32_t)buffer[5] << 24));
+}
@@ -0,0 +1,148 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp32_driver_mcp320x/mcp320x_capture.h"
+#include "jitter.h"
+#include "assertion.h"
+#include "log.h"
+
+// The timer wakes the calling task on the last notification index, leaving
+// the others to the caller. With a single index, it's the caller's index 0.
+#define MCP320X_CAPTURE_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+
+static void mcp320x_capture_timer_callback(void *arg);
+static mcp320x_err_t mcp320x_capture_run(mcp320x_prepared_t *prepared,
+                                         mcp320x_capture_trigger_t trigger,
+                                         uint32_t period_us,
+                                         mcp320x_capture_sample_t *samples,
+                                         size_t count,
+                                         mcp320x_jitter_t *jitter);
+
+mcp320x_err_t mcp320x_capture(mcp320x_t *handle,
+                              mcp320x_capture_config_t const *config,
+                              mcp320x_capture_sample_t *samples,
+                              size_t count,
+                              mcp320x_capture_stats_t *stats)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((config != NULL), "config error(NULL)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((samples != NULL), "samples error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK((count > 0), "count error(0)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+    CMP_CHECK((config->trigger == MCP320X_CAPTURE_TRIGGER_TIMER || config->trigger == MCP320X_CAPTURE_TRIGGER_SPIN), "trigger error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->rate_hz > 0), "rate_hz error(0)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->trigger != MCP320X_CAPTURE_TRIGGER_TIMER || config->rate_hz <= MCP320X_CAPTURE_TIMER_RATE_MAX_HZ), "rate_hz error(>MCP320X_CAPTURE_TIMER_RATE_MAX_HZ)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->trigger != MCP320X_CAPTURE_TRIGGER_SPIN || config->rate_hz <= MCP320X_CAPTURE_SPIN_RATE_MAX_HZ), "rate_hz error(>MCP320X_CAPTURE_SPIN_RATE_MAX_HZ)", MCP320X_ERR_INVALID_CONFIG)
+
+    mcp320x_prepared_t prepared;
+    mcp320x_jitter_t jitter;
+
+    mcp320x_err_t result = mcp320x_prepare(handle, config->channel, config->read_mode, &prepared);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
+
+    CMP_CHECK((mcp320x_acquire(handle, portMAX_DELAY) == MCP320X_OK), "bus error(acquire)", MCP320X_ERR_SPI_BUS_ACQUIRE)
+
+    result = mcp320x_capture_run(&prepared, config->trigger, 1000000 / config->rate_hz, samples, count, &jitter);
+
+    mcp320x_release(handle);
+
+    if (result == MCP320X_OK && stats != NULL)
+    {
+        mcp320x_jitter_get_stats(&jitter, stats);
+    }
+
+    return result;
+}
+
+static mcp320x_err_t mcp320x_capture_run(mcp320x_prepared_t *prepared,
+                                         mcp320x_capture_trigger_t trigger,
+                                         uint32_t period_us,
+                                         mcp320x_capture_sample_t *samples,
+                                         size_t count,
+                                         mcp320x_jitter_t *jitter)
+{
+    esp_timer_handle_t timer = NULL;
+
+    if (trigger == MCP320X_CAPTURE_TRIGGER_TIMER)
+    {
+        const esp_timer_create_args_t timer_args = {
+            .callback = mcp320x_capture_timer_callback,
+            .arg = xTaskGetCurrentTaskHandle(),
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "mcp320x_capture",
+            .skip_unhandled_events = true};
+
+        CMP_CHECK((esp_timer_create(&timer_args, &timer) == ESP_OK), "timer error(esp_timer_create)", MCP320X_ERR_FAIL)
+
+        ulTaskNotifyTakeIndexed(MCP320X_CAPTURE_NOTIFY_INDEX, pdTRUE, 0); // Stale notifications would trigger early.
+    }
+
+    // Timestamps are relative to the start, so the first one should be one
+    // period. Spinning, deadlines are absolute, so being late once doesn't
+    // shift the following samples.
+    const int64_t start_us = esp_timer_get_time();
+    int64_t deadline_us = start_us + period_us;
+    mcp320x_err_t result = MCP320X_OK;
+
+    mcp320x_jitter_init(jitter, period_us, 0);
+
+    if (timer != NULL && esp_timer_start_periodic(timer, period_us) != ESP_OK)
+    {
+        esp_timer_delete(timer);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "timer error(esp_timer_start_periodic)");
+        return MCP320X_ERR_FAIL;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (timer != NULL)
+        {
+            ulTaskNotifyTakeIndexed(MCP320X_CAPTURE_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+        }
+        else
+        {
+            while (esp_timer_get_time() < deadline_us)
+            {
+            }
+        }
+
+        const int64_t now_us = esp_timer_get_time();
+
+        result = mcp320x_read_prepared(prepared, &samples[i].value);
+
+        if (result != MCP320X_OK)
+        {
+            break;
+        }
+
+        samples[i].timestamp_us = (uint32_t)(now_us - start_us);
+
+        mcp320x_jitter_add(jitter, samples[i].timestamp_us);
+
+        // Deadlines already passed are skipped; the jitter accounts them as missed.
+        deadline_us += period_us;
+
+        if (now_us >= deadline_us)
+        {
+            deadline_us += (int64_t)(((now_us - deadline_us) / period_us) + 1) * period_us;
+        }
+    }
+
+    if (timer != NULL)
+    {
+        esp_timer_stop(timer);
+        esp_timer_delete(timer);
+
+        ulTaskNotifyTakeIndexed(MCP320X_CAPTURE_NOTIFY_INDEX, pdTRUE, 0); // A tick may have come after the last sample.
+    }
+
+    return result;
+}
+
+static void mcp320x_capture_timer_callback(void *arg)
+{
+    xTaskNotifyGiveIndexed((TaskHandle_t)arg, MCP320X_CAPTURE_NOTIFY_INDEX);
+}
@@ -0,0 +1,103 @@
+#include <string.h>
+#include "esp32_driver_mcp320x/mcp320x_decimator.h"
+#include "assertion.h"
+
+// Cascaded integrator-comb (Hogenauer) decimator: N integrators at the input
+// rate, a downsampler and N combs (differentiators) at the output rate. Its
+// gain is ratio^N, so a 12 bits input grows by N * log2(ratio) bits. The
+// stages use modular (wrapping) arithmetic: as long as the output fits 32
+// bits the overflows of the integrators cancel on the combs.
+//
+// With N = 1 it's a boxcar: the sum of the last "ratio" codes.
+
+mcp320x_err_t mcp320x_decimator_init(mcp320x_decimator_t *decimator, mcp320x_decimator_config_t const *config)
+{
+    CMP_CHECK((decimator != NULL), "decimator error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((config != NULL), "config error(NULL)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->order > 0 && config->order <= MCP320X_DECIMATOR_ORDER_MAX), "order error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->ratio > 0 && config->ratio <= MCP320X_DECIMATOR_RATIO_MAX), "ratio error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK(((config->ratio & (config->ratio - 1)) == 0), "ratio error(not power of two)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->output_bits >= MCP320X_DECIMATOR_OUTPUT_BITS_MIN && config->output_bits <= MCP320X_DECIMATOR_OUTPUT_BITS_MAX), "output_bits error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->channel_count > 0 && config->channel_count <= MCP320X_CHANNEL_COUNT_MAX), "channel_count error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+
+    uint8_t ratio_bits = 0;
+
+    while ((1U << ratio_bits) < config->ratio)
+    {
+        ratio_bits++;
+    }
+
+    const uint8_t growth = (uint8_t)(config->order * ratio_bits);
+    const uint8_t extra_bits = (uint8_t)(config->output_bits - MCP320X_DECIMATOR_OUTPUT_BITS_MIN);
+
+    CMP_CHECK((growth <= MCP320X_DECIMATOR_GROWTH_MAX), "order/ratio error(>MCP320X_DECIMATOR_GROWTH_MAX)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((growth >= extra_bits), "output_bits error(more bits than the filter adds)", MCP320X_ERR_INVALID_CONFIG)
+
+    memset(decimator, 0, sizeof(mcp320x_decimator_t));
+
+    decimator->order = config->order;
+    decimator->shift = (uint8_t)(growth - extra_bits);
+    decimator->channel_count = config->channel_count;
+    decimator->ratio = config->ratio;
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_decimator_process(mcp320x_decimator_t *decimator,
+                                        uint16_t const *codes,
+                                        size_t count,
+                                        uint16_t *outputs,
+                                        size_t capacity,
+                                        size_t *output_count)
+{
+    CMP_CHECK_ARG((decimator != NULL), "decimator error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((codes != NULL || count == 0), "codes error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((outputs != NULL), "outputs error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((output_count != NULL), "output_count error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK((capacity >= count / decimator->ratio + decimator->channel_count), "capacity error(too small)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+
+    const uint8_t order = decimator->order;
+    const uint32_t half = decimator->shift > 0 ? 1UL << (decimator->shift - 1) : 0;
+    size_t produced = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint8_t channel = decimator->channel;
+        uint32_t value = codes[i];
+
+        for (uint8_t stage = 0; stage < order; stage++)
+        {
+            decimator->integrators[stage][channel] += value;
+            value = decimator->integrators[stage][channel];
+        }
+
+        if (decimator->phase == decimator->ratio - 1)
+        {
+            for (uint8_t stage = 0; stage < order; stage++)
+            {
+                const uint32_t delayed = decimator->combs[stage][channel];
+
+                decimator->combs[stage][channel] = value;
+                value -= delayed;
+            }
+
+            // Rounds to nearest. Can't overflow: the output is at most
+            // 4095 * 2^growth, and growth is at most 20 bits.
+            outputs[produced++] = (uint16_t)((value + half) >> decimator->shift);
+        }
+
+        if (++decimator->channel == decimator->channel_count)
+        {
+            decimator->channel = 0;
+
+            if (++decimator->phase == decimator->ratio)
+            {
+                decimator->phase = 0;
+            }
+        }
+    }
+
+    *output_count = produced;
+
+    return MCP320X_OK;
+}
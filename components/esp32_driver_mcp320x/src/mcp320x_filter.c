@@ -0,0 +1,283 @@
+#include <string.h>
+#include "esp32_driver_mcp320x/mcp320x_filter.h"
+#include "assertion.h"
+
+// Every filter works with integers and Q15 coefficients. Recursive filters
+// (EMA and biquad) keep their outputs with MCP320X_FILTER_GUARD_BITS
+// fractional bits, otherwise small steps would be rounded away and the output
+// would stop short of the input. Products go to 64 bits: a 16 bits code times
+// a Q15 coefficient, with guard bits, doesn't fit 32.
+//
+// Each filter runs over the whole array before the next, so its switch and
+// coefficients are loaded once per call, not once per code.
+
+#define MCP320X_FILTER_GUARD_BITS 8
+#define MCP320X_FILTER_STATE_MAX (1L << 30) // Bounds an unstable biquad, so its state can't wrap.
+
+static void mcp320x_filter_ema(mcp320x_filter_stage_t *stage, uint16_t *codes, size_t count, uint8_t channel, uint8_t channel_count, uint8_t primed);
+static void mcp320x_filter_boxcar(mcp320x_filter_stage_t *stage, uint16_t *codes, size_t count, uint8_t channel, uint8_t channel_count, uint8_t primed);
+static void mcp320x_filter_fir(mcp320x_filter_stage_t *stage, uint16_t *codes, size_t count, uint8_t channel, uint8_t channel_count, uint8_t primed);
+static void mcp320x_filter_biquad(mcp320x_filter_stage_t *stage, uint16_t *codes, size_t count, uint8_t channel, uint8_t channel_count, uint8_t primed);
+
+mcp320x_err_t mcp320x_filter_init(mcp320x_filter_t *filter, mcp320x_filter_config_t const *config)
+{
+    CMP_CHECK((filter != NULL), "filter error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((config != NULL), "config error(NULL)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->stage_count > 0 && config->stage_count <= MCP320X_FILTER_STAGES_MAX), "stage_count error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->channel_count > 0 && config->channel_count <= MCP320X_CHANNEL_COUNT_MAX), "channel_count error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+
+    for (uint8_t i = 0; i < config->stage_count; i++)
+    {
+        mcp320x_filter_stage_config_t const *stage = &config->stages[i];
+
+        switch (stage->type)
+        {
+        case MCP320X_FILTER_EMA:
+            CMP_CHECK((stage->alpha > 0 && stage->alpha <= MCP320X_FILTER_ONE), "alpha error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+            break;
+        case MCP320X_FILTER_BOXCAR:
+            CMP_CHECK((stage->length > 0 && stage->length <= MCP320X_FILTER_TAPS_MAX), "length error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+            break;
+        case MCP320X_FILTER_FIR:
+            CMP_CHECK((stage->length > 0 && stage->length <= MCP320X_FILTER_TAPS_MAX), "length error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+
+            for (uint8_t tap = 0; tap < stage->length; tap++)
+            {
+                CMP_CHECK((stage->coefficients[tap] >= -MCP320X_FILTER_ONE && stage->coefficients[tap] <= MCP320X_FILTER_ONE), "coefficients error(tap out of -1.0 to 1.0)", MCP320X_ERR_INVALID_CONFIG)
+            }
+            break;
+        case MCP320X_FILTER_BIQUAD:
+            for (uint8_t k = 0; k < 5; k++)
+            {
+                CMP_CHECK((stage->coefficients[k] > -MCP320X_FILTER_BIQUAD_COEFFICIENT_MAX && stage->coefficients[k] < MCP320X_FILTER_BIQUAD_COEFFICIENT_MAX), "coefficients error(>MCP320X_FILTER_BIQUAD_COEFFICIENT_MAX)", MCP320X_ERR_INVALID_CONFIG)
+            }
+            break;
+        default:
+            CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "type error(invalid)");
+            return MCP320X_ERR_INVALID_CONFIG;
+        }
+    }
+
+    memset(filter, 0, sizeof(mcp320x_filter_t));
+
+    filter->stage_count = config->stage_count;
+    filter->channel_count = config->channel_count;
+
+    for (uint8_t i = 0; i < config->stage_count; i++)
+    {
+        filter->stages[i].type = config->stages[i].type;
+        filter->stages[i].length = config->stages[i].length;
+
+        if (config->stages[i].type == MCP320X_FILTER_EMA)
+        {
+            filter->stages[i].coefficients[0] = config->stages[i].alpha;
+        }
+        else
+        {
+            memcpy(filter->stages[i].coefficients, config->stages[i].coefficients, sizeof(filter->stages[i].coefficients));
+        }
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_filter_process(mcp320x_filter_t *filter, uint16_t *codes, size_t count)
+{
+    CMP_CHECK_ARG((filter != NULL), "filter error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((codes != NULL || count == 0), "codes error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    for (uint8_t i = 0; i < filter->stage_count; i++)
+    {
+        mcp320x_filter_stage_t *stage = &filter->stages[i];
+
+        switch (stage->type)
+        {
+        case MCP320X_FILTER_EMA:
+            mcp320x_filter_ema(stage, codes, count, filter->channel, filter->channel_count, filter->primed);
+            break;
+        case MCP320X_FILTER_BOXCAR:
+            mcp320x_filter_boxcar(stage, codes, count, filter->channel, filter->channel_count, filter->primed);
+            break;
+        case MCP320X_FILTER_FIR:
+            mcp320x_filter_fir(stage, codes, count, filter->channel, filter->channel_count, filter->primed);
+            break;
+        default:
+            mcp320x_filter_biquad(stage, codes, count, filter->channel, filter->channel_count, filter->primed);
+            break;
+        }
+    }
+
+    // The first channel_count codes hold one code of each channel.
+    for (size_t i = 0; i < count && i < filter->channel_count; i++)
+    {
+        filter->primed |= (uint8_t)(1 << ((filter->channel + i) % filter->channel_count));
+    }
+
+    filter->channel = (uint8_t)((filter->channel + count) % filter->channel_count);
+
+    return MCP320X_OK;
+}
+
+/**
+ * @brief Round a value with guard bits to a code, clamping it from 0 to 65535.
+ * @param[in] value Value with MCP320X_FILTER_GUARD_BITS fractional bits.
+ * @return Digital code.
+ */
+static inline uint16_t mcp320x_filter_to_code(int64_t value)
+{
+    const int64_t code = (value + (1 << (MCP320X_FILTER_GUARD_BITS - 1))) >> MCP320X_FILTER_GUARD_BITS;
+
+    return code < 0 ? 0 : (code > UINT16_MAX ? UINT16_MAX : (uint16_t)code);
+}
+
+static void mcp320x_filter_ema(mcp320x_filter_stage_t *stage, uint16_t *codes, size_t count, uint8_t channel, uint8_t channel_count, uint8_t primed)
+{
+    const int64_t alpha = stage->coefficients[0];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const int32_t input = (int32_t)codes[i] << MCP320X_FILTER_GUARD_BITS;
+        int32_t *output = &stage->state[channel][0];
+
+        if (i < channel_count && !(primed & (1 << channel)))
+        {
+            *output = input;
+        }
+        else
+        {
+            *output += (int32_t)((alpha * (input - *output) + (1 << 14)) >> 15);
+        }
+
+        codes[i] = mcp320x_filter_to_code(*output);
+
+        if (++channel == channel_count)
+        {
+            channel = 0;
+        }
+    }
+}
+
+static void mcp320x_filter_boxcar(mcp320x_filter_stage_t *stage, uint16_t *codes, size_t count, uint8_t channel, uint8_t channel_count, uint8_t primed)
+{
+    const uint8_t length = stage->length;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint16_t input = codes[i];
+        uint16_t *history = stage->history[channel];
+        int32_t *sum = &stage->state[channel][0];
+        uint8_t *position = &stage->position[channel];
+
+        if (i < channel_count && !(primed & (1 << channel)))
+        {
+            for (uint8_t k = 0; k < length; k++)
+            {
+                history[k] = input;
+            }
+
+            *sum = (int32_t)input * length;
+        }
+
+        // Running sum: add the newest code, remove the oldest.
+        *sum += (int32_t)input - history[*position];
+        history[*position] = input;
+
+        if (++(*position) == length)
+        {
+            *position = 0;
+        }
+
+        codes[i] = (uint16_t)((*sum + length / 2) / length);
+
+        if (++channel == channel_count)
+        {
+            channel = 0;
+        }
+    }
+}
+
+static void mcp320x_filter_fir(mcp320x_filter_stage_t *stage, uint16_t *codes, size_t count, uint8_t channel, uint8_t channel_count, uint8_t primed)
+{
+    const uint8_t length = stage->length;
+    int32_t const *taps = stage->coefficients;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint16_t input = codes[i];
+        uint16_t *history = stage->history[channel];
+        uint8_t *position = &stage->position[channel];
+
+        if (i < channel_count && !(primed & (1 << channel)))
+        {
+            for (uint8_t k = 0; k < length; k++)
+            {
+                history[k] = input;
+            }
+        }
+
+        // The newest code replaces the oldest; the taps walk back from it.
+        uint8_t index = *position;
+        int64_t sum = 0;
+
+        history[index] = input;
+
+        if (++(*position) == length)
+        {
+            *position = 0;
+        }
+
+        for (uint8_t k = 0; k < length; k++)
+        {
+            sum += (int32_t)history[index] * taps[k];
+            index = index == 0 ? (uint8_t)(length - 1) : (uint8_t)(index - 1);
+        }
+
+        // Truncated to the guard bits, so the sum is only rounded once.
+        codes[i] = mcp320x_filter_to_code(sum >> (15 - MCP320X_FILTER_GUARD_BITS));
+
+        if (++channel == channel_count)
+        {
+            channel = 0;
+        }
+    }
+}
+
+static void mcp320x_filter_biquad(mcp320x_filter_stage_t *stage, uint16_t *codes, size_t count, uint8_t channel, uint8_t channel_count, uint8_t primed)
+{
+    const int64_t b0 = stage->coefficients[0];
+    const int64_t b1 = stage->coefficients[1];
+    const int64_t b2 = stage->coefficients[2];
+    const int64_t a1 = stage->coefficients[3];
+    const int64_t a2 = stage->coefficients[4];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const int32_t input = (int32_t)codes[i] << MCP320X_FILTER_GUARD_BITS;
+        uint16_t *x = stage->history[channel];
+        int32_t *y = stage->state[channel];
+
+        if (i < channel_count && !(primed & (1 << channel)))
+        {
+            x[0] = x[1] = codes[i];
+            y[0] = y[1] = input;
+        }
+
+        const int64_t x1 = (int32_t)x[0] << MCP320X_FILTER_GUARD_BITS;
+        const int64_t x2 = (int32_t)x[1] << MCP320X_FILTER_GUARD_BITS;
+        int64_t output = (b0 * input + b1 * x1 + b2 * x2 - a1 * y[0] - a2 * y[1] + (1 << 14)) >> 15;
+
+        output = output > MCP320X_FILTER_STATE_MAX ? MCP320X_FILTER_STATE_MAX : (output < -MCP320X_FILTER_STATE_MAX ? -MCP320X_FILTER_STATE_MAX : output);
+
+        x[1] = x[0];
+        x[0] = codes[i];
+        y[1] = y[0];
+        y[0] = (int32_t)output;
+
+        codes[i] = mcp320x_filter_to_code(output);
+
+        if (++channel == channel_count)
+        {
+            channel = 0;
+        }
+    }
+}
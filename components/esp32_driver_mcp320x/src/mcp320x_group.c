@@ -0,0 +1,223 @@
+#include <stdlib.h>
+#include "esp32_driver_mcp320x/mcp320x_group.h"
+#include "esp_attr.h"
+#include "context.h"
+#include "frame.h"
+#include "lock.h"
+#include "stats.h"
+#include "assertion.h"
+#include "log.h"
+
+// ESP-IDF only lets one device hold a SPI bus, so a group never acquires it.
+// Instead, every conversion of a pass is queued before waiting for any: the
+// SPI driver chains the transactions of all devices from its interrupt, with
+// no task switch between them. Frames alternate the devices, so the chip
+// select recovery time of one device passes while the others convert.
+
+// A pass queues at most one frame per channel on each device.
+_Static_assert(MCP320X_CHANNEL_COUNT_MAX <= MCP320X_BATCH_QUEUE_SIZE, "A pass must fit the queue of each device");
+
+static mcp320x_err_t mcp320x_group_pipeline(mcp320x_group_t *group,
+                                            mcp320x_channel_t const *channels,
+                                            size_t channel_count,
+                                            mcp320x_read_mode_t read_mode,
+                                            uint16_t values[][MCP320X_CHANNEL_COUNT_MAX]);
+
+mcp320x_group_t *mcp320x_group_install(mcp320x_config_t const *configs, size_t count)
+{
+    CMP_CHECK((configs != NULL), "configs error(NULL)", NULL)
+    CMP_CHECK((count > 0), "count error(0)", NULL)
+    CMP_CHECK((count <= MCP320X_GROUP_DEVICES_MAX), "count error(>MCP320X_GROUP_DEVICES_MAX)", NULL)
+
+    mcp320x_group_t *group = (mcp320x_group_t *)calloc(1, sizeof(mcp320x_group_t));
+
+    CMP_CHECK((group != NULL), "group error(no memory)", NULL)
+
+    group->model = MCP3208_MODEL;
+
+    for (; group->count < count; group->count++)
+    {
+        mcp320x_t *device = mcp320x_install(&configs[group->count]);
+
+        if (device == NULL)
+        {
+            mcp320x_group_delete(group);
+            CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "device error(install)");
+            return NULL;
+        }
+
+        group->devices[group->count] = device;
+
+        if (device->mcp_model < group->model)
+        {
+            group->model = device->mcp_model;
+        }
+    }
+
+    return group;
+}
+
+mcp320x_err_t mcp320x_group_delete(mcp320x_group_t *group)
+{
+    CMP_CHECK((group != NULL), "group error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+
+    // Checked before deleting any, so a failure leaves the group whole.
+    for (size_t i = 0; i < group->count; i++)
+    {
+        CMP_CHECK((group->devices[i]->async_count == 0), "async error(reads pending)", MCP320X_ERR_INVALID_STATE)
+    }
+
+    mcp320x_err_t result = MCP320X_OK;
+
+    for (size_t i = 0; i < group->count; i++)
+    {
+        const mcp320x_err_t delete_result = mcp320x_delete(group->devices[i]);
+
+        result = result == MCP320X_OK ? delete_result : result;
+    }
+
+    free(group);
+
+    return result;
+}
+
+mcp320x_err_t mcp320x_group_get_device(mcp320x_group_t *group, size_t index, mcp320x_t **handle)
+{
+    CMP_CHECK((group != NULL), "group error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((index < group->count), "index error(>=count)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    *handle = group->devices[index];
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_group_scan(mcp320x_group_t *group,
+                                 uint8_t channel_mask,
+                                 mcp320x_read_mode_t read_mode,
+                                 uint16_t values[][MCP320X_CHANNEL_COUNT_MAX])
+{
+    CMP_CHECK_ARG((group != NULL), "group error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((channel_mask != 0), "channel_mask error(0)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG(((channel_mask >> (int)group->model) == 0), "channel_mask error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG((values != NULL), "values error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    mcp320x_channel_t channels[MCP320X_CHANNEL_COUNT_MAX];
+    size_t channel_count = 0;
+    mcp320x_err_t result = MCP320X_OK;
+
+    for (int channel = 0; channel < (int)group->model; channel++)
+    {
+        if (channel_mask & (1 << channel))
+        {
+            channels[channel_count++] = (mcp320x_channel_t)channel;
+        }
+    }
+
+    // Always taken in index order, so concurrent passes can't deadlock.
+    for (size_t i = 0; i < group->count; i++)
+    {
+        mcp320x_lock_take(group->devices[i], portMAX_DELAY);
+    }
+
+    // A device holding the bus would stall the queue of all the others, and
+    // pending asynchronous reads would be collected as the group's. A stream
+    // on a locked device only holds the lock during its scans, so it's
+    // checked on its own.
+    for (size_t i = 0; i < group->count && result == MCP320X_OK; i++)
+    {
+        mcp320x_t const *device = group->devices[i];
+
+        if (device->acquired > 0 || device->async_count > 0 || device->stream != NULL)
+        {
+            CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "device error(bus acquired, streaming or reads pending)");
+            result = MCP320X_ERR_INVALID_STATE;
+        }
+    }
+
+    if (result == MCP320X_OK)
+    {
+        result = mcp320x_group_pipeline(group, channels, channel_count, read_mode, values);
+    }
+
+    for (size_t i = 0; i < group->count && result == MCP320X_OK; i++)
+    {
+        if (group->devices[i]->transport->submit == NULL)
+        {
+            result = mcp320x_scan(group->devices[i], channel_mask, read_mode, values[i]);
+        }
+    }
+
+    for (size_t i = group->count; i > 0; i--)
+    {
+        mcp320x_lock_give(group->devices[i - 1]);
+    }
+
+    return result;
+}
+
+static mcp320x_err_t mcp320x_group_pipeline(mcp320x_group_t *group,
+                                            mcp320x_channel_t const *channels,
+                                            size_t channel_count,
+                                            mcp320x_read_mode_t read_mode,
+                                            uint16_t values[][MCP320X_CHANNEL_COUNT_MAX])
+{
+    WORD_ALIGNED_ATTR uint8_t frame[MCP320X_FRAME_SIZE];
+    uint8_t submitted[MCP320X_GROUP_DEVICES_MAX] = {0};
+    mcp320x_err_t result = MCP320X_OK;
+
+    for (size_t i = 0; i < channel_count && result == MCP320X_OK; i++)
+    {
+        mcp320x_frame_encode(channels[i], read_mode, frame);
+
+        for (size_t device = 0; device < group->count && result == MCP320X_OK; device++)
+        {
+            mcp320x_t *handle = group->devices[device];
+
+            if (handle->transport->submit == NULL)
+            {
+                continue;
+            }
+
+            if (handle->transport->submit(handle->transport_context, frame, NULL, NULL) != MCP320X_OK)
+            {
+                mcp320x_stats_error(handle, MCP320X_ERR_SPI_BUS);
+                CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "transport error(submit)");
+                result = MCP320X_ERR_SPI_BUS;
+                break;
+            }
+
+            submitted[device]++;
+        }
+    }
+
+    // Every submitted frame must be collected, even after a failure,
+    // otherwise they would be left inside the driver queue.
+    for (size_t i = 0; i < channel_count; i++)
+    {
+        for (size_t device = 0; device < group->count; device++)
+        {
+            mcp320x_t *handle = group->devices[device];
+
+            if (i >= submitted[device])
+            {
+                continue;
+            }
+
+            const mcp320x_err_t collected = handle->transport->collect(handle->transport_context, frame, portMAX_DELAY) == MCP320X_OK ? MCP320X_OK : MCP320X_ERR_SPI_BUS;
+
+            mcp320x_stats_collected(handle, collected);
+
+            if (collected != MCP320X_OK)
+            {
+                CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "transport error(collect)");
+                result = collected;
+                continue;
+            }
+
+            values[device][channels[i]] = mcp320x_frame_decode(frame);
+        }
+    }
+
+    return result;
+}
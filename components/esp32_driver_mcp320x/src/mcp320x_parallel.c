@@ -0,0 +1,358 @@
+#include <stdatomic.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp32_driver_mcp320x/mcp320x_parallel.h"
+#include "context.h"
+#include "ring.h"
+#include "assertion.h"
+#include "log.h"
+
+// Each worker owns a single-producer/single-consumer ring of scans, like the
+// stream ring: free running counters masked by a power of two capacity.
+//
+// The reader merges the rings by timestamp. Rings alone can't tell whether an
+// empty worker is about to store an older scan, so each worker also publishes
+// a watermark after every scan: a time its next scan can't be older than.
+// The reader loads the watermark before looking at the ring; a scan stored
+// after that load was timestamped after the watermark.
+
+/**
+ * @typedef mcp320x_parallel_worker_t
+ * @brief Holds control data for a worker of a parallel acquisition.
+ */
+typedef struct
+{
+    mcp320x_parallel_t *parallel;            /** @brief Parallel acquisition it belongs to. */
+    mcp320x_group_t *group;                  /** @brief Devices scanned. */
+    uint8_t channel_mask;                    /** @brief Channels converted on every device. */
+    uint8_t index;                           /** @brief Index on the configuration. */
+    mcp320x_parallel_scan_t *buffer;         /** @brief Ring storage. */
+    size_t capacity;                         /** @brief Scans on the ring; power of two. */
+    atomic_size_t head;                      /** @brief Next scan to write. Only moved by the worker. */
+    atomic_size_t tail;                      /** @brief Next scan to read. Only moved by the reader. */
+    _Atomic int64_t watermark_us;            /** @brief The next scan is not older than this; INT64_MAX once stopped. */
+    esp_timer_handle_t timer;                /** @brief Periodic timer that triggers the scans; NULL when back-to-back. */
+    TaskHandle_t task;                       /** @brief Worker task. */
+    SemaphoreHandle_t stopped;               /** @brief Given by the worker task when it exits. */
+    volatile mcp320x_parallel_stats_t stats; /** @brief Counters; only written by the worker task. */
+} mcp320x_parallel_worker_t;
+
+/**
+ * @struct mcp320x_parallel_t
+ * @brief Holds control data for a parallel acquisition.
+ */
+struct mcp320x_parallel_t
+{
+    mcp320x_parallel_worker_t workers[MCP320X_PARALLEL_WORKERS_MAX]; /** @brief Workers. */
+    size_t worker_count;                                             /** @brief Workers started. */
+    mcp320x_read_mode_t read_mode;                                   /** @brief Read mode used by all channels. */
+    uint32_t period_us;                                              /** @brief Scan period; 0 when back-to-back. */
+    volatile bool running;                                           /** @brief Cleared to ask the worker tasks to exit. */
+};
+
+static void mcp320x_parallel_timer_callback(void *arg);
+static void mcp320x_parallel_task(void *arg);
+static void mcp320x_parallel_free(mcp320x_parallel_t *parallel);
+
+mcp320x_parallel_t *mcp320x_parallel_start(mcp320x_parallel_config_t const *config)
+{
+    CMP_CHECK((config != NULL), "config error(NULL)", NULL)
+    CMP_CHECK((config->worker_count > 0), "worker_count error(0)", NULL)
+    CMP_CHECK((config->worker_count <= MCP320X_PARALLEL_WORKERS_MAX), "worker_count error(>MCP320X_PARALLEL_WORKERS_MAX)", NULL)
+    CMP_CHECK((config->rate_hz <= MCP320X_PARALLEL_RATE_MAX_HZ), "rate_hz error(>MCP320X_PARALLEL_RATE_MAX_HZ)", NULL)
+
+    for (size_t i = 0; i < config->worker_count; i++)
+    {
+        mcp320x_parallel_worker_config_t const *worker = &config->workers[i];
+
+        CMP_CHECK((worker->group != NULL), "group error(NULL)", NULL)
+        CMP_CHECK((worker->channel_mask != 0), "channel_mask error(0)", NULL)
+        CMP_CHECK(((worker->channel_mask >> (int)worker->group->model) == 0), "channel_mask error(invalid)", NULL)
+
+        for (size_t j = 0; j < i; j++)
+        {
+            CMP_CHECK((config->workers[j].group != worker->group), "group error(shared by workers)", NULL)
+        }
+    }
+
+    mcp320x_parallel_t *parallel = (mcp320x_parallel_t *)calloc(1, sizeof(mcp320x_parallel_t));
+
+    CMP_CHECK((parallel != NULL), "parallel error(no memory)", NULL)
+
+    const size_t capacity = mcp320x_ring_round_capacity(config->ring_capacity > 0 ? config->ring_capacity : 1);
+
+    parallel->read_mode = config->read_mode;
+    parallel->period_us = config->rate_hz > 0 ? 1000000 / config->rate_hz : 0;
+    parallel->running = true;
+
+    for (; parallel->worker_count < config->worker_count; parallel->worker_count++)
+    {
+        mcp320x_parallel_worker_t *worker = &parallel->workers[parallel->worker_count];
+
+        worker->parallel = parallel;
+        worker->group = config->workers[parallel->worker_count].group;
+        worker->channel_mask = config->workers[parallel->worker_count].channel_mask;
+        worker->index = (uint8_t)parallel->worker_count;
+        worker->capacity = capacity;
+        worker->buffer = (mcp320x_parallel_scan_t *)calloc(capacity, sizeof(mcp320x_parallel_scan_t));
+        worker->stopped = xSemaphoreCreateBinary();
+        atomic_init(&worker->head, 0);
+        atomic_init(&worker->tail, 0);
+        atomic_init(&worker->watermark_us, 0);
+
+        if (worker->buffer == NULL || worker->stopped == NULL)
+        {
+            mcp320x_parallel_stop(parallel);
+            CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "parallel error(no memory)");
+            return NULL;
+        }
+
+        if (xTaskCreatePinnedToCore(mcp320x_parallel_task,
+                                    "mcp320x_parallel",
+                                    config->task_stack_size != 0 ? config->task_stack_size : MCP320X_PARALLEL_TASK_STACK_SIZE_DEFAULT,
+                                    worker,
+                                    config->task_priority,
+                                    &worker->task,
+                                    config->workers[parallel->worker_count].task_core) != pdPASS)
+        {
+            mcp320x_parallel_stop(parallel);
+            CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "task error(xTaskCreatePinnedToCore)");
+            return NULL;
+        }
+
+        // The callback only gets the task, so a tick still being dispatched
+        // while the acquisition stops never touches the freed worker.
+        const esp_timer_create_args_t timer_args = {
+            .callback = mcp320x_parallel_timer_callback,
+            .arg = worker->task,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "mcp320x_parallel",
+            .skip_unhandled_events = true};
+
+        if (parallel->period_us > 0 && esp_timer_create(&timer_args, &worker->timer) != ESP_OK)
+        {
+            worker->timer = NULL;
+            mcp320x_parallel_stop(parallel);
+            CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "timer error(esp_timer_create)");
+            return NULL;
+        }
+    }
+
+    for (size_t i = 0; i < parallel->worker_count; i++)
+    {
+        if (parallel->workers[i].timer != NULL && esp_timer_start_periodic(parallel->workers[i].timer, parallel->period_us) != ESP_OK)
+        {
+            mcp320x_parallel_stop(parallel);
+            CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "timer error(esp_timer_start_periodic)");
+            return NULL;
+        }
+    }
+
+    return parallel;
+}
+
+mcp320x_err_t mcp320x_parallel_stop(mcp320x_parallel_t *parallel)
+{
+    CMP_CHECK((parallel != NULL), "parallel error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+
+    // No more ticks before the tasks are asked to exit.
+    for (size_t i = 0; i < MCP320X_PARALLEL_WORKERS_MAX; i++)
+    {
+        mcp320x_parallel_worker_t *worker = &parallel->workers[i];
+
+        if (worker->timer != NULL)
+        {
+            esp_timer_stop(worker->timer);
+            esp_timer_delete(worker->timer);
+            worker->timer = NULL;
+        }
+    }
+
+    parallel->running = false;
+
+    for (size_t i = 0; i < MCP320X_PARALLEL_WORKERS_MAX; i++)
+    {
+        mcp320x_parallel_worker_t *worker = &parallel->workers[i];
+
+        // Also called when a start fails: only created tasks are waited for.
+        if (worker->task != NULL)
+        {
+            xTaskNotifyGive(worker->task);
+            xSemaphoreTake(worker->stopped, portMAX_DELAY);
+        }
+    }
+
+    mcp320x_parallel_free(parallel);
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_parallel_read(mcp320x_parallel_t *parallel,
+                                    mcp320x_parallel_scan_t *scans,
+                                    size_t length,
+                                    size_t *read_count)
+{
+    CMP_CHECK_ARG((parallel != NULL), "parallel error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((scans != NULL), "scans error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((read_count != NULL), "read_count error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    *read_count = 0;
+
+    while (*read_count < length)
+    {
+        mcp320x_parallel_worker_t *oldest = NULL;
+        int64_t oldest_us = INT64_MAX;
+        int64_t bound_us = INT64_MAX;
+
+        for (size_t i = 0; i < parallel->worker_count; i++)
+        {
+            mcp320x_parallel_worker_t *worker = &parallel->workers[i];
+
+            // Watermark first: see the comment at the top.
+            const int64_t watermark_us = atomic_load_explicit(&worker->watermark_us, memory_order_acquire);
+            const size_t head = atomic_load_explicit(&worker->head, memory_order_acquire);
+            const size_t tail = atomic_load_explicit(&worker->tail, memory_order_relaxed);
+
+            if (head == tail)
+            {
+                bound_us = watermark_us < bound_us ? watermark_us : bound_us;
+                continue;
+            }
+
+            const int64_t timestamp_us = worker->buffer[tail & (worker->capacity - 1)].timestamp_us;
+
+            if (timestamp_us < oldest_us)
+            {
+                oldest = worker;
+                oldest_us = timestamp_us;
+            }
+        }
+
+        // Nothing stored, or an empty worker may still store an older scan.
+        if (oldest == NULL || oldest_us > bound_us)
+        {
+            break;
+        }
+
+        const size_t tail = atomic_load_explicit(&oldest->tail, memory_order_relaxed);
+
+        memcpy(&scans[*read_count], &oldest->buffer[tail & (oldest->capacity - 1)], sizeof(mcp320x_parallel_scan_t));
+
+        // Release the slot only after it is copied.
+        atomic_store_explicit(&oldest->tail, tail + 1, memory_order_release);
+
+        (*read_count)++;
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_parallel_get_stats(mcp320x_parallel_t *parallel, mcp320x_parallel_stats_t *stats)
+{
+    CMP_CHECK((parallel != NULL), "parallel error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((stats != NULL), "stats error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    memset(stats, 0, sizeof(mcp320x_parallel_stats_t));
+
+    for (size_t i = 0; i < parallel->worker_count; i++)
+    {
+        stats->scans += parallel->workers[i].stats.scans;
+        stats->dropped += parallel->workers[i].stats.dropped;
+        stats->errors += parallel->workers[i].stats.errors;
+    }
+
+    return MCP320X_OK;
+}
+
+static void mcp320x_parallel_timer_callback(void *arg)
+{
+    xTaskNotifyGive((TaskHandle_t)arg);
+}
+
+static void mcp320x_parallel_task(void *arg)
+{
+    mcp320x_parallel_worker_t *worker = (mcp320x_parallel_worker_t *)arg;
+    mcp320x_parallel_t *parallel = worker->parallel;
+
+    atomic_store_explicit(&worker->watermark_us, esp_timer_get_time(), memory_order_release);
+
+    while (parallel->running)
+    {
+        if (parallel->period_us > 0)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+            if (!parallel->running)
+            {
+                break;
+            }
+        }
+
+        const size_t head = atomic_load_explicit(&worker->head, memory_order_relaxed);
+        const size_t tail = atomic_load_explicit(&worker->tail, memory_order_acquire);
+
+        if (head - tail == worker->capacity)
+        {
+            worker->stats.dropped++;
+
+            // Back-to-back, wait for the reader instead of spinning.
+            if (parallel->period_us == 0)
+            {
+                vTaskDelay(1);
+            }
+
+            atomic_store_explicit(&worker->watermark_us, esp_timer_get_time(), memory_order_release);
+            continue;
+        }
+
+        mcp320x_parallel_scan_t *scan = &worker->buffer[head & (worker->capacity - 1)];
+
+        scan->timestamp_us = esp_timer_get_time();
+        scan->worker = worker->index;
+
+        if (mcp320x_group_scan(worker->group, worker->channel_mask, parallel->read_mode, scan->values) == MCP320X_OK)
+        {
+            // Publish the scan only after it is written.
+            atomic_store_explicit(&worker->head, head + 1, memory_order_release);
+            worker->stats.scans++;
+        }
+        else
+        {
+            worker->stats.errors++;
+        }
+
+        atomic_store_explicit(&worker->watermark_us, esp_timer_get_time(), memory_order_release);
+    }
+
+    // Nothing else will be stored: stop holding back the other workers.
+    atomic_store_explicit(&worker->watermark_us, INT64_MAX, memory_order_release);
+
+    xSemaphoreGive(worker->stopped);
+
+    vTaskDelete(NULL);
+}
+
+static void mcp320x_parallel_free(mcp320x_parallel_t *parallel)
+{
+    for (size_t i = 0; i < MCP320X_PARALLEL_WORKERS_MAX; i++)
+    {
+        mcp320x_parallel_worker_t *worker = &parallel->workers[i];
+
+        if (worker->timer != NULL)
+        {
+            esp_timer_delete(worker->timer);
+        }
+
+        if (worker->stopped != NULL)
+        {
+            vSemaphoreDelete(worker->stopped);
+        }
+
+        free(worker->buffer);
+    }
+
+    free(parallel);
+}
@@ -0,0 +1,146 @@
+#include "esp32_driver_mcp320x/mcp320x.h"
+#include "isqrt.h"
+#include "assertion.h"
+
+static uint16_t mcp320x_select(uint16_t *codes, size_t low, size_t high, size_t k);
+
+mcp320x_err_t mcp320x_codes_stats(uint16_t *codes,
+                                  uint16_t count,
+                                  uint8_t trim_percent,
+                                  mcp320x_sample_stats_t *stats)
+{
+    CMP_CHECK_ARG((codes != NULL), "codes error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((stats != NULL), "stats error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((count > 0), "count error(0)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+    CMP_CHECK_ARG((trim_percent <= MCP320X_SAMPLE_STATS_TRIM_MAX), "trim_percent error(>MCP320X_SAMPLE_STATS_TRIM_MAX)", MCP320X_ERR_INVALID_SAMPLE_COUNT)
+
+    // Single pass for the moments. Codes are integers, so the sums are exact
+    // and the variance doesn't suffer the cancellation Welford's algorithm
+    // avoids on floating point: n * sum(x^2) - sum(x)^2 is at most
+    // 65535^2 * 4095^2, well within 64 bits.
+    uint16_t min = codes[0];
+    uint16_t max = codes[0];
+    uint32_t sum = 0;
+    uint64_t sum_squares = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint16_t code = codes[i];
+
+        min = code < min ? code : min;
+        max = code > max ? code : max;
+        sum += code;
+        sum_squares += (uint32_t)code * code;
+    }
+
+    const uint64_t n = count;
+    const uint64_t deviations = n * sum_squares - (uint64_t)sum * sum; // n^2 * variance.
+
+    stats->count = count;
+    stats->min = min;
+    stats->max = max;
+    stats->mean = (uint16_t)((sum + count / 2) / count);
+    stats->variance = (uint32_t)((deviations + n * n / 2) / (n * n));
+    stats->stddev_mcodes = mcp320x_isqrt((deviations / n) * 1000000 / n);
+
+    // Order statistics by selection, O(n) on average: the trimmed codes are
+    // moved to each end, then the median is selected among the remaining.
+    const size_t trimmed = (size_t)count * trim_percent / 100;
+    const size_t last = count - 1 - trimmed;
+    const size_t middle = count / 2;
+
+    if (trimmed > 0)
+    {
+        mcp320x_select(codes, 0, count - 1, trimmed);
+        mcp320x_select(codes, trimmed, count - 1, last);
+    }
+
+    uint32_t trimmed_sum = 0;
+
+    for (size_t i = trimmed; i <= last; i++)
+    {
+        trimmed_sum += codes[i];
+    }
+
+    const uint32_t kept = (uint32_t)(last - trimmed + 1);
+    uint32_t median = mcp320x_select(codes, trimmed, last, middle);
+
+    if ((count & 1) == 0)
+    {
+        // Lower middle: the biggest code left of the median.
+        uint16_t lower = codes[trimmed];
+
+        for (size_t i = trimmed + 1; i < middle; i++)
+        {
+            lower = codes[i] > lower ? codes[i] : lower;
+        }
+
+        median = (median + lower + 1) / 2;
+    }
+
+    stats->median = (uint16_t)median;
+    stats->trimmed_mean = (uint16_t)((trimmed_sum + kept / 2) / kept);
+
+    return MCP320X_OK;
+}
+
+static uint16_t mcp320x_select(uint16_t *codes, size_t low, size_t high, size_t k)
+{
+    // Hoare's quickselect with a median of three pivot: afterwards codes[k]
+    // is the k-th smallest on [low, high], with smaller or equal codes on its
+    // left and bigger or equal ones on its right.
+    while (low < high)
+    {
+        const size_t mid = low + (high - low) / 2;
+        uint16_t a = codes[low];
+        uint16_t b = codes[mid];
+        uint16_t c = codes[high];
+        const uint16_t pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+        size_t i = low;
+        size_t j = high;
+
+        while (i <= j)
+        {
+            while (codes[i] < pivot)
+            {
+                i++;
+            }
+
+            while (codes[j] > pivot)
+            {
+                j--;
+            }
+
+            if (i <= j)
+            {
+                const uint16_t swap = codes[i];
+
+                codes[i] = codes[j];
+                codes[j] = swap;
+                i++;
+
+                if (j == 0)
+                {
+                    break;
+                }
+
+                j--;
+            }
+        }
+
+        if (k <= j)
+        {
+            high = j;
+        }
+        else if (k >= i)
+        {
+            low = i;
+        }
+        else
+        {
+            break; // Between j and i: all equal to the pivot.
+        }
+    }
+
+    return codes[k];
+}
@@ -0,0 +1,210 @@
+#include <string.h>
+#include "esp32_driver_mcp320x/mcp320x_scheduler.h"
+#include "assertion.h"
+
+// Interleaves the conversions of many channels in proportion to their
+// weights, so the bus time goes where the signal changes:
+//
+// - Smooth weighted round-robin (as in nginx): every pick adds its weight to
+//   the credit of each slot, converts the slot with the most credit and takes
+//   the total weight from it. Weights 4:1 give A A B A A, not A A A A B.
+// - Earliest deadline: each slot is due every SCALE / weight of virtual time;
+//   the slot due first is converted and its deadline moves one period.
+//
+// The adaptation computes the variance of each slot over a window of its own
+// conversions and doubles its weight when busy, or halves it when quiet.
+
+static uint8_t mcp320x_scheduler_pick(mcp320x_scheduler_t *scheduler);
+static void mcp320x_scheduler_adapt(mcp320x_scheduler_t *scheduler, mcp320x_scheduler_slot_t *slot);
+
+mcp320x_err_t mcp320x_scheduler_init(mcp320x_scheduler_t *scheduler, mcp320x_scheduler_config_t const *config)
+{
+    CMP_CHECK((scheduler != NULL), "scheduler error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((config != NULL), "config error(NULL)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->slot_count > 0 && config->slot_count <= MCP320X_CHANNEL_COUNT_MAX), "slot_count error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->policy == MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN || config->policy == MCP320X_SCHEDULER_POLICY_EARLIEST_DEADLINE), "policy error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->window <= MCP320X_SCHEDULER_WINDOW_MAX), "window error(>MCP320X_SCHEDULER_WINDOW_MAX)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->window == 0 || config->variance_low < config->variance_high), "variance_low error(not below variance_high)", MCP320X_ERR_INVALID_CONFIG)
+
+    for (uint8_t i = 0; i < config->slot_count; i++)
+    {
+        mcp320x_scheduler_slot_config_t const *slot = &config->slots[i];
+
+        CMP_CHECK((slot->request.channel <= MCP320X_CHANNEL_7), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+        CMP_CHECK((slot->weight > 0 && slot->weight <= MCP320X_SCHEDULER_WEIGHT_MAX), "weight error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+        CMP_CHECK((config->window == 0 || (slot->weight_min > 0 && slot->weight_min <= slot->weight && slot->weight <= slot->weight_max && slot->weight_max <= MCP320X_SCHEDULER_WEIGHT_MAX)),
+                  "weight_min/weight_max error(weight out of them)", MCP320X_ERR_INVALID_CONFIG)
+    }
+
+    memset(scheduler, 0, sizeof(mcp320x_scheduler_t));
+
+    scheduler->slot_count = config->slot_count;
+    scheduler->policy = config->policy;
+    scheduler->window = config->window;
+    scheduler->variance_high = config->variance_high;
+    scheduler->variance_low = config->variance_low;
+
+    for (uint8_t i = 0; i < config->slot_count; i++)
+    {
+        mcp320x_scheduler_slot_t *slot = &scheduler->slots[i];
+
+        slot->request = config->slots[i].request;
+        slot->weight = config->slots[i].weight;
+        slot->weight_min = config->window > 0 ? config->slots[i].weight_min : slot->weight;
+        slot->weight_max = config->window > 0 ? config->slots[i].weight_max : slot->weight;
+        slot->deadline = MCP320X_SCHEDULER_TIME_SCALE / slot->weight;
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_scheduler_next(mcp320x_scheduler_t *scheduler, mcp320x_request_t *requests, uint8_t *slots, size_t count)
+{
+    CMP_CHECK_ARG((scheduler != NULL), "scheduler error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG(((requests != NULL && slots != NULL) || count == 0), "requests/slots error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint8_t slot = mcp320x_scheduler_pick(scheduler);
+
+        scheduler->slots[slot].conversions++;
+        requests[i] = scheduler->slots[slot].request;
+        slots[i] = slot;
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_scheduler_update(mcp320x_scheduler_t *scheduler, uint8_t const *slots, uint16_t const *codes, size_t count)
+{
+    CMP_CHECK_ARG((scheduler != NULL), "scheduler error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG(((slots != NULL && codes != NULL) || count == 0), "slots/codes error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    if (scheduler->window == 0)
+    {
+        return MCP320X_OK;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        CMP_CHECK_ARG((slots[i] < scheduler->slot_count), "slots error(>=slot_count)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+        mcp320x_scheduler_slot_t *slot = &scheduler->slots[slots[i]];
+
+        slot->sum += codes[i];
+        slot->sum_squares += (uint32_t)codes[i] * codes[i];
+
+        if (++slot->window_count == scheduler->window)
+        {
+            mcp320x_scheduler_adapt(scheduler, slot);
+        }
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_scheduler_read(mcp320x_scheduler_t *scheduler, mcp320x_t *handle, uint8_t *slots, uint16_t *values, size_t count)
+{
+    CMP_CHECK((scheduler != NULL), "scheduler error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK(((slots != NULL && values != NULL) || count == 0), "slots/values error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    mcp320x_request_t requests[MCP320X_BATCH_QUEUE_SIZE];
+
+    // One batch at a time, so the weights adapted by a batch shape the next.
+    for (size_t done = 0; done < count; done += MCP320X_BATCH_QUEUE_SIZE)
+    {
+        const size_t batch = count - done < MCP320X_BATCH_QUEUE_SIZE ? count - done : MCP320X_BATCH_QUEUE_SIZE;
+
+        mcp320x_scheduler_next(scheduler, requests, &slots[done], batch);
+
+        const mcp320x_err_t result = mcp320x_read_batch(handle, requests, batch, &values[done]);
+
+        if (result != MCP320X_OK)
+        {
+            return result;
+        }
+
+        mcp320x_scheduler_update(scheduler, &slots[done], &values[done], batch);
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_scheduler_get_stats(mcp320x_scheduler_t const *scheduler, mcp320x_scheduler_stats_t *stats)
+{
+    CMP_CHECK((scheduler != NULL), "scheduler error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((stats != NULL), "stats error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    memset(stats, 0, sizeof(mcp320x_scheduler_stats_t));
+
+    for (uint8_t i = 0; i < scheduler->slot_count; i++)
+    {
+        stats->conversions[i] = scheduler->slots[i].conversions;
+        stats->weights[i] = scheduler->slots[i].weight;
+        stats->variances[i] = scheduler->slots[i].variance;
+    }
+
+    return MCP320X_OK;
+}
+
+static uint8_t mcp320x_scheduler_pick(mcp320x_scheduler_t *scheduler)
+{
+    mcp320x_scheduler_slot_t *slots = scheduler->slots;
+    uint8_t pick = 0;
+
+    if (scheduler->policy == MCP320X_SCHEDULER_POLICY_EARLIEST_DEADLINE)
+    {
+        // Compared as a difference, so the virtual time can wrap.
+        for (uint8_t i = 1; i < scheduler->slot_count; i++)
+        {
+            if ((int32_t)(slots[i].deadline - slots[pick].deadline) < 0)
+            {
+                pick = i;
+            }
+        }
+
+        slots[pick].deadline += MCP320X_SCHEDULER_TIME_SCALE / slots[pick].weight;
+
+        return pick;
+    }
+
+    int16_t total = 0;
+
+    for (uint8_t i = 0; i < scheduler->slot_count; i++)
+    {
+        slots[i].credit += slots[i].weight;
+        total += slots[i].weight;
+
+        if (slots[i].credit > slots[pick].credit)
+        {
+            pick = i;
+        }
+    }
+
+    slots[pick].credit -= total;
+
+    return pick;
+}
+
+static void mcp320x_scheduler_adapt(mcp320x_scheduler_t *scheduler, mcp320x_scheduler_slot_t *slot)
+{
+    const uint64_t n = scheduler->window;
+    const uint64_t sum = slot->sum;
+
+    // n * sum(x²) - sum(x)², over n²: never negative, and fits 64 bits for 1024 codes of 12 bits.
+    slot->variance = (uint32_t)((n * slot->sum_squares - sum * sum) / (n * n));
+
+    if (slot->variance > scheduler->variance_high)
+    {
+        slot->weight = slot->weight * 2 < slot->weight_max ? (uint8_t)(slot->weight * 2) : slot->weight_max;
+    }
+    else if (slot->variance < scheduler->variance_low)
+    {
+        slot->weight = slot->weight / 2 > slot->weight_min ? (uint8_t)(slot->weight / 2) : slot->weight_min;
+    }
+
+    slot->window_count = 0;
+    slot->sum = 0;
+    slot->sum_squares = 0;
+}
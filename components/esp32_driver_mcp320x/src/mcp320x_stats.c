@@ -0,0 +1,71 @@
+#include <string.h>
+#include "esp32_driver_mcp320x/mcp320x_stats.h"
+#include "context.h"
+#include "lock.h"
+#include "stats.h"
+#include "assertion.h"
+#include "log.h"
+
+mcp320x_err_t mcp320x_get_stats(mcp320x_t *handle, mcp320x_stats_t *stats)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((stats != NULL), "stats error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+#if CONFIG_MCP320X_ENABLE_STATS
+    mcp320x_lock_take(handle, portMAX_DELAY);
+    *stats = handle->stats;
+    mcp320x_lock_give(handle);
+
+    return MCP320X_OK;
+#else
+    CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "stats error(CONFIG_MCP320X_ENABLE_STATS disabled)");
+    return MCP320X_ERR_INVALID_STATE;
+#endif
+}
+
+mcp320x_err_t mcp320x_reset_stats(mcp320x_t *handle)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+
+#if CONFIG_MCP320X_ENABLE_STATS
+    mcp320x_lock_take(handle, portMAX_DELAY);
+    memset(&handle->stats, 0, sizeof(mcp320x_stats_t));
+    mcp320x_lock_give(handle);
+
+    return MCP320X_OK;
+#else
+    CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "stats error(CONFIG_MCP320X_ENABLE_STATS disabled)");
+    return MCP320X_ERR_INVALID_STATE;
+#endif
+}
+
+mcp320x_err_t mcp320x_set_trace_hooks(mcp320x_t *handle, mcp320x_trace_hooks_t const *hooks, void *context)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+
+#if CONFIG_MCP320X_ENABLE_STATS
+    // Changed under the lock, so a locked handle never calls half of a pair.
+    mcp320x_lock_take(handle, portMAX_DELAY);
+
+    if (hooks != NULL)
+    {
+        handle->trace_hooks = *hooks;
+    }
+    else
+    {
+        memset(&handle->trace_hooks, 0, sizeof(mcp320x_trace_hooks_t));
+    }
+
+    handle->trace_context = context;
+
+    mcp320x_lock_give(handle);
+
+    return MCP320X_OK;
+#else
+    (void)hooks;
+    (void)context;
+
+    CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "trace error(CONFIG_MCP320X_ENABLE_STATS disabled)");
+    return MCP320X_ERR_INVALID_STATE;
+#endif
+}
@@ -0,0 +1,333 @@
+#include <stdatomic.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp32_driver_mcp320x/mcp320x_stream.h"
+#include "context.h"
+#include "ring.h"
+#include "assertion.h"
+#include "log.h"
+
+/**
+ * @struct mcp320x_stream_t
+ * @brief Holds control data for a background acquisition.
+ */
+struct mcp320x_stream_t
+{
+    mcp320x_t *handle;                                     /** @brief Device being converted. */
+    mcp320x_ring_t ring;                                   /** @brief Digital codes waiting to be read. */
+    uint16_t *ring_buffer;                                 /** @brief Ring storage. */
+    mcp320x_request_t requests[MCP320X_CHANNEL_COUNT_MAX]; /** @brief One request per channel on the scan. */
+    size_t request_count;                                  /** @brief Channels on the scan. */
+    mcp320x_stream_overflow_t overflow_policy;             /** @brief What to do when the ring is full. */
+    mcp320x_filter_t *filter;                              /** @brief Applied to every scan; NULL when not filtering. */
+    mcp320x_alarm_t *alarm;                                /** @brief Compares every scan, after the filter; NULL when not comparing. */
+    esp_timer_handle_t timer;                              /** @brief Periodic timer that triggers the scans. */
+    TaskHandle_t task;                                     /** @brief Acquisition task. */
+    SemaphoreHandle_t stopped;                             /** @brief Given by the acquisition task when it exits. */
+    volatile bool running;                                 /** @brief Cleared to ask the acquisition task to exit. */
+    atomic_bool waiting;                                   /** @brief Set while the acquisition task waits for space on the ring. */
+    volatile mcp320x_stream_stats_t stats;                 /** @brief Counters; only written by the acquisition task. */
+};
+
+static void mcp320x_stream_timer_callback(void *arg);
+static void mcp320x_stream_task(void *arg);
+static void mcp320x_stream_join(mcp320x_stream_t *stream);
+static void mcp320x_stream_free(mcp320x_stream_t *stream);
+
+mcp320x_err_t mcp320x_stream_start(mcp320x_t *handle, mcp320x_stream_config_t const *config)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((config != NULL), "config error(NULL)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((handle->stream == NULL), "stream error(already started)", MCP320X_ERR_INVALID_STATE)
+    CMP_CHECK((config->channel_mask != 0), "channel_mask error(0)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK(((config->channel_mask >> (int)handle->mcp_model) == 0), "channel_mask error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK((config->rate_hz > 0), "rate_hz error(0)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->rate_hz <= MCP320X_STREAM_RATE_MAX_HZ), "rate_hz error(>MCP320X_STREAM_RATE_MAX_HZ)", MCP320X_ERR_INVALID_CONFIG)
+
+    mcp320x_stream_t *stream = (mcp320x_stream_t *)calloc(1, sizeof(mcp320x_stream_t));
+
+    CMP_CHECK((stream != NULL), "stream error(no memory)", MCP320X_ERR_NO_MEMORY)
+
+    stream->handle = handle;
+    stream->overflow_policy = config->overflow_policy;
+
+    for (int channel = 0; channel < (int)handle->mcp_model; channel++)
+    {
+        if (config->channel_mask & (1 << channel))
+        {
+            stream->requests[stream->request_count].channel = (mcp320x_channel_t)channel;
+            stream->requests[stream->request_count].read_mode = config->read_mode;
+            stream->request_count++;
+        }
+    }
+
+    if (config->filter != NULL && config->filter->channel_count != stream->request_count)
+    {
+        mcp320x_stream_free(stream);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "filter error(channel_count differs from the channels converted)");
+        return MCP320X_ERR_INVALID_CONFIG;
+    }
+
+    if (config->alarm != NULL && config->alarm->channel_count != stream->request_count)
+    {
+        mcp320x_stream_free(stream);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "alarm error(channel_count differs from the channels converted)");
+        return MCP320X_ERR_INVALID_CONFIG;
+    }
+
+    stream->filter = config->filter;
+    stream->alarm = config->alarm;
+
+    const size_t capacity = mcp320x_ring_round_capacity(config->ring_capacity < stream->request_count ? stream->request_count : config->ring_capacity);
+
+    stream->ring_buffer = (uint16_t *)malloc(capacity * sizeof(uint16_t));
+    stream->stopped = xSemaphoreCreateBinary();
+
+    if (stream->ring_buffer == NULL || stream->stopped == NULL)
+    {
+        mcp320x_stream_free(stream);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "stream error(no memory)");
+        return MCP320X_ERR_NO_MEMORY;
+    }
+
+    mcp320x_ring_init(&stream->ring, stream->ring_buffer, capacity);
+
+    stream->running = true;
+    atomic_init(&stream->waiting, false);
+
+    if (xTaskCreatePinnedToCore(mcp320x_stream_task,
+                                "mcp320x_stream",
+                                config->task_stack_size != 0 ? config->task_stack_size : MCP320X_STREAM_TASK_STACK_SIZE_DEFAULT,
+                                stream,
+                                config->task_priority,
+                                &stream->task,
+                                config->task_core) != pdPASS)
+    {
+        mcp320x_stream_free(stream);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "task error(xTaskCreatePinnedToCore)");
+        return MCP320X_ERR_NO_MEMORY;
+    }
+
+    // The callback only gets the task, so a tick still being dispatched
+    // while the stream stops never touches the freed stream.
+    const esp_timer_create_args_t timer_args = {
+        .callback = mcp320x_stream_timer_callback,
+        .arg = stream->task,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "mcp320x_stream",
+        .skip_unhandled_events = true};
+
+    if (esp_timer_create(&timer_args, &stream->timer) != ESP_OK)
+    {
+        stream->timer = NULL;
+        mcp320x_stream_join(stream);
+        mcp320x_stream_free(stream);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "timer error(esp_timer_create)");
+        return MCP320X_ERR_FAIL;
+    }
+
+    if (esp_timer_start_periodic(stream->timer, 1000000 / config->rate_hz) != ESP_OK)
+    {
+        mcp320x_stream_join(stream);
+        mcp320x_stream_free(stream);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "timer error(esp_timer_start_periodic)");
+        return MCP320X_ERR_FAIL;
+    }
+
+    handle->stream = stream;
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_stream_stop(mcp320x_t *handle)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((handle->stream != NULL), "stream error(not started)", MCP320X_ERR_INVALID_STATE)
+
+    mcp320x_stream_t *stream = handle->stream;
+
+    // No more ticks before the task is asked to exit.
+    esp_timer_stop(stream->timer);
+    esp_timer_delete(stream->timer);
+    stream->timer = NULL;
+
+    mcp320x_stream_join(stream);
+
+    handle->stream = NULL;
+
+    mcp320x_stream_free(stream);
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_stream_read(mcp320x_t *handle,
+                                  uint16_t *values,
+                                  size_t length,
+                                  size_t *read_count)
+{
+    CMP_CHECK_ARG((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((values != NULL), "values error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((read_count != NULL), "read_count error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK((handle->stream != NULL), "stream error(not started)", MCP320X_ERR_INVALID_STATE)
+
+    mcp320x_stream_t *stream = handle->stream;
+
+    *read_count = mcp320x_ring_pop(&stream->ring, values, length);
+
+    // Only wake an acquisition task waiting for space: any other notification
+    // would be taken as a timer tick. The fence pairs with the one in the task,
+    // so either the task sees the space or this sees it waiting.
+    if (*read_count > 0 && stream->overflow_policy == MCP320X_STREAM_OVERFLOW_BLOCK)
+    {
+        atomic_thread_fence(memory_order_seq_cst);
+
+        if (atomic_load_explicit(&stream->waiting, memory_order_relaxed))
+        {
+            xTaskNotifyGive(stream->task);
+        }
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_stream_get_stats(mcp320x_t *handle, mcp320x_stream_stats_t *stats)
+{
+    CMP_CHECK((handle != NULL), "handle error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((stats != NULL), "stats error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK((handle->stream != NULL), "stream error(not started)", MCP320X_ERR_INVALID_STATE)
+
+    memcpy(stats, (void const *)&handle->stream->stats, sizeof(mcp320x_stream_stats_t));
+
+    return MCP320X_OK;
+}
+
+static void mcp320x_stream_timer_callback(void *arg)
+{
+    xTaskNotifyGive((TaskHandle_t)arg);
+}
+
+static void mcp320x_stream_task(void *arg)
+{
+    mcp320x_stream_t *stream = (mcp320x_stream_t *)arg;
+    uint16_t values[MCP320X_CHANNEL_COUNT_MAX];
+
+    // A locked handle is shared with other tasks: its lock, and the bus, are
+    // only held for each scan. Otherwise the bus is held until the stop.
+    const bool shared = stream->handle->lock != NULL;
+
+    if (!shared)
+    {
+        mcp320x_acquire(stream->handle, portMAX_DELAY);
+    }
+
+    while (stream->running)
+    {
+        // Each timer tick is one notification; more than one pending means
+        // the previous scan took longer than the period.
+        const uint32_t ticks = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        if (!stream->running)
+        {
+            break;
+        }
+
+        if (ticks > 1)
+        {
+            stream->stats.overruns += ticks - 1;
+        }
+
+        if (shared && mcp320x_acquire(stream->handle, portMAX_DELAY) != MCP320X_OK)
+        {
+            stream->stats.errors++;
+            continue;
+        }
+
+        const mcp320x_err_t result = mcp320x_read_batch(stream->handle, stream->requests, stream->request_count, values);
+
+        if (shared)
+        {
+            mcp320x_release(stream->handle);
+        }
+
+        if (result != MCP320X_OK)
+        {
+            stream->stats.errors++;
+            continue;
+        }
+
+        stream->stats.scans++;
+
+        if (stream->filter != NULL)
+        {
+            mcp320x_filter_process(stream->filter, values, stream->request_count);
+        }
+
+        if (stream->alarm != NULL)
+        {
+            mcp320x_alarm_process(stream->alarm, values, stream->request_count);
+        }
+
+        if (stream->overflow_policy == MCP320X_STREAM_OVERFLOW_DROP_OLDEST)
+        {
+            stream->stats.dropped += mcp320x_ring_push_overwrite(&stream->ring, values, stream->request_count);
+        }
+        else if (!mcp320x_ring_push(&stream->ring, values, stream->request_count))
+        {
+            stream->stats.blocked++;
+
+            // Woken by the consumer after a read, or by the timer. Timer ticks
+            // consumed while waiting are not converted.
+            atomic_store_explicit(&stream->waiting, true, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+
+            while (stream->running && !mcp320x_ring_push(&stream->ring, values, stream->request_count))
+            {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+
+            atomic_store_explicit(&stream->waiting, false, memory_order_relaxed);
+
+            if (!stream->running)
+            {
+                break;
+            }
+        }
+
+        stream->stats.samples += stream->request_count;
+    }
+
+    if (!shared)
+    {
+        mcp320x_release(stream->handle);
+    }
+
+    xSemaphoreGive(stream->stopped);
+
+    vTaskDelete(NULL);
+}
+
+static void mcp320x_stream_join(mcp320x_stream_t *stream)
+{
+    stream->running = false;
+    xTaskNotifyGive(stream->task);
+    xSemaphoreTake(stream->stopped, portMAX_DELAY);
+}
+
+static void mcp320x_stream_free(mcp320x_stream_t *stream)
+{
+    if (stream->timer != NULL)
+    {
+        esp_timer_delete(stream->timer);
+    }
+
+    if (stream->stopped != NULL)
+    {
+        vSemaphoreDelete(stream->stopped);
+    }
+
+    free(stream->ring_buffer);
+    free(stream);
+}
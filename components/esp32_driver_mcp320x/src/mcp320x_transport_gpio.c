@@ -0,0 +1,254 @@
+#include <stdlib.h>
+#include <string.h>
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/gpio.h"
+#include "soc/soc_caps.h"
+#if SOC_DEDICATED_GPIO_SUPPORTED
+#include "driver/dedic_gpio.h"
+#endif
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include "frame.h"
+#include "assertion.h"
+#include "log.h"
+
+#define MCP320X_GPIO_CS (1 << 0)   /** @brief CS bit on the output bundle. */
+#define MCP320X_GPIO_SCLK (1 << 1) /** @brief SCLK bit on the output bundle. */
+#define MCP320X_GPIO_MOSI (1 << 2) /** @brief MOSI bit on the output bundle. */
+
+/**
+ * @typedef mcp320x_transport_gpio_t
+ * @brief Holds control data for the bit-bang transport.
+ */
+typedef struct
+{
+    gpio_num_t cs_io_num;                  /** @brief Chip select. */
+    gpio_num_t sclk_io_num;                /** @brief Clock. */
+    gpio_num_t mosi_io_num;                /** @brief Device input. */
+    gpio_num_t miso_io_num;                /** @brief Device output. */
+    uint32_t half_period_cycles;           /** @brief CPU cycles of half a clock. */
+    uint32_t frequency_hz;                 /** @brief Clock frequency given by \p half_period_cycles. */
+    portMUX_TYPE lock;                     /** @brief Keeps interrupts and the other core off a frame. */
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    dedic_gpio_bundle_handle_t out_bundle; /** @brief CS, SCLK and MOSI. */
+    dedic_gpio_bundle_handle_t in_bundle;  /** @brief MISO. */
+#endif
+} mcp320x_transport_gpio_t;
+
+static mcp320x_err_t mcp320x_transport_gpio_install(mcp320x_config_t const *config, void **context);
+static mcp320x_err_t mcp320x_transport_gpio_remove(void *context);
+static mcp320x_err_t mcp320x_transport_gpio_transfer(void *context, uint8_t const *tx, uint8_t *rx, size_t count);
+static mcp320x_err_t mcp320x_transport_gpio_get_actual_freq(void *context, uint32_t *frequency_hz);
+static void mcp320x_transport_gpio_free(mcp320x_transport_gpio_t *gpio);
+
+const mcp320x_transport_t mcp320x_transport_gpio = {
+    .capabilities = 0,
+    .install = mcp320x_transport_gpio_install,
+    .remove = mcp320x_transport_gpio_remove,
+    .transfer = mcp320x_transport_gpio_transfer,
+    .acquire = NULL,
+    .release = NULL,
+    .get_actual_freq = mcp320x_transport_gpio_get_actual_freq};
+
+static inline void mcp320x_transport_gpio_write(mcp320x_transport_gpio_t const *gpio, uint32_t mask, uint32_t value)
+{
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    dedic_gpio_bundle_write(gpio->out_bundle, mask, value);
+#else
+    if (mask & MCP320X_GPIO_MOSI)
+    {
+        gpio_set_level(gpio->mosi_io_num, (value & MCP320X_GPIO_MOSI) ? 1 : 0);
+    }
+
+    if (mask & MCP320X_GPIO_CS)
+    {
+        gpio_set_level(gpio->cs_io_num, (value & MCP320X_GPIO_CS) ? 1 : 0);
+    }
+
+    if (mask & MCP320X_GPIO_SCLK)
+    {
+        gpio_set_level(gpio->sclk_io_num, (value & MCP320X_GPIO_SCLK) ? 1 : 0);
+    }
+#endif
+}
+
+static inline uint32_t mcp320x_transport_gpio_read(mcp320x_transport_gpio_t const *gpio)
+{
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    return dedic_gpio_bundle_read_in(gpio->in_bundle) & 1;
+#else
+    return (uint32_t)gpio_get_level(gpio->miso_io_num);
+#endif
+}
+
+static inline void mcp320x_transport_gpio_wait(uint32_t cycles)
+{
+    const esp_cpu_cycle_count_t start = esp_cpu_get_cycle_count();
+
+    while ((esp_cpu_cycle_count_t)(esp_cpu_get_cycle_count() - start) < cycles)
+    {
+    }
+}
+
+static mcp320x_err_t mcp320x_transport_gpio_install(mcp320x_config_t const *config, void **context)
+{
+    mcp320x_transport_gpio_config_t const *gpio_config_pins = (mcp320x_transport_gpio_config_t const *)config->transport_config;
+
+    CMP_CHECK((gpio_config_pins != NULL), "transport_config error(NULL)", MCP320X_ERR_INVALID_CONFIG)
+    CMP_CHECK((config->cs_io_num >= 0 && gpio_config_pins->sclk_io_num >= 0 && gpio_config_pins->mosi_io_num >= 0 && gpio_config_pins->miso_io_num >= 0), "transport_config error(pin)", MCP320X_ERR_INVALID_CONFIG)
+
+    mcp320x_transport_gpio_t *gpio = (mcp320x_transport_gpio_t *)calloc(1, sizeof(mcp320x_transport_gpio_t));
+
+    CMP_CHECK((gpio != NULL), "transport error(no memory)", MCP320X_ERR_NO_MEMORY)
+
+    const uint64_t ticks_per_second = (uint64_t)esp_rom_get_cpu_ticks_per_us() * 1000000;
+
+    gpio->cs_io_num = config->cs_io_num;
+    gpio->sclk_io_num = gpio_config_pins->sclk_io_num;
+    gpio->mosi_io_num = gpio_config_pins->mosi_io_num;
+    gpio->miso_io_num = gpio_config_pins->miso_io_num;
+    gpio->half_period_cycles = (uint32_t)((ticks_per_second + config->clock_speed_hz) / (2 * (uint64_t)config->clock_speed_hz));
+    gpio->frequency_hz = (uint32_t)(ticks_per_second / (2 * (uint64_t)gpio->half_period_cycles));
+    portMUX_INITIALIZE(&gpio->lock);
+
+    const gpio_config_t out_config = {
+        .pin_bit_mask = (1ULL << gpio->cs_io_num) | (1ULL << gpio->sclk_io_num) | (1ULL << gpio->mosi_io_num),
+        .mode = GPIO_MODE_OUTPUT,
+        .pull_up_en = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_DISABLE};
+    const gpio_config_t in_config = {
+        .pin_bit_mask = 1ULL << gpio->miso_io_num,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_DISABLE};
+
+    if (gpio_config(&out_config) != ESP_OK || gpio_config(&in_config) != ESP_OK)
+    {
+        free(gpio);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "gpio error(gpio_config)");
+        return MCP320X_ERR_INVALID_CONFIG;
+    }
+
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    // Dedicated GPIOs are written by the CPU in one instruction, instead of
+    // through the GPIO matrix registers.
+    int out_pins[] = {gpio->cs_io_num, gpio->sclk_io_num, gpio->mosi_io_num};
+    int in_pins[] = {gpio->miso_io_num};
+    const dedic_gpio_bundle_config_t out_bundle_config = {
+        .gpio_array = out_pins,
+        .array_size = sizeof(out_pins) / sizeof(out_pins[0]),
+        .flags = {.out_en = 1}};
+    const dedic_gpio_bundle_config_t in_bundle_config = {
+        .gpio_array = in_pins,
+        .array_size = sizeof(in_pins) / sizeof(in_pins[0]),
+        .flags = {.in_en = 1}};
+
+    if (dedic_gpio_new_bundle(&out_bundle_config, &gpio->out_bundle) != ESP_OK ||
+        dedic_gpio_new_bundle(&in_bundle_config, &gpio->in_bundle) != ESP_OK)
+    {
+        mcp320x_transport_gpio_free(gpio);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "gpio error(dedic_gpio_new_bundle)");
+        return MCP320X_ERR_INVALID_CONFIG;
+    }
+#endif
+
+    // Idle: deselected, clock low (mode 0).
+    mcp320x_transport_gpio_write(gpio, MCP320X_GPIO_CS | MCP320X_GPIO_SCLK | MCP320X_GPIO_MOSI, MCP320X_GPIO_CS);
+
+    *context = gpio;
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_gpio_remove(void *context)
+{
+    mcp320x_transport_gpio_free((mcp320x_transport_gpio_t *)context);
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_gpio_transfer(void *context, uint8_t const *tx, uint8_t *rx, size_t count)
+{
+    // Mode 0: MOSI is set while the clock is low, the device reads it on the
+    // rising edge and changes MISO on the falling edge, so MISO is read right
+    // after the rising edge.
+    //
+    // The clock can't be stretched: below 10KHz the sample and hold capacitor
+    // leaks during the conversion, and a preemption or an interrupt would
+    // stop the clock for a tick or more. So each frame runs in a critical
+    // section: 19 clocks, 9.5us at 2MHz but 1.9ms at the 10KHz minimum.
+
+    mcp320x_transport_gpio_t *gpio = (mcp320x_transport_gpio_t *)context;
+    const uint32_t half_period = gpio->half_period_cycles;
+
+    for (size_t frame = 0; frame < count; frame++)
+    {
+        uint8_t const *out = &tx[frame * MCP320X_FRAME_SIZE];
+        uint8_t *in = &rx[frame * MCP320X_FRAME_SIZE];
+
+        memset(in, 0, MCP320X_FRAME_SIZE);
+
+        portENTER_CRITICAL(&gpio->lock);
+
+        mcp320x_transport_gpio_write(gpio, MCP320X_GPIO_CS, 0);
+
+        for (int bit = 0; bit < MCP320X_FRAME_BITS; bit++)
+        {
+            const uint32_t mosi = (out[bit / 8] >> (7 - (bit % 8))) & 1;
+
+            mcp320x_transport_gpio_write(gpio, MCP320X_GPIO_MOSI, mosi ? MCP320X_GPIO_MOSI : 0);
+            mcp320x_transport_gpio_wait(half_period);
+            mcp320x_transport_gpio_write(gpio, MCP320X_GPIO_SCLK, MCP320X_GPIO_SCLK);
+
+            if (mcp320x_transport_gpio_read(gpio))
+            {
+                in[bit / 8] |= (uint8_t)(0x80 >> (bit % 8));
+            }
+
+            mcp320x_transport_gpio_wait(half_period);
+            mcp320x_transport_gpio_write(gpio, MCP320X_GPIO_SCLK, 0);
+        }
+
+        mcp320x_transport_gpio_write(gpio, MCP320X_GPIO_CS, MCP320X_GPIO_CS);
+
+        portEXIT_CRITICAL(&gpio->lock);
+
+        // CS disable time (tCSH) before the next frame.
+        mcp320x_transport_gpio_wait(2 * half_period);
+    }
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_gpio_get_actual_freq(void *context, uint32_t *frequency_hz)
+{
+    // Upper bound: the time spent writing the pins is not accounted for.
+    *frequency_hz = ((mcp320x_transport_gpio_t const *)context)->frequency_hz;
+
+    return MCP320X_OK;
+}
+
+static void mcp320x_transport_gpio_free(mcp320x_transport_gpio_t *gpio)
+{
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    if (gpio->out_bundle != NULL)
+    {
+        dedic_gpio_del_bundle(gpio->out_bundle);
+    }
+
+    if (gpio->in_bundle != NULL)
+    {
+        dedic_gpio_del_bundle(gpio->in_bundle);
+    }
+#endif
+
+    gpio_reset_pin(gpio->cs_io_num);
+    gpio_reset_pin(gpio->sclk_io_num);
+    gpio_reset_pin(gpio->mosi_io_num);
+    gpio_reset_pin(gpio->miso_io_num);
+
+    free(gpio);
+}
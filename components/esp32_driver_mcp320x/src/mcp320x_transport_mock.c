@@ -0,0 +1,106 @@
+#include <stdlib.h>
+#include <string.h>
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+#include "frame.h"
+#include "assertion.h"
+#include "log.h"
+
+/**
+ * @typedef mcp320x_transport_mock_context_t
+ * @brief Holds control data for the mock transport.
+ */
+typedef struct
+{
+    mcp320x_transport_mock_t *mock; /** @brief Caller owned device. */
+    uint32_t frequency_hz;          /** @brief Configured clock. */
+} mcp320x_transport_mock_context_t;
+
+static mcp320x_err_t mcp320x_transport_mock_install(mcp320x_config_t const *config, void **context);
+static mcp320x_err_t mcp320x_transport_mock_remove(void *context);
+static mcp320x_err_t mcp320x_transport_mock_transfer(void *context, uint8_t const *tx, uint8_t *rx, size_t count);
+static mcp320x_err_t mcp320x_transport_mock_acquire(void *context, TickType_t timeout);
+static mcp320x_err_t mcp320x_transport_mock_release(void *context);
+static mcp320x_err_t mcp320x_transport_mock_get_actual_freq(void *context, uint32_t *frequency_hz);
+
+const mcp320x_transport_t mcp320x_transport_mock = {
+    .capabilities = MCP320X_TRANSPORT_CAP_BATCH,
+    .install = mcp320x_transport_mock_install,
+    .remove = mcp320x_transport_mock_remove,
+    .transfer = mcp320x_transport_mock_transfer,
+    .acquire = mcp320x_transport_mock_acquire,
+    .release = mcp320x_transport_mock_release,
+    .get_actual_freq = mcp320x_transport_mock_get_actual_freq};
+
+static mcp320x_err_t mcp320x_transport_mock_install(mcp320x_config_t const *config, void **context)
+{
+    CMP_CHECK((config->transport_config != NULL), "transport_config error(NULL)", MCP320X_ERR_INVALID_CONFIG)
+
+    mcp320x_transport_mock_context_t *mock = (mcp320x_transport_mock_context_t *)calloc(1, sizeof(mcp320x_transport_mock_context_t));
+
+    CMP_CHECK((mock != NULL), "transport error(no memory)", MCP320X_ERR_NO_MEMORY)
+
+    mock->mock = (mcp320x_transport_mock_t *)config->transport_config;
+    mock->frequency_hz = config->clock_speed_hz;
+
+    *context = mock;
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_mock_remove(void *context)
+{
+    free(context);
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_mock_transfer(void *context, uint8_t const *tx, uint8_t *rx, size_t count)
+{
+    mcp320x_transport_mock_t *mock = ((mcp320x_transport_mock_context_t *)context)->mock;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        // Answer with the same frame layout as the device: the start bit on
+        // the first clock, the null bit on the 7th and B11..B0 after it.
+        const mcp320x_channel_t channel = (mcp320x_channel_t)((tx[i * MCP320X_FRAME_SIZE] >> 3) & 0b111);
+        const uint32_t frame = (uint32_t)mock->codes[channel] << (24 - MCP320X_FRAME_BITS);
+        uint8_t *out = &rx[i * MCP320X_FRAME_SIZE];
+
+        out[0] = (uint8_t)(frame >> 16);
+        out[1] = (uint8_t)(frame >> 8);
+        out[2] = (uint8_t)frame;
+        out[3] = 0;
+    }
+
+    mock->transfers++;
+    mock->frames += count;
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_mock_acquire(void *context, TickType_t timeout)
+{
+    (void)timeout;
+
+    ((mcp320x_transport_mock_context_t *)context)->mock->acquired++;
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_mock_release(void *context)
+{
+    mcp320x_transport_mock_t *mock = ((mcp320x_transport_mock_context_t *)context)->mock;
+
+    CMP_CHECK((mock->acquired > 0), "bus error(not acquired)", MCP320X_ERR_INVALID_STATE)
+
+    mock->acquired--;
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_mock_get_actual_freq(void *context, uint32_t *frequency_hz)
+{
+    *frequency_hz = ((mcp320x_transport_mock_context_t *)context)->frequency_hz;
+
+    return MCP320X_OK;
+}
@@ -0,0 +1,331 @@
+#include <stdlib.h>
+#include <string.h>
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+#include "driver/spi_master.h"
+#include "frame.h"
+#include "attributes.h"
+#include "assertion.h"
+#include "log.h"
+
+/**
+ * @typedef mcp320x_transport_spi_submitted_t
+ * @brief A frame submitted without waiting: its transaction and completion.
+ */
+typedef struct
+{
+    spi_transaction_t transaction; /** @brief Transaction; its user field points back to this struct. */
+    mcp320x_transport_done_t done; /** @brief Completion, called from the SPI interrupt. */
+    void *user;                    /** @brief Passed to done. */
+} mcp320x_transport_spi_submitted_t;
+
+/**
+ * @typedef mcp320x_transport_spi_t
+ * @brief Holds control data for the SPI master transports.
+ */
+typedef struct
+{
+    spi_device_handle_t spi_handle;                                        /** @brief SPI device handle. */
+    spi_transaction_t transactions[MCP320X_BATCH_QUEUE_SIZE];              /** @brief Transactions used by batches. */
+    mcp320x_transport_spi_submitted_t submitted[MCP320X_BATCH_QUEUE_SIZE]; /** @brief Transactions used by submitted frames, used in order. */
+    uint32_t submit_count;                                                 /** @brief Frames submitted since install; picks the next submitted slot. */
+} mcp320x_transport_spi_t;
+
+static mcp320x_err_t mcp320x_transport_spi_install(mcp320x_config_t const *config, void **context);
+static mcp320x_err_t mcp320x_transport_spi_remove(void *context);
+static mcp320x_err_t mcp320x_transport_spi_transfer_queued(void *context, uint8_t const *tx, uint8_t *rx, size_t count);
+static mcp320x_err_t mcp320x_transport_spi_transfer_polling(void *context, uint8_t const *tx, uint8_t *rx, size_t count);
+static mcp320x_err_t mcp320x_transport_spi_poll(mcp320x_transport_spi_t *spi, uint8_t const *tx, uint8_t *rx);
+static mcp320x_err_t mcp320x_transport_spi_acquire(void *context, TickType_t timeout);
+static mcp320x_err_t mcp320x_transport_spi_release(void *context);
+static mcp320x_err_t mcp320x_transport_spi_get_actual_freq(void *context, uint32_t *frequency_hz);
+static mcp320x_err_t mcp320x_transport_spi_prepare(void *context, uint8_t const *tx, void *prepared);
+static mcp320x_err_t mcp320x_transport_spi_transfer_prepared(void *context, void *prepared, uint8_t *rx);
+static mcp320x_err_t mcp320x_transport_spi_submit(void *context, uint8_t const *tx, mcp320x_transport_done_t done, void *user);
+static mcp320x_err_t mcp320x_transport_spi_collect(void *context, uint8_t *rx, TickType_t timeout);
+static void mcp320x_transport_spi_post_transfer(spi_transaction_t *transaction);
+
+_Static_assert(sizeof(spi_transaction_t) <= MCP320X_TRANSPORT_PREPARED_SIZE, "A prepared transaction must fit MCP320X_TRANSPORT_PREPARED_SIZE");
+
+const mcp320x_transport_t mcp320x_transport_spi_queued = {
+    .capabilities = MCP320X_TRANSPORT_CAP_BATCH | MCP320X_TRANSPORT_CAP_DMA,
+    .install = mcp320x_transport_spi_install,
+    .remove = mcp320x_transport_spi_remove,
+    .transfer = mcp320x_transport_spi_transfer_queued,
+    .acquire = mcp320x_transport_spi_acquire,
+    .release = mcp320x_transport_spi_release,
+    .get_actual_freq = mcp320x_transport_spi_get_actual_freq,
+    .prepare = mcp320x_transport_spi_prepare,
+    .transfer_prepared = mcp320x_transport_spi_transfer_prepared,
+    .submit = mcp320x_transport_spi_submit,
+    .collect = mcp320x_transport_spi_collect};
+
+const mcp320x_transport_t mcp320x_transport_spi_polling = {
+    .capabilities = MCP320X_TRANSPORT_CAP_DMA,
+    .install = mcp320x_transport_spi_install,
+    .remove = mcp320x_transport_spi_remove,
+    .transfer = mcp320x_transport_spi_transfer_polling,
+    .acquire = mcp320x_transport_spi_acquire,
+    .release = mcp320x_transport_spi_release,
+    .get_actual_freq = mcp320x_transport_spi_get_actual_freq,
+    .prepare = mcp320x_transport_spi_prepare,
+    .transfer_prepared = mcp320x_transport_spi_transfer_prepared,
+    .submit = mcp320x_transport_spi_submit,
+    .collect = mcp320x_transport_spi_collect};
+
+static mcp320x_err_t mcp320x_transport_spi_install(mcp320x_config_t const *config, void **context)
+{
+    spi_device_interface_config_t dev_cfg = {
+        .command_bits = 0,
+        .address_bits = 0,
+        .dummy_bits = 0,
+        .mode = 0, // Clock idle: low, clock phase: leading, data write: CS on and CLK fall, data read: CS on and CLK rise.
+        .clock_source = SPI_CLK_SRC_DEFAULT,
+        .duty_cycle_pos = 128,
+        .cs_ena_pretrans = 0,
+        .cs_ena_posttrans = 0,
+        .clock_speed_hz = (int)config->clock_speed_hz,
+        .input_delay_ns = 0,
+        .spics_io_num = config->cs_io_num,
+        .flags = SPI_DEVICE_NO_DUMMY,
+        .queue_size = MCP320X_BATCH_QUEUE_SIZE,
+        .pre_cb = NULL,
+        .post_cb = mcp320x_transport_spi_post_transfer};
+
+    mcp320x_transport_spi_t *spi = (mcp320x_transport_spi_t *)calloc(1, sizeof(mcp320x_transport_spi_t));
+
+    CMP_CHECK((spi != NULL), "transport error(no memory)", MCP320X_ERR_NO_MEMORY)
+
+    if (spi_bus_add_device(config->host, &dev_cfg, &spi->spi_handle) != ESP_OK)
+    {
+        free(spi);
+        CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "bus error(spi_bus_add_device)");
+        return MCP320X_ERR_SPI_BUS;
+    }
+
+    *context = spi;
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_spi_remove(void *context)
+{
+    mcp320x_transport_spi_t *spi = (mcp320x_transport_spi_t *)context;
+
+    CMP_CHECK(spi_bus_remove_device(spi->spi_handle) == ESP_OK, "bus error(spi_bus_remove_device)", MCP320X_ERR_SPI_BUS)
+
+    free(spi);
+
+    return MCP320X_OK;
+}
+
+MCP320X_HOT_ATTR static mcp320x_err_t mcp320x_transport_spi_transfer_queued(void *context, uint8_t const *tx, uint8_t *rx, size_t count)
+{
+    mcp320x_transport_spi_t *spi = (mcp320x_transport_spi_t *)context;
+
+    // Queuing costs an interrupt per transaction: a single frame is faster polled.
+    if (count == 1)
+    {
+        return mcp320x_transport_spi_poll(spi, tx, rx);
+    }
+
+    // All transactions are queued before waiting for any result, so the SPI
+    // driver can start the next one as soon as the previous ends, without
+    // returning to this task in between. Each one must be a transaction of
+    // its own because the device only starts a conversion on the falling
+    // edge of CS.
+
+    mcp320x_err_t result = MCP320X_OK;
+    size_t queued = 0;
+
+    for (; queued < count; queued++)
+    {
+        spi_transaction_t *transaction = &spi->transactions[queued];
+
+        transaction->flags = 0;
+        transaction->cmd = 0;
+        transaction->addr = 0;
+        transaction->length = MCP320X_FRAME_BITS;
+        transaction->rxlength = 0;
+        transaction->user = NULL;
+        transaction->tx_buffer = &tx[queued * MCP320X_FRAME_SIZE];
+        transaction->rx_buffer = &rx[queued * MCP320X_FRAME_SIZE];
+
+        if (spi_device_queue_trans(spi->spi_handle, transaction, portMAX_DELAY) != ESP_OK)
+        {
+            CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "device error(spi_device_queue_trans)");
+            result = MCP320X_ERR_SPI_BUS;
+            break;
+        }
+    }
+
+    // Every queued transaction must be collected, even after a failure,
+    // otherwise they would be left inside the driver queue and returned to
+    // the next transfer. The first error is kept.
+    for (size_t i = 0; i < queued; i++)
+    {
+        spi_transaction_t *transaction;
+
+        if (spi_device_get_trans_result(spi->spi_handle, &transaction, portMAX_DELAY) != ESP_OK && result == MCP320X_OK)
+        {
+            CMP_LOGE("%s(%d): %s", __FUNCTION__, __LINE__, "device error(spi_device_get_trans_result)");
+            result = MCP320X_ERR_SPI_BUS;
+        }
+    }
+
+    return result;
+}
+
+MCP320X_HOT_ATTR static mcp320x_err_t mcp320x_transport_spi_transfer_polling(void *context, uint8_t const *tx, uint8_t *rx, size_t count)
+{
+    mcp320x_transport_spi_t *spi = (mcp320x_transport_spi_t *)context;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        mcp320x_err_t result = mcp320x_transport_spi_poll(spi, &tx[i * MCP320X_FRAME_SIZE], &rx[i * MCP320X_FRAME_SIZE]);
+
+        if (result != MCP320X_OK)
+        {
+            return result;
+        }
+    }
+
+    return MCP320X_OK;
+}
+
+MCP320X_HOT_ATTR static mcp320x_err_t mcp320x_transport_spi_poll(mcp320x_transport_spi_t *spi, uint8_t const *tx, uint8_t *rx)
+{
+    // Frames fit the transaction registers, so any buffer can be used.
+    spi_transaction_t transaction = {
+        .flags = SPI_TRANS_USE_RXDATA | SPI_TRANS_USE_TXDATA,
+        .cmd = 0,
+        .addr = 0,
+        .length = MCP320X_FRAME_BITS};
+
+    memcpy(transaction.tx_data, tx, MCP320X_FRAME_SIZE);
+
+    CMP_CHECK(spi_device_polling_transmit(spi->spi_handle, &transaction) == ESP_OK, "device error(spi_device_polling_transmit)", MCP320X_ERR_SPI_BUS)
+
+    memcpy(rx, transaction.rx_data, MCP320X_FRAME_SIZE);
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_spi_acquire(void *context, TickType_t timeout)
+{
+    mcp320x_transport_spi_t *spi = (mcp320x_transport_spi_t *)context;
+
+    CMP_CHECK((spi_device_acquire_bus(spi->spi_handle, timeout) == ESP_OK), "device error(spi_device_acquire_bus)", MCP320X_ERR_SPI_BUS_ACQUIRE)
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_spi_release(void *context)
+{
+    mcp320x_transport_spi_t *spi = (mcp320x_transport_spi_t *)context;
+
+    spi_device_release_bus(spi->spi_handle);
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_spi_get_actual_freq(void *context, uint32_t *frequency_hz)
+{
+    mcp320x_transport_spi_t *spi = (mcp320x_transport_spi_t *)context;
+    int calculated_freq_khz;
+
+    CMP_CHECK((spi_device_get_actual_freq(spi->spi_handle, &calculated_freq_khz) == ESP_OK), "device error(spi_device_get_actual_freq)", MCP320X_ERR_FAIL)
+
+    *frequency_hz = (uint32_t)calculated_freq_khz * 1000;
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_spi_prepare(void *context, uint8_t const *tx, void *prepared)
+{
+    (void)context;
+
+    // Same transaction as a polled frame, kept by the caller: only rx_data
+    // changes between transfers.
+    spi_transaction_t *transaction = (spi_transaction_t *)prepared;
+
+    memset(transaction, 0, sizeof(spi_transaction_t));
+
+    transaction->flags = SPI_TRANS_USE_RXDATA | SPI_TRANS_USE_TXDATA;
+    transaction->length = MCP320X_FRAME_BITS;
+
+    memcpy(transaction->tx_data, tx, MCP320X_FRAME_SIZE);
+
+    return MCP320X_OK;
+}
+
+MCP320X_HOT_ATTR static mcp320x_err_t mcp320x_transport_spi_transfer_prepared(void *context, void *prepared, uint8_t *rx)
+{
+    mcp320x_transport_spi_t *spi = (mcp320x_transport_spi_t *)context;
+    spi_transaction_t *transaction = (spi_transaction_t *)prepared;
+
+    if (spi_device_polling_transmit(spi->spi_handle, transaction) != ESP_OK)
+    {
+        return MCP320X_ERR_SPI_BUS;
+    }
+
+    memcpy(rx, transaction->rx_data, MCP320X_FRAME_SIZE);
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_spi_submit(void *context, uint8_t const *tx, mcp320x_transport_done_t done, void *user)
+{
+    mcp320x_transport_spi_t *spi = (mcp320x_transport_spi_t *)context;
+
+    // Submitted frames are collected in order, and never more than the
+    // queue size are in flight, so slots are reused round-robin.
+    mcp320x_transport_spi_submitted_t *submitted = &spi->submitted[spi->submit_count % MCP320X_BATCH_QUEUE_SIZE];
+    spi_transaction_t *transaction = &submitted->transaction;
+
+    memset(transaction, 0, sizeof(spi_transaction_t));
+
+    transaction->flags = SPI_TRANS_USE_RXDATA | SPI_TRANS_USE_TXDATA;
+    transaction->length = MCP320X_FRAME_BITS;
+    transaction->user = submitted;
+    submitted->done = done;
+    submitted->user = user;
+
+    memcpy(transaction->tx_data, tx, MCP320X_FRAME_SIZE);
+
+    CMP_CHECK((spi_device_queue_trans(spi->spi_handle, transaction, 0) == ESP_OK), "device error(spi_device_queue_trans)", MCP320X_ERR_SPI_BUS)
+
+    spi->submit_count++;
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t mcp320x_transport_spi_collect(void *context, uint8_t *rx, TickType_t timeout)
+{
+    mcp320x_transport_spi_t *spi = (mcp320x_transport_spi_t *)context;
+    spi_transaction_t *transaction;
+
+    esp_err_t result = spi_device_get_trans_result(spi->spi_handle, &transaction, timeout);
+
+    if (result == ESP_ERR_TIMEOUT)
+    {
+        return MCP320X_ERR_TIMEOUT;
+    }
+
+    CMP_CHECK((result == ESP_OK), "device error(spi_device_get_trans_result)", MCP320X_ERR_SPI_BUS)
+
+    memcpy(rx, transaction->rx_data, MCP320X_FRAME_SIZE);
+
+    return MCP320X_OK;
+}
+
+IRAM_ATTR static void mcp320x_transport_spi_post_transfer(spi_transaction_t *transaction)
+{
+    // Runs from the SPI interrupt for every transaction of the device; only
+    // submitted frames have a user.
+    mcp320x_transport_spi_submitted_t *submitted = (mcp320x_transport_spi_submitted_t *)transaction->user;
+
+    if (submitted != NULL && submitted->done != NULL)
+    {
+        submitted->done(submitted->user, transaction->rx_data);
+    }
+}
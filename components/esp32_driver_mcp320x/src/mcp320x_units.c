@@ -0,0 +1,118 @@
+#include <string.h>
+#include "esp32_driver_mcp320x/mcp320x_units.h"
+#include "assertion.h"
+
+// A transfer function is a table of its values, computed off the target (see
+// tools/mcp320x_units_table.py), so a nonlinear sensor costs no log nor float
+// per code. A direct table is a plain gather. An interpolated table keeps the
+// values at every 2^shift codes, code 4096 included so the last segment has an
+// end, and interpolates between the two around each code:
+//
+//   value = t[i] + ((t[i + 1] - t[i]) * (code & mask) + half) >> shift
+//
+// with i = code >> shift. 257 entries every 16 codes take 1KB instead of 16KB.
+
+mcp320x_err_t mcp320x_units_init(mcp320x_units_t *units)
+{
+    CMP_CHECK((units != NULL), "units error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+
+    memset(units, 0, sizeof(mcp320x_units_t));
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_units_set_table(mcp320x_units_t *units, mcp320x_channel_t channel, int32_t const *table, uint16_t size)
+{
+    CMP_CHECK((units != NULL), "units error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK((channel <= MCP320X_CHANNEL_7), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK((table != NULL), "table error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    uint8_t shift = 0;
+
+    if (size != MCP320X_UNITS_TABLE_SIZE)
+    {
+        CMP_CHECK((size >= MCP320X_UNITS_TABLE_SIZE_MIN && size <= MCP320X_UNITS_TABLE_SIZE_MAX_INTERPOLATED), "size error(invalid)", MCP320X_ERR_INVALID_CONFIG)
+        CMP_CHECK((((size - 1) & (size - 2)) == 0), "size error(not 4096 / 2^k + 1)", MCP320X_ERR_INVALID_CONFIG)
+
+        while ((MCP320X_UNITS_TABLE_SIZE >> shift) != size - 1)
+        {
+            shift++;
+        }
+    }
+
+    mcp320x_units_channel_t *state = &units->channels[channel];
+
+    state->table = table;
+    state->size = size;
+    state->shift = shift;
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_units_convert(mcp320x_units_t const *units,
+                                    mcp320x_channel_t channel,
+                                    uint16_t const *codes,
+                                    int32_t *values,
+                                    size_t count)
+{
+    CMP_CHECK_ARG((units != NULL), "units error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((channel <= MCP320X_CHANNEL_7), "channel error(invalid)", MCP320X_ERR_INVALID_CHANNEL)
+    CMP_CHECK_ARG((codes != NULL || count == 0), "codes error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+    CMP_CHECK_ARG((values != NULL || count == 0), "values error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    mcp320x_units_channel_t const *state = &units->channels[channel];
+    int32_t const *table = state->table;
+
+    if (table == NULL)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            values[i] = codes[i];
+        }
+    }
+    else if (state->shift == 0)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            values[i] = table[codes[i] & (MCP320X_UNITS_TABLE_SIZE - 1)];
+        }
+    }
+    else
+    {
+        const uint8_t shift = state->shift;
+        const uint32_t mask = (1u << shift) - 1;
+        const int64_t half = (int64_t)1 << (shift - 1);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const uint32_t code = codes[i] & (MCP320X_UNITS_TABLE_SIZE - 1);
+            const int32_t start = table[code >> shift];
+            const int32_t end = table[(code >> shift) + 1];
+
+            values[i] = start + (int32_t)((((int64_t)end - start) * (code & mask) + half) >> shift);
+        }
+    }
+
+    return MCP320X_OK;
+}
+
+mcp320x_err_t mcp320x_units_read(mcp320x_t *handle,
+                                 mcp320x_units_t const *units,
+                                 mcp320x_channel_t channel,
+                                 mcp320x_read_mode_t read_mode,
+                                 int32_t *value)
+{
+    CMP_CHECK_ARG((units != NULL), "units error(NULL)", MCP320X_ERR_INVALID_HANDLE)
+    CMP_CHECK_ARG((value != NULL), "value error(NULL)", MCP320X_ERR_INVALID_VALUE_HANDLE)
+
+    uint16_t code = 0;
+
+    const mcp320x_err_t result = mcp320x_read(handle, channel, read_mode, &code);
+
+    if (result != MCP320X_OK)
+    {
+        return result;
+    }
+
+    return mcp320x_units_convert(units, channel, &code, value, 1);
+}
@@ -0,0 +1,115 @@
+#include "ring.h"
+
+bool mcp320x_ring_init(mcp320x_ring_t *ring, uint16_t *buffer, size_t capacity)
+{
+    if (ring == NULL || buffer == NULL || capacity == 0 || (capacity & (capacity - 1)) != 0)
+    {
+        return false;
+    }
+
+    ring->buffer = buffer;
+    ring->capacity = capacity;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+
+    return true;
+}
+
+size_t mcp320x_ring_round_capacity(size_t capacity)
+{
+    size_t rounded = 1;
+
+    while (rounded < capacity)
+    {
+        rounded <<= 1;
+    }
+
+    return rounded;
+}
+
+size_t mcp320x_ring_size(mcp320x_ring_t *ring)
+{
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    const size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    return head - tail;
+}
+
+bool mcp320x_ring_push(mcp320x_ring_t *ring, uint16_t const *values, size_t count)
+{
+    const size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    const size_t mask = ring->capacity - 1;
+
+    if (ring->capacity - (head - tail) < count)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        ring->buffer[(head + i) & mask] = values[i];
+    }
+
+    // Publish the values only after they are written.
+    atomic_store_explicit(&ring->head, head + count, memory_order_release);
+
+    return true;
+}
+
+size_t mcp320x_ring_push_overwrite(mcp320x_ring_t *ring, uint16_t const *values, size_t count)
+{
+    const size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    const size_t mask = ring->capacity - 1;
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t discarded = 0;
+
+    // The tail is moved with a compare-and-swap because the consumer may be
+    // moving it at the same time. When the consumer wins, the loop runs again
+    // with the new tail, which may already leave enough space.
+    while (ring->capacity - (head - tail) < count)
+    {
+        const size_t stored = head - tail;
+        const size_t step = count < stored ? count : stored;
+
+        if (atomic_compare_exchange_weak_explicit(&ring->tail, &tail, tail + step, memory_order_acq_rel, memory_order_acquire))
+        {
+            discarded += step;
+            tail += step;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        ring->buffer[(head + i) & mask] = values[i];
+    }
+
+    atomic_store_explicit(&ring->head, head + count, memory_order_release);
+
+    return discarded;
+}
+
+size_t mcp320x_ring_pop(mcp320x_ring_t *ring, uint16_t *values, size_t count)
+{
+    const size_t mask = ring->capacity - 1;
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    for (;;)
+    {
+        const size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        const size_t available = head - tail;
+        const size_t length = count < available ? count : available;
+
+        for (size_t i = 0; i < length; i++)
+        {
+            values[i] = ring->buffer[(tail + i) & mask];
+        }
+
+        // If the producer discarded values while they were being copied the
+        // tail will have moved and the copy is stale, so it is redone.
+        if (atomic_compare_exchange_weak_explicit(&ring->tail, &tail, tail + length, memory_order_acq_rel, memory_order_acquire))
+        {
+            return length;
+        }
+    }
+}
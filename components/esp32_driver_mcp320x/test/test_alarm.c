@@ -0,0 +1,294 @@
+#include "common_infra_test.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "esp32_driver_mcp320x/mcp320x_alarm.h"
+#include "esp32_driver_mcp320x/mcp320x_stream.h"
+
+typedef struct
+{
+    uint32_t transitions;
+    uint8_t channel;
+    mcp320x_alarm_state_t state;
+    uint16_t code;
+} alarm_record_t;
+
+static void alarm_record(uint8_t channel, mcp320x_alarm_state_t state, uint16_t code, void *context)
+{
+    alarm_record_t *record = (alarm_record_t *)context;
+
+    record->transitions++;
+    record->channel = channel;
+    record->state = state;
+    record->code = code;
+}
+
+static void alarm_record_deep(uint8_t channel, mcp320x_alarm_state_t state, uint16_t code, void *context)
+{
+    // More stack than the default acquisition task leaves to callbacks.
+    volatile uint8_t scratch[1536];
+
+    for (size_t i = 0; i < sizeof(scratch); i++)
+    {
+        scratch[i] = (uint8_t)(code + i);
+    }
+
+    alarm_record(channel, state, code, context);
+}
+
+static mcp320x_alarm_config_t single_window(uint16_t low, uint16_t high, uint16_t hysteresis, uint8_t debounce)
+{
+    mcp320x_alarm_config_t config = {
+        .channels = {{.low = low, .high = high, .hysteresis = hysteresis, .debounce = debounce}},
+        .channel_count = 1};
+
+    return config;
+}
+
+TEST_CASE("Cannot init alarm with invalid handle", "[alarm]")
+{
+    const mcp320x_alarm_config_t config = single_window(1000, 3000, 0, 0);
+
+    mcp320x_err_t result = mcp320x_alarm_init(NULL, &config);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot init alarm with invalid config", "[alarm]")
+{
+    mcp320x_alarm_t alarm;
+    mcp320x_alarm_config_t configs[] = {
+        single_window(3000, 1000, 0, 0),
+        single_window(1000, 3000, 1001, 0),
+        single_window(1000, 3000, 0, 0),
+        single_window(1000, 3000, 0, 0),
+        single_window(1000, 3000, 0, 0),
+        single_window(1000, 3000, 0, 0)};
+
+    configs[2].channel_count = 0;
+    configs[3].channel_count = MCP320X_CHANNEL_COUNT_MAX + 1;
+    configs[4].channels[0].event_bits = 1 << 0; // No event group.
+    configs[5].channels[0].event_bits = 1 << 24;
+    configs[5].event_group = (EventGroupHandle_t)&alarm;
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_alarm_init(&alarm, NULL));
+
+    for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++)
+    {
+        TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_alarm_init(&alarm, &configs[i]));
+    }
+}
+
+TEST_CASE("Cannot compare with invalid handle", "[alarm]")
+{
+    uint16_t codes[4] = {0};
+
+    mcp320x_err_t result = mcp320x_alarm_process(NULL, codes, 4);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot get alarm state of invalid channel", "[alarm]")
+{
+    mcp320x_alarm_t alarm;
+    mcp320x_alarm_state_t state;
+    const mcp320x_alarm_config_t config = single_window(1000, 3000, 0, 0);
+
+    mcp320x_alarm_init(&alarm, &config);
+    mcp320x_err_t result = mcp320x_alarm_get_state(&alarm, 1, &state);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Can compare with window", "[alarm]")
+{
+    mcp320x_alarm_t alarm;
+    alarm_record_t record = {0};
+    mcp320x_alarm_config_t config = single_window(1000, 3000, 0, 0);
+    const uint16_t codes[] = {2000, 2500, 3001, 3500, 2000, 999, 500, 1000};
+    const mcp320x_alarm_state_t expected[] = {
+        MCP320X_ALARM_STATE_NORMAL, MCP320X_ALARM_STATE_NORMAL, MCP320X_ALARM_STATE_HIGH, MCP320X_ALARM_STATE_HIGH,
+        MCP320X_ALARM_STATE_NORMAL, MCP320X_ALARM_STATE_LOW, MCP320X_ALARM_STATE_LOW, MCP320X_ALARM_STATE_NORMAL};
+
+    config.callback = alarm_record;
+    config.callback_context = &record;
+
+    mcp320x_alarm_init(&alarm, &config);
+
+    for (size_t i = 0; i < 8; i++)
+    {
+        mcp320x_alarm_state_t state;
+
+        TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_alarm_process(&alarm, &codes[i], 1));
+        TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_alarm_get_state(&alarm, 0, &state));
+        TEST_ASSERT_EQUAL(expected[i], state);
+    }
+
+    TEST_ASSERT_EQUAL(4, record.transitions);
+    TEST_ASSERT_EQUAL(MCP320X_ALARM_STATE_NORMAL, record.state);
+    TEST_ASSERT_EQUAL(1000, record.code);
+}
+
+TEST_CASE("Can compare with hysteresis", "[alarm]")
+{
+    mcp320x_alarm_t alarm;
+    alarm_record_t record = {0};
+    mcp320x_alarm_config_t config = single_window(0, 3000, 100, 0);
+    // Noise around the threshold: only the first crossing and the real return count.
+    const uint16_t codes[] = {3001, 2990, 3005, 2950, 3010, 2901, 2900};
+
+    config.callback = alarm_record;
+    config.callback_context = &record;
+
+    mcp320x_alarm_init(&alarm, &config);
+    mcp320x_alarm_process(&alarm, codes, 6);
+
+    TEST_ASSERT_EQUAL(1, record.transitions);
+    TEST_ASSERT_EQUAL(MCP320X_ALARM_STATE_HIGH, record.state);
+
+    mcp320x_alarm_process(&alarm, &codes[6], 1);
+
+    TEST_ASSERT_EQUAL(2, record.transitions);
+    TEST_ASSERT_EQUAL(MCP320X_ALARM_STATE_NORMAL, record.state);
+}
+
+TEST_CASE("Can compare with debounce", "[alarm]")
+{
+    mcp320x_alarm_t alarm;
+    alarm_record_t record = {0};
+    mcp320x_alarm_config_t config = single_window(1000, 3000, 0, 3);
+    // A spike of 2 codes is rejected; 3 codes change the state on the third.
+    const uint16_t codes[] = {4000, 4000, 2000, 4000, 4000, 4001};
+
+    config.callback = alarm_record;
+    config.callback_context = &record;
+
+    mcp320x_alarm_init(&alarm, &config);
+    mcp320x_alarm_process(&alarm, codes, 5);
+
+    TEST_ASSERT_EQUAL(0, record.transitions);
+
+    mcp320x_alarm_process(&alarm, &codes[5], 1);
+
+    TEST_ASSERT_EQUAL(1, record.transitions);
+    TEST_ASSERT_EQUAL(MCP320X_ALARM_STATE_HIGH, record.state);
+    TEST_ASSERT_EQUAL(4001, record.code);
+}
+
+TEST_CASE("Can compare interleaved channels", "[alarm]")
+{
+    mcp320x_alarm_t alarm;
+    alarm_record_t record = {0};
+    const mcp320x_alarm_config_t config = {
+        .channels = {
+            {.low = 0, .high = UINT16_MAX},
+            {.low = 1000, .high = 3000}},
+        .channel_count = 2,
+        .callback = alarm_record,
+        .callback_context = &record};
+    const uint16_t codes[] = {0, 2000, 4095, 2000, 4095};
+
+    mcp320x_alarm_init(&alarm, &config);
+    mcp320x_alarm_process(&alarm, codes, 5);
+    mcp320x_alarm_process(&alarm, (uint16_t[]){500}, 1); // Channel 1, carried from the last call.
+
+    TEST_ASSERT_EQUAL(1, record.transitions);
+    TEST_ASSERT_EQUAL(1, record.channel);
+    TEST_ASSERT_EQUAL(MCP320X_ALARM_STATE_LOW, record.state);
+}
+
+TEST_CASE("Can set event bits on transitions", "[alarm]")
+{
+    mcp320x_alarm_t alarm;
+    EventGroupHandle_t event_group = xEventGroupCreate();
+    mcp320x_alarm_config_t config = single_window(1000, 3000, 0, 0);
+
+    config.channels[0].event_bits = 1 << 3;
+    config.event_group = event_group;
+
+    mcp320x_alarm_init(&alarm, &config);
+    mcp320x_alarm_process(&alarm, (uint16_t[]){2000, 2500}, 2);
+    const EventBits_t quiet = xEventGroupGetBits(event_group);
+    mcp320x_alarm_process(&alarm, (uint16_t[]){3500}, 1);
+    const EventBits_t crossed = xEventGroupWaitBits(event_group, 1 << 3, pdTRUE, pdFALSE, 0);
+
+    vEventGroupDelete(event_group);
+
+    TEST_ASSERT_EQUAL(0, quiet);
+    TEST_ASSERT_EQUAL(1 << 3, crossed);
+}
+
+TEST_CASE("Can wait for alarm on stream", "[alarm]")
+{
+    static mcp320x_alarm_t alarm;
+    EventGroupHandle_t event_group = xEventGroupCreate();
+    const mcp320x_alarm_config_t config = {
+        .channels = {
+            {.low = 0, .high = UINT16_MAX},
+            {.low = 0, .high = 1000, .event_bits = 1 << 0}}, // Channel 3 at 2.5V is above.
+        .channel_count = 2,
+        .event_group = event_group};
+    const mcp320x_stream_config_t stream_config = {
+        .channel_mask = (1 << MCP320X_CHANNEL_0) | (1 << MCP320X_CHANNEL_3),
+        .read_mode = MCP320X_READ_MODE_SINGLE,
+        .rate_hz = 1000,
+        .ring_capacity = 256,
+        .overflow_policy = MCP320X_STREAM_OVERFLOW_DROP_OLDEST,
+        .task_priority = 5,
+        .task_core = tskNO_AFFINITY,
+        .alarm = &alarm};
+    mcp320x_alarm_state_t state = MCP320X_ALARM_STATE_NORMAL;
+
+    mcp320x_alarm_init(&alarm, &config);
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+
+    mcp320x_err_t start_result = mcp320x_stream_start(handle, &stream_config);
+    const EventBits_t bits = xEventGroupWaitBits(event_group, 1 << 0, pdTRUE, pdFALSE, pdMS_TO_TICKS(100));
+    mcp320x_alarm_get_state(&alarm, 1, &state);
+    mcp320x_err_t stop_result = mcp320x_stream_stop(handle);
+
+    mcp320x_delete(handle);
+    vEventGroupDelete(event_group);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, start_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, stop_result);
+    TEST_ASSERT_EQUAL(1 << 0, bits & (1 << 0));
+    TEST_ASSERT_EQUAL(MCP320X_ALARM_STATE_HIGH, state);
+}
+
+TEST_CASE("Can run deep alarm callback on stream with larger stack", "[alarm]")
+{
+    static mcp320x_alarm_t alarm;
+    alarm_record_t record = {0};
+    const mcp320x_alarm_config_t config = {
+        .channels = {{.low = 0, .high = 1000}}, // Channel 3 at 2.5V is above.
+        .channel_count = 1,
+        .callback = alarm_record_deep,
+        .callback_context = &record};
+    const mcp320x_stream_config_t stream_config = {
+        .channel_mask = 1 << MCP320X_CHANNEL_3,
+        .read_mode = MCP320X_READ_MODE_SINGLE,
+        .rate_hz = 1000,
+        .ring_capacity = 256,
+        .overflow_policy = MCP320X_STREAM_OVERFLOW_DROP_OLDEST,
+        .task_priority = 5,
+        .task_core = tskNO_AFFINITY,
+        .task_stack_size = MCP320X_STREAM_TASK_STACK_SIZE_DEFAULT + 2048,
+        .alarm = &alarm};
+
+    mcp320x_alarm_init(&alarm, &config);
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+
+    mcp320x_err_t start_result = mcp320x_stream_start(handle, &stream_config);
+    vTaskDelay(pdMS_TO_TICKS(50));
+    mcp320x_err_t stop_result = mcp320x_stream_stop(handle);
+
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, start_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, stop_result);
+    TEST_ASSERT_EQUAL(1, record.transitions);
+    TEST_ASSERT_EQUAL(MCP320X_ALARM_STATE_HIGH, record.state);
+}
@@ -0,0 +1,188 @@
+#include "common_infra_test.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp32_driver_mcp320x/mcp320x_broker.h"
+
+#define BROKER_CLIENTS 4
+#define BROKER_CLIENT_READS 50
+
+typedef struct
+{
+    mcp320x_t *handle;
+    SemaphoreHandle_t done;
+    mcp320x_err_t result;
+    uint16_t min;
+    uint16_t max;
+} broker_client_t;
+
+static mcp320x_broker_config_t VALID_BROKER_CONFIG = {
+    .window_us = 0,
+    .task_priority = 6,
+    .task_core = tskNO_AFFINITY};
+
+static void broker_client_task(void *arg)
+{
+    broker_client_t *client = (broker_client_t *)arg;
+
+    client->result = MCP320X_OK;
+    client->min = UINT16_MAX;
+    client->max = 0;
+
+    for (int i = 0; i < BROKER_CLIENT_READS && client->result == MCP320X_OK; i++)
+    {
+        uint16_t value = 0;
+
+        client->result = mcp320x_broker_read(client->handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value);
+
+        client->min = value < client->min ? value : client->min;
+        client->max = value > client->max ? value : client->max;
+    }
+
+    xSemaphoreGive(client->done);
+
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("Cannot start broker with invalid handle", "[broker]")
+{
+    mcp320x_err_t result = mcp320x_broker_start(NULL, &VALID_BROKER_CONFIG);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot start broker with null config", "[broker]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_broker_start(handle, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, result);
+}
+
+TEST_CASE("Cannot start broker with long window", "[broker]")
+{
+    mcp320x_broker_config_t config = VALID_BROKER_CONFIG;
+    config.window_us = MCP320X_BROKER_WINDOW_MAX_US + 1;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_broker_start(handle, &config))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, result);
+}
+
+TEST_CASE("Cannot start broker twice", "[broker]")
+{
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+
+    mcp320x_broker_start(handle, &VALID_BROKER_CONFIG);
+    mcp320x_err_t result = mcp320x_broker_start(handle, &VALID_BROKER_CONFIG);
+
+    mcp320x_broker_stop(handle);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, result);
+}
+
+TEST_CASE("Cannot read broker not started", "[broker]")
+{
+    uint16_t value;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_broker_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, result);
+}
+
+TEST_CASE("Cannot stop broker not started", "[broker]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_broker_stop(handle))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, result);
+}
+
+TEST_CASE("Cannot read broker with invalid channel", "[broker]")
+{
+    uint16_t value;
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+    mcp320x_broker_start(handle, &VALID_BROKER_CONFIG);
+    mcp320x_err_t result = mcp320x_broker_read(handle, MCP320X_CHANNEL_7, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_broker_stop(handle);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Cannot read broker with null value", "[broker]")
+{
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+    mcp320x_broker_start(handle, &VALID_BROKER_CONFIG);
+    mcp320x_err_t result = mcp320x_broker_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, NULL);
+    mcp320x_broker_stop(handle);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Can read through broker", "[broker]")
+{
+    mcp320x_broker_stats_t stats;
+    uint16_t value = 0;
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+    mcp320x_err_t start_result = mcp320x_broker_start(handle, &VALID_BROKER_CONFIG);
+    mcp320x_err_t read_result = mcp320x_broker_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_err_t stats_result = mcp320x_broker_get_stats(handle, &stats);
+    mcp320x_err_t stop_result = mcp320x_broker_stop(handle);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, start_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, read_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, stats_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, stop_result);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, value); // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_EQUAL(1, stats.requests);
+    TEST_ASSERT_EQUAL(1, stats.bursts);
+    TEST_ASSERT_EQUAL(1, stats.conversions);
+    TEST_ASSERT_EQUAL(0, stats.errors);
+}
+
+TEST_CASE("Can read through broker from many tasks", "[broker]")
+{
+    mcp320x_broker_config_t config = VALID_BROKER_CONFIG;
+    broker_client_t clients[BROKER_CLIENTS] = {0};
+    mcp320x_broker_stats_t stats;
+
+    config.window_us = 100;
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+    mcp320x_err_t start_result = mcp320x_broker_start(handle, &config);
+
+    for (int i = 0; i < BROKER_CLIENTS; i++)
+    {
+        clients[i].handle = handle;
+        clients[i].done = xSemaphoreCreateBinary();
+        xTaskCreate(broker_client_task, "broker_client", 4096, &clients[i], 5, NULL);
+    }
+
+    for (int i = 0; i < BROKER_CLIENTS; i++)
+    {
+        xSemaphoreTake(clients[i].done, portMAX_DELAY);
+        vSemaphoreDelete(clients[i].done);
+    }
+
+    mcp320x_broker_get_stats(handle, &stats);
+    mcp320x_broker_stop(handle);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, start_result);
+
+    for (int i = 0; i < BROKER_CLIENTS; i++)
+    {
+        TEST_ASSERT_EQUAL(MCP320X_OK, clients[i].result);
+        TEST_ASSERT_INT16_WITHIN(50, 2048, clients[i].min); // Will accept 2.5V +- 50mV.
+        TEST_ASSERT_INT16_WITHIN(50, 2048, clients[i].max); // Will accept 2.5V +- 50mV.
+    }
+
+    TEST_ASSERT_EQUAL(BROKER_CLIENTS * BROKER_CLIENT_READS, stats.requests);
+    TEST_ASSERT_EQUAL(stats.bursts, stats.conversions); // Same channel and mode: one conversion per burst.
+    TEST_ASSERT_TRUE(stats.bursts <= stats.requests);
+    TEST_ASSERT_EQUAL(0, stats.errors);
+}
@@ -0,0 +1,258 @@
+#include <string.h>
+#include "common_infra_test.h"
+#include "esp32_driver_mcp320x/mcp320x_calibration.h"
+#include "conversion.h"
+
+// A front end reading 1% high with a 10mV offset: 0V reads as code 8 and 4V as
+// code 3318, as 16 times the mean of many reads.
+static const mcp320x_calibration_point_t TWO_POINTS[2] = {
+    {.code_x16 = 8 * 16, .microvolts = 0},
+    {.code_x16 = 3318 * 16, .microvolts = 4000000}};
+
+static int32_t table[MCP320X_CALIBRATION_TABLE_SIZE];
+
+// Fletcher-16, as stored at the end of a blob.
+static void seal_blob(uint8_t *blob, size_t size)
+{
+    uint16_t sum1 = 0;
+    uint16_t sum2 = 0;
+
+    for (size_t i = 0; i < size - 2; i++)
+    {
+        sum1 = (uint16_t)((sum1 + blob[i]) % 255);
+        sum2 = (uint16_t)((sum2 + sum1) % 255);
+    }
+
+    blob[size - 2] = (uint8_t)sum1;
+    blob[size - 1] = (uint8_t)sum2;
+}
+
+TEST_CASE("Cannot init calibration with invalid handle", "[calibration]")
+{
+    mcp320x_err_t result = mcp320x_calibration_init(NULL, 5000);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot init calibration with invalid reference voltage", "[calibration]")
+{
+    mcp320x_calibration_t calibration;
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_calibration_init(&calibration, MCP320X_REF_VOLTAGE_MIN - 1));
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_calibration_init(&calibration, MCP320X_REF_VOLTAGE_MAX + 1));
+}
+
+TEST_CASE("Cannot set calibration points with invalid points", "[calibration]")
+{
+    mcp320x_calibration_t calibration;
+    const mcp320x_calibration_point_t decreasing[2] = {TWO_POINTS[1], TWO_POINTS[0]};
+    const mcp320x_calibration_point_t repeated[2] = {TWO_POINTS[0], TWO_POINTS[0]};
+    const mcp320x_calibration_point_t beyond[2] = {TWO_POINTS[0], {.code_x16 = 4095 * 16 + 1, .microvolts = 5000000}};
+
+    mcp320x_calibration_init(&calibration, 5000);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, mcp320x_calibration_set_points(&calibration, (mcp320x_channel_t)8, TWO_POINTS, 2, NULL));
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_0, NULL, 2, NULL));
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_0, TWO_POINTS, 1, NULL));
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_0, TWO_POINTS, MCP320X_CALIBRATION_POINTS_MAX + 1, NULL));
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_0, decreasing, 2, NULL));
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_0, repeated, 2, NULL));
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_0, beyond, 2, NULL));
+}
+
+TEST_CASE("Can apply calibration of uncalibrated channel", "[calibration]")
+{
+    mcp320x_calibration_t calibration;
+    uint16_t codes[4096];
+    int32_t microvolts[4096];
+
+    for (uint16_t i = 0; i < 4096; i++)
+    {
+        codes[i] = i;
+    }
+
+    mcp320x_calibration_init(&calibration, 3300);
+    mcp320x_err_t result = mcp320x_calibration_apply(&calibration, MCP320X_CHANNEL_5, codes, microvolts, 4096);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+
+    for (uint16_t i = 0; i < 4096; i++)
+    {
+        TEST_ASSERT_EQUAL_INT32(mcp320x_code_to_microvolts(i, MCP320X_MICROVOLTS_SCALE(3300)), microvolts[i]);
+    }
+}
+
+TEST_CASE("Can apply two points calibration", "[calibration]")
+{
+    mcp320x_calibration_t calibration;
+    const uint16_t codes[3] = {8, 1663, 3318};
+    int32_t microvolts[3];
+
+    mcp320x_calibration_init(&calibration, 5000);
+    mcp320x_err_t result_set = mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_1, TWO_POINTS, 2, NULL);
+    mcp320x_err_t result_apply = mcp320x_calibration_apply(&calibration, MCP320X_CHANNEL_1, codes, microvolts, 3);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_set);
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_apply);
+    TEST_ASSERT_INT32_WITHIN(1, 0, microvolts[0]);
+    TEST_ASSERT_INT32_WITHIN(1, 2000000, microvolts[1]);
+    TEST_ASSERT_INT32_WITHIN(1, 4000000, microvolts[2]);
+}
+
+TEST_CASE("Can apply calibration table", "[calibration]")
+{
+    mcp320x_calibration_t calibration;
+    // Bowed: reads 20mV low at mid scale.
+    const mcp320x_calibration_point_t points[3] = {
+        {.code_x16 = 0, .microvolts = 0},
+        {.code_x16 = 2032 * 16, .microvolts = 2500000},
+        {.code_x16 = 4096 * 16 - 16, .microvolts = 4998779}};
+    const uint16_t codes[4] = {0, 1016, 2032, 4095};
+    int32_t microvolts[4];
+
+    mcp320x_calibration_init(&calibration, 5000);
+    mcp320x_err_t result_set = mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_2, points, 3, table);
+    mcp320x_err_t result_apply = mcp320x_calibration_apply(&calibration, MCP320X_CHANNEL_2, codes, microvolts, 4);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_set);
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_apply);
+    TEST_ASSERT_EQUAL_INT32(0, microvolts[0]);
+    TEST_ASSERT_EQUAL_INT32(1250000, microvolts[1]);
+    TEST_ASSERT_EQUAL_INT32(2500000, microvolts[2]);
+    TEST_ASSERT_EQUAL_INT32(4998779, microvolts[3]);
+}
+
+TEST_CASE("Can serialize and deserialize calibration", "[calibration]")
+{
+    mcp320x_calibration_t calibration;
+    mcp320x_calibration_t loaded;
+    uint8_t blob[MCP320X_CALIBRATION_BLOB_SIZE_MAX];
+    size_t size = 0;
+    int32_t *const tables[MCP320X_CHANNEL_COUNT_MAX] = {[MCP320X_CHANNEL_4] = table};
+    const uint16_t codes[3] = {0, 2000, 4095};
+    int32_t expected[3];
+    int32_t actual[3];
+
+    mcp320x_calibration_init(&calibration, 5000);
+    mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_1, TWO_POINTS, 2, NULL);
+    mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_4, TWO_POINTS, 2, table);
+    mcp320x_err_t result_serialize = mcp320x_calibration_serialize(&calibration, blob, sizeof(blob), &size);
+
+    mcp320x_calibration_init(&loaded, 5000);
+    mcp320x_err_t result_deserialize = mcp320x_calibration_deserialize(&loaded, blob, size, tables);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_serialize);
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_deserialize);
+    TEST_ASSERT_EQUAL(8 + 2 * 14, size);
+
+    for (uint8_t channel = 0; channel < MCP320X_CHANNEL_COUNT_MAX; channel++)
+    {
+        mcp320x_calibration_apply(&calibration, (mcp320x_channel_t)channel, codes, expected, 3);
+        mcp320x_calibration_apply(&loaded, (mcp320x_channel_t)channel, codes, actual, 3);
+
+        TEST_ASSERT_EQUAL_INT32_ARRAY(expected, actual, 3);
+    }
+}
+
+TEST_CASE("Cannot serialize calibration on small buffer", "[calibration]")
+{
+    mcp320x_calibration_t calibration;
+    uint8_t blob[8 + 14 - 1];
+    size_t size = 0;
+
+    mcp320x_calibration_init(&calibration, 5000);
+    mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_0, TWO_POINTS, 2, NULL);
+    mcp320x_err_t result = mcp320x_calibration_serialize(&calibration, blob, sizeof(blob), &size);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_SAMPLE_COUNT, result);
+}
+
+TEST_CASE("Cannot deserialize invalid calibration", "[calibration]")
+{
+    mcp320x_calibration_t calibration;
+    mcp320x_calibration_t loaded;
+    uint8_t blob[MCP320X_CALIBRATION_BLOB_SIZE_MAX];
+    uint8_t corrupt[MCP320X_CALIBRATION_BLOB_SIZE_MAX];
+    size_t size = 0;
+    const uint16_t code = 2000;
+    int32_t before;
+    int32_t after;
+
+    mcp320x_calibration_init(&calibration, 5000);
+    mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_0, TWO_POINTS, 2, table);
+    mcp320x_calibration_serialize(&calibration, blob, sizeof(blob), &size);
+
+    mcp320x_calibration_init(&loaded, 5000);
+    mcp320x_calibration_set_points(&loaded, MCP320X_CHANNEL_0, TWO_POINTS, 2, NULL);
+    mcp320x_calibration_apply(&loaded, MCP320X_CHANNEL_0, &code, &before, 1);
+
+    memcpy(corrupt, blob, size);
+    corrupt[10] ^= 0x01; // A point.
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_calibration_deserialize(&loaded, corrupt, size, NULL));
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_calibration_deserialize(&loaded, blob, size - 1, NULL));
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, mcp320x_calibration_deserialize(&loaded, blob, size, NULL)); // Without its table.
+
+    mcp320x_calibration_apply(&loaded, MCP320X_CHANNEL_0, &code, &after, 1);
+
+    TEST_ASSERT_EQUAL_INT32(before, after);
+}
+
+TEST_CASE("Cannot deserialize calibration with gain out of range", "[calibration]")
+{
+    mcp320x_calibration_t calibration;
+    mcp320x_calibration_t loaded;
+    const mcp320x_calibration_point_t full_scale[2] = {{.code_x16 = 0, .microvolts = 0}, {.code_x16 = 4095 * 16, .microvolts = 5000000}};
+    uint8_t blob[MCP320X_CALIBRATION_BLOB_SIZE_MAX];
+    size_t size = 0;
+    const uint16_t code = 2000;
+    int32_t before;
+    int32_t after;
+
+    mcp320x_calibration_init(&calibration, 5000);
+    mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_0, full_scale, 2, NULL);
+    mcp320x_calibration_set_points(&calibration, MCP320X_CHANNEL_1, TWO_POINTS, 2, NULL);
+    mcp320x_calibration_serialize(&calibration, blob, sizeof(blob), &size);
+
+    // The last point of channel 1, bytes 28 to 33, at INT32_MAX microvolts: the gain overflows 32 bits.
+    blob[30] = 0xFF;
+    blob[31] = 0xFF;
+    blob[32] = 0xFF;
+    blob[33] = 0x7F;
+    seal_blob(blob, size);
+
+    mcp320x_calibration_init(&loaded, 5000);
+    mcp320x_calibration_set_points(&loaded, MCP320X_CHANNEL_0, TWO_POINTS, 2, NULL);
+    mcp320x_calibration_apply(&loaded, MCP320X_CHANNEL_0, &code, &before, 1);
+
+    mcp320x_err_t result = mcp320x_calibration_deserialize(&loaded, blob, size, NULL);
+
+    mcp320x_calibration_apply(&loaded, MCP320X_CHANNEL_0, &code, &after, 1);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, result);
+    TEST_ASSERT_EQUAL_INT32(before, after);
+}
+
+TEST_CASE("Can capture calibration point", "[calibration]")
+{
+    mcp320x_calibration_point_t point;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_calibration_capture(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, 2500000, &point))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_INT32_WITHIN(50 << 4, 2048 << 4, point.code_x16); // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_EQUAL_INT32(2500000, point.microvolts);
+}
+
+TEST_CASE("Can read calibrated", "[calibration]")
+{
+    mcp320x_calibration_t calibration;
+    int32_t microvolts;
+
+    mcp320x_calibration_init(&calibration, VALID_CONFIG.reference_voltage);
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_calibration_read(handle, &calibration, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &microvolts))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_INT32_WITHIN(50000, 2500000, microvolts);
+}
@@ -0,0 +1,132 @@
+#include "common_infra_test.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp32_driver_mcp320x/mcp320x_capture.h"
+
+#define CAPTURE_COUNT 50
+
+static mcp320x_capture_config_t VALID_CAPTURE_CONFIG = {
+    .channel = MCP320X_CHANNEL_3,
+    .read_mode = MCP320X_READ_MODE_SINGLE,
+    .rate_hz = 1000,
+    .trigger = MCP320X_CAPTURE_TRIGGER_TIMER};
+
+static void assert_capture(mcp320x_capture_sample_t const *samples, mcp320x_capture_stats_t const *stats, uint32_t period_us, bool absolute)
+{
+    TEST_ASSERT_EQUAL_UINT32(CAPTURE_COUNT, stats->samples);
+    TEST_ASSERT_TRUE(stats->error_min_us <= stats->error_max_us);
+
+    for (size_t i = 0; i < CAPTURE_COUNT; i++)
+    {
+        TEST_ASSERT_INT16_WITHIN(50, 2048, samples[i].value); // Will accept 2.5V +- 50mV.
+
+        if (i > 0)
+        {
+            TEST_ASSERT_GREATER_THAN_UINT32(samples[i - 1].timestamp_us, samples[i].timestamp_us);
+        }
+
+        // Absolute deadlines are never early: skipping only delays them. How
+        // late depends on the host scheduler, so there's no upper bound.
+        if (absolute)
+        {
+            TEST_ASSERT_GREATER_OR_EQUAL_UINT32((i + 1) * period_us, samples[i].timestamp_us);
+        }
+    }
+
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(CAPTURE_COUNT * period_us - period_us / 2, samples[CAPTURE_COUNT - 1].timestamp_us);
+}
+
+TEST_CASE("Cannot capture with invalid handle", "[capture]")
+{
+    mcp320x_capture_sample_t samples[1];
+
+    mcp320x_err_t result = mcp320x_capture(NULL, &VALID_CAPTURE_CONFIG, samples, 1, NULL);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot capture with invalid channel", "[capture]")
+{
+    mcp320x_capture_config_t config = VALID_CAPTURE_CONFIG;
+    mcp320x_capture_sample_t samples[1];
+
+    config.channel = MCP320X_CHANNEL_7;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_capture(handle, &config, samples, 1, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Cannot capture with null samples", "[capture]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_capture(handle, &VALID_CAPTURE_CONFIG, NULL, 1, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Cannot capture zero samples", "[capture]")
+{
+    mcp320x_capture_sample_t samples[1];
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_capture(handle, &VALID_CAPTURE_CONFIG, samples, 0, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_SAMPLE_COUNT, result);
+}
+
+TEST_CASE("Cannot capture with invalid rate", "[capture]")
+{
+    mcp320x_capture_config_t timer_config = VALID_CAPTURE_CONFIG;
+    mcp320x_capture_config_t spin_config = VALID_CAPTURE_CONFIG;
+    mcp320x_capture_sample_t samples[1];
+
+    timer_config.rate_hz = MCP320X_CAPTURE_TIMER_RATE_MAX_HZ + 1;
+    spin_config.trigger = MCP320X_CAPTURE_TRIGGER_SPIN;
+    spin_config.rate_hz = MCP320X_CAPTURE_SPIN_RATE_MAX_HZ + 1;
+
+    EXECUTE_WITH_HANDLE(
+        mcp320x_err_t timer_result = mcp320x_capture(handle, &timer_config, samples, 1, NULL);
+        mcp320x_err_t spin_result = mcp320x_capture(handle, &spin_config, samples, 1, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, timer_result);
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, spin_result);
+}
+
+TEST_CASE("Can capture with timer", "[capture]")
+{
+    static mcp320x_capture_sample_t samples[CAPTURE_COUNT];
+    mcp320x_capture_stats_t stats;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_capture(handle, &VALID_CAPTURE_CONFIG, samples, CAPTURE_COUNT, &stats))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    assert_capture(samples, &stats, 1000, false);
+}
+
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES > 1
+TEST_CASE("Can capture with timer keeping notifications", "[capture]")
+{
+    static mcp320x_capture_sample_t samples[CAPTURE_COUNT];
+
+    xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_capture(handle, &VALID_CAPTURE_CONFIG, samples, CAPTURE_COUNT, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_UINT32(1, ulTaskNotifyTake(pdTRUE, 0));
+}
+#endif
+
+TEST_CASE("Can capture spinning", "[capture]")
+{
+    static mcp320x_capture_sample_t samples[CAPTURE_COUNT];
+    mcp320x_capture_config_t config = VALID_CAPTURE_CONFIG;
+    mcp320x_capture_stats_t stats;
+
+    config.trigger = MCP320X_CAPTURE_TRIGGER_SPIN;
+    config.rate_hz = 10000;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_capture(handle, &config, samples, CAPTURE_COUNT, &stats))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    assert_capture(samples, &stats, 100, true);
+}
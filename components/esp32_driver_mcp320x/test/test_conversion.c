@@ -0,0 +1,78 @@
+#include <math.h>
+#include "common_infra_test.h"
+#include "conversion.h"
+
+static const uint16_t REFERENCE_VOLTAGES[] = {MCP320X_REF_VOLTAGE_MIN, 1024, 2048, 3300, 4096, 5000, MCP320X_REF_VOLTAGE_MAX};
+
+TEST_CASE("Can convert every code to millivolts rounding to nearest", "[conversion]")
+{
+    for (size_t r = 0; r < sizeof(REFERENCE_VOLTAGES) / sizeof(REFERENCE_VOLTAGES[0]); r++)
+    {
+        for (uint32_t code = 0; code < MCP320X_RESOLUTION; code++)
+        {
+            const uint16_t expected = (uint16_t)floor((double)code * REFERENCE_VOLTAGES[r] / MCP320X_RESOLUTION + 0.5);
+
+            TEST_ASSERT_EQUAL_UINT16(expected, mcp320x_code_to_millivolts(code, REFERENCE_VOLTAGES[r]));
+        }
+    }
+}
+
+TEST_CASE("Can convert every code to microvolts rounding to nearest", "[conversion]")
+{
+    for (size_t r = 0; r < sizeof(REFERENCE_VOLTAGES) / sizeof(REFERENCE_VOLTAGES[0]); r++)
+    {
+        const uint32_t scale = MCP320X_MICROVOLTS_SCALE(REFERENCE_VOLTAGES[r]);
+
+        for (uint32_t code = 0; code < MCP320X_RESOLUTION; code++)
+        {
+            const uint32_t expected = (uint32_t)floor((double)code * REFERENCE_VOLTAGES[r] * 1000.0 / MCP320X_RESOLUTION + 0.5);
+
+            TEST_ASSERT_EQUAL_UINT32(expected, mcp320x_code_to_microvolts(code, scale));
+        }
+    }
+}
+
+TEST_CASE("Can convert sum of codes to mean voltage", "[conversion]")
+{
+    // Mean code 2047.5: half a step above 2047.
+    const uint64_t sum = 2047 + 2048;
+
+    TEST_ASSERT_EQUAL_UINT16(2499, mcp320x_sum_to_millivolts(sum, 2, 5000));
+    TEST_ASSERT_EQUAL_UINT32(2499390, mcp320x_sum_to_microvolts(sum, 2, MCP320X_MICROVOLTS_SCALE(5000)));
+}
+
+TEST_CASE("Cannot convert codes with invalid handle", "[conversion]")
+{
+    uint16_t codes[] = {0, 2048, 4095};
+    uint16_t voltages[3];
+
+    mcp320x_err_t result = mcp320x_codes_to_millivolts(NULL, codes, voltages, 3);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Can convert codes to millivolts", "[conversion]")
+{
+    uint16_t codes[] = {0, 2048, 4095};
+    uint16_t voltages[3];
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_codes_to_millivolts(handle, codes, voltages, 3))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_UINT16(0, voltages[0]);
+    TEST_ASSERT_EQUAL_UINT16(2500, voltages[1]);
+    TEST_ASSERT_EQUAL_UINT16(4999, voltages[2]);
+}
+
+TEST_CASE("Can convert codes to microvolts", "[conversion]")
+{
+    uint16_t codes[] = {0, 2048, 4095};
+    uint32_t voltages[3];
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_codes_to_microvolts(handle, codes, voltages, 3))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_UINT32(0, voltages[0]);
+    TEST_ASSERT_EQUAL_UINT32(2500000, voltages[1]);
+    TEST_ASSERT_EQUAL_UINT32(4998779, voltages[2]);
+}
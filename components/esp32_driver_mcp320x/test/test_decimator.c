@@ -0,0 +1,133 @@
+#include "common_infra_test.h"
+#include "esp32_driver_mcp320x/mcp320x_decimator.h"
+
+TEST_CASE("Cannot init decimator with invalid handle", "[decimator]")
+{
+    const mcp320x_decimator_config_t config = {.order = 1, .ratio = 4, .output_bits = 12, .channel_count = 1};
+
+    mcp320x_err_t result = mcp320x_decimator_init(NULL, &config);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot init decimator with invalid config", "[decimator]")
+{
+    mcp320x_decimator_t decimator;
+    const mcp320x_decimator_config_t configs[] = {
+        {.order = 0, .ratio = 4, .output_bits = 12, .channel_count = 1},
+        {.order = MCP320X_DECIMATOR_ORDER_MAX + 1, .ratio = 4, .output_bits = 12, .channel_count = 1},
+        {.order = 1, .ratio = 0, .output_bits = 12, .channel_count = 1},
+        {.order = 1, .ratio = 6, .output_bits = 12, .channel_count = 1},
+        {.order = 1, .ratio = MCP320X_DECIMATOR_RATIO_MAX * 2, .output_bits = 12, .channel_count = 1},
+        {.order = 1, .ratio = 4, .output_bits = 11, .channel_count = 1},
+        {.order = 1, .ratio = 4, .output_bits = 17, .channel_count = 1},
+        {.order = 1, .ratio = 4, .output_bits = 15, .channel_count = 1}, // Adds 2 bits only.
+        {.order = 3, .ratio = 1024, .output_bits = 16, .channel_count = 1}, // Adds 30 bits.
+        {.order = 1, .ratio = 4, .output_bits = 12, .channel_count = 0},
+        {.order = 1, .ratio = 4, .output_bits = 12, .channel_count = MCP320X_CHANNEL_COUNT_MAX + 1}};
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_decimator_init(&decimator, NULL));
+
+    for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++)
+    {
+        TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_decimator_init(&decimator, &configs[i]));
+    }
+}
+
+TEST_CASE("Cannot decimate with small capacity", "[decimator]")
+{
+    mcp320x_decimator_t decimator;
+    const mcp320x_decimator_config_t config = {.order = 1, .ratio = 4, .output_bits = 12, .channel_count = 1};
+    uint16_t codes[8] = {0};
+    uint16_t outputs[2];
+    size_t output_count;
+
+    mcp320x_decimator_init(&decimator, &config);
+
+    mcp320x_err_t result = mcp320x_decimator_process(&decimator, codes, 8, outputs, 2, &output_count);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_SAMPLE_COUNT, result);
+}
+
+TEST_CASE("Can decimate with boxcar", "[decimator]")
+{
+    mcp320x_decimator_t decimator;
+    const mcp320x_decimator_config_t config = {.order = 1, .ratio = 4, .output_bits = 12, .channel_count = 1};
+    const uint16_t codes[] = {100, 200, 300, 400, 1000, 1000, 1000, 1001};
+    uint16_t outputs[4];
+    size_t output_count;
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_decimator_init(&decimator, &config));
+
+    mcp320x_err_t result = mcp320x_decimator_process(&decimator, codes, 8, outputs, 4, &output_count);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(2, output_count);
+    TEST_ASSERT_EQUAL_UINT16(250, outputs[0]);
+    TEST_ASSERT_EQUAL_UINT16(1000, outputs[1]); // 1000.25 rounded.
+}
+
+TEST_CASE("Can decimate across calls", "[decimator]")
+{
+    mcp320x_decimator_t decimator;
+    const mcp320x_decimator_config_t config = {.order = 1, .ratio = 4, .output_bits = 14, .channel_count = 1};
+    const uint16_t codes[] = {1000, 1000, 1001, 1001, 1001, 1001};
+    uint16_t outputs[4];
+    size_t first_count;
+    size_t second_count;
+
+    mcp320x_decimator_init(&decimator, &config);
+
+    mcp320x_decimator_process(&decimator, codes, 3, outputs, 4, &first_count);
+    mcp320x_decimator_process(&decimator, &codes[3], 3, &outputs[first_count], 4 - first_count, &second_count);
+
+    TEST_ASSERT_EQUAL(0, first_count);
+    TEST_ASSERT_EQUAL(1, second_count);
+    TEST_ASSERT_EQUAL_UINT16(4002, outputs[0]); // 1000.5 with 2 extra bits.
+}
+
+TEST_CASE("Can decimate with CIC", "[decimator]")
+{
+    mcp320x_decimator_t decimator;
+    const mcp320x_decimator_config_t config = {.order = 3, .ratio = 64, .output_bits = 16, .channel_count = 1};
+    static uint16_t codes[64 * 8];
+    uint16_t outputs[16];
+    size_t output_count;
+
+    for (size_t i = 0; i < sizeof(codes) / sizeof(codes[0]); i++)
+    {
+        codes[i] = 4095;
+    }
+
+    mcp320x_decimator_init(&decimator, &config);
+
+    mcp320x_err_t result = mcp320x_decimator_process(&decimator, codes, 64 * 8, outputs, 16, &output_count);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(8, output_count);
+
+    // Settled after "order" outputs: the full scale, without overflowing.
+    for (size_t i = config.order - 1; i < output_count; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT16(4095 << 4, outputs[i]);
+    }
+}
+
+TEST_CASE("Can decimate interleaved channels", "[decimator]")
+{
+    mcp320x_decimator_t decimator;
+    const mcp320x_decimator_config_t config = {.order = 1, .ratio = 2, .output_bits = 12, .channel_count = 3};
+    const uint16_t codes[] = {10, 20, 30, 12, 22, 32};
+    uint16_t outputs[6];
+    size_t output_count;
+
+    mcp320x_decimator_init(&decimator, &config);
+
+    mcp320x_err_t result = mcp320x_decimator_process(&decimator, codes, 6, outputs, 6, &output_count);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(3, output_count);
+    TEST_ASSERT_EQUAL_UINT16(11, outputs[0]);
+    TEST_ASSERT_EQUAL_UINT16(21, outputs[1]);
+    TEST_ASSERT_EQUAL_UINT16(31, outputs[2]);
+}
@@ -0,0 +1,179 @@
+#include "common_infra_test.h"
+#include "esp32_driver_mcp320x/mcp320x_filter.h"
+
+static mcp320x_filter_config_t single_stage(mcp320x_filter_stage_config_t stage, uint8_t channel_count)
+{
+    mcp320x_filter_config_t config = {
+        .stages = {stage},
+        .stage_count = 1,
+        .channel_count = channel_count};
+
+    return config;
+}
+
+TEST_CASE("Cannot init filter with invalid handle", "[filter]")
+{
+    const mcp320x_filter_config_t config = single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_BOXCAR, .length = 4}, 1);
+
+    mcp320x_err_t result = mcp320x_filter_init(NULL, &config);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot init filter with invalid config", "[filter]")
+{
+    mcp320x_filter_t filter;
+    mcp320x_filter_config_t configs[] = {
+        single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_EMA, .alpha = 0}, 1),
+        single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_EMA, .alpha = MCP320X_FILTER_ONE + 1}, 1),
+        single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_BOXCAR, .length = 0}, 1),
+        single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_BOXCAR, .length = MCP320X_FILTER_TAPS_MAX + 1}, 1),
+        single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_FIR, .length = 0}, 1),
+        single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_FIR, .length = 1, .coefficients = {MCP320X_FILTER_ONE + 1}}, 1),
+        single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_BIQUAD, .coefficients = {0, 0, 0, -MCP320X_FILTER_BIQUAD_COEFFICIENT_MAX, 0}}, 1),
+        single_stage((mcp320x_filter_stage_config_t){.type = (mcp320x_filter_type_t)4, .length = 1}, 1),
+        single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_BOXCAR, .length = 4}, 0),
+        single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_BOXCAR, .length = 4}, MCP320X_CHANNEL_COUNT_MAX + 1),
+        single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_BOXCAR, .length = 4}, 1)};
+
+    configs[10].stage_count = MCP320X_FILTER_STAGES_MAX + 1;
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_filter_init(&filter, NULL));
+
+    for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++)
+    {
+        TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_filter_init(&filter, &configs[i]));
+    }
+}
+
+TEST_CASE("Cannot filter with invalid handle", "[filter]")
+{
+    uint16_t codes[4] = {0};
+
+    mcp320x_err_t result = mcp320x_filter_process(NULL, codes, 4);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Can filter with boxcar", "[filter]")
+{
+    mcp320x_filter_t filter;
+    const mcp320x_filter_config_t config = single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_BOXCAR, .length = 4}, 1);
+    uint16_t codes[] = {1000, 1000, 2000, 2000, 2000, 2000, 0};
+    const uint16_t expected[] = {1000, 1000, 1250, 1500, 1750, 2000, 1500};
+
+    mcp320x_filter_init(&filter, &config);
+    mcp320x_err_t result = mcp320x_filter_process(&filter, codes, 7);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, codes, 7);
+}
+
+TEST_CASE("Can filter with ema", "[filter]")
+{
+    mcp320x_filter_t filter;
+    const mcp320x_filter_config_t config = single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_EMA, .alpha = MCP320X_Q15(0.5)}, 1);
+    uint16_t codes[] = {1000, 2000, 2000, 2000};
+    const uint16_t expected[] = {1000, 1500, 1750, 1875};
+
+    mcp320x_filter_init(&filter, &config);
+    mcp320x_err_t result = mcp320x_filter_process(&filter, codes, 4);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, codes, 4);
+}
+
+TEST_CASE("Can filter with fir", "[filter]")
+{
+    mcp320x_filter_t filter;
+    const mcp320x_filter_config_t config = single_stage((mcp320x_filter_stage_config_t){
+                                                            .type = MCP320X_FILTER_FIR,
+                                                            .length = 3,
+                                                            .coefficients = {MCP320X_Q15(0.5), MCP320X_Q15(0.25), MCP320X_Q15(0.25)}},
+                                                        1);
+    uint16_t codes[] = {1000, 2000, 2000, 2000};
+    const uint16_t expected[] = {1000, 1500, 1750, 2000};
+
+    mcp320x_filter_init(&filter, &config);
+    mcp320x_err_t result = mcp320x_filter_process(&filter, codes, 4);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, codes, 4);
+}
+
+TEST_CASE("Can filter with FIR rounding once", "[filter]")
+{
+    mcp320x_filter_t filter;
+    // 0.498: rounding to the guard bits first would push 0.498 up to 0.5.
+    const mcp320x_filter_config_t config = single_stage((mcp320x_filter_stage_config_t){.type = MCP320X_FILTER_FIR, .length = 1, .coefficients = {16320}}, 1);
+    uint16_t codes[] = {1, 3, 1000};
+    const uint16_t expected[] = {0, 1, 498};
+
+    mcp320x_filter_init(&filter, &config);
+    mcp320x_err_t result = mcp320x_filter_process(&filter, codes, 3);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, codes, 3);
+}
+
+TEST_CASE("Can filter with biquad", "[filter]")
+{
+    mcp320x_filter_t filter;
+    // y = 0.25 x0 + 0.5 y1: unit gain at DC.
+    const mcp320x_filter_config_t config = single_stage((mcp320x_filter_stage_config_t){
+                                                            .type = MCP320X_FILTER_BIQUAD,
+                                                            .coefficients = {MCP320X_Q15(0.25), MCP320X_Q15(0.25), 0, MCP320X_Q15(-0.5), 0}},
+                                                        1);
+    uint16_t codes[] = {1000, 2000, 2000, 2000};
+    const uint16_t expected[] = {1000, 1250, 1625, 1813};
+
+    mcp320x_filter_init(&filter, &config);
+    mcp320x_err_t result = mcp320x_filter_process(&filter, codes, 4);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, codes, 4);
+}
+
+TEST_CASE("Can filter interleaved channels across calls", "[filter]")
+{
+    mcp320x_filter_t filter;
+    mcp320x_filter_t reference;
+    const mcp320x_filter_config_t config = {
+        .stages = {
+            {.type = MCP320X_FILTER_BOXCAR, .length = 3},
+            {.type = MCP320X_FILTER_EMA, .alpha = MCP320X_Q15(0.3)}},
+        .stage_count = 2,
+        .channel_count = 2};
+    const mcp320x_filter_config_t single = {
+        .stages = {
+            {.type = MCP320X_FILTER_BOXCAR, .length = 3},
+            {.type = MCP320X_FILTER_EMA, .alpha = MCP320X_Q15(0.3)}},
+        .stage_count = 2,
+        .channel_count = 1};
+    uint16_t codes[20];
+    uint16_t channel_1[10];
+
+    for (size_t i = 0; i < 20; i++)
+    {
+        codes[i] = (uint16_t)((i % 2) ? 3000 + 37 * i : 500 + 11 * i);
+    }
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        channel_1[i] = codes[2 * i + 1];
+    }
+
+    mcp320x_filter_init(&filter, &config);
+    mcp320x_filter_init(&reference, &single);
+
+    // Odd splits, so the calls don't start on channel 0.
+    mcp320x_filter_process(&filter, codes, 5);
+    mcp320x_filter_process(&filter, &codes[5], 8);
+    mcp320x_filter_process(&filter, &codes[13], 7);
+    mcp320x_filter_process(&reference, channel_1, 10);
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        TEST_ASSERT_EQUAL(channel_1[i], codes[2 * i + 1]);
+    }
+}
@@ -0,0 +1,112 @@
+#include "common_infra_test.h"
+#include "esp_timer.h"
+#include "frame.h"
+
+TEST_CASE("Can encode frame", "[frame]")
+{
+    uint8_t frame[MCP320X_FRAME_SIZE];
+
+    mcp320x_frame_encode(MCP320X_CHANNEL_0, MCP320X_READ_MODE_DIFFERENTIAL, frame);
+    TEST_ASSERT_EQUAL_HEX8(0b10000000, frame[0]);
+
+    mcp320x_frame_encode(MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, frame);
+    TEST_ASSERT_EQUAL_HEX8(0b11011000, frame[0]);
+
+    mcp320x_frame_encode(MCP320X_CHANNEL_7, MCP320X_READ_MODE_SINGLE, frame);
+    TEST_ASSERT_EQUAL_HEX8(0b11111000, frame[0]);
+    TEST_ASSERT_EQUAL_HEX8(0, frame[1]);
+    TEST_ASSERT_EQUAL_HEX8(0, frame[2]);
+    TEST_ASSERT_EQUAL_HEX8(0, frame[3]);
+}
+
+TEST_CASE("Can decode frame", "[frame]")
+{
+    // 1270 with every dummy bit set.
+    const uint8_t frame[MCP320X_FRAME_SIZE] = {0b11111100, 0b10011110, 0b11011111, 0xFF};
+
+    TEST_ASSERT_EQUAL(1270, mcp320x_frame_decode(frame));
+}
+
+TEST_CASE("Can decode every code from frames", "[frame]")
+{
+    static uint8_t rx[MCP320X_RESOLUTION * MCP320X_FRAME_SIZE];
+    static uint16_t values[MCP320X_RESOLUTION];
+
+    for (uint32_t code = 0; code < MCP320X_RESOLUTION; code++)
+    {
+        // Code bits start after 7 clocks; bits not clocked are random.
+        const uint32_t bits = (code << 13) | (0b1111111u << 25) | (code * 2654435761u & 0x1FFF);
+
+        rx[code * MCP320X_FRAME_SIZE + 0] = (uint8_t)(bits >> 24);
+        rx[code * MCP320X_FRAME_SIZE + 1] = (uint8_t)(bits >> 16);
+        rx[code * MCP320X_FRAME_SIZE + 2] = (uint8_t)(bits >> 8);
+        rx[code * MCP320X_FRAME_SIZE + 3] = (uint8_t)bits;
+    }
+
+    mcp320x_decode_frames(rx, MCP320X_RESOLUTION, values);
+
+    for (uint32_t code = 0; code < MCP320X_RESOLUTION; code++)
+    {
+        TEST_ASSERT_EQUAL(code, values[code]);
+    }
+}
+
+TEST_CASE("Can decode frames with word loads as the reference", "[frame]")
+{
+    static uint8_t rx[257 * MCP320X_FRAME_SIZE + 1];
+    static uint16_t expected[257];
+    static uint16_t values[257];
+    uint32_t seed = 0x12345678;
+
+    for (int round = 0; round < 64; round++)
+    {
+        for (size_t i = 0; i < sizeof(rx); i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            rx[i] = (uint8_t)(seed >> 24);
+        }
+
+        // Odd lengths exercise the tail; offset 1 exercises unaligned loads.
+        const size_t count = 1 + (seed % 257);
+        uint8_t const *frames = &rx[round & 1];
+
+        mcp320x_decode_frames_scalar(frames, count, expected);
+        mcp320x_decode_frames_word(frames, count, values);
+
+        TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, values, count);
+    }
+}
+
+TEST_CASE("Can benchmark frame decoders", "[frame][throughput]")
+{
+    static uint8_t rx[MCP320X_RESOLUTION * MCP320X_FRAME_SIZE];
+    static uint16_t values[MCP320X_RESOLUTION];
+    const int rounds = 50;
+
+    for (size_t i = 0; i < sizeof(rx); i++)
+    {
+        rx[i] = (uint8_t)(i * 31);
+    }
+
+    int64_t start = esp_timer_get_time();
+
+    for (int round = 0; round < rounds; round++)
+    {
+        mcp320x_decode_frames_scalar(rx, MCP320X_RESOLUTION, values);
+    }
+
+    const int64_t scalar_us = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+
+    for (int round = 0; round < rounds; round++)
+    {
+        mcp320x_decode_frames_word(rx, MCP320X_RESOLUTION, values);
+    }
+
+    const int64_t word_us = esp_timer_get_time() - start;
+    const int64_t decoded = (int64_t)rounds * MCP320X_RESOLUTION * 1000000;
+
+    printf("decode scalar: %lld samples/s\n", (long long)(decoded / (scalar_us > 0 ? scalar_us : 1)));
+    printf("decode word: %lld samples/s\n", (long long)(decoded / (word_us > 0 ? word_us : 1)));
+}
@@ -11,9 +11,7 @@ TEST_CASE("Cannot get frequency with invalid handle", "[freq]")
 
 TEST_CASE("Cannot get frequency with null frequency", "[freq]")
 {
-    uint32_t frequency;
-
-    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_get_actual_freq(handle, &frequency))
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_get_actual_freq(handle, NULL))
 
     TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
 }
@@ -0,0 +1,172 @@
+#include "common_infra_test.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp32_driver_mcp320x/mcp320x_group.h"
+#include "esp32_driver_mcp320x/mcp320x_stream.h"
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+
+// The test device plus an in-memory one: a pipelined device and one scanned
+// afterwards.
+
+static mcp320x_transport_mock_t group_mock = {.codes = {100, 200, 300, 400}};
+
+static mcp320x_config_t group_mock_config(void)
+{
+    mcp320x_config_t config = VALID_CONFIG;
+
+    config.transport = &mcp320x_transport_mock;
+    config.transport_config = &group_mock;
+
+    return config;
+}
+
+TEST_CASE("Cannot install group with null configs", "[group]")
+{
+    mcp320x_group_t *group = mcp320x_group_install(NULL, 1);
+
+    TEST_ASSERT_NULL(group);
+}
+
+TEST_CASE("Cannot install group with zero devices", "[group]")
+{
+    mcp320x_group_t *group = mcp320x_group_install(&VALID_CONFIG, 0);
+
+    TEST_ASSERT_NULL(group);
+}
+
+TEST_CASE("Cannot install group with too many devices", "[group]")
+{
+    mcp320x_config_t configs[MCP320X_GROUP_DEVICES_MAX + 1];
+
+    for (int i = 0; i < MCP320X_GROUP_DEVICES_MAX + 1; i++)
+    {
+        configs[i] = group_mock_config();
+    }
+
+    mcp320x_group_t *group = mcp320x_group_install(configs, MCP320X_GROUP_DEVICES_MAX + 1);
+
+    TEST_ASSERT_NULL(group);
+}
+
+TEST_CASE("Cannot install group with invalid device", "[group]")
+{
+    mcp320x_config_t configs[2] = {VALID_CONFIG, VALID_CONFIG};
+    configs[1].clock_speed_hz = MCP320X_CLOCK_MAX_HZ + 1;
+
+    mcp320x_group_t *group = mcp320x_group_install(configs, 2);
+
+    TEST_ASSERT_NULL(group);
+}
+
+TEST_CASE("Cannot delete group with invalid handle", "[group]")
+{
+    mcp320x_err_t result = mcp320x_group_delete(NULL);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot get group device with invalid index", "[group]")
+{
+    mcp320x_t *handle;
+
+    mcp320x_group_t *group = mcp320x_group_install(&VALID_CONFIG, 1);
+    mcp320x_err_t result = mcp320x_group_get_device(group, 1, &handle);
+    mcp320x_group_delete(group);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, result);
+}
+
+TEST_CASE("Cannot scan group with invalid handle", "[group]")
+{
+    uint16_t values[1][MCP320X_CHANNEL_COUNT_MAX];
+
+    mcp320x_err_t result = mcp320x_group_scan(NULL, 1 << MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, values);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot scan group with invalid channel", "[group]")
+{
+    uint16_t values[1][MCP320X_CHANNEL_COUNT_MAX];
+
+    mcp320x_group_t *group = mcp320x_group_install(&VALID_CONFIG, 1);
+    mcp320x_err_t result = mcp320x_group_scan(group, 1 << MCP320X_CHANNEL_7, MCP320X_READ_MODE_SINGLE, values);
+    mcp320x_group_delete(group);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Cannot scan group with null values", "[group]")
+{
+    mcp320x_group_t *group = mcp320x_group_install(&VALID_CONFIG, 1);
+    mcp320x_err_t result = mcp320x_group_scan(group, 1 << MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, NULL);
+    mcp320x_group_delete(group);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Cannot scan group with device acquired", "[group]")
+{
+    uint16_t values[1][MCP320X_CHANNEL_COUNT_MAX];
+    mcp320x_t *handle;
+
+    mcp320x_group_t *group = mcp320x_group_install(&VALID_CONFIG, 1);
+    mcp320x_group_get_device(group, 0, &handle);
+    mcp320x_acquire(handle, portMAX_DELAY);
+    mcp320x_err_t result = mcp320x_group_scan(group, 1 << MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, values);
+    mcp320x_release(handle);
+    mcp320x_group_delete(group);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, result);
+}
+
+TEST_CASE("Cannot scan group with locked device streaming", "[group]")
+{
+    mcp320x_config_t config = VALID_CONFIG;
+    const mcp320x_stream_config_t stream_config = {
+        .channel_mask = 1 << MCP320X_CHANNEL_3,
+        .read_mode = MCP320X_READ_MODE_SINGLE,
+        .rate_hz = 1000,
+        .ring_capacity = 256,
+        .overflow_policy = MCP320X_STREAM_OVERFLOW_DROP_OLDEST,
+        .task_priority = 5,
+        .task_core = tskNO_AFFINITY};
+    uint16_t values[1][MCP320X_CHANNEL_COUNT_MAX];
+    mcp320x_t *handle;
+
+    config.locked = true;
+
+    mcp320x_group_t *group = mcp320x_group_install(&config, 1);
+    mcp320x_group_get_device(group, 0, &handle);
+    mcp320x_stream_start(handle, &stream_config);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    mcp320x_err_t result = mcp320x_group_scan(group, 1 << MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, values);
+    mcp320x_stream_stop(handle);
+    mcp320x_group_delete(group);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, result);
+}
+
+TEST_CASE("Can scan group", "[group]")
+{
+    const mcp320x_config_t configs[2] = {VALID_CONFIG, group_mock_config()};
+    uint16_t values[2][MCP320X_CHANNEL_COUNT_MAX] = {0};
+    mcp320x_t *handle = NULL;
+
+    group_mock.frames = 0;
+
+    mcp320x_group_t *group = mcp320x_group_install(configs, 2);
+    mcp320x_err_t scan_result = mcp320x_group_scan(group, (1 << MCP320X_CHANNEL_1) | (1 << MCP320X_CHANNEL_3), MCP320X_READ_MODE_SINGLE, values);
+    mcp320x_err_t device_result = mcp320x_group_get_device(group, 1, &handle);
+    mcp320x_err_t delete_result = mcp320x_group_delete(group);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, scan_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, device_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, delete_result);
+    TEST_ASSERT_NOT_NULL(handle);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, values[0][MCP320X_CHANNEL_3]); // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_EQUAL(200, values[1][MCP320X_CHANNEL_1]);
+    TEST_ASSERT_EQUAL(400, values[1][MCP320X_CHANNEL_3]);
+    TEST_ASSERT_EQUAL(0, values[1][MCP320X_CHANNEL_0]); // Not selected: untouched.
+    TEST_ASSERT_EQUAL(2, group_mock.frames);
+}
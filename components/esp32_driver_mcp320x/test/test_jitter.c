@@ -0,0 +1,89 @@
+#include "common_infra_test.h"
+#include "jitter.h"
+
+// The accumulator is fed by a virtual clock: exact, host independent timestamps.
+
+TEST_CASE("Can measure no jitter", "[jitter]")
+{
+    mcp320x_jitter_t jitter;
+    mcp320x_capture_stats_t stats;
+
+    mcp320x_jitter_init(&jitter, 20, 0);
+
+    for (uint32_t i = 1; i <= 100; i++)
+    {
+        mcp320x_jitter_add(&jitter, i * 20);
+    }
+
+    mcp320x_jitter_get_stats(&jitter, &stats);
+
+    TEST_ASSERT_EQUAL_UINT32(100, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+    TEST_ASSERT_EQUAL_INT32(0, stats.error_min_us);
+    TEST_ASSERT_EQUAL_INT32(0, stats.error_max_us);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.error_stddev_ns);
+}
+
+TEST_CASE("Can measure jitter", "[jitter]")
+{
+    mcp320x_jitter_t jitter;
+    mcp320x_capture_stats_t stats;
+
+    // Every other sample 2us late: intervals of 22us and 18us.
+    mcp320x_jitter_init(&jitter, 20, 0);
+
+    for (uint32_t i = 1; i <= 100; i++)
+    {
+        mcp320x_jitter_add(&jitter, i * 20 + (i % 2) * 2);
+    }
+
+    mcp320x_jitter_get_stats(&jitter, &stats);
+
+    TEST_ASSERT_EQUAL_UINT32(100, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+    TEST_ASSERT_EQUAL_INT32(-2, stats.error_min_us);
+    TEST_ASSERT_EQUAL_INT32(2, stats.error_max_us);
+    TEST_ASSERT_EQUAL_UINT32(2000, stats.error_stddev_ns);
+}
+
+TEST_CASE("Can count missed deadlines", "[jitter]")
+{
+    mcp320x_jitter_t jitter;
+    mcp320x_capture_stats_t stats;
+
+    // Samples at 100, 200, 500 (2 missed), 601 and 700.
+    const uint32_t timestamps[] = {100, 200, 500, 601, 700};
+
+    mcp320x_jitter_init(&jitter, 100, 0);
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        mcp320x_jitter_add(&jitter, timestamps[i]);
+    }
+
+    mcp320x_jitter_get_stats(&jitter, &stats);
+
+    TEST_ASSERT_EQUAL_UINT32(5, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.missed);
+    TEST_ASSERT_EQUAL_INT32(-1, stats.error_min_us);
+    TEST_ASSERT_EQUAL_INT32(1, stats.error_max_us);
+}
+
+TEST_CASE("Can measure jitter across the timestamp wrap around", "[jitter]")
+{
+    mcp320x_jitter_t jitter;
+    mcp320x_capture_stats_t stats;
+
+    mcp320x_jitter_init(&jitter, 50, UINT32_MAX - 60);
+
+    mcp320x_jitter_add(&jitter, UINT32_MAX - 10);
+    mcp320x_jitter_add(&jitter, 39);
+    mcp320x_jitter_add(&jitter, 90);
+
+    mcp320x_jitter_get_stats(&jitter, &stats);
+
+    TEST_ASSERT_EQUAL_UINT32(3, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+    TEST_ASSERT_EQUAL_INT32(0, stats.error_min_us);
+    TEST_ASSERT_EQUAL_INT32(1, stats.error_max_us);
+}
@@ -0,0 +1,149 @@
+#include "common_infra_test.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+typedef struct
+{
+    mcp320x_t *handle;
+    SemaphoreHandle_t done;
+    mcp320x_err_t try_result;
+    mcp320x_err_t read_result;
+    uint16_t value;
+} lock_waiter_t;
+
+static mcp320x_config_t locked_config(void)
+{
+    mcp320x_config_t config = VALID_CONFIG;
+
+    config.locked = true;
+
+    return config;
+}
+
+static void lock_waiter_task(void *arg)
+{
+    lock_waiter_t *waiter = (lock_waiter_t *)arg;
+
+    waiter->try_result = mcp320x_acquire(waiter->handle, 0);
+    waiter->read_result = mcp320x_read(waiter->handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &waiter->value);
+
+    xSemaphoreGive(waiter->done);
+
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("Cannot get lock stats with invalid handle", "[lock]")
+{
+    mcp320x_lock_stats_t stats;
+
+    mcp320x_err_t result = mcp320x_get_lock_stats(NULL, &stats);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot get lock stats with null stats", "[lock]")
+{
+    mcp320x_config_t config = locked_config();
+
+    mcp320x_t *handle = mcp320x_install(&config);
+    mcp320x_err_t result = mcp320x_get_lock_stats(handle, NULL);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Cannot get lock stats of unlocked handle", "[lock]")
+{
+    mcp320x_lock_stats_t stats;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_get_lock_stats(handle, &stats))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, result);
+}
+
+TEST_CASE("Can read with locked handle", "[lock]")
+{
+    mcp320x_config_t config = locked_config();
+    const mcp320x_channel_t channels[] = {MCP320X_CHANNEL_3, MCP320X_CHANNEL_3};
+    mcp320x_lock_stats_t stats;
+    uint16_t value = 0;
+    uint16_t values[2] = {0};
+    uint16_t sample = 0;
+
+    mcp320x_t *handle = mcp320x_install(&config);
+    mcp320x_err_t read_result = mcp320x_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_err_t many_result = mcp320x_read_many(handle, channels, 2, MCP320X_READ_MODE_SINGLE, values);
+    mcp320x_err_t sample_result = mcp320x_sample(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, 40, &sample);
+    mcp320x_err_t stats_result = mcp320x_get_lock_stats(handle, &stats);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, read_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, many_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, sample_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, stats_result);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, value);     // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_INT16_WITHIN(50, 2048, values[1]); // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_INT16_WITHIN(50, 2048, sample);    // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_EQUAL(3, stats.acquisitions);      // Once per call, whatever the conversions.
+    TEST_ASSERT_EQUAL(0, stats.contentions);
+}
+
+TEST_CASE("Can nest acquisitions of locked handle", "[lock]")
+{
+    mcp320x_config_t config = locked_config();
+    mcp320x_lock_stats_t stats;
+    uint16_t value = 0;
+
+    mcp320x_t *handle = mcp320x_install(&config);
+    mcp320x_err_t acquire_result = mcp320x_acquire(handle, portMAX_DELAY);
+    mcp320x_err_t nested_result = mcp320x_acquire(handle, portMAX_DELAY);
+    mcp320x_err_t read_result = mcp320x_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_err_t nested_release_result = mcp320x_release(handle);
+    mcp320x_err_t release_result = mcp320x_release(handle);
+    mcp320x_err_t release_again_result = mcp320x_release(handle);
+    mcp320x_get_lock_stats(handle, &stats);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, acquire_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, nested_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, read_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, nested_release_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, release_result);
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, release_again_result);
+    TEST_ASSERT_EQUAL(3, stats.acquisitions);
+    TEST_ASSERT_EQUAL(0, stats.contentions);
+}
+
+TEST_CASE("Locked handle makes other tasks wait", "[lock]")
+{
+    mcp320x_config_t config = locked_config();
+    lock_waiter_t waiter = {0};
+    mcp320x_lock_stats_t stats;
+
+    waiter.handle = mcp320x_install(&config);
+    waiter.done = xSemaphoreCreateBinary();
+
+    mcp320x_acquire(waiter.handle, portMAX_DELAY);
+    xTaskCreate(lock_waiter_task, "lock_waiter", 4096, &waiter, 5, NULL);
+
+    const BaseType_t done_while_held = xSemaphoreTake(waiter.done, pdMS_TO_TICKS(50));
+
+    mcp320x_release(waiter.handle);
+
+    const BaseType_t done_after_release = xSemaphoreTake(waiter.done, pdMS_TO_TICKS(1000));
+
+    mcp320x_get_lock_stats(waiter.handle, &stats);
+    mcp320x_delete(waiter.handle);
+    vSemaphoreDelete(waiter.done);
+
+    TEST_ASSERT_EQUAL(pdFALSE, done_while_held);
+    TEST_ASSERT_EQUAL(pdTRUE, done_after_release);
+    TEST_ASSERT_EQUAL(MCP320X_ERR_TIMEOUT, waiter.try_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, waiter.read_result);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, waiter.value); // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_EQUAL(2, stats.acquisitions);
+    TEST_ASSERT_EQUAL(1, stats.contentions);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(40 * 1000, stats.wait_max_us);
+    TEST_ASSERT_EQUAL(stats.wait_max_us, stats.wait_total_us);
+}
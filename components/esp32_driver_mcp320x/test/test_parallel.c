@@ -0,0 +1,129 @@
+#include "common_infra_test.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp32_driver_mcp320x/mcp320x_parallel.h"
+
+static mcp320x_parallel_config_t parallel_config(mcp320x_group_t *group)
+{
+    mcp320x_parallel_config_t config = {
+        .workers = {{.group = group, .channel_mask = 1 << MCP320X_CHANNEL_3, .task_core = tskNO_AFFINITY}},
+        .worker_count = 1,
+        .read_mode = MCP320X_READ_MODE_SINGLE,
+        .rate_hz = 1000,
+        .ring_capacity = 64,
+        .task_priority = 5};
+
+    return config;
+}
+
+TEST_CASE("Cannot start parallel with null config", "[parallel]")
+{
+    mcp320x_parallel_t *parallel = mcp320x_parallel_start(NULL);
+
+    TEST_ASSERT_NULL(parallel);
+}
+
+TEST_CASE("Cannot start parallel with no workers", "[parallel]")
+{
+    mcp320x_group_t *group = mcp320x_group_install(&VALID_CONFIG, 1);
+    mcp320x_parallel_config_t config = parallel_config(group);
+    config.worker_count = 0;
+
+    mcp320x_parallel_t *parallel = mcp320x_parallel_start(&config);
+    mcp320x_group_delete(group);
+
+    TEST_ASSERT_NULL(parallel);
+}
+
+TEST_CASE("Cannot start parallel with null group", "[parallel]")
+{
+    mcp320x_parallel_config_t config = parallel_config(NULL);
+
+    mcp320x_parallel_t *parallel = mcp320x_parallel_start(&config);
+
+    TEST_ASSERT_NULL(parallel);
+}
+
+TEST_CASE("Cannot start parallel with invalid channel", "[parallel]")
+{
+    mcp320x_group_t *group = mcp320x_group_install(&VALID_CONFIG, 1);
+    mcp320x_parallel_config_t config = parallel_config(group);
+    config.workers[0].channel_mask = 1 << MCP320X_CHANNEL_7;
+
+    mcp320x_parallel_t *parallel = mcp320x_parallel_start(&config);
+    mcp320x_group_delete(group);
+
+    TEST_ASSERT_NULL(parallel);
+}
+
+TEST_CASE("Cannot start parallel with group shared by workers", "[parallel]")
+{
+    mcp320x_group_t *group = mcp320x_group_install(&VALID_CONFIG, 1);
+    mcp320x_parallel_config_t config = parallel_config(group);
+    config.workers[1] = config.workers[0];
+    config.worker_count = 2;
+
+    mcp320x_parallel_t *parallel = mcp320x_parallel_start(&config);
+    mcp320x_group_delete(group);
+
+    TEST_ASSERT_NULL(parallel);
+}
+
+TEST_CASE("Cannot start parallel with high rate", "[parallel]")
+{
+    mcp320x_group_t *group = mcp320x_group_install(&VALID_CONFIG, 1);
+    mcp320x_parallel_config_t config = parallel_config(group);
+    config.rate_hz = MCP320X_PARALLEL_RATE_MAX_HZ + 1;
+
+    mcp320x_parallel_t *parallel = mcp320x_parallel_start(&config);
+    mcp320x_group_delete(group);
+
+    TEST_ASSERT_NULL(parallel);
+}
+
+TEST_CASE("Cannot read parallel with invalid handle", "[parallel]")
+{
+    mcp320x_parallel_scan_t scan;
+    size_t read_count;
+
+    mcp320x_err_t result = mcp320x_parallel_read(NULL, &scan, 1, &read_count);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Can acquire in parallel", "[parallel]")
+{
+    static mcp320x_parallel_scan_t scans[64];
+    mcp320x_parallel_stats_t stats;
+    size_t read_count = 0;
+
+    mcp320x_group_t *group = mcp320x_group_install(&VALID_CONFIG, 1);
+    mcp320x_parallel_config_t config = parallel_config(group);
+
+    mcp320x_parallel_t *parallel = mcp320x_parallel_start(&config);
+
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    mcp320x_err_t read_result = mcp320x_parallel_read(parallel, scans, 64, &read_count);
+    mcp320x_err_t stats_result = mcp320x_parallel_get_stats(parallel, &stats);
+    mcp320x_err_t stop_result = mcp320x_parallel_stop(parallel);
+    mcp320x_group_delete(group);
+
+    TEST_ASSERT_NOT_NULL(parallel);
+    TEST_ASSERT_EQUAL(MCP320X_OK, read_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, stats_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, stop_result);
+    TEST_ASSERT_GREATER_THAN(10, read_count);
+    TEST_ASSERT_EQUAL(0, stats.errors);
+
+    for (size_t i = 0; i < read_count; i++)
+    {
+        TEST_ASSERT_EQUAL(0, scans[i].worker);
+        TEST_ASSERT_INT16_WITHIN(50, 2048, scans[i].values[0][MCP320X_CHANNEL_3]); // Will accept 2.5V +- 50mV.
+
+        if (i > 0)
+        {
+            TEST_ASSERT_GREATER_THAN(scans[i - 1].timestamp_us, scans[i].timestamp_us);
+        }
+    }
+}
@@ -0,0 +1,146 @@
+#include "common_infra_test.h"
+#include "esp32_driver_mcp320x/mcp320x_async.h"
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+
+typedef struct
+{
+    uint32_t calls;
+    uint16_t value;
+} async_capture_t;
+
+static void capture_value(mcp320x_t *handle, uint16_t value, void *context)
+{
+    (void)handle;
+
+    async_capture_t *capture = (async_capture_t *)context;
+
+    capture->calls++;
+    capture->value = value;
+}
+
+TEST_CASE("Cannot read async with invalid handle", "[read_async]")
+{
+    mcp320x_err_t result = mcp320x_read_async(NULL, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, NULL, NULL);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot read async with invalid channel", "[read_async]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_async(handle, MCP320X_CHANNEL_7, MCP320X_READ_MODE_SINGLE, NULL, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Cannot get result without a pending read", "[read_async]")
+{
+    uint16_t value;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_get_result(handle, &value, 0))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, result);
+}
+
+TEST_CASE("Cannot get result with null value", "[read_async]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_get_result(handle, NULL, 0))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Can read async", "[read_async]")
+{
+    async_capture_t capture = {0};
+    uint16_t value = 0;
+    uint8_t pending_before;
+    uint8_t pending_after;
+
+    EXECUTE_WITH_HANDLE(
+        mcp320x_err_t submitted = mcp320x_read_async(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, capture_value, &capture);
+        mcp320x_get_pending(handle, &pending_before);
+        mcp320x_err_t collected = mcp320x_get_result(handle, &value, portMAX_DELAY);
+        mcp320x_get_pending(handle, &pending_after))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, submitted);
+    TEST_ASSERT_EQUAL(MCP320X_OK, collected);
+    TEST_ASSERT_EQUAL(1, pending_before);
+    TEST_ASSERT_EQUAL(0, pending_after);
+    TEST_ASSERT_EQUAL(1, capture.calls);
+    TEST_ASSERT_EQUAL_UINT16(value, capture.value);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, value); // Will accept 2.5V +- 50mV.
+}
+
+TEST_CASE("Can read async in order", "[read_async]")
+{
+    uint16_t values[3] = {0};
+    mcp320x_err_t results[3];
+
+    EXECUTE_WITH_HANDLE(
+        mcp320x_read_async(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, NULL, NULL);
+        mcp320x_read_async(handle, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, NULL, NULL);
+        mcp320x_read_async(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, NULL, NULL);
+        for (size_t i = 0; i < 3; i++) {
+            results[i] = mcp320x_get_result(handle, &values[i], portMAX_DELAY);
+        })
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, results[0]);
+    TEST_ASSERT_EQUAL(MCP320X_OK, results[1]);
+    TEST_ASSERT_EQUAL(MCP320X_OK, results[2]);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, values[0]);
+    TEST_ASSERT_INT16_WITHIN(50, 0, values[1]);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, values[2]);
+}
+
+TEST_CASE("Cannot read async beyond the queue size", "[read_async]")
+{
+    mcp320x_err_t overflow;
+    mcp320x_err_t deleted_pending;
+    uint16_t value;
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+
+    for (size_t i = 0; i < MCP320X_ASYNC_QUEUE_SIZE; i++)
+    {
+        TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_read_async(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, NULL, NULL));
+    }
+
+    overflow = mcp320x_read_async(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, NULL, NULL);
+    deleted_pending = mcp320x_delete(handle);
+
+    for (size_t i = 0; i < MCP320X_ASYNC_QUEUE_SIZE; i++)
+    {
+        TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_get_result(handle, &value, portMAX_DELAY));
+    }
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, overflow);
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, deleted_pending);
+    TEST_ASSERT_EQUAL(MCP320X_OK, mcp320x_delete(handle));
+}
+
+TEST_CASE("Can read async without a transport queue", "[read_async]")
+{
+    mcp320x_transport_mock_t mock = {.codes = {[MCP320X_CHANNEL_2] = 1234}};
+    mcp320x_config_t config = {
+        .device_model = MCP3204_MODEL,
+        .clock_speed_hz = 1 * 1000 * 1000,
+        .reference_voltage = 5000,
+        .transport = &mcp320x_transport_mock,
+        .transport_config = &mock};
+    async_capture_t capture = {0};
+    uint16_t value = 0;
+
+    mcp320x_t *handle = mcp320x_install(&config);
+
+    mcp320x_err_t submitted = mcp320x_read_async(handle, MCP320X_CHANNEL_2, MCP320X_READ_MODE_SINGLE, capture_value, &capture);
+    uint32_t calls_before_collect = capture.calls;
+    mcp320x_err_t collected = mcp320x_get_result(handle, &value, 0);
+
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, submitted);
+    TEST_ASSERT_EQUAL(MCP320X_OK, collected);
+    TEST_ASSERT_EQUAL(1, calls_before_collect);
+    TEST_ASSERT_EQUAL(1, mock.frames);
+    TEST_ASSERT_EQUAL_UINT16(1234, capture.value);
+    TEST_ASSERT_EQUAL_UINT16(1234, value);
+}
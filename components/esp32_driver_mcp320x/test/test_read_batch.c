@@ -0,0 +1,122 @@
+#include "common_infra_test.h"
+#include "esp_timer.h"
+#include "frame.h"
+
+#define BATCH_THROUGHPUT_SAMPLES 1000
+
+static const mcp320x_request_t VALID_REQUESTS[] = {
+    {.channel = MCP320X_CHANNEL_3, .read_mode = MCP320X_READ_MODE_SINGLE},
+    {.channel = MCP320X_CHANNEL_0, .read_mode = MCP320X_READ_MODE_SINGLE},
+    {.channel = MCP320X_CHANNEL_3, .read_mode = MCP320X_READ_MODE_SINGLE}};
+
+TEST_CASE("Cannot read batch with invalid handle", "[read][batch]")
+{
+    uint16_t values[3];
+
+    mcp320x_err_t result = mcp320x_read_batch(NULL, VALID_REQUESTS, 3, values);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot read batch with null requests", "[read][batch]")
+{
+    uint16_t values[3];
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_batch(handle, NULL, 3, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Cannot read batch with null values", "[read][batch]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_batch(handle, VALID_REQUESTS, 3, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Cannot read batch with zero count", "[read][batch]")
+{
+    uint16_t values[3];
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_batch(handle, VALID_REQUESTS, 0, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_SAMPLE_COUNT, result);
+}
+
+TEST_CASE("Cannot read batch with invalid channel", "[read][batch]")
+{
+    uint16_t values[2];
+    mcp320x_request_t requests[] = {
+        {.channel = MCP320X_CHANNEL_3, .read_mode = MCP320X_READ_MODE_SINGLE},
+        {.channel = MCP320X_CHANNEL_7, .read_mode = MCP320X_READ_MODE_SINGLE}};
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_batch(handle, requests, 2, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Can read batch", "[read][batch]")
+{
+    uint16_t values[3];
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_batch(handle, VALID_REQUESTS, 3, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, values[0]); // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_INT16_WITHIN(50, 2048, values[2]); // Will accept 2.5V +- 50mV.
+}
+
+TEST_CASE("Can read batch larger than the queue", "[read][batch]")
+{
+    mcp320x_request_t requests[MCP320X_BATCH_QUEUE_SIZE * 2 + 1];
+    uint16_t values[MCP320X_BATCH_QUEUE_SIZE * 2 + 1];
+
+    for (size_t i = 0; i < MCP320X_BATCH_QUEUE_SIZE * 2 + 1; i++)
+    {
+        requests[i].channel = MCP320X_CHANNEL_3;
+        requests[i].read_mode = MCP320X_READ_MODE_SINGLE;
+    }
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_batch(handle, requests, MCP320X_BATCH_QUEUE_SIZE * 2 + 1, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+
+    for (size_t i = 0; i < MCP320X_BATCH_QUEUE_SIZE * 2 + 1; i++)
+    {
+        TEST_ASSERT_INT16_WITHIN(50, 2048, values[i]); // Will accept 2.5V +- 50mV.
+    }
+}
+
+TEST_CASE("Can read batch close to the bus limit", "[read][batch][throughput]")
+{
+    static mcp320x_request_t requests[BATCH_THROUGHPUT_SAMPLES];
+    static uint16_t values[BATCH_THROUGHPUT_SAMPLES];
+
+    for (size_t i = 0; i < BATCH_THROUGHPUT_SAMPLES; i++)
+    {
+        requests[i].channel = MCP320X_CHANNEL_3;
+        requests[i].read_mode = MCP320X_READ_MODE_SINGLE;
+    }
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+    mcp320x_acquire(handle, portMAX_DELAY);
+
+    const int64_t start = esp_timer_get_time();
+    mcp320x_err_t result = mcp320x_read_batch(handle, requests, BATCH_THROUGHPUT_SAMPLES, values);
+    const int64_t elapsed_us = esp_timer_get_time() - start;
+
+    mcp320x_release(handle);
+    mcp320x_delete(handle);
+
+    // Each conversion takes MCP320X_FRAME_BITS clocks; anything above 70% of
+    // that limit means the queue is keeping the bus busy between conversions.
+    // 24 clocks frames top out at 79% with no gap at all, so with the usual
+    // gaps a regression to them falls below.
+    const uint32_t theoretical_sps = VALID_CONFIG.clock_speed_hz / MCP320X_FRAME_BITS;
+    const uint32_t measured_sps = (uint32_t)((BATCH_THROUGHPUT_SAMPLES * 1000000LL) / elapsed_us);
+
+    printf("batch: %lu samples/s (limit %lu samples/s)\n", (unsigned long)measured_sps, (unsigned long)theoretical_sps);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(theoretical_sps * 7 / 10, measured_sps);
+}
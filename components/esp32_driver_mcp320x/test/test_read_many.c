@@ -0,0 +1,95 @@
+#include "common_infra_test.h"
+
+static const mcp320x_channel_t VALID_CHANNELS[] = {MCP320X_CHANNEL_3, MCP320X_CHANNEL_0, MCP320X_CHANNEL_3};
+
+TEST_CASE("Cannot read many with invalid handle", "[read][many]")
+{
+    uint16_t values[3];
+
+    mcp320x_err_t result = mcp320x_read_many(NULL, VALID_CHANNELS, 3, MCP320X_READ_MODE_SINGLE, values);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot read many with null channels", "[read][many]")
+{
+    uint16_t values[3];
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_many(handle, NULL, 3, MCP320X_READ_MODE_SINGLE, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Cannot read many with null values", "[read][many]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_many(handle, VALID_CHANNELS, 3, MCP320X_READ_MODE_SINGLE, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Cannot read many with zero count", "[read][many]")
+{
+    uint16_t values[3];
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_many(handle, VALID_CHANNELS, 0, MCP320X_READ_MODE_SINGLE, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_SAMPLE_COUNT, result);
+}
+
+TEST_CASE("Cannot read many with invalid channel", "[read][many]")
+{
+    uint16_t values[2];
+    const mcp320x_channel_t channels[] = {MCP320X_CHANNEL_3, MCP320X_CHANNEL_7};
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_many(handle, channels, 2, MCP320X_READ_MODE_SINGLE, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Can read many", "[read][many]")
+{
+    uint16_t values[3];
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_many(handle, VALID_CHANNELS, 3, MCP320X_READ_MODE_SINGLE, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, values[0]); // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_INT16_WITHIN(50, 2048, values[2]); // Will accept 2.5V +- 50mV.
+}
+
+TEST_CASE("Can read many larger than the queue", "[read][many]")
+{
+    mcp320x_channel_t channels[MCP320X_BATCH_QUEUE_SIZE * 2 + 1];
+    uint16_t values[MCP320X_BATCH_QUEUE_SIZE * 2 + 1];
+
+    for (size_t i = 0; i < MCP320X_BATCH_QUEUE_SIZE * 2 + 1; i++)
+    {
+        channels[i] = MCP320X_CHANNEL_3;
+    }
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_many(handle, channels, MCP320X_BATCH_QUEUE_SIZE * 2 + 1, MCP320X_READ_MODE_SINGLE, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+
+    for (size_t i = 0; i < MCP320X_BATCH_QUEUE_SIZE * 2 + 1; i++)
+    {
+        TEST_ASSERT_INT16_WITHIN(50, 2048, values[i]); // Will accept 2.5V +- 50mV.
+    }
+}
+
+TEST_CASE("Can read many with the bus acquired", "[read][many]")
+{
+    uint16_t values[3];
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+    mcp320x_acquire(handle, portMAX_DELAY);
+
+    mcp320x_err_t result = mcp320x_read_many(handle, VALID_CHANNELS, 3, MCP320X_READ_MODE_SINGLE, values);
+    mcp320x_err_t release_result = mcp320x_release(handle);
+
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, release_result); // The nested acquisition was released by read many.
+    TEST_ASSERT_INT16_WITHIN(50, 2048, values[0]); // Will accept 2.5V +- 50mV.
+}
@@ -0,0 +1,93 @@
+#include "common_infra_test.h"
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+
+TEST_CASE("Cannot prepare with invalid handle", "[read_prepared]")
+{
+    mcp320x_prepared_t prepared;
+
+    mcp320x_err_t result = mcp320x_prepare(NULL, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, &prepared);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot prepare with invalid channel", "[read_prepared]")
+{
+    mcp320x_prepared_t prepared;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_prepare(handle, MCP320X_CHANNEL_7, MCP320X_READ_MODE_SINGLE, &prepared))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Cannot prepare with null prepared", "[read_prepared]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_prepare(handle, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Cannot read prepared with null prepared", "[read_prepared]")
+{
+    uint16_t value;
+
+    mcp320x_err_t result = mcp320x_read_prepared(NULL, &value);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot read prepared with null value", "[read_prepared]")
+{
+    mcp320x_prepared_t prepared;
+
+    EXECUTE_WITH_HANDLE(
+        mcp320x_prepare(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &prepared);
+        mcp320x_err_t result = mcp320x_read_prepared(&prepared, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Can read prepared", "[read_prepared]")
+{
+    mcp320x_prepared_t prepared;
+    uint16_t first;
+    uint16_t second;
+
+    EXECUTE_WITH_HANDLE(
+        mcp320x_prepare(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &prepared);
+        mcp320x_err_t first_result = mcp320x_read_prepared(&prepared, &first);
+        mcp320x_err_t second_result = mcp320x_read_prepared(&prepared, &second))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, first_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, second_result);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, first); // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_INT16_WITHIN(50, 2048, second);
+}
+
+TEST_CASE("Can read prepared with transport without prepare", "[read_prepared]")
+{
+    mcp320x_transport_mock_t mock = {
+        .codes = {0, 1, 2048, 4095}};
+    mcp320x_config_t config = VALID_CONFIG;
+    mcp320x_prepared_t prepared[4];
+    uint16_t values[4];
+
+    config.transport = &mcp320x_transport_mock;
+    config.transport_config = &mock;
+
+    mcp320x_t *handle = mcp320x_install(&config);
+
+    for (int i = 0; i < 4; i++)
+    {
+        mcp320x_prepare(handle, (mcp320x_channel_t)i, MCP320X_READ_MODE_SINGLE, &prepared[i]);
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        mcp320x_read_prepared(&prepared[i], &values[i]);
+    }
+
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(mock.codes, values, 4);
+    TEST_ASSERT_EQUAL(4, mock.frames);
+}
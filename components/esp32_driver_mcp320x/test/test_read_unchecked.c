@@ -0,0 +1,23 @@
+#include "common_infra_test.h"
+
+TEST_CASE("Can read unchecked", "[read_unchecked]")
+{
+    uint16_t value;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_read_unchecked(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, value); // Will accept 2.5V +- 50mV.
+}
+
+TEST_CASE("Can read unchecked the same as checked", "[read_unchecked]")
+{
+    uint16_t checked;
+    uint16_t unchecked;
+
+    EXECUTE_WITH_HANDLE(
+        mcp320x_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &checked);
+        mcp320x_read_unchecked(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &unchecked))
+
+    TEST_ASSERT_INT16_WITHIN(2, checked, unchecked);
+}
@@ -0,0 +1,188 @@
+#include "common_infra_test.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "ring.h"
+
+#define RING_STRESS_CAPACITY 64
+#define RING_STRESS_COUNT 100000
+
+typedef struct
+{
+    mcp320x_ring_t *ring;
+    SemaphoreHandle_t done;
+    bool overwrite;
+} ring_stress_context_t;
+
+TEST_CASE("Cannot init ring with capacity not power of two", "[ring]")
+{
+    mcp320x_ring_t ring;
+    uint16_t buffer[6];
+
+    TEST_ASSERT_FALSE(mcp320x_ring_init(&ring, buffer, 6));
+}
+
+TEST_CASE("Can round ring capacity", "[ring]")
+{
+    TEST_ASSERT_EQUAL(1, mcp320x_ring_round_capacity(0));
+    TEST_ASSERT_EQUAL(8, mcp320x_ring_round_capacity(5));
+    TEST_ASSERT_EQUAL(8, mcp320x_ring_round_capacity(8));
+}
+
+TEST_CASE("Cannot push to full ring", "[ring]")
+{
+    mcp320x_ring_t ring;
+    uint16_t buffer[4];
+    uint16_t values[] = {1, 2, 3};
+
+    mcp320x_ring_init(&ring, buffer, 4);
+
+    TEST_ASSERT_TRUE(mcp320x_ring_push(&ring, values, 3));
+    TEST_ASSERT_FALSE(mcp320x_ring_push(&ring, values, 2));
+    TEST_ASSERT_EQUAL(3, mcp320x_ring_size(&ring));
+}
+
+TEST_CASE("Can wrap around ring", "[ring]")
+{
+    mcp320x_ring_t ring;
+    uint16_t buffer[4];
+    uint16_t read[4];
+
+    mcp320x_ring_init(&ring, buffer, 4);
+
+    for (uint16_t i = 0; i < 10; i++)
+    {
+        uint16_t values[] = {i, (uint16_t)(i + 100), (uint16_t)(i + 200)};
+
+        TEST_ASSERT_TRUE(mcp320x_ring_push(&ring, values, 3));
+        TEST_ASSERT_EQUAL(3, mcp320x_ring_pop(&ring, read, 4));
+        TEST_ASSERT_EQUAL(i, read[0]);
+        TEST_ASSERT_EQUAL(i + 100, read[1]);
+        TEST_ASSERT_EQUAL(i + 200, read[2]);
+    }
+
+    TEST_ASSERT_EQUAL(0, mcp320x_ring_size(&ring));
+}
+
+TEST_CASE("Can overwrite oldest values of ring", "[ring]")
+{
+    mcp320x_ring_t ring;
+    uint16_t buffer[8];
+    uint16_t read[8];
+
+    mcp320x_ring_init(&ring, buffer, 8);
+
+    size_t discarded = 0;
+
+    for (uint16_t i = 0; i < 5; i++)
+    {
+        uint16_t values[] = {i, i};
+
+        discarded += mcp320x_ring_push_overwrite(&ring, values, 2);
+    }
+
+    TEST_ASSERT_EQUAL(2, discarded);
+    TEST_ASSERT_EQUAL(8, mcp320x_ring_pop(&ring, read, 8));
+    TEST_ASSERT_EQUAL(1, read[0]);
+    TEST_ASSERT_EQUAL(1, read[1]);
+    TEST_ASSERT_EQUAL(4, read[6]);
+}
+
+static void ring_stress_producer(void *arg)
+{
+    ring_stress_context_t *context = (ring_stress_context_t *)arg;
+
+    for (uint32_t i = 0; i < RING_STRESS_COUNT; i++)
+    {
+        uint16_t value = (uint16_t)i;
+
+        if (context->overwrite)
+        {
+            mcp320x_ring_push_overwrite(context->ring, &value, 1);
+        }
+        else
+        {
+            while (!mcp320x_ring_push(context->ring, &value, 1))
+            {
+                taskYIELD();
+            }
+        }
+    }
+
+    xSemaphoreGive(context->done);
+
+    vTaskDelete(NULL);
+}
+
+static uint32_t ring_stress(bool overwrite, uint32_t *out_of_order)
+{
+    static uint16_t buffer[RING_STRESS_CAPACITY];
+    mcp320x_ring_t ring;
+    ring_stress_context_t context = {
+        .ring = &ring,
+        .done = xSemaphoreCreateBinary(),
+        .overwrite = overwrite};
+    uint32_t received = 0;
+    uint16_t last = UINT16_MAX;
+    bool producing = true;
+
+    *out_of_order = 0;
+
+    mcp320x_ring_init(&ring, buffer, RING_STRESS_CAPACITY);
+
+    xTaskCreatePinnedToCore(ring_stress_producer, "ring_stress", 2048, &context, uxTaskPriorityGet(NULL), NULL, tskNO_AFFINITY);
+
+    while (producing || mcp320x_ring_size(&ring) > 0)
+    {
+        uint16_t values[16];
+
+        producing = producing && xSemaphoreTake(context.done, 0) != pdTRUE;
+
+        const size_t count = mcp320x_ring_pop(&ring, values, 16);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            // The producer writes an increasing sequence (modulo 2^16). Without
+            // overwriting it must arrive complete. With, values can be skipped
+            // between pops, by any amount, but a pop is always contiguous.
+            const uint16_t delta = (uint16_t)(values[i] - last);
+            const bool skipped = overwrite && i == 0;
+
+            if (skipped ? (delta == 0) : (delta != 1))
+            {
+                (*out_of_order)++;
+            }
+
+            last = values[i];
+        }
+
+        received += count;
+
+        if (count == 0)
+        {
+            taskYIELD();
+        }
+    }
+
+    vSemaphoreDelete(context.done);
+
+    return received;
+}
+
+TEST_CASE("Can stress ring with concurrent producer and consumer", "[ring]")
+{
+    uint32_t out_of_order;
+    uint32_t received = ring_stress(false, &out_of_order);
+
+    TEST_ASSERT_EQUAL(RING_STRESS_COUNT, received);
+    TEST_ASSERT_EQUAL(0, out_of_order);
+}
+
+TEST_CASE("Can stress overwriting ring with concurrent producer and consumer", "[ring]")
+{
+    uint32_t out_of_order;
+    uint32_t received = ring_stress(true, &out_of_order);
+
+    TEST_ASSERT_LESS_OR_EQUAL(RING_STRESS_COUNT, received);
+    TEST_ASSERT_EQUAL(0, out_of_order);
+}
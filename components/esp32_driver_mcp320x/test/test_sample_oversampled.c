@@ -0,0 +1,59 @@
+#include "common_infra_test.h"
+
+TEST_CASE("Cannot sample oversampled with invalid handle", "[sample_oversampled]")
+{
+    uint16_t value;
+
+    mcp320x_err_t result = mcp320x_sample_oversampled(NULL, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, 2, &value);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot sample oversampled with invalid channel", "[sample_oversampled]")
+{
+    uint16_t value;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_sample_oversampled(handle, MCP320X_CHANNEL_7, MCP320X_READ_MODE_SINGLE, 2, &value))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Cannot sample oversampled with null value", "[sample_oversampled]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_sample_oversampled(handle, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, 2, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Cannot sample oversampled with zero extra bits", "[sample_oversampled]")
+{
+    uint16_t value;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_sample_oversampled(handle, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, 0, &value))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_SAMPLE_COUNT, result);
+}
+
+TEST_CASE("Cannot sample oversampled with too many extra bits", "[sample_oversampled]")
+{
+    uint16_t value;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_sample_oversampled(handle, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, MCP320X_OVERSAMPLE_BITS_MAX + 1, &value))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_SAMPLE_COUNT, result);
+}
+
+TEST_CASE("Can sample oversampled", "[sample_oversampled]")
+{
+    uint16_t value_13_bits;
+    uint16_t value_16_bits;
+
+    EXECUTE_WITH_HANDLE(
+        mcp320x_err_t result_13_bits = mcp320x_sample_oversampled(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, 1, &value_13_bits);
+        mcp320x_err_t result_16_bits = mcp320x_sample_oversampled(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, 4, &value_16_bits))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_13_bits);
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_16_bits);
+    TEST_ASSERT_INT32_WITHIN(50 << 1, 2048 << 1, value_13_bits); // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_INT32_WITHIN(50 << 4, 2048 << 4, value_16_bits);
+}
@@ -0,0 +1,128 @@
+#include "common_infra_test.h"
+
+TEST_CASE("Cannot sample stats with invalid handle", "[sample_stats]")
+{
+    mcp320x_sample_stats_t stats;
+
+    mcp320x_err_t result = mcp320x_sample_stats(NULL, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, 5, 0, NULL, &stats);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot sample stats with invalid channel", "[sample_stats]")
+{
+    mcp320x_sample_stats_t stats;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_sample_stats(handle, MCP320X_CHANNEL_7, MCP320X_READ_MODE_SINGLE, 5, 0, NULL, &stats))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Cannot sample stats with null stats", "[sample_stats]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_sample_stats(handle, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, 5, 0, NULL, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Cannot sample stats with invalid sample count", "[sample_stats]")
+{
+    mcp320x_sample_stats_t stats;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_sample_stats(handle, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, 0, 0, NULL, &stats))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_SAMPLE_COUNT, result);
+}
+
+TEST_CASE("Cannot sample stats with invalid trim", "[sample_stats]")
+{
+    mcp320x_sample_stats_t stats;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_sample_stats(handle, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, 5, MCP320X_SAMPLE_STATS_TRIM_MAX + 1, NULL, &stats))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_SAMPLE_COUNT, result);
+}
+
+TEST_CASE("Cannot sample stats beyond the stack without a buffer", "[sample_stats]")
+{
+    mcp320x_sample_stats_t stats;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_sample_stats(handle, MCP320X_CHANNEL_0, MCP320X_READ_MODE_SINGLE, MCP320X_SAMPLE_STATS_STACK_SIZE + 1, 0, NULL, &stats))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Can sample stats", "[sample_stats]")
+{
+    mcp320x_sample_stats_t stats;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_sample_stats(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, 21, 10, NULL, &stats))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(21, stats.count);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, stats.median); // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_INT16_WITHIN(50, 2048, stats.trimmed_mean);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.median, stats.min);
+    TEST_ASSERT_GREATER_OR_EQUAL(stats.median, stats.max);
+}
+
+TEST_CASE("Can sample stats with buffer", "[sample_stats]")
+{
+    static uint16_t buffer[200];
+    mcp320x_sample_stats_t stats;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_sample_stats(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, 200, 0, buffer, &stats))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(200, stats.count);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, stats.mean);
+}
+
+TEST_CASE("Can compute stats of codes", "[sample_stats]")
+{
+    uint16_t codes[] = {2, 4, 4, 4, 5, 5, 7, 9};
+    mcp320x_sample_stats_t stats;
+
+    mcp320x_err_t result = mcp320x_codes_stats(codes, 8, 0, &stats);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_UINT16(2, stats.min);
+    TEST_ASSERT_EQUAL_UINT16(9, stats.max);
+    TEST_ASSERT_EQUAL_UINT16(5, stats.mean);
+    TEST_ASSERT_EQUAL_UINT16(5, stats.median); // 4.5 rounded.
+    TEST_ASSERT_EQUAL_UINT32(4, stats.variance);
+    TEST_ASSERT_EQUAL_UINT32(2000, stats.stddev_mcodes);
+}
+
+TEST_CASE("Can reject spikes with median and trimmed mean", "[sample_stats]")
+{
+    uint16_t codes[] = {2048, 4095, 2050, 2046, 0, 2049, 2047, 2048, 2051, 4095};
+    mcp320x_sample_stats_t stats;
+
+    mcp320x_err_t result = mcp320x_codes_stats(codes, 10, 20, &stats);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.min);
+    TEST_ASSERT_EQUAL_UINT16(4095, stats.max);
+    TEST_ASSERT_EQUAL_UINT16(2253, stats.mean); // Skewed by the spikes.
+    TEST_ASSERT_EQUAL_UINT16(2049, stats.median); // 2048.5 rounded.
+    TEST_ASSERT_EQUAL_UINT16(2049, stats.trimmed_mean); // 2048.83 rounded.
+}
+
+TEST_CASE("Can select median of many equal codes", "[sample_stats]")
+{
+    uint16_t codes[101];
+    mcp320x_sample_stats_t stats;
+
+    for (size_t i = 0; i < 101; i++)
+    {
+        codes[i] = i % 3 == 0 ? 100 : 200;
+    }
+
+    mcp320x_err_t result = mcp320x_codes_stats(codes, 101, 49, &stats);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_UINT16(200, stats.median);
+    TEST_ASSERT_EQUAL_UINT16(200, stats.trimmed_mean);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.stddev_mcodes);
+}
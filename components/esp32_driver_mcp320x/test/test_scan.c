@@ -0,0 +1,86 @@
+#include "common_infra_test.h"
+#include "esp_timer.h"
+
+#define SCAN_BENCHMARK_ROUNDS 100
+#define SCAN_ALL_CHANNELS ((1 << MCP3204_MODEL) - 1)
+
+TEST_CASE("Cannot scan with invalid handle", "[scan]")
+{
+    uint16_t values[MCP320X_CHANNEL_COUNT_MAX];
+
+    mcp320x_err_t result = mcp320x_scan(NULL, SCAN_ALL_CHANNELS, MCP320X_READ_MODE_SINGLE, values);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot scan with empty channel mask", "[scan]")
+{
+    uint16_t values[MCP320X_CHANNEL_COUNT_MAX];
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_scan(handle, 0, MCP320X_READ_MODE_SINGLE, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Cannot scan with invalid channel", "[scan]")
+{
+    uint16_t values[MCP320X_CHANNEL_COUNT_MAX];
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_scan(handle, 1 << MCP320X_CHANNEL_7, MCP320X_READ_MODE_SINGLE, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Cannot scan with null values", "[scan]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_scan(handle, SCAN_ALL_CHANNELS, MCP320X_READ_MODE_SINGLE, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Can scan", "[scan]")
+{
+    uint16_t values[MCP320X_CHANNEL_COUNT_MAX] = {0, 0, UINT16_MAX, 0, 0, 0, 0, 0};
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_scan(handle, (1 << MCP320X_CHANNEL_0) | (1 << MCP320X_CHANNEL_3), MCP320X_READ_MODE_SINGLE, values))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(UINT16_MAX, values[2]);       // Not scanned: untouched.
+    TEST_ASSERT_INT16_WITHIN(50, 2048, values[3]); // Will accept 2.5V +- 50mV.
+}
+
+TEST_CASE("Can scan faster than individual reads", "[scan][throughput]")
+{
+    uint16_t values[MCP320X_CHANNEL_COUNT_MAX];
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+    mcp320x_acquire(handle, portMAX_DELAY);
+
+    int64_t start = esp_timer_get_time();
+
+    for (int round = 0; round < SCAN_BENCHMARK_ROUNDS; round++)
+    {
+        for (int channel = 0; channel < (int)VALID_CONFIG.device_model; channel++)
+        {
+            mcp320x_read(handle, (mcp320x_channel_t)channel, MCP320X_READ_MODE_SINGLE, &values[channel]);
+        }
+    }
+
+    const int64_t reads_us = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+
+    for (int round = 0; round < SCAN_BENCHMARK_ROUNDS; round++)
+    {
+        mcp320x_scan(handle, SCAN_ALL_CHANNELS, MCP320X_READ_MODE_SINGLE, values);
+    }
+
+    const int64_t scan_us = esp_timer_get_time() - start;
+
+    mcp320x_release(handle);
+    mcp320x_delete(handle);
+
+    printf("scan: %lld us, individual reads: %lld us (%d rounds)\n", (long long)scan_us, (long long)reads_us, SCAN_BENCHMARK_ROUNDS);
+
+    TEST_ASSERT_LESS_THAN(reads_us, scan_us);
+}
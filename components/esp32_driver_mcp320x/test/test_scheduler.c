@@ -0,0 +1,151 @@
+#include "common_infra_test.h"
+#include "esp32_driver_mcp320x/mcp320x_scheduler.h"
+
+static mcp320x_scheduler_config_t two_slots(mcp320x_scheduler_policy_t policy, uint8_t weight_a, uint8_t weight_b)
+{
+    mcp320x_scheduler_config_t config = {
+        .slots = {
+            {.request = {.channel = MCP320X_CHANNEL_0, .read_mode = MCP320X_READ_MODE_SINGLE}, .weight = weight_a},
+            {.request = {.channel = MCP320X_CHANNEL_3, .read_mode = MCP320X_READ_MODE_SINGLE}, .weight = weight_b}},
+        .slot_count = 2,
+        .policy = policy};
+
+    return config;
+}
+
+TEST_CASE("Cannot init scheduler with invalid handle", "[scheduler]")
+{
+    const mcp320x_scheduler_config_t config = two_slots(MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN, 1, 1);
+
+    mcp320x_err_t result = mcp320x_scheduler_init(NULL, &config);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot init scheduler with invalid config", "[scheduler]")
+{
+    mcp320x_scheduler_t scheduler;
+    mcp320x_scheduler_config_t configs[] = {
+        two_slots(MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN, 0, 1),
+        two_slots(MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN, MCP320X_SCHEDULER_WEIGHT_MAX + 1, 1),
+        two_slots((mcp320x_scheduler_policy_t)2, 1, 1),
+        two_slots(MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN, 1, 1),
+        two_slots(MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN, 1, 1),
+        two_slots(MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN, 1, 1),
+        two_slots(MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN, 1, 1)};
+
+    configs[3].slot_count = 0;
+    configs[4].window = MCP320X_SCHEDULER_WINDOW_MAX + 1;
+    configs[5].window = 16; // Without weight_min and weight_max.
+    configs[6].window = 16;
+    configs[6].variance_low = 100;
+    configs[6].variance_high = 100;
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_scheduler_init(&scheduler, NULL));
+
+    for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++)
+    {
+        TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_scheduler_init(&scheduler, &configs[i]));
+    }
+}
+
+TEST_CASE("Cannot schedule with invalid handle", "[scheduler]")
+{
+    mcp320x_request_t requests[4];
+    uint8_t slots[4];
+
+    mcp320x_err_t result = mcp320x_scheduler_next(NULL, requests, slots, 4);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Can schedule with weighted round-robin", "[scheduler]")
+{
+    mcp320x_scheduler_t scheduler;
+    const mcp320x_scheduler_config_t config = two_slots(MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN, 4, 1);
+    mcp320x_request_t requests[10];
+    uint8_t slots[10];
+    const uint8_t expected[10] = {0, 0, 1, 0, 0, 0, 0, 1, 0, 0}; // Spread, not 4 then 1.
+
+    mcp320x_scheduler_init(&scheduler, &config);
+    mcp320x_err_t result = mcp320x_scheduler_next(&scheduler, requests, slots, 10);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, slots, 10);
+    TEST_ASSERT_EQUAL(MCP320X_CHANNEL_3, requests[2].channel);
+    TEST_ASSERT_EQUAL(MCP320X_CHANNEL_0, requests[3].channel);
+}
+
+TEST_CASE("Can schedule with earliest deadline", "[scheduler]")
+{
+    mcp320x_scheduler_t scheduler;
+    const mcp320x_scheduler_config_t config = two_slots(MCP320X_SCHEDULER_POLICY_EARLIEST_DEADLINE, 3, 1);
+    mcp320x_request_t requests[40];
+    uint8_t slots[40];
+    mcp320x_scheduler_stats_t stats;
+
+    mcp320x_scheduler_init(&scheduler, &config);
+    mcp320x_err_t result = mcp320x_scheduler_next(&scheduler, requests, slots, 40);
+    mcp320x_scheduler_get_stats(&scheduler, &stats);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(30, stats.conversions[0]);
+    TEST_ASSERT_EQUAL(10, stats.conversions[1]);
+
+    // Slot 1 is due every 4 conversions.
+    for (size_t i = 4; i < 40; i++)
+    {
+        TEST_ASSERT_EQUAL(slots[i - 4], slots[i]);
+    }
+}
+
+TEST_CASE("Can adapt scheduler weights to variance", "[scheduler]")
+{
+    mcp320x_scheduler_t scheduler;
+    mcp320x_scheduler_config_t config = two_slots(MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN, 4, 4);
+    const uint8_t slots[8] = {0, 1, 0, 1, 0, 1, 0, 1};
+    const uint16_t codes[8] = {1000, 2048, 3000, 2048, 1000, 2048, 3000, 2048}; // Slot 0 busy, slot 1 quiet.
+    mcp320x_scheduler_stats_t stats;
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        config.slots[i].weight_min = 1;
+        config.slots[i].weight_max = 16;
+    }
+
+    config.window = 4;
+    config.variance_high = 10000;
+    config.variance_low = 100;
+
+    mcp320x_scheduler_init(&scheduler, &config);
+    mcp320x_err_t result = mcp320x_scheduler_update(&scheduler, slots, codes, 8);
+    mcp320x_scheduler_get_stats(&scheduler, &stats);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(1000000, stats.variances[0]);
+    TEST_ASSERT_EQUAL(0, stats.variances[1]);
+    TEST_ASSERT_EQUAL(8, stats.weights[0]);
+    TEST_ASSERT_EQUAL(2, stats.weights[1]);
+}
+
+TEST_CASE("Can read scheduled conversions", "[scheduler]")
+{
+    mcp320x_scheduler_t scheduler;
+    const mcp320x_scheduler_config_t config = two_slots(MCP320X_SCHEDULER_POLICY_WEIGHTED_ROUND_ROBIN, 1, 3);
+    uint8_t slots[40];
+    uint16_t values[40];
+
+    mcp320x_scheduler_init(&scheduler, &config);
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_scheduler_read(&scheduler, handle, slots, values, 40))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+
+    for (size_t i = 0; i < 40; i++)
+    {
+        if (slots[i] == 1)
+        {
+            TEST_ASSERT_INT16_WITHIN(50, 2048, values[i]); // Channel 3: will accept 2.5V +- 50mV.
+        }
+    }
+}
@@ -0,0 +1,217 @@
+#include "common_infra_test.h"
+#include "esp32_driver_mcp320x/mcp320x_stats.h"
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+
+typedef struct
+{
+    uint32_t begins;
+    uint32_t ends;
+    size_t frames;
+    mcp320x_err_t result;
+} trace_counter_t;
+
+static mcp320x_err_t failing_install(mcp320x_config_t const *config, void **context)
+{
+    (void)config;
+
+    *context = NULL;
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t failing_remove(void *context)
+{
+    (void)context;
+
+    return MCP320X_OK;
+}
+
+static mcp320x_err_t failing_transfer(void *context, uint8_t const *tx, uint8_t *rx, size_t count)
+{
+    (void)context;
+    (void)tx;
+    (void)rx;
+    (void)count;
+
+    return MCP320X_ERR_SPI_BUS;
+}
+
+static mcp320x_err_t failing_get_actual_freq(void *context, uint32_t *frequency_hz)
+{
+    (void)context;
+
+    *frequency_hz = 0;
+
+    return MCP320X_OK;
+}
+
+static const mcp320x_transport_t failing_transport = {
+    .install = failing_install,
+    .remove = failing_remove,
+    .transfer = failing_transfer,
+    .get_actual_freq = failing_get_actual_freq};
+
+static void trace_begin(mcp320x_t *handle, mcp320x_trace_event_t event, size_t frames, void *context)
+{
+    trace_counter_t *counter = (trace_counter_t *)context;
+
+    (void)handle;
+
+    if (event == MCP320X_TRACE_TRANSFER)
+    {
+        counter->begins++;
+        counter->frames += frames;
+    }
+}
+
+static void trace_end(mcp320x_t *handle, mcp320x_trace_event_t event, mcp320x_err_t result, void *context)
+{
+    trace_counter_t *counter = (trace_counter_t *)context;
+
+    (void)handle;
+
+    if (event == MCP320X_TRACE_TRANSFER)
+    {
+        counter->ends++;
+        counter->result = result;
+    }
+}
+
+TEST_CASE("Cannot get stats with invalid handle", "[stats]")
+{
+    mcp320x_stats_t stats;
+
+    mcp320x_err_t result = mcp320x_get_stats(NULL, &stats);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot get stats with null stats", "[stats]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_get_stats(handle, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Cannot reset stats with invalid handle", "[stats]")
+{
+    mcp320x_err_t result = mcp320x_reset_stats(NULL);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot set trace hooks with invalid handle", "[stats]")
+{
+    mcp320x_err_t result = mcp320x_set_trace_hooks(NULL, NULL, NULL);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Can count reads", "[stats]")
+{
+    mcp320x_request_t requests[20];
+    uint16_t values[20];
+    uint16_t value = 0;
+    mcp320x_stats_t stats;
+
+    for (size_t i = 0; i < 20; i++)
+    {
+        requests[i].channel = MCP320X_CHANNEL_3;
+        requests[i].read_mode = MCP320X_READ_MODE_SINGLE;
+    }
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+    mcp320x_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_read_batch(handle, requests, 20, values); // Two transactions: 16 + 4 frames.
+    mcp320x_err_t result = mcp320x_get_stats(handle, &stats);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(4, stats.transactions);
+    TEST_ASSERT_EQUAL(22, stats.samples);
+    TEST_ASSERT_EQUAL(0, stats.errors);
+    TEST_ASSERT_GREATER_THAN(0, stats.transaction_max_us);
+    TEST_ASSERT_TRUE(stats.transaction_total_us >= stats.transaction_max_us);
+}
+
+TEST_CASE("Can count bus acquisitions", "[stats]")
+{
+    mcp320x_stats_t stats;
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+    mcp320x_acquire(handle, portMAX_DELAY);
+    mcp320x_acquire(handle, portMAX_DELAY); // Nested: not counted.
+    mcp320x_release(handle);
+    mcp320x_release(handle);
+    mcp320x_err_t result = mcp320x_get_stats(handle, &stats);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(1, stats.bus_acquisitions);
+    TEST_ASSERT_TRUE(stats.bus_wait_total_us >= stats.bus_wait_max_us);
+}
+
+TEST_CASE("Can count errors by code", "[stats]")
+{
+    mcp320x_config_t config = VALID_CONFIG;
+    mcp320x_stats_t stats;
+    uint16_t value = 0;
+
+    config.transport = &failing_transport;
+
+    mcp320x_t *handle = mcp320x_install(&config);
+    mcp320x_err_t read_result = mcp320x_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_err_t scan_result = mcp320x_scan(handle, 0x0F, MCP320X_READ_MODE_SINGLE, (uint16_t[MCP320X_CHANNEL_COUNT_MAX]){0});
+    mcp320x_err_t result = mcp320x_get_stats(handle, &stats);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_SPI_BUS, read_result);
+    TEST_ASSERT_EQUAL(MCP320X_ERR_SPI_BUS, scan_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(2, stats.transactions);
+    TEST_ASSERT_EQUAL(0, stats.samples);
+    TEST_ASSERT_EQUAL(2, stats.errors);
+    TEST_ASSERT_EQUAL(2, stats.errors_spi_bus);
+    TEST_ASSERT_EQUAL(0, stats.errors_other);
+}
+
+TEST_CASE("Can reset stats", "[stats]")
+{
+    mcp320x_stats_t stats;
+    uint16_t value = 0;
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+    mcp320x_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_err_t reset_result = mcp320x_reset_stats(handle);
+    mcp320x_err_t result = mcp320x_get_stats(handle, &stats);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, reset_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(0, stats.transactions);
+    TEST_ASSERT_EQUAL(0, stats.samples);
+    TEST_ASSERT_EQUAL(0, stats.transaction_max_us);
+}
+
+TEST_CASE("Can call trace hooks", "[stats]")
+{
+    const mcp320x_trace_hooks_t hooks = {.begin = trace_begin, .end = trace_end};
+    trace_counter_t counter = {0};
+    uint16_t values[MCP320X_CHANNEL_COUNT_MAX] = {0};
+    uint16_t value = 0;
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+    mcp320x_err_t hooks_result = mcp320x_set_trace_hooks(handle, &hooks, &counter);
+    mcp320x_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_scan(handle, 0x0F, MCP320X_READ_MODE_SINGLE, values);
+    mcp320x_set_trace_hooks(handle, NULL, NULL);
+    mcp320x_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, hooks_result);
+    TEST_ASSERT_EQUAL(2, counter.begins);
+    TEST_ASSERT_EQUAL(2, counter.ends);
+    TEST_ASSERT_EQUAL(5, counter.frames);
+    TEST_ASSERT_EQUAL(MCP320X_OK, counter.result);
+}
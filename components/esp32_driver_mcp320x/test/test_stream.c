@@ -0,0 +1,266 @@
+#include "common_infra_test.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp32_driver_mcp320x/mcp320x_stream.h"
+
+static mcp320x_stream_config_t VALID_STREAM_CONFIG = {
+    .channel_mask = (1 << MCP320X_CHANNEL_0) | (1 << MCP320X_CHANNEL_3),
+    .read_mode = MCP320X_READ_MODE_SINGLE,
+    .rate_hz = 1000,
+    .ring_capacity = 256,
+    .overflow_policy = MCP320X_STREAM_OVERFLOW_DROP_OLDEST,
+    .task_priority = 5,
+    .task_core = tskNO_AFFINITY};
+
+typedef struct
+{
+    mcp320x_t *handle;
+    SemaphoreHandle_t done;
+    mcp320x_err_t read_result;
+    uint16_t value;
+} stream_reader_t;
+
+static void stream_reader_task(void *arg)
+{
+    stream_reader_t *reader = (stream_reader_t *)arg;
+
+    reader->read_result = mcp320x_read(reader->handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &reader->value);
+
+    xSemaphoreGive(reader->done);
+
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("Cannot start stream with invalid handle", "[stream]")
+{
+    mcp320x_err_t result = mcp320x_stream_start(NULL, &VALID_STREAM_CONFIG);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot start stream with null config", "[stream]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_stream_start(handle, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, result);
+}
+
+TEST_CASE("Cannot start stream with invalid channel", "[stream]")
+{
+    mcp320x_stream_config_t config = VALID_STREAM_CONFIG;
+    config.channel_mask = 1 << MCP320X_CHANNEL_7;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_stream_start(handle, &config))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, result);
+}
+
+TEST_CASE("Cannot start stream with high rate", "[stream]")
+{
+    mcp320x_stream_config_t config = VALID_STREAM_CONFIG;
+    config.rate_hz = MCP320X_STREAM_RATE_MAX_HZ + 1;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_stream_start(handle, &config))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, result);
+}
+
+TEST_CASE("Cannot start stream twice", "[stream]")
+{
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+
+    mcp320x_stream_start(handle, &VALID_STREAM_CONFIG);
+    mcp320x_err_t result = mcp320x_stream_start(handle, &VALID_STREAM_CONFIG);
+
+    mcp320x_stream_stop(handle);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, result);
+}
+
+TEST_CASE("Cannot read stream not started", "[stream]")
+{
+    uint16_t values[2];
+    size_t read_count;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_stream_read(handle, values, 2, &read_count))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, result);
+}
+
+TEST_CASE("Cannot stop stream not started", "[stream]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_stream_stop(handle))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, result);
+}
+
+TEST_CASE("Can stream", "[stream]")
+{
+    uint16_t values[64];
+    size_t read_count = 0;
+    mcp320x_stream_stats_t stats;
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+
+    mcp320x_err_t start_result = mcp320x_stream_start(handle, &VALID_STREAM_CONFIG);
+
+    vTaskDelay(pdMS_TO_TICKS(20));
+
+    mcp320x_err_t read_result = mcp320x_stream_read(handle, values, 64, &read_count);
+    mcp320x_stream_get_stats(handle, &stats);
+    mcp320x_err_t stop_result = mcp320x_stream_stop(handle);
+
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, start_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, read_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, stop_result);
+    TEST_ASSERT_GREATER_OR_EQUAL(4, read_count);
+    TEST_ASSERT_EQUAL(0, read_count % 2);
+    TEST_ASSERT_EQUAL(0, stats.errors);
+
+    for (size_t i = 1; i < read_count; i += 2)
+    {
+        TEST_ASSERT_INT16_WITHIN(50, 2048, values[i]); // Channel 3: will accept 2.5V +- 50mV.
+    }
+}
+
+TEST_CASE("Can stream dropping oldest scans", "[stream]")
+{
+    mcp320x_stream_config_t config = VALID_STREAM_CONFIG;
+    config.ring_capacity = 4;
+    mcp320x_stream_stats_t stats;
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+
+    mcp320x_stream_start(handle, &config);
+    vTaskDelay(pdMS_TO_TICKS(20));
+    mcp320x_stream_get_stats(handle, &stats);
+    mcp320x_stream_stop(handle);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_GREATER_THAN(0, stats.dropped);
+    TEST_ASSERT_EQUAL(0, stats.dropped % 2);
+}
+
+TEST_CASE("Can stream blocking when full", "[stream]")
+{
+    mcp320x_stream_config_t config = VALID_STREAM_CONFIG;
+    config.rate_hz = 100;
+    config.ring_capacity = 4;
+    config.overflow_policy = MCP320X_STREAM_OVERFLOW_BLOCK;
+    mcp320x_stream_stats_t blocked_stats;
+    mcp320x_stream_stats_t stats;
+    uint16_t values[4];
+    size_t read_count = 0;
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+
+    mcp320x_stream_start(handle, &config);
+    vTaskDelay(pdMS_TO_TICKS(50));
+    mcp320x_stream_get_stats(handle, &blocked_stats);
+
+    // Reading far faster than the rate: reads free space, they don't trigger scans.
+    for (int i = 0; i < 200; i++)
+    {
+        mcp320x_stream_read(handle, values, 4, &read_count);
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+
+    mcp320x_stream_get_stats(handle, &stats);
+    mcp320x_stream_stop(handle);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(0, blocked_stats.dropped);
+    TEST_ASSERT_GREATER_THAN(0, blocked_stats.blocked);
+    TEST_ASSERT_EQUAL(4, blocked_stats.samples);
+    TEST_ASSERT_GREATER_OR_EQUAL(10, stats.scans); // About 25 in 250ms at 100Hz.
+    TEST_ASSERT_LESS_OR_EQUAL(35, stats.scans);
+}
+
+TEST_CASE("Cannot start stream with filter of other channel count", "[stream]")
+{
+    mcp320x_filter_t filter;
+    const mcp320x_filter_config_t filter_config = {
+        .stages = {{.type = MCP320X_FILTER_BOXCAR, .length = 4}},
+        .stage_count = 1,
+        .channel_count = 1};
+    mcp320x_stream_config_t config = VALID_STREAM_CONFIG;
+
+    mcp320x_filter_init(&filter, &filter_config);
+    config.filter = &filter;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_stream_start(handle, &config))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, result);
+}
+
+TEST_CASE("Can stream filtered", "[stream]")
+{
+    static mcp320x_filter_t filter;
+    const mcp320x_filter_config_t filter_config = {
+        .stages = {{.type = MCP320X_FILTER_EMA, .alpha = MCP320X_Q15(0.25)}},
+        .stage_count = 1,
+        .channel_count = 2};
+    mcp320x_stream_config_t config = VALID_STREAM_CONFIG;
+    uint16_t values[64];
+    size_t read_count = 0;
+
+    mcp320x_filter_init(&filter, &filter_config);
+    config.filter = &filter;
+
+    mcp320x_t *handle = mcp320x_install(&VALID_CONFIG);
+
+    mcp320x_err_t start_result = mcp320x_stream_start(handle, &config);
+
+    vTaskDelay(pdMS_TO_TICKS(20));
+
+    mcp320x_err_t read_result = mcp320x_stream_read(handle, values, 64, &read_count);
+    mcp320x_err_t stop_result = mcp320x_stream_stop(handle);
+
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, start_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, read_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, stop_result);
+    TEST_ASSERT_GREATER_OR_EQUAL(4, read_count);
+
+    for (size_t i = 1; i < read_count; i += 2)
+    {
+        TEST_ASSERT_INT16_WITHIN(50, 2048, values[i]); // Channel 3: starts from its first code, no settling from 0.
+    }
+}
+
+TEST_CASE("Can read locked handle while streaming", "[stream]")
+{
+    mcp320x_config_t config = VALID_CONFIG;
+    stream_reader_t reader = {0};
+    mcp320x_stream_stats_t stats;
+
+    config.locked = true;
+    reader.handle = mcp320x_install(&config);
+    reader.done = xSemaphoreCreateBinary();
+
+    mcp320x_err_t start_result = mcp320x_stream_start(reader.handle, &VALID_STREAM_CONFIG);
+
+    vTaskDelay(pdMS_TO_TICKS(10));
+    xTaskCreate(stream_reader_task, "stream_reader", 4096, &reader, 5, NULL);
+
+    const BaseType_t done = xSemaphoreTake(reader.done, pdMS_TO_TICKS(1000));
+
+    mcp320x_stream_get_stats(reader.handle, &stats);
+    mcp320x_err_t stop_result = mcp320x_stream_stop(reader.handle);
+
+    mcp320x_delete(reader.handle);
+    vSemaphoreDelete(reader.done);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, start_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, stop_result);
+    TEST_ASSERT_EQUAL(pdTRUE, done);
+    TEST_ASSERT_EQUAL(MCP320X_OK, reader.read_result);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, reader.value); // Will accept 2.5V +- 50mV.
+    TEST_ASSERT_GREATER_THAN(0, stats.scans);
+    TEST_ASSERT_EQUAL(0, stats.errors);
+}
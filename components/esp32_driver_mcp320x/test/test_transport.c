@@ -0,0 +1,128 @@
+#include "common_infra_test.h"
+#include "esp32_driver_mcp320x/mcp320x_transport.h"
+
+static mcp320x_config_t mock_config(mcp320x_transport_mock_t *mock)
+{
+    mcp320x_config_t config = VALID_CONFIG;
+
+    config.transport = &mcp320x_transport_mock;
+    config.transport_config = mock;
+
+    return config;
+}
+
+TEST_CASE("Cannot init with incomplete transport", "[transport]")
+{
+    const mcp320x_transport_t transport = {
+        .capabilities = 0,
+        .install = NULL};
+    mcp320x_config_t config = VALID_CONFIG;
+
+    config.transport = &transport;
+
+    mcp320x_t *handle = mcp320x_install(&config);
+
+    TEST_ASSERT_NULL(handle);
+}
+
+TEST_CASE("Cannot init gpio transport without pins", "[transport]")
+{
+    mcp320x_config_t config = VALID_CONFIG;
+
+    config.transport = &mcp320x_transport_gpio;
+
+    mcp320x_t *handle = mcp320x_install(&config);
+
+    TEST_ASSERT_NULL(handle);
+}
+
+TEST_CASE("Cannot init mock transport without device", "[transport]")
+{
+    mcp320x_t *handle = mcp320x_install(&(mcp320x_config_t){
+        .device_model = MCP3204_MODEL,
+        .clock_speed_hz = 1000000,
+        .reference_voltage = 5000,
+        .transport = &mcp320x_transport_mock});
+
+    TEST_ASSERT_NULL(handle);
+}
+
+TEST_CASE("Cannot get capabilities with null capabilities", "[transport]")
+{
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_get_capabilities(handle, NULL))
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, result);
+}
+
+TEST_CASE("Can get capabilities of default transport", "[transport]")
+{
+    uint32_t capabilities = 0;
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_get_capabilities(handle, &capabilities))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL(MCP320X_TRANSPORT_CAP_BATCH | MCP320X_TRANSPORT_CAP_DMA, capabilities);
+}
+
+TEST_CASE("Can read with spi polling transport", "[transport]")
+{
+    mcp320x_config_t config = VALID_CONFIG;
+    uint16_t value;
+    uint16_t values[MCP320X_CHANNEL_COUNT_MAX];
+
+    config.transport = &mcp320x_transport_spi_polling;
+
+    mcp320x_t *handle = mcp320x_install(&config);
+    mcp320x_err_t read_result = mcp320x_read(handle, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_err_t scan_result = mcp320x_scan(handle, 1 << MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, values);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, read_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, scan_result);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, value);
+    TEST_ASSERT_INT16_WITHIN(50, 2048, values[MCP320X_CHANNEL_3]);
+}
+
+TEST_CASE("Can read with mock transport", "[transport]")
+{
+    mcp320x_transport_mock_t mock = {
+        .codes = {0, 1, 2048, 4095}};
+    mcp320x_config_t config = mock_config(&mock);
+    uint16_t value;
+    uint16_t values[MCP320X_CHANNEL_COUNT_MAX] = {0};
+
+    mcp320x_t *handle = mcp320x_install(&config);
+    mcp320x_err_t read_result = mcp320x_read(handle, MCP320X_CHANNEL_2, MCP320X_READ_MODE_SINGLE, &value);
+    mcp320x_err_t scan_result = mcp320x_scan(handle, 0b1111, MCP320X_READ_MODE_SINGLE, values);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, read_result);
+    TEST_ASSERT_EQUAL(MCP320X_OK, scan_result);
+    TEST_ASSERT_EQUAL(2048, value);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(mock.codes, values, 4);
+    TEST_ASSERT_EQUAL(2, mock.transfers); // The scan is a single transfer.
+    TEST_ASSERT_EQUAL(5, mock.frames);
+}
+
+TEST_CASE("Can acquire and release mock transport", "[transport]")
+{
+    mcp320x_transport_mock_t mock = {0};
+    mcp320x_config_t config = mock_config(&mock);
+    uint32_t frequency = 0;
+    uint32_t capabilities = 0;
+
+    mcp320x_t *handle = mcp320x_install(&config);
+    mcp320x_acquire(handle, portMAX_DELAY);
+    const uint32_t acquired = mock.acquired;
+    mcp320x_release(handle);
+    mcp320x_err_t release_again_result = mcp320x_release(handle);
+    mcp320x_get_actual_freq(handle, &frequency);
+    mcp320x_get_capabilities(handle, &capabilities);
+    mcp320x_delete(handle);
+
+    TEST_ASSERT_EQUAL(1, acquired);
+    TEST_ASSERT_EQUAL(0, mock.acquired);
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_STATE, release_again_result);
+    TEST_ASSERT_EQUAL(VALID_CONFIG.clock_speed_hz, frequency);
+    TEST_ASSERT_EQUAL(MCP320X_TRANSPORT_CAP_BATCH, capabilities);
+}
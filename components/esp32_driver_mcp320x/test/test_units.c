@@ -0,0 +1,138 @@
+#include <math.h>
+#include "common_infra_test.h"
+#include "esp32_driver_mcp320x/mcp320x_units.h"
+#include "conversion.h"
+#include "units_millivolts_5v.h"
+#include "units_thermistor_10k.h"
+
+// Tables generated at build time from test/units: millivolts with a 5V
+// reference, one entry per code, and a 10K NTC (beta 3950) under a 10K
+// resistor in milli-Celsius, one entry every 16 codes.
+
+static double thermistor_celsius(uint16_t code)
+{
+    const double resistance = 10000.0 * code / (4096.0 - code);
+
+    return 1.0 / (1.0 / 298.15 + log(resistance / 10000.0) / 3950.0) - 273.15;
+}
+
+TEST_CASE("Cannot init units with invalid handle", "[units]")
+{
+    mcp320x_err_t result = mcp320x_units_init(NULL);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_HANDLE, result);
+}
+
+TEST_CASE("Cannot set units table with invalid table", "[units]")
+{
+    mcp320x_units_t units;
+    const uint16_t sizes[5] = {0, 2, 100, 4095, 4097};
+
+    mcp320x_units_init(&units);
+
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CHANNEL, mcp320x_units_set_table(&units, (mcp320x_channel_t)8, units_millivolts_5v, UNITS_MILLIVOLTS_5V_SIZE));
+    TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_VALUE_HANDLE, mcp320x_units_set_table(&units, MCP320X_CHANNEL_0, NULL, UNITS_MILLIVOLTS_5V_SIZE));
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        TEST_ASSERT_EQUAL(MCP320X_ERR_INVALID_CONFIG, mcp320x_units_set_table(&units, MCP320X_CHANNEL_0, units_millivolts_5v, sizes[i]));
+    }
+}
+
+TEST_CASE("Can convert units without table", "[units]")
+{
+    mcp320x_units_t units;
+    const uint16_t codes[3] = {0, 1234, 4095};
+    int32_t values[3];
+
+    mcp320x_units_init(&units);
+    mcp320x_err_t result = mcp320x_units_convert(&units, MCP320X_CHANNEL_2, codes, values, 3);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_EQUAL_INT32(0, values[0]);
+    TEST_ASSERT_EQUAL_INT32(1234, values[1]);
+    TEST_ASSERT_EQUAL_INT32(4095, values[2]);
+}
+
+TEST_CASE("Can convert units with direct table", "[units]")
+{
+    mcp320x_units_t units;
+    uint16_t codes[4096];
+    int32_t values[4096];
+
+    for (uint16_t i = 0; i < 4096; i++)
+    {
+        codes[i] = i;
+    }
+
+    mcp320x_units_init(&units);
+    mcp320x_err_t result_set = mcp320x_units_set_table(&units, MCP320X_CHANNEL_1, units_millivolts_5v, UNITS_MILLIVOLTS_5V_SIZE);
+    mcp320x_err_t result_convert = mcp320x_units_convert(&units, MCP320X_CHANNEL_1, codes, values, 4096);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_set);
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_convert);
+
+    for (uint16_t i = 0; i < 4096; i++)
+    {
+        TEST_ASSERT_EQUAL_INT32(mcp320x_code_to_millivolts(i, 5000), values[i]);
+    }
+}
+
+TEST_CASE("Can convert units with interpolated table", "[units]")
+{
+    mcp320x_units_t units;
+    const int32_t table[3] = {0, 1000, -3000}; // Codes 0, 2048 and 4096.
+    const uint16_t codes[5] = {0, 1024, 2048, 3072, 4095};
+    int32_t values[5];
+
+    mcp320x_units_init(&units);
+    mcp320x_err_t result_set = mcp320x_units_set_table(&units, MCP320X_CHANNEL_4, table, 3);
+    mcp320x_err_t result_convert = mcp320x_units_convert(&units, MCP320X_CHANNEL_4, codes, values, 5);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_set);
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_convert);
+    TEST_ASSERT_EQUAL_INT32(0, values[0]);
+    TEST_ASSERT_EQUAL_INT32(500, values[1]);
+    TEST_ASSERT_EQUAL_INT32(1000, values[2]);
+    TEST_ASSERT_EQUAL_INT32(-1000, values[3]);
+    TEST_ASSERT_EQUAL_INT32(-2998, values[4]);
+}
+
+TEST_CASE("Can convert units with generated thermistor table", "[units]")
+{
+    mcp320x_units_t units;
+    uint16_t codes[64];
+    int32_t values[64];
+
+    for (uint16_t i = 0; i < 64; i++)
+    {
+        codes[i] = (uint16_t)(400 + i * 51); // From 85C down to -14C, off the entries.
+    }
+
+    mcp320x_units_init(&units);
+    mcp320x_err_t result_set = mcp320x_units_set_table(&units, MCP320X_CHANNEL_0, units_thermistor_10k, UNITS_THERMISTOR_10K_SIZE);
+    mcp320x_err_t result_convert = mcp320x_units_convert(&units, MCP320X_CHANNEL_0, codes, values, 64);
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_set);
+    TEST_ASSERT_EQUAL(MCP320X_OK, result_convert);
+    TEST_ASSERT_EQUAL_INT32(25000, units_thermistor_10k[128]); // Code 2048: 10K, 25C.
+
+    for (uint16_t i = 0; i < 64; i++)
+    {
+        TEST_ASSERT_INT32_WITHIN(50, (int32_t)lround(thermistor_celsius(codes[i]) * 1000.0), values[i]);
+    }
+}
+
+TEST_CASE("Can read units", "[units]")
+{
+    mcp320x_units_t units;
+    int32_t millivolts;
+
+    mcp320x_units_init(&units);
+    mcp320x_units_set_table(&units, MCP320X_CHANNEL_3, units_millivolts_5v, UNITS_MILLIVOLTS_5V_SIZE);
+
+    EXECUTE_WITH_HANDLE(mcp320x_err_t result = mcp320x_units_read(handle, &units, MCP320X_CHANNEL_3, MCP320X_READ_MODE_SINGLE, &millivolts))
+
+    TEST_ASSERT_EQUAL(MCP320X_OK, result);
+    TEST_ASSERT_INT32_WITHIN(50, 2500, millivolts);
+}
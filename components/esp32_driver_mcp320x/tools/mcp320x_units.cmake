@@ -0,0 +1,46 @@
+# Code to physical unit tables for mcp320x_units.h, generated at build time.
+#
+#   include(<component dir>/tools/mcp320x_units.cmake)
+#   mcp320x_units_add_table(TARGET ${COMPONENT_LIB} DESCRIPTION thermistor.json)
+#
+# Generates thermistor.c and thermistor.h from the description (see
+# mcp320x_units_table.py), adds the source to the target and the header
+# directory to its include path. Regenerated when the description changes.
+
+set(MCP320X_UNITS_GENERATOR ${CMAKE_CURRENT_LIST_DIR}/mcp320x_units_table.py)
+
+function(mcp320x_units_add_table)
+    cmake_parse_arguments(UNITS "" "TARGET;DESCRIPTION" "" ${ARGN})
+
+    # ESP-IDF runs the component CMakeLists once as a script, to find the requirements.
+    if(CMAKE_BUILD_EARLY_EXPANSION)
+        return()
+    endif()
+
+    if(NOT UNITS_TARGET OR NOT UNITS_DESCRIPTION)
+        message(FATAL_ERROR "mcp320x_units_add_table: TARGET and DESCRIPTION are required")
+    endif()
+
+    if(COMMAND idf_build_get_property)
+        idf_build_get_property(python PYTHON)
+    else()
+        find_package(Python3 REQUIRED COMPONENTS Interpreter)
+        set(python ${Python3_EXECUTABLE})
+    endif()
+
+    get_filename_component(description ${UNITS_DESCRIPTION} ABSOLUTE)
+    get_filename_component(name ${UNITS_DESCRIPTION} NAME_WE)
+    set(output_dir ${CMAKE_CURRENT_BINARY_DIR}/mcp320x_units)
+
+    file(MAKE_DIRECTORY ${output_dir})
+
+    add_custom_command(
+        OUTPUT ${output_dir}/${name}.c ${output_dir}/${name}.h
+        COMMAND ${python} ${MCP320X_UNITS_GENERATOR} ${description} ${output_dir}
+        DEPENDS ${description} ${MCP320X_UNITS_GENERATOR}
+        COMMENT "Generating MCP320X units table ${name}"
+        VERBATIM)
+
+    target_sources(${UNITS_TARGET} PRIVATE ${output_dir}/${name}.c ${output_dir}/${name}.h)
+    target_include_directories(${UNITS_TARGET} PRIVATE ${output_dir})
+endfunction()
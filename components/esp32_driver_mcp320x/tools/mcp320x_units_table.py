@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+"""Generate a code to physical unit table for mcp320x_units.h.
+
+Reads a JSON description of a transfer function and writes <name>.c and
+<name>.h, where <name> is the description file name without extension:
+
+    const int32_t <name>[<NAME>_SIZE];
+
+Entries are the function evaluated at the codes 0, step, 2 * step, ..., with
+step = 4096 / (size - 1), times "scale", rounded to the nearest integer. A size
+of 4096 has one entry per code instead.
+
+Description fields:
+
+    type              "linear", "polynomial", "piecewise", "steinhart_hart" or "beta".
+    size              4096, or 4096 / 2^k + 1 (2049, 1025, ..., 3) for an interpolated table.
+    scale             Output multiplier before rounding, like 1000 for milli-units. Default 1.
+    input             "code" (0 to 4095) or "volts"; the input of linear, polynomial and piecewise.
+    reference_voltage Reference voltage in millivolts, with "input": "volts".
+
+    linear            gain, offset: offset + gain * x.
+    polynomial        coefficients: c0 + c1 * x + c2 * x^2 + ...
+    piecewise         points: [[x, y], ...] in increasing x; the ends extend their segments.
+    steinhart_hart    a, b, c: 1 / T = a + b * ln(R) + c * ln(R)^3, T in kelvin; outputs Celsius.
+    beta              beta, r0, t0 (Celsius): 1 / T = 1 / T0 + ln(R / R0) / beta; outputs Celsius.
+
+Thermistors are ratiometric: a divider with "series_resistance" (ohms) to the
+reference, and the thermistor to ground ("thermistor": "low", the default) or
+to the reference ("thermistor": "high").
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import sys
+
+CODES = 4096
+INT32_MIN = -(2**31)
+INT32_MAX = 2**31 - 1
+
+
+def fail(message):
+    sys.exit("mcp320x_units_table: " + message)
+
+
+def make_input(description):
+    mode = description.get("input", "code")
+
+    if mode == "code":
+        return lambda code: float(code)
+
+    if mode == "volts":
+        reference_voltage = description.get("reference_voltage")
+
+        if not reference_voltage:
+            fail('"input": "volts" needs "reference_voltage"')
+
+        return lambda code: code * reference_voltage / CODES / 1000.0
+
+    fail('unknown "input": ' + str(mode))
+
+
+def make_resistance(description):
+    series = description.get("series_resistance")
+    position = description.get("thermistor", "low")
+
+    if not series or position not in ("low", "high"):
+        fail('thermistors need "series_resistance" and a "thermistor" of "low" or "high"')
+
+    def resistance(code):
+        # Away from the rails, where the divider has no solution.
+        code = min(max(code, 1), CODES - 1)
+        ratio = code / CODES
+
+        return series * ratio / (1.0 - ratio) if position == "low" else series * (1.0 - ratio) / ratio
+
+    return resistance
+
+
+def make_function(description):
+    kind = description.get("type")
+
+    if kind == "linear":
+        x = make_input(description)
+        gain = description["gain"]
+        offset = description.get("offset", 0.0)
+
+        return lambda code: offset + gain * x(code)
+
+    if kind == "polynomial":
+        x = make_input(description)
+        coefficients = description["coefficients"]
+
+        return lambda code: _horner(coefficients, x(code))
+
+    if kind == "piecewise":
+        x = make_input(description)
+        points = description["points"]
+
+        if len(points) < 2 or any(points[i][0] >= points[i + 1][0] for i in range(len(points) - 1)):
+            fail('"piecewise" needs 2 or more points in increasing x')
+
+        return lambda code: _interpolate(points, x(code))
+
+    if kind == "steinhart_hart":
+        resistance = make_resistance(description)
+        a, b, c = description["a"], description["b"], description["c"]
+
+        def steinhart_hart(code):
+            ln_r = math.log(resistance(code))
+
+            return 1.0 / (a + b * ln_r + c * ln_r**3) - 273.15
+
+        return steinhart_hart
+
+    if kind == "beta":
+        resistance = make_resistance(description)
+        beta, r0, t0 = description["beta"], description["r0"], description["t0"] + 273.15
+
+        return lambda code: 1.0 / (1.0 / t0 + math.log(resistance(code) / r0) / beta) - 273.15
+
+    fail('unknown "type": ' + str(kind))
+
+
+def _horner(coefficients, x):
+    result = 0.0
+
+    for c in reversed(coefficients):
+        result = result * x + c
+
+    return result
+
+
+def _interpolate(points, x):
+    segment = 0
+
+    while segment < len(points) - 2 and x > points[segment + 1][0]:
+        segment += 1
+
+    (x0, y0), (x1, y1) = points[segment], points[segment + 1]
+
+    return y0 + (y1 - y0) * (x - x0) / (x1 - x0)
+
+
+def make_table(description):
+    size = description.get("size", CODES)
+
+    if size == CODES:
+        codes = range(CODES)
+    elif size >= 3 and (CODES % (size - 1)) == 0 and ((size - 1) & (size - 2)) == 0:
+        step = CODES // (size - 1)
+        codes = range(0, CODES + 1, step)
+    else:
+        fail('"size" must be 4096, or 4096 / 2^k + 1')
+
+    function = make_function(description)
+    scale = description.get("scale", 1.0)
+    table = []
+
+    for code in codes:
+        value = math.floor(function(code) * scale + 0.5)
+        table.append(min(max(value, INT32_MIN), INT32_MAX))
+
+    return table
+
+
+def write(name, description, table, output_dir):
+    guard = "__" + name.upper() + "_H__"
+    size_name = name.upper() + "_SIZE"
+    source = os.path.basename(description)
+
+    with open(os.path.join(output_dir, name + ".h"), "w") as header:
+        header.write(
+            "// Generated by mcp320x_units_table.py from {0}. Do not edit.\n"
+            "#ifndef {1}\n"
+            "#define {1}\n"
+            "\n"
+            "#include <stdint.h>\n"
+            "\n"
+            "#define {2} {3}\n"
+            "\n"
+            "#ifdef __cplusplus\n"
+            'extern "C"\n'
+            "{{\n"
+            "#endif\n"
+            "\n"
+            "    extern const int32_t {4}[{2}];\n"
+            "\n"
+            "#ifdef __cplusplus\n"
+            "}}\n"
+            "#endif\n"
+            "#endif\n".format(source, guard, size_name, len(table), name)
+        )
+
+    with open(os.path.join(output_dir, name + ".c"), "w") as c:
+        c.write("// Generated by mcp320x_units_table.py from {0}. Do not edit.\n".format(source))
+        c.write('#include "{0}.h"\n\n'.format(name))
+        c.write("const int32_t {0}[{1}] = {{\n".format(name, size_name))
+
+        for i in range(0, len(table), 8):
+            c.write("    " + ", ".join(str(value) for value in table[i : i + 8]) + ",\n")
+
+        c.write("};\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate a code to physical unit table for mcp320x_units.h.")
+    parser.add_argument("description", help="JSON description of the transfer function")
+    parser.add_argument("output_dir", help="where <name>.c and <name>.h are written")
+    arguments = parser.parse_args()
+
+    name = os.path.splitext(os.path.basename(arguments.description))[0]
+
+    if not re.match(r"^[A-Za-z_][A-Za-z0-9_]*$", name):
+        fail("the description file name must be a C identifier: " + name)
+
+    with open(arguments.description) as file:
+        description = json.load(file)
+
+    write(name, arguments.description, make_table(description), arguments.output_dir)
+
+
+if __name__ == "__main__":
+    main()
@@ -8,17 +8,25 @@ switch ($args[0]) {
     'build-test' {
         &docker.exe run --rm --env LC_ALL='C.UTF-8' -v ${ProjectFolder}:/project -w /project ${EspIdfDockerImage} idf.py build -C ./test
     }
+    'build-benchmark' {
+        &docker.exe run --rm --env LC_ALL='C.UTF-8' -v ${ProjectFolder}:/project -w /project ${EspIdfDockerImage} idf.py build -C ./benchmark
+    }
     'clean' {
         &docker.exe run --rm --env LC_ALL='C.UTF-8' -v ${ProjectFolder}:/project -w /project ${EspIdfDockerImage} idf.py fullclean
     }
     'clean-test' {
         &docker.exe run --rm --env LC_ALL='C.UTF-8' -v ${ProjectFolder}:/project -w /project ${EspIdfDockerImage} idf.py fullclean -C ./test
     }
+    'clean-benchmark' {
+        &docker.exe run --rm --env LC_ALL='C.UTF-8' -v ${ProjectFolder}:/project -w /project ${EspIdfDockerImage} idf.py fullclean -C ./benchmark
+    }
     Default {
         Write-Host "Command not recognized. Valid commands:"
         Write-Host "`t* build: build the main project"
         Write-Host "`t* build-test: build the test project"
+        Write-Host "`t* build-benchmark: build the benchmark project"
         Write-Host "`t* clean: clean the main project build files"
         Write-Host "`t* clean-test: clean the test project build files"
+        Write-Host "`t* clean-benchmark: clean the benchmark project build files"
     }
 }